@@ -0,0 +1,313 @@
+/*
+ * amp_channel.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* Standard includes. */
+#include <string.h>
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "semphr.h"
+/* Xilinx includes. */
+#include "xil_cache.h"
+#include "xil_io.h"
+#include "xil_types.h"
+#include "xpseudo_asm.h"
+#include "xscugic.h"
+/* Application includes. */
+#include "amp_channel.h"
+
+#if DO_AMP
+
+#define AMP_CACHE_LINE	32							/* Cortex-A9 L1 and L2 cache line */
+#define AMP_SLOT_MASK	( AMP_CHANNEL_SLOTS - 1 )	/* index of a buffer in the ring */
+#define AMP_MAGIC	0x414D5031U						/* "AMP1", once core 0 has set up the rings */
+#define AMP_START_ADDRESS	0xFFFFFFF0U				/* where the boot ROM of core 1 reads its start */
+#define AMP_SGI_TRIGGER	0x3							/* rising edge, as the tick in portZynq7000.c */
+#if ( AMP_CORE == 0 )
+#define AMP_TO_PEER	AMP_TO_CORE1					/* the channel this core sends on */
+#define AMP_TO_SELF	AMP_TO_CORE0					/* the channel this core receives on */
+#define AMP_PEER_MASK	XSCUGIC_SPI_CPU1_MASK		/* the other core, for its interrupt */
+#else
+#define AMP_TO_PEER	AMP_TO_CORE0
+#define AMP_TO_SELF	AMP_TO_CORE1
+#define AMP_PEER_MASK	XSCUGIC_SPI_CPU0_MASK
+#endif
+#ifndef sev
+#define sev()	__asm__ __volatile__ ( "sev" : : : "memory" )	/* wake a core from WFE */
+#endif
+
+/* A buffer of a ring, with its length on a line of its own. */
+typedef struct {
+	u32 length __attribute__(( aligned( AMP_CACHE_LINE ) ));	/* bytes of the message */
+	u8 data[ AMP_BUFFER_SIZE ] __attribute__(( aligned( AMP_CACHE_LINE ) ));	/* the message */
+} AmpSlot;
+
+/* A ring in the OCM.  Each index only grows, and is written by one core. */
+typedef struct {
+	volatile u32 head __attribute__(( aligned( AMP_CACHE_LINE ) ));	/* messages sent, by the sender */
+	volatile u32 tail __attribute__(( aligned( AMP_CACHE_LINE ) ));	/* messages released, by the receiver */
+	AmpSlot slots[ AMP_CHANNEL_SLOTS ];
+} AmpRing;
+
+/* The memory shared by the two cores, at AMP_SHARED_BASE. */
+typedef struct {
+	volatile u32 magic __attribute__(( aligned( AMP_CACHE_LINE ) ));	/* AMP_MAGIC once set up */
+	AmpRing rings[ AMP_CHANNELS ];
+} AmpShared;
+
+/* This core's end of a channel, in its own memory. */
+typedef struct {
+	AmpRing *pxRing;			/* the ring in the OCM */
+	u32 own;					/* the index this core writes: the head of a sender, the tail of a receiver */
+	u32 peer;					/* the index the other core writes, as last read */
+	u32 received;				/* the messages received, of a receiver */
+	SemaphoreHandle_t xWake;	/* given by the interrupt while a task waits */
+	volatile BaseType_t xWaiting;	/* whether a task waits on the channel */
+} AmpEndpoint;
+
+/* Whether an endpoint can go on, refreshing what it knows of the other core. */
+typedef BaseType_t ( *AmpReady )( AmpEndpoint *pxEndpoint );
+
+/* Whether the ring of a sender has a free buffer. */
+static BaseType_t prvAmpHasSpace( AmpEndpoint *pxEndpoint );
+/* Whether the ring of a receiver has a message not yet received. */
+static BaseType_t prvAmpHasMessage( AmpEndpoint *pxEndpoint );
+/* Wait up to xTicksToWait for pxReady to hold. */
+static BaseType_t prvAmpWait( AmpEndpoint *pxEndpoint, AmpReady pxReady, TickType_t xTicksToWait );
+#if ( AMP_CORE == 0 )
+/* Start core 1 at AMP_CORE1_ENTRY. */
+static void prvAmpStartCore1( void );
+#endif
+/* The interrupt raised by the other core. */
+static void prvAmpISR( void *pvCallBackRef );
+/*-----------------------------------------------------------*/
+
+/* The interrupt controller instance, defined by portZynq7000.c. */
+extern XScuGic xInterruptController;
+
+/* This core's end of each channel. */
+static AmpEndpoint endpoints[ AMP_CHANNELS ];
+
+#endif /* DO_AMP */
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xAmpInit( void )
+{
+#if DO_AMP
+	AmpShared *pxShared = ( AmpShared * ) AMP_SHARED_BASE;	/* Hold the shared memory. */
+	u32 channel;	/* Hold the index of the channel. */
+
+#if ( AMP_CORE == 0 )
+	/* Core 1 has not started, so the rings are set up before it can look. */
+	memset( pxShared, 0, sizeof( *pxShared ) );
+	pxShared->magic = AMP_MAGIC;
+	Xil_DCacheFlushRange( ( INTPTR ) pxShared, sizeof( *pxShared ) );
+#else
+	Xil_DCacheInvalidateRange( ( INTPTR ) &pxShared->magic, AMP_CACHE_LINE );
+	if ( pxShared->magic != AMP_MAGIC ) {
+		return pdFAIL;
+	}
+#endif
+
+	for ( channel = 0; channel < AMP_CHANNELS; ++channel ) {
+		endpoints[channel].pxRing = &pxShared->rings[channel];
+		endpoints[channel].xWake = xSemaphoreCreateBinary();
+		if ( endpoints[channel].xWake == NULL ) {
+			return pdFAIL;
+		}
+	}
+
+	/* The software generated interrupt must be allowed to use the API. */
+	xPortInstallInterruptHandler( AMP_SGI_ID, prvAmpISR, NULL );
+	XScuGic_SetPriorityTriggerType( &xInterruptController, AMP_SGI_ID,
+		portLOWEST_USABLE_INTERRUPT_PRIORITY << portPRIORITY_SHIFT, AMP_SGI_TRIGGER );
+	vPortEnableInterrupt( AMP_SGI_ID );
+
+#if ( AMP_CORE == 0 )
+	prvAmpStartCore1();
+#endif
+#endif /* DO_AMP */
+	return pdPASS;
+}
+
+
+#if DO_AMP
+
+/*-----------------------------------------------------------*/
+void *pvAmpChannelAcquire( u32 channel, TickType_t xTicksToWait )
+{
+	AmpEndpoint *pxEndpoint = &endpoints[channel];	/* Hold this end of the channel. */
+
+	configASSERT( channel == AMP_TO_PEER );
+	if ( prvAmpWait( pxEndpoint, prvAmpHasSpace, xTicksToWait ) != pdPASS ) {
+		return NULL;
+	}
+	return pxEndpoint->pxRing->slots[ pxEndpoint->own & AMP_SLOT_MASK ].data;
+}
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xAmpChannelSend( u32 channel, void *pvBuffer, u32 length )
+{
+	AmpEndpoint *pxEndpoint = &endpoints[channel];	/* Hold this end of the channel. */
+	AmpSlot *pxSlot;	/* Hold the buffer at the head. */
+
+	configASSERT( channel == AMP_TO_PEER );
+	pxSlot = &pxEndpoint->pxRing->slots[ pxEndpoint->own & AMP_SLOT_MASK ];
+	if ( ( pvBuffer != pxSlot->data ) || ( length > AMP_BUFFER_SIZE )
+			|| ( pxEndpoint->own - pxEndpoint->peer >= AMP_CHANNEL_SLOTS ) ) {
+		return pdFAIL;
+	}
+
+	/* The message is in memory before the head says so, as the clean ends
+	 * with a barrier. */
+	pxSlot->length = length;
+	Xil_DCacheFlushRange( ( INTPTR ) pxSlot, AMP_CACHE_LINE + length );
+	pxEndpoint->pxRing->head = ++pxEndpoint->own;
+	Xil_DCacheFlushRange( ( INTPTR ) &pxEndpoint->pxRing->head, AMP_CACHE_LINE );
+
+	XScuGic_SoftwareIntr( &xInterruptController, AMP_SGI_ID, AMP_PEER_MASK );
+	return pdPASS;
+}
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xAmpChannelReceive( u32 channel, void **ppvBuffer, u32 *pulLength, TickType_t xTicksToWait )
+{
+	AmpEndpoint *pxEndpoint = &endpoints[channel];	/* Hold this end of the channel. */
+	AmpSlot *pxSlot;	/* Hold the next buffer to receive. */
+	u32 length;			/* Hold the length of its message. */
+
+	configASSERT( channel == AMP_TO_SELF );
+	if ( prvAmpWait( pxEndpoint, prvAmpHasMessage, xTicksToWait ) != pdPASS ) {
+		return pdFAIL;
+	}
+
+	/* Any line of the buffer in the cache is from before it was sent. */
+	pxSlot = &pxEndpoint->pxRing->slots[ pxEndpoint->received & AMP_SLOT_MASK ];
+	Xil_DCacheInvalidateRange( ( INTPTR ) pxSlot, AMP_CACHE_LINE );
+	length = pxSlot->length;
+	if ( length > AMP_BUFFER_SIZE ) {
+		length = AMP_BUFFER_SIZE;
+	}
+	Xil_DCacheInvalidateRange( ( INTPTR ) pxSlot->data, length );
+	++pxEndpoint->received;
+
+	*ppvBuffer = pxSlot->data;
+	*pulLength = length;
+	return pdPASS;
+}
+
+
+/*-----------------------------------------------------------*/
+void vAmpChannelRelease( u32 channel, void *pvBuffer )
+{
+	AmpEndpoint *pxEndpoint = &endpoints[channel];	/* Hold this end of the channel. */
+	AmpRing *pxRing = pxEndpoint->pxRing;			/* Hold the ring of the channel. */
+
+	configASSERT( channel == AMP_TO_SELF );
+	configASSERT( pxEndpoint->own != pxEndpoint->received );
+	configASSERT( pvBuffer == pxRing->slots[ pxEndpoint->own & AMP_SLOT_MASK ].data );
+
+	pxRing->tail = ++pxEndpoint->own;
+	Xil_DCacheFlushRange( ( INTPTR ) &pxRing->tail, AMP_CACHE_LINE );
+
+	/* The sender only waits on a full ring, which it cannot add to, so the
+	 * head read after the tail is written tells whether it may be waiting. */
+	Xil_DCacheInvalidateRange( ( INTPTR ) &pxRing->head, AMP_CACHE_LINE );
+	pxEndpoint->peer = pxRing->head;
+	if ( pxEndpoint->peer - ( pxEndpoint->own - 1 ) >= AMP_CHANNEL_SLOTS ) {
+		XScuGic_SoftwareIntr( &xInterruptController, AMP_SGI_ID, AMP_PEER_MASK );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static BaseType_t prvAmpHasSpace( AmpEndpoint *pxEndpoint )
+{
+	if ( pxEndpoint->own - pxEndpoint->peer < AMP_CHANNEL_SLOTS ) {
+		return pdTRUE;
+	}
+
+	Xil_DCacheInvalidateRange( ( INTPTR ) &pxEndpoint->pxRing->tail, AMP_CACHE_LINE );
+	pxEndpoint->peer = pxEndpoint->pxRing->tail;
+	return ( pxEndpoint->own - pxEndpoint->peer < AMP_CHANNEL_SLOTS );
+}
+
+
+/*-----------------------------------------------------------*/
+static BaseType_t prvAmpHasMessage( AmpEndpoint *pxEndpoint )
+{
+	if ( pxEndpoint->peer != pxEndpoint->received ) {
+		return pdTRUE;
+	}
+
+	Xil_DCacheInvalidateRange( ( INTPTR ) &pxEndpoint->pxRing->head, AMP_CACHE_LINE );
+	pxEndpoint->peer = pxEndpoint->pxRing->head;
+	return ( pxEndpoint->peer != pxEndpoint->received );
+}
+
+
+/*-----------------------------------------------------------*/
+static BaseType_t prvAmpWait( AmpEndpoint *pxEndpoint, AmpReady pxReady, TickType_t xTicksToWait )
+{
+	TimeOut_t xTimeOut;	/* Hold when the wait started. */
+
+	vTaskSetTimeOutState( &xTimeOut );
+	for( ;; )
+	{
+		if ( pxReady( pxEndpoint ) ) {
+			return pdPASS;
+		}
+		if ( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) != pdFALSE ) {
+			return pdFAIL;
+		}
+
+		/* The interrupt only gives the semaphore while a task waits, so the
+		 * test is made again once it does, for an interrupt taken before.  A
+		 * give left over from an earlier wait only costs another test. */
+		pxEndpoint->xWaiting = pdTRUE;
+		if ( !pxReady( pxEndpoint ) ) {
+			xSemaphoreTake( pxEndpoint->xWake, xTicksToWait );
+		}
+		pxEndpoint->xWaiting = pdFALSE;
+	}
+}
+
+
+#if ( AMP_CORE == 0 )
+/*-----------------------------------------------------------*/
+static void prvAmpStartCore1( void )
+{
+	/* The boot ROM holds core 1 in WFE until it finds an address to jump
+	 * to. */
+	Xil_Out32( AMP_START_ADDRESS, AMP_CORE1_ENTRY );
+	Xil_DCacheFlushRange( ( INTPTR ) AMP_START_ADDRESS, sizeof( u32 ) );
+	sev();
+}
+#endif
+
+
+/*-----------------------------------------------------------*/
+static void prvAmpISR( void *pvCallBackRef )
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;	/* Hold whether to switch on exit. */
+	u32 channel;	/* Hold the index of the channel. */
+
+	/* A send and a release raise the same interrupt, so every waiting task
+	 * tests its channel again. */
+	for ( channel = 0; channel < AMP_CHANNELS; ++channel ) {
+		if ( endpoints[channel].xWaiting ) {
+			xSemaphoreGiveFromISR( endpoints[channel].xWake, &xHigherPriorityTaskWoken );
+		}
+	}
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+
+#endif /* DO_AMP */
@@ -0,0 +1,86 @@
+/*
+ * amp_channel.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* Message channels between two images, one on each Cortex-A9 core.  With
+* DO_AMP set to 1, each core runs its own FreeRTOS, built with AMP_CORE set to
+* the core it runs on, and neither kernel knows of the other.  Core 0 runs the
+* lab tasks and starts core 1, which runs the data processing of
+* amp_service.h.
+*
+* There are two channels, one to each core.  Each is a ring of
+* AMP_CHANNEL_SLOTS buffers in the on-chip memory mapped high, at
+* AMP_SHARED_BASE, which lscript.ld leaves unused.  The sender only writes the
+* head and the buffers, and the receiver only the tail, each on its own cache
+* line, so the ring needs no lock and neither kernel's critical sections are
+* entered on behalf of the other core.
+*
+* The buffers are handed over, not copied.  The sender acquires the buffer at
+* the head, fills it and sends it.  The receiver reads it where it is, and
+* releases it back to the sender.  The OCM is cached by both cores, which do
+* not snoop each other, so the channel cleans what it writes to memory and
+* invalidates what it is about to read, with xil_cache.  A send raises
+* AMP_SGI_ID on the other core, as does a release that frees a full ring, to
+* wake a task blocked on the channel.  Only one task may use each end of a
+* channel.
+*
+* Each core needs its own board support package and application project,
+* built from these sources.  That of core 1 is a ps7_cortexa9_1 BSP built with
+* USE_AMP=1, so that it leaves the interrupt distributor and the L2 cache to
+* core 0, and a linker script that places the image at AMP_CORE1_ENTRY, in the
+* DDR that lscript.ld leaves to core 1.  "make amp" in the host build runs
+* the two images as two processes that share the OCM.
+*
+*******************************************************************************************/
+
+#ifndef AMP_CHANNEL_H
+#define AMP_CHANNEL_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+
+/* AMP definitions */
+#ifndef DO_AMP
+#define DO_AMP	0									/* whether each core runs its own image */
+#endif
+#ifndef AMP_CORE
+#define AMP_CORE	0								/* the core this image runs on */
+#endif
+#define AMP_SHARED_BASE	0xFFFF0000U					/* the channels, in the OCM mapped high */
+#define AMP_CORE1_ENTRY	0x10000000U					/* the start of the image of core 1 */
+#define AMP_SGI_ID	2								/* software generated interrupt of the channels */
+#define AMP_CHANNEL_SLOTS	8						/* buffers of each channel, a power of 2 */
+#define AMP_BUFFER_SIZE	1024						/* bytes of each buffer, a multiple of the cache line */
+
+/* The channels, by the core they send to. */
+#define AMP_TO_CORE0	0
+#define AMP_TO_CORE1	1
+#define AMP_CHANNELS	2
+
+/* Set up this end of the channels, and on core 0 start core 1.  Returns pdPASS
+ * without DO_AMP. */
+BaseType_t xAmpInit( void );
+/* The buffer at the head of a channel to this core's peer, waiting up to
+ * xTicksToWait for one to be released.  Returns NULL on a timeout.  Until it is
+ * sent, the same buffer is returned again. */
+void *pvAmpChannelAcquire( u32 channel, TickType_t xTicksToWait );
+/* Hand the acquired buffer, filled with length bytes, to the peer.  Returns
+ * pdFAIL if it is not the acquired buffer, or length is over AMP_BUFFER_SIZE. */
+BaseType_t xAmpChannelSend( u32 channel, void *pvBuffer, u32 length );
+/* Wait up to xTicksToWait for the next buffer of a channel to this core, and
+ * return it in *ppvBuffer and its length in *pulLength.  Returns pdFAIL on a
+ * timeout. */
+BaseType_t xAmpChannelReceive( u32 channel, void **ppvBuffer, u32 *pulLength, TickType_t xTicksToWait );
+/* Hand a received buffer back to the peer, in the order they were received. */
+void vAmpChannelRelease( u32 channel, void *pvBuffer );
+
+#endif /* AMP_CHANNEL_H */
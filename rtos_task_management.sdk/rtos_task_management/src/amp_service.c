@@ -0,0 +1,94 @@
+/*
+ * amp_service.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* Standard includes. */
+#include <string.h>
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+/* Application includes. */
+#include "amp_channel.h"
+#include "amp_service.h"
+#include "static_alloc.h"
+
+#if DO_AMP && ( AMP_CORE == 1 )
+
+/* Handle the messages of core 0, as a task. */
+static void prvAmpService( void *pvParameters );
+/* Sum the words of a message. */
+static u32 prvAmpSum( const void *pvBuffer, u32 length );
+/*-----------------------------------------------------------*/
+
+/* The sum of the streamed messages, so the work is not optimised away. */
+static volatile u32 streamSum;
+/* The messages of an unknown type. */
+static volatile u32 unknown;
+/* The memory of the service task. */
+STATIC_TASK_MEMORY( service, AMP_SERVICE_STACK );
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xAmpServiceStart( void )
+{
+	return xStaticTaskCreate( prvAmpService, "TaskAMP", AMP_SERVICE_STACK, NULL, AMP_SERVICE_PRIORITY, NULL,
+		STATIC_TASK_BUFFERS( service ) );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvAmpService( void *pvParameters )
+{
+	void *pvRequest;	/* Hold the message received. */
+	void *pvReply;		/* Hold the buffer of the reply. */
+	u32 length;			/* Hold the length of the message. */
+
+	for( ;; )
+	{
+		xAmpChannelReceive( AMP_TO_CORE1, &pvRequest, &length, portMAX_DELAY );
+		if ( length < sizeof( AmpMessage ) ) {
+			++unknown;
+			vAmpChannelRelease( AMP_TO_CORE1, pvRequest );
+			continue;
+		}
+
+		switch ( ( ( const AmpMessage * ) pvRequest )->type ) {
+		case AMP_MSG_ECHO:
+			/* The request is held until the reply is sent, so a full channel
+			 * to core 0 holds up the channel to core 1. */
+			pvReply = pvAmpChannelAcquire( AMP_TO_CORE0, portMAX_DELAY );
+			memcpy( pvReply, pvRequest, length );
+			xAmpChannelSend( AMP_TO_CORE0, pvReply, length );
+			break;
+		case AMP_MSG_STREAM:
+			streamSum += prvAmpSum( pvRequest, length );
+			break;
+		default:
+			++unknown;
+			break;
+		}
+		vAmpChannelRelease( AMP_TO_CORE1, pvRequest );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvAmpSum( const void *pvBuffer, u32 length )
+{
+	const u32 *pulWord = ( const u32 * ) pvBuffer;	/* Hold the next word. */
+	u32 sum = 0;	/* Hold the sum so far. */
+	u32 index;		/* Hold the index of the word. */
+
+	for ( index = 0; index < length / sizeof( u32 ); ++index ) {
+		sum += pulWord[index];
+	}
+	return sum;
+}
+
+#endif /* DO_AMP && ( AMP_CORE == 1 ) */
@@ -0,0 +1,51 @@
+/*
+ * amp_service.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* The data processing that core 1 does for core 0, when each core runs its own
+* image (see amp_channel.h).  TaskAMP on core 1 receives the messages of the
+* channel to core 1, each starting with an AmpMessage, and handles each by its
+* type:
+*
+* 	AMP_MSG_ECHO	sent back on the channel to core 0, as it is
+* 	AMP_MSG_STREAM	summed a word at a time, with no reply
+*
+* The benchmark suite of core 0 measures the latency of the channels with the
+* echo, and their throughput with the stream.  Processing that is moved to
+* core 1 gets a type of its own.
+*
+*******************************************************************************************/
+
+#ifndef AMP_SERVICE_H
+#define AMP_SERVICE_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+
+/* AMP service definitions */
+#define AMP_SERVICE_PRIORITY	1					/* priority of TaskAMP */
+#define AMP_SERVICE_STACK	( configMINIMAL_STACK_SIZE * 2 )	/* stack of TaskAMP */
+
+/* The types of the messages. */
+#define AMP_MSG_ECHO	1
+#define AMP_MSG_STREAM	2
+
+/* The start of every message to the service. */
+typedef struct {
+	u32 type;		/* what to do with the message */
+	u32 sequence;	/* set by the sender, and kept in a reply */
+} AmpMessage;
+
+/* Create TaskAMP, on core 1. */
+BaseType_t xAmpServiceStart( void );
+
+#endif /* AMP_SERVICE_H */
@@ -0,0 +1,1641 @@
+/*
+ * benchmark.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+#include <string.h>
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "mem_pool.h"
+#include "queue.h"
+#include "semphr.h"
+#include "stream_buffer.h"
+/* Xilinx includes. */
+#include "xil_cache.h"
+#include "xil_printf.h"
+#include "xil_types.h"
+#include "xparameters.h"
+#include "xpm_counter.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xscugic.h"
+#include "xtime_l.h"
+/* Application includes. */
+#include "amp_channel.h"
+#include "amp_service.h"
+#include "benchmark.h"
+#include "heap_regions.h"
+#include "spsc_ring.h"
+#include "static_alloc.h"
+#include "typed_queue.h"
+
+#if DO_BENCHMARK
+
+#define printf xil_printf							/* a smaller footprint printf */
+
+#define BENCH_CYCLE_COUNTER	3						/* counter of XPM_EVENT_CLOCKCYCLES in XPM_CNTRCFG3 */
+#define BENCH_MISS_COUNTER	2						/* counter of XPM_EVENT_BRANCHMISS in XPM_CNTRCFG3 */
+#define BENCH_SGI_TRIGGER	0x3						/* rising edge, as the tick in portZynq7000.c */
+#define BENCH_CHECK_MS	100UL						/* length of the cycle counter check */
+#define BENCH_QUEUE_LENGTH	1						/* items in the benchmark queue */
+#define BENCH_POOL_BLOCK_SIZE	64					/* block of the benchmark pool, which has one */
+#define BENCH_FILLER_TICKS	( ( TickType_t ) 0x10000000UL )	/* delay of the other delayed tasks, from the first */
+#define BENCH_TIMEOUT_TICKS	( ( TickType_t ) 0x20000000UL )	/* timeout of the blocking task, after every delay */
+#define COUNTS_PER_USECOND	( COUNTS_PER_SECOND / 1000000UL )	/* global timer counts per us */
+#define CYCLES_PER_USECOND	( XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / 1000000UL )	/* CPU clock cycles per us */
+#define COUNTS_PER_MSECOND	( COUNTS_PER_SECOND / 1000UL )	/* global timer counts per ms */
+#define BENCH_CORE_MASK	( ( UBaseType_t ) 1U )		/* affinity of the latency tasks, core 0 */
+#define BENCH_FPU_TASKS	2							/* most tasks using the FPU in the switch runs */
+#define BENCH_HEAP_SLOTS	64						/* most blocks allocated at once in the heap runs */
+#define BENCH_HEAP_MAX	512							/* largest block of the heap runs */
+#define BENCH_HEAP_SEED	0x2545F491UL				/* first state of the random numbers of the heap runs */
+#define BENCH_REGION_BYTES	4096					/* buffer read by each sample of the region runs */
+#define BENCH_STREAM_MESSAGES	20000UL				/* messages of each stream run */
+#define BENCH_STREAM_MAX	4096					/* largest message of the stream runs */
+#define BENCH_RING_SIZE	64							/* items of the benchmark ring, a power of 2 */
+#define BENCH_BURST_MAX	64							/* largest burst of the burst runs, and their queue length */
+#define BENCH_BYTES_TOTAL	( 320UL * 64UL )		/* bytes of each byte stream run, a multiple of every trigger level */
+#define BENCH_BYTES_CHUNK	8						/* bytes written at once in the byte stream runs */
+#define BENCH_BYTES_SIZE	256						/* bytes of the queue and the stream buffer of the byte stream runs */
+#define BENCH_COPY_MAX	16							/* largest item of the copy runs */
+#define BENCH_BYTES_IDLE_TICKS	( ( TickType_t ) 1 )	/* wait of the reader of the byte stream runs for the bytes below the trigger */
+
+/* A path under measurement. */
+typedef struct {
+	const char *name;			/* printed with the results */
+	TaskFunction_t pxPeer;		/* the task woken by the path, or NULL */
+	u32 ( *pxSample )( void );	/* measure the path once, returning the cycles */
+} BenchPath;
+
+/* The task that runs the suite, and the tasks woken by the paths. */
+static void prvBenchTask( void *pvParameters );
+static void prvPeerBlocked( void *pvParameters );
+static void prvPeerSuspended( void *pvParameters );
+static void prvPeerQueue( void *pvParameters );
+static void prvPeerSemaphore( void *pvParameters );
+static void prvPeerPool( void *pvParameters );
+static void prvPeerRing( void *pvParameters );
+static void prvPeerRingStream( void *pvParameters );
+static void prvPeerBurst( void *pvParameters );
+static void prvPeerBytes( void *pvParameters );
+static void prvPeerStreamBuffer( void *pvParameters );
+static void prvPeerTimeout( void *pvParameters );
+static void prvPeerYield( void *pvParameters );
+static void prvFiller( void *pvParameters );
+#if ( configNUMBER_OF_CORES > 1 )
+static void prvWorker( void *pvParameters );
+#endif
+
+/* Measure a path once. */
+static u32 prvSampleSuspend( void );
+static u32 prvSampleResume( void );
+static u32 prvSampleNotify( void );
+static u32 prvSampleQueueSend( void );
+static u32 prvSampleQueueReceive( void );
+static u32 prvSampleQueueWake( void );
+static u32 prvSampleGive( void );
+static u32 prvSampleTake( void );
+static u32 prvSampleSemaphoreWake( void );
+static u32 prvSamplePoolAlloc( void );
+static u32 prvSamplePoolFree( void );
+static u32 prvSamplePoolWake( void );
+static u32 prvSampleRingPush( void );
+static u32 prvSampleRingPop( void );
+static u32 prvSampleRingWake( void );
+static u32 prvSampleISR( void );
+static u32 prvSampleBlock( void );
+static u32 prvSampleTick( void );
+static u32 prvSampleSwitch( BaseType_t xUsesFPU );
+static u32 prvSampleCopy( u32 size, BaseType_t xTyped );
+static u32 prvSampleStream( u32 size, BaseType_t xByReference );
+/* The next of a sequence of random numbers, as xorshift32. */
+static u32 prvRandom( void );
+
+/* The interrupt of the ISR path. */
+static void prvBenchISR( void *pvCallBackRef );
+/* Measure a path, with the woken task at a priority, and print the results. */
+static void prvRunPath( const BenchPath *pxPath, UBaseType_t uxPriority );
+/* Measure the block and the tick with uxDelayed other tasks delayed, and print the results. */
+static void prvRunDelayed( UBaseType_t uxDelayed );
+/* Measure the context switch with uxFPUTasks of the two tasks using the FPU, and print the results. */
+static void prvRunSwitch( UBaseType_t uxFPUTasks );
+/* Measure the allocations, or the frees, of a random sequence of both. */
+static void prvRunHeap( BaseType_t xFree );
+/* Measure reading a buffer allocated with a placement hint, from memory. */
+static void prvRunRegion( eHeapHint eHint );
+/* Measure a stream of messages of size bytes through a queue, copied or by reference, and print the results. */
+static void prvRunStream( u32 size, BaseType_t xByReference );
+/* Measure a stream of words through the ring, waking the consumer at wakeLevel, or through the queue with 0, and
+ * print the results. */
+static void prvRunRingStream( u32 wakeLevel );
+/* Measure a stream of words sent in bursts of burst words, item by item or as batches, and print the results. */
+static void prvRunBurst( u32 burst, BaseType_t xBatch );
+/* Measure a stream of bytes written in chunks, through a queue of bytes at a trigger level of 0, or through a
+ * stream buffer, copied or in regions, and print the results. */
+static void prvRunByteStream( u32 triggerLevel, BaseType_t xRegions );
+/* Measure sending and receiving an item of size bytes, through a queue or a typed queue, and print the results. */
+static void prvRunCopy( u32 size, BaseType_t xTyped );
+#if ( configNUMBER_OF_CORES > 1 )
+/* Measure the work of the worker tasks on uxCores cores, and print the results. */
+static u32 prvRunThroughput( UBaseType_t uxCores, u32 oneCoreRate );
+#endif
+#if DO_AMP && ( AMP_CORE == 0 )
+/* Measure the round trip of a message of size bytes through core 1, and print the results. */
+static void prvRunAmpRoundTrip( u32 size );
+/* Measure the stream of messages of size bytes to core 1, and print the results. */
+static void prvRunAmpStream( u32 size );
+#endif
+/* Create a benchmark task, kept on the core of the measuring task. */
+static void prvBenchTaskCreate( TaskFunction_t pxTaskCode, const char * const pcName,
+	const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters, UBaseType_t uxPriority,
+	TaskHandle_t * const pxCreatedTask, StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer );
+/* Sort the samples of a run, and print the results after the name. */
+static void prvReport( u32 count, u32 misses );
+/*-----------------------------------------------------------*/
+
+/* The paths, in the order they are run. */
+static const BenchPath paths[] = {
+	{ "suspend",		prvPeerBlocked,		prvSampleSuspend },
+	{ "resume",			prvPeerSuspended,	prvSampleResume },
+	{ "notify",			prvPeerBlocked,		prvSampleNotify },
+	{ "queue send",		NULL,				prvSampleQueueSend },
+	{ "queue receive",	NULL,				prvSampleQueueReceive },
+	{ "queue wake",		prvPeerQueue,		prvSampleQueueWake },
+	{ "sem give",		NULL,				prvSampleGive },
+	{ "sem take",		NULL,				prvSampleTake },
+	{ "sem wake",		prvPeerSemaphore,	prvSampleSemaphoreWake },
+	{ "pool alloc",		NULL,				prvSamplePoolAlloc },
+	{ "pool free",		NULL,				prvSamplePoolFree },
+	{ "pool wake",		prvPeerPool,		prvSamplePoolWake },
+	{ "ring push",		NULL,				prvSampleRingPush },
+	{ "ring pop",		NULL,				prvSampleRingPop },
+	{ "ring wake",		prvPeerRing,		prvSampleRingWake },
+	{ "ISR wake",		prvPeerBlocked,		prvSampleISR },
+};
+#define BENCH_PATHS	( sizeof( paths ) / sizeof( paths[0] ) )
+
+/* The numbers of other delayed tasks of the delayed task runs. */
+static const UBaseType_t delayedCounts[] = { 0, 16, 64, BENCH_DELAYED_MAX };
+#define BENCH_DELAYED_RUNS	( sizeof( delayedCounts ) / sizeof( delayedCounts[0] ) )
+
+/* The sizes of the messages of the stream runs. */
+static const u32 streamSizes[] = { 16, 64, 256, 1024, BENCH_STREAM_MAX };
+#define BENCH_STREAM_RUNS	( sizeof( streamSizes ) / sizeof( streamSizes[0] ) )
+
+/* The wake levels of the ring stream runs, after the queue at 0. */
+static const u32 ringLevels[] = { 0, 1, 8, 32 };
+#define BENCH_RING_RUNS	( sizeof( ringLevels ) / sizeof( ringLevels[0] ) )
+
+/* The item sizes of the copy runs: one and two words, and a byte more, which
+ * are copied by memcpy(). */
+static const u32 copySizes[] = { 4, 5, 8, 9 };
+#define BENCH_COPY_RUNS	( sizeof( copySizes ) / sizeof( copySizes[0] ) )
+
+/* The bursts of the burst runs. */
+static const u32 burstSizes[] = { 4, 16, BENCH_BURST_MAX };
+#define BENCH_BURST_RUNS	( sizeof( burstSizes ) / sizeof( burstSizes[0] ) )
+
+#if DO_AMP && ( AMP_CORE == 0 )
+/* The sizes of the messages to core 1. */
+static const u32 ampSizes[] = { sizeof( AmpMessage ), 256, AMP_BUFFER_SIZE };
+#define BENCH_AMP_RUNS	( sizeof( ampSizes ) / sizeof( ampSizes[0] ) )
+#endif
+
+/* The interrupt controller instance, defined by portZynq7000.c. */
+extern XScuGic xInterruptController;
+
+/* The benchmark tasks. */
+static TaskHandle_t xBench;
+static TaskHandle_t xPeer;
+STATIC_TASK_MEMORY( bench, BENCH_STACK );
+STATIC_TASK_MEMORY( benchPeer, BENCH_STACK );
+/* The other delayed tasks. */
+static TaskHandle_t fillers[ BENCH_DELAYED_MAX ];
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+static StaticTask_t fillerTCB[ BENCH_DELAYED_MAX ] STATIC_TCB;
+static STATIC_STACK_TYPE( configMINIMAL_STACK_SIZE ) fillerStack[ BENCH_DELAYED_MAX ] STATIC_STACK;
+#define FILLER_BUFFERS( index )	fillerStack[index].stack, &fillerTCB[index]
+#else
+#define FILLER_BUFFERS( index )	NULL, NULL
+#endif
+/* The queue, the semaphore and the pool under measurement. */
+static QueueHandle_t xQueue;
+static SemaphoreHandle_t xSemaphore;
+static MemPoolHandle_t xPool;
+/* The block of the pool last allocated by the woken task. */
+static void * volatile poolBlock;
+/* The blocks of the heap runs, and the state of their random numbers. */
+static void *heapBlocks[ BENCH_HEAP_SLOTS ];
+static u32 randomState;
+/* The sum of the buffers of the region runs, so the reads are not optimised away. */
+static volatile u32 regionSum;
+/* The queue of the stream runs, the messages copied into and out of it, and
+ * the sum of their first words. */
+static QueueHandle_t xStream;
+static u32 streamOut[ BENCH_STREAM_MAX / sizeof( u32 ) ];
+static u32 streamIn[ BENCH_STREAM_MAX / sizeof( u32 ) ];
+static volatile u32 streamSum;
+/* The ring under measurement, its items, and the items read from it at once. */
+static SpscRing benchRing;
+static u32 ringStorage[ BENCH_RING_SIZE ];
+static u32 ringIn[ BENCH_RING_SIZE ];
+/* The queue of the burst runs, and the words sent and received at once. */
+static QueueHandle_t xBurst;
+static u32 burstOut[ BENCH_BURST_MAX ];
+static u32 burstIn[ BENCH_BURST_MAX ];
+/* The queue and the stream buffer of the byte stream runs, the chunk written,
+ * and the bytes read at once. */
+static QueueHandle_t xBytes;
+static StreamBufferHandle_t xByteStream;
+static const u8 bytesOut[ BENCH_BYTES_CHUNK ] = { 0, 1, 2, 3, 4, 5, 6, 7 };
+static u8 bytesIn[ BENCH_BYTES_SIZE ];
+/* The queues of the copy runs, and the item copied. */
+TYPED_QUEUE( BenchWordQueue, u32 )
+TYPED_QUEUE( BenchStampQueue, u64 )
+static QueueHandle_t xCopy;
+static BenchWordQueue xWords;
+static BenchStampQueue xStamps;
+static u32 copyItem[ BENCH_COPY_MAX / sizeof( u32 ) ];
+/* The floating point work of the switch runs. */
+static volatile double fpuValue;
+/* When the woken task last ran, and how many times it has run. */
+static volatile u32 peerStamp;
+static volatile u32 peerWakes;
+/* The samples of the current run. */
+static u32 samples[ BENCH_SAMPLES ];
+#if ( configNUMBER_OF_CORES > 1 )
+/* The worker tasks, and the work each has done, each on its own cache line. */
+static TaskHandle_t workers[ configNUMBER_OF_CORES ];
+static volatile struct {
+	u32 count;					/* iterations of the work */
+	u32 value;					/* result of the work */
+} __attribute__(( aligned( STATIC_CACHE_LINE ) )) work[ configNUMBER_OF_CORES ];
+#endif
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xBenchmarkStart( void )
+{
+	xQueue = xQueueCreate( BENCH_QUEUE_LENGTH, sizeof( u32 ) );
+	xSemaphore = xSemaphoreCreateBinary();
+	xPool = xMemPoolCreate( BENCH_POOL_BLOCK_SIZE, 1 );
+	vSpscRingInit( &benchRing, ringStorage, sizeof( u32 ), BENCH_RING_SIZE );
+	if ( ( xQueue == NULL ) || ( xSemaphore == NULL ) || ( xPool == NULL ) ) {
+		return pdFAIL;
+	}
+
+	/* The software generated interrupt must be allowed to use the API. */
+	xPortInstallInterruptHandler( BENCH_SGI_ID, prvBenchISR, NULL );
+	XScuGic_SetPriorityTriggerType( &xInterruptController, BENCH_SGI_ID,
+		portLOWEST_USABLE_INTERRUPT_PRIORITY << portPRIORITY_SHIFT, BENCH_SGI_TRIGGER );
+	vPortEnableInterrupt( BENCH_SGI_ID );
+
+	if ( xStaticTaskCreate( prvBenchTask, ( const char * ) "TaskBENCH", BENCH_STACK, NULL,
+			BENCH_PRIORITY, &xBench, STATIC_TASK_BUFFERS( bench ) ) != pdPASS ) {
+		return pdFAIL;
+	}
+#if ( configNUMBER_OF_CORES > 1 )
+	/* The paths are measured on one core, as the interrupt is taken on core 0. */
+	vTaskCoreAffinitySet( xBench, BENCH_CORE_MASK );
+#endif
+	return pdPASS;
+}
+
+
+/*-----------------------------------------------------------*/
+void vBenchmarkCompleteHook( void ) __attribute__((weak));
+void vBenchmarkCompleteHook( void )
+{
+}
+
+
+/*-----------------------------------------------------------*/
+/* Read the clock cycle counter, without stopping the counters as
+ * Xpm_GetEventCounters() does. */
+static inline u32 prvReadCycles( void )
+{
+	mtcp( XREG_CP15_EVENT_CNTR_SEL, BENCH_CYCLE_COUNTER );
+	return mfcp( XREG_CP15_PERF_MONITOR_COUNT );
+}
+
+
+/*-----------------------------------------------------------*/
+/* Wait for the woken task to run, in case the path wakes it late. */
+static inline void prvWaitForPeer( u32 wakes )
+{
+	while ( peerWakes == wakes ) {
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvBenchTask( void *pvParameters )
+{
+	XTime start, end;	/* Hold the global timer around the check. */
+	u32 cycles;			/* Hold the cycle counter at the start of the check. */
+	UBaseType_t uxPath;	/* Hold the index of the path. */
+	UBaseType_t uxPriority;	/* Hold the priority of the woken task. */
+	UBaseType_t uxRun;	/* Hold the index of the delayed task run, or the cores of the throughput run. */
+#if ( configNUMBER_OF_CORES > 1 )
+	u32 rate;			/* Hold the throughput on one core. */
+#endif
+
+	/* Check the rate of the cycle counter against the global timer. */
+	Xpm_SetEvents( XPM_CNTRCFG3 );
+	XTime_GetTime( &start );
+	cycles = prvReadCycles();
+	vTaskDelay( pdMS_TO_TICKS( BENCH_CHECK_MS ) );
+	cycles = prvReadCycles() - cycles;
+	XTime_GetTime( &end );
+	printf( "Cycle counter: %u MHz, CPU clock: %u MHz\r\n",
+		( u32 ) ( cycles / ( ( end - start ) / COUNTS_PER_USECOND ) ), ( u32 ) CYCLES_PER_USECOND );
+
+	printf( "%-14s %4s %8s %8s %8s %8s %8s\r\n", "path", "prio", "min", "mean", "p99", "max", "miss" );
+	for ( uxPath = 0; uxPath < BENCH_PATHS; ++uxPath ) {
+		if ( paths[uxPath].pxPeer == NULL ) {
+			prvRunPath( &paths[uxPath], BENCH_PRIORITY );
+			continue;
+		}
+		for ( uxPriority = BENCH_PRIORITY + 1; uxPriority < configMAX_PRIORITIES; ++uxPriority ) {
+			prvRunPath( &paths[uxPath], uxPriority );
+		}
+	}
+
+	printf( "%-14s %4s %8s %8s %8s %8s %8s\r\n", "path", "dly", "min", "mean", "p99", "max", "miss" );
+	for ( uxRun = 0; uxRun < BENCH_DELAYED_RUNS; ++uxRun ) {
+		prvRunDelayed( delayedCounts[uxRun] );
+	}
+
+	printf( "%-14s %4s %8s %8s %8s %8s %8s\r\n", "path", "frag", "min", "mean", "p99", "max", "miss" );
+	prvRunHeap( pdFALSE );
+	prvRunHeap( pdTRUE );
+
+	printf( "%-14s %4s %8s %8s %8s %8s %8s\r\n", "path", "hint", "min", "mean", "p99", "max", "miss" );
+	prvRunRegion( eHeapFast );
+	prvRunRegion( eHeapBulk );
+	vHeapRegionsReport();
+
+	printf( "%-14s %4s %8s %8s %8s %8s %8s\r\n", "path", "size", "min", "mean", "p99", "max", "miss" );
+	for ( uxRun = 0; uxRun < BENCH_STREAM_RUNS; ++uxRun ) {
+		prvRunStream( streamSizes[uxRun], pdFALSE );
+		prvRunStream( streamSizes[uxRun], pdTRUE );
+	}
+
+	printf( "%-14s %4s %8s\r\n", "path", "lvl", "msg/ms" );
+	for ( uxRun = 0; uxRun < BENCH_RING_RUNS; ++uxRun ) {
+		prvRunRingStream( ringLevels[uxRun] );
+	}
+
+	printf( "%-14s %4s %8s\r\n", "path", "bst", "msg/ms" );
+	for ( uxRun = 0; uxRun < BENCH_BURST_RUNS; ++uxRun ) {
+		prvRunBurst( burstSizes[uxRun], pdFALSE );
+		prvRunBurst( burstSizes[uxRun], pdTRUE );
+	}
+
+	printf( "%-14s %4s %8s\r\n", "path", "trg", "KB/s" );
+	prvRunByteStream( 0, pdFALSE );
+	prvRunByteStream( 1, pdFALSE );
+	prvRunByteStream( BENCH_BYTES_CHUNK * 8, pdFALSE );
+	prvRunByteStream( BENCH_BYTES_CHUNK * 8, pdTRUE );
+
+	printf( "%-14s %4s %8s %8s %8s %8s %8s\r\n", "path", "size", "min", "mean", "p99", "max", "miss" );
+	for ( uxRun = 0; uxRun < BENCH_COPY_RUNS; ++uxRun ) {
+		prvRunCopy( copySizes[uxRun], pdFALSE );
+	}
+	prvRunCopy( sizeof( u32 ), pdTRUE );
+	prvRunCopy( sizeof( u64 ), pdTRUE );
+
+#if ( configNUMBER_OF_CORES > 1 )
+	printf( "%-14s %4s %8s %8s\r\n", "path", "core", "iter/ms", "scale %" );
+	rate = prvRunThroughput( 1, 0 );
+	for ( uxRun = 2; uxRun <= configNUMBER_OF_CORES; ++uxRun ) {
+		prvRunThroughput( uxRun, rate );
+	}
+#endif
+
+#if DO_AMP && ( AMP_CORE == 0 )
+	printf( "%-14s %4s %8s %8s %8s %8s %8s\r\n", "path", "size", "min", "mean", "p99", "max", "miss" );
+	for ( uxRun = 0; uxRun < BENCH_AMP_RUNS; ++uxRun ) {
+		prvRunAmpRoundTrip( ampSizes[uxRun] );
+	}
+
+	printf( "%-14s %4s %8s %8s\r\n", "path", "size", "msg/ms", "KB/s" );
+	for ( uxRun = 0; uxRun < BENCH_AMP_RUNS; ++uxRun ) {
+		prvRunAmpStream( ampSizes[uxRun] );
+	}
+#endif
+
+	/* Last, as a task given an FPU context keeps it. */
+	printf( "%-14s %4s %8s %8s %8s %8s %8s\r\n", "path", "fpu", "min", "mean", "p99", "max", "miss" );
+	for ( uxRun = 0; uxRun <= BENCH_FPU_TASKS; ++uxRun ) {
+		prvRunSwitch( uxRun );
+	}
+	printf( "Benchmark complete.\r\n" );
+
+	vBenchmarkCompleteHook();
+	vTaskSuspend( NULL );
+}
+
+
+/*-----------------------------------------------------------*/
+static int prvCompareSamples( const void *pvLeft, const void *pvRight )
+{
+	u32 left = *( const u32 * ) pvLeft;		/* Hold the left sample. */
+	u32 right = *( const u32 * ) pvRight;	/* Hold the right sample. */
+
+	return ( left > right ) - ( left < right );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRunPath( const BenchPath *pxPath, UBaseType_t uxPriority )
+{
+	u32 counters[ XPM_CTRCOUNT ];	/* Hold the event counters after the run. */
+	u32 sample;			/* Hold the latest sample. */
+	u32 index;			/* Hold the index of the sample. */
+
+	/* The woken task has the higher priority, so it runs at once, and
+	 * blocks where the path wakes it. */
+	if ( pxPath->pxPeer != NULL ) {
+		prvBenchTaskCreate( pxPath->pxPeer, ( const char * ) "TaskPEER", BENCH_STACK, NULL,
+			uxPriority, &xPeer, STATIC_TASK_BUFFERS( benchPeer ) );
+	}
+
+	Xpm_SetEvents( XPM_CNTRCFG3 );
+	for ( index = 0; index < BENCH_WARMUP + BENCH_SAMPLES; ++index ) {
+		sample = pxPath->pxSample();
+		if ( index >= BENCH_WARMUP ) {
+			samples[index - BENCH_WARMUP] = sample;
+		}
+	}
+	Xpm_GetEventCounters( counters );
+
+	/* Another task deleting the woken task frees it at once, so its memory
+	 * can be used by the next run. */
+	if ( pxPath->pxPeer != NULL ) {
+		vTaskDelete( xPeer );
+		xPeer = NULL;
+	}
+
+	if ( pxPath->pxPeer != NULL ) {
+		printf( "%-14s %4u", pxPath->name, ( u32 ) uxPriority );
+	}
+	else {
+		printf( "%-14s %4s", pxPath->name, "-" );
+	}
+	prvReport( BENCH_SAMPLES, counters[BENCH_MISS_COUNTER] / ( BENCH_WARMUP + BENCH_SAMPLES ) );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRunDelayed( UBaseType_t uxDelayed )
+{
+	u32 counters[ XPM_CTRCOUNT ];	/* Hold the event counters after the run. */
+	u32 sample;			/* Hold the latest sample. */
+	u32 index;			/* Hold the index of the sample, or of the delayed task. */
+
+	/* Each delayed task has the higher priority, so it delays at once, to
+	 * its own tick.  So does the blocking task, after all of them. */
+	for ( index = 0; index < uxDelayed; ++index ) {
+		prvBenchTaskCreate( prvFiller, ( const char * ) "TaskFILL", configMINIMAL_STACK_SIZE,
+			( void * ) ( uintptr_t ) index, BENCH_PRIORITY + 1, &fillers[index], FILLER_BUFFERS( index ) );
+	}
+	prvBenchTaskCreate( prvPeerTimeout, ( const char * ) "TaskPEER", BENCH_STACK, NULL,
+		BENCH_PRIORITY + 1, &xPeer, STATIC_TASK_BUFFERS( benchPeer ) );
+
+	Xpm_SetEvents( XPM_CNTRCFG3 );
+	for ( index = 0; index < BENCH_WARMUP + BENCH_SAMPLES; ++index ) {
+		sample = prvSampleBlock();
+		if ( index >= BENCH_WARMUP ) {
+			samples[index - BENCH_WARMUP] = sample;
+		}
+	}
+	Xpm_GetEventCounters( counters );
+	printf( "%-14s %4u", "block", ( u32 ) uxDelayed );
+	prvReport( BENCH_SAMPLES, counters[BENCH_MISS_COUNTER] / ( BENCH_WARMUP + BENCH_SAMPLES ) );
+
+	/* The tick comes round every 1 / configTICK_RATE_HZ, so it is sampled
+	 * less. */
+	Xpm_SetEvents( XPM_CNTRCFG3 );
+	for ( index = 0; index < BENCH_TICK_SAMPLES; ++index ) {
+		samples[index] = prvSampleTick();
+	}
+	Xpm_GetEventCounters( counters );
+	printf( "%-14s %4u", "tick", ( u32 ) uxDelayed );
+	prvReport( BENCH_TICK_SAMPLES, counters[BENCH_MISS_COUNTER] / BENCH_TICK_SAMPLES );
+
+	vTaskDelete( xPeer );
+	xPeer = NULL;
+	for ( index = 0; index < uxDelayed; ++index ) {
+		vTaskDelete( fillers[index] );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRunSwitch( UBaseType_t uxFPUTasks )
+{
+	u32 counters[ XPM_CTRCOUNT ];	/* Hold the event counters after the run. */
+	u32 sample;			/* Hold the latest sample. */
+	u32 index;			/* Hold the index of the sample. */
+
+	/* The other task has the priority of this one, so each yields to the
+	 * other.  The other uses the FPU in the runs with one task using it, and
+	 * both do in the run with two. */
+	prvBenchTaskCreate( prvPeerYield, ( const char * ) "TaskPEER", BENCH_STACK,
+		( void * ) ( uintptr_t ) ( uxFPUTasks > 0 ), BENCH_PRIORITY, &xPeer, STATIC_TASK_BUFFERS( benchPeer ) );
+	if ( uxFPUTasks > 1 ) {
+		portTASK_USES_FLOATING_POINT();
+	}
+
+	Xpm_SetEvents( XPM_CNTRCFG3 );
+	for ( index = 0; index < BENCH_WARMUP + BENCH_SAMPLES; ++index ) {
+		sample = prvSampleSwitch( uxFPUTasks > 1 );
+		if ( index >= BENCH_WARMUP ) {
+			samples[index - BENCH_WARMUP] = sample;
+		}
+	}
+	Xpm_GetEventCounters( counters );
+
+	vTaskDelete( xPeer );
+	xPeer = NULL;
+
+	printf( "%-14s %4u", "switch", ( u32 ) uxFPUTasks );
+	prvReport( BENCH_SAMPLES, counters[BENCH_MISS_COUNTER] / ( BENCH_WARMUP + BENCH_SAMPLES ) );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRunHeap( BaseType_t xFree )
+{
+	u32 counters[ XPM_CTRCOUNT ];	/* Hold the event counters after the run. */
+	u32 operations = 0;	/* Hold the allocations and frees of the run. */
+	u32 count = 0;		/* Hold the operations measured. */
+	u32 start;			/* Hold the cycles before the operation. */
+	u32 sample;			/* Hold the cycles of the operation. */
+	u32 size;			/* Hold the size of the block allocated. */
+	u32 slot;			/* Hold the index of the block. */
+	size_t fragmentation;	/* Hold the fragmentation of the heap at the end of the run. */
+
+	/* Each run makes the same sequence, so the frees are of the blocks the
+	 * allocations were measured on.  Picking a slot at random allocates it if
+	 * it is empty, and frees it if not, so the heap fills to about half the
+	 * slots, with sizes mostly small, and spread up to BENCH_HEAP_MAX. */
+	randomState = BENCH_HEAP_SEED;
+	Xpm_SetEvents( XPM_CNTRCFG3 );
+	while ( count < BENCH_WARMUP + BENCH_SAMPLES ) {
+		slot = prvRandom() % BENCH_HEAP_SLOTS;
+		if ( heapBlocks[slot] == NULL ) {
+			size = 1 + prvRandom() % ( BENCH_HEAP_MAX >> ( prvRandom() % 6 ) );
+			start = prvReadCycles();
+			heapBlocks[slot] = pvPortMalloc( size );
+			sample = prvReadCycles() - start;
+		}
+		else {
+			start = prvReadCycles();
+			vPortFree( heapBlocks[slot] );
+			sample = prvReadCycles() - start;
+			heapBlocks[slot] = NULL;
+		}
+		++operations;
+
+		if ( ( heapBlocks[slot] == NULL ) == ( xFree != pdFALSE ) ) {
+			if ( count >= BENCH_WARMUP ) {
+				samples[count - BENCH_WARMUP] = sample;
+			}
+			++count;
+		}
+	}
+	Xpm_GetEventCounters( counters );
+	fragmentation = xPortGetHeapFragmentation();
+
+	for ( slot = 0; slot < BENCH_HEAP_SLOTS; ++slot ) {
+		vPortFree( heapBlocks[slot] );
+		heapBlocks[slot] = NULL;
+	}
+
+	printf( "%-14s %4u", ( xFree != pdFALSE ) ? "free" : "malloc", ( u32 ) fragmentation );
+	prvReport( BENCH_SAMPLES, counters[BENCH_MISS_COUNTER] / operations );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRunRegion( eHeapHint eHint )
+{
+	u32 counters[ XPM_CTRCOUNT ];	/* Hold the event counters after the run. */
+	volatile u32 *pulBuffer;	/* Hold the buffer read. */
+	u32 sum = 0;		/* Hold the sum of the buffer. */
+	u32 start;			/* Hold the cycles before the buffer is read. */
+	u32 sample;			/* Hold the latest sample. */
+	u32 index;			/* Hold the index of the sample. */
+	u32 word;			/* Hold the index of the word read. */
+
+	pulBuffer = pvPortMallocHint( BENCH_REGION_BYTES, eHint );
+	configASSERT( pulBuffer != NULL );
+
+	/* The buffer is cleaned out of the caches before each sample, so each of
+	 * its lines is read from the memory of its region. */
+	Xpm_SetEvents( XPM_CNTRCFG3 );
+	for ( index = 0; index < BENCH_WARMUP + BENCH_SAMPLES; ++index ) {
+		Xil_DCacheFlushRange( ( INTPTR ) pulBuffer, BENCH_REGION_BYTES );
+		start = prvReadCycles();
+		for ( word = 0; word < BENCH_REGION_BYTES / sizeof( u32 ); word += STATIC_CACHE_LINE / sizeof( u32 ) ) {
+			sum += pulBuffer[word];
+		}
+		sample = prvReadCycles() - start;
+		if ( index >= BENCH_WARMUP ) {
+			samples[index - BENCH_WARMUP] = sample;
+		}
+	}
+	Xpm_GetEventCounters( counters );
+	regionSum += sum;
+	vPortFree( ( void * ) pulBuffer );
+
+	printf( "%-14s %4s", "region read", ( eHint == eHeapFast ) ? "fast" : "bulk" );
+	prvReport( BENCH_SAMPLES, counters[BENCH_MISS_COUNTER] / ( BENCH_WARMUP + BENCH_SAMPLES ) );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRunStream( u32 size, BaseType_t xByReference )
+{
+	u32 counters[ XPM_CTRCOUNT ];	/* Hold the event counters after the run. */
+	MemPoolHandle_t xStreamPool = NULL;	/* Hold the pool of the buffers, by reference. */
+	u32 sample;			/* Hold the latest sample. */
+	u32 index;			/* Hold the index of the sample. */
+
+	/* A queue of one message, sent and received by this task, so each sample
+	 * hands one message over without blocking, waking or switching tasks,
+	 * and the copies are not lost among them. */
+	if ( xByReference != pdFALSE ) {
+		xStreamPool = xMemPoolCreate( size, 2 );
+		configASSERT( xStreamPool != NULL );
+		xStream = xQueueCreateByReference( 1, xStreamPool );
+	}
+	else {
+		xStream = xQueueCreate( 1, size );
+	}
+	configASSERT( xStream != NULL );
+
+	Xpm_SetEvents( XPM_CNTRCFG3 );
+	for ( index = 0; index < BENCH_WARMUP + BENCH_SAMPLES; ++index ) {
+		sample = prvSampleStream( size, xByReference );
+		if ( index >= BENCH_WARMUP ) {
+			samples[index - BENCH_WARMUP] = sample;
+		}
+	}
+	Xpm_GetEventCounters( counters );
+
+	vQueueDelete( xStream );
+	xStream = NULL;
+	if ( xStreamPool != NULL ) {
+		vMemPoolDelete( xStreamPool );
+	}
+
+	printf( "%-14s %4u", ( xByReference != pdFALSE ) ? "queue ref" : "queue copy", size );
+	prvReport( BENCH_SAMPLES, counters[BENCH_MISS_COUNTER] / ( BENCH_WARMUP + BENCH_SAMPLES ) );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRunRingStream( u32 wakeLevel )
+{
+	XTime start, end;	/* Hold the global timer around the run. */
+	u32 wakes = peerWakes;	/* Hold the words received before the run. */
+	u32 count;			/* Hold the words sent. */
+	u32 us;				/* Hold the length of the run in us. */
+
+	/* The consumer has the higher priority, so it runs as soon as it is
+	 * woken: for each word through the queue, and for each wakeLevel words
+	 * through the ring.  The flush wakes it for the words left. */
+	vSpscRingInit( &benchRing, ringStorage, sizeof( u32 ), BENCH_RING_SIZE );
+	if ( wakeLevel == 0 ) {
+		prvBenchTaskCreate( prvPeerQueue, ( const char * ) "TaskPEER", BENCH_STACK, NULL,
+			BENCH_PRIORITY + 1, &xPeer, STATIC_TASK_BUFFERS( benchPeer ) );
+	}
+	else {
+		prvBenchTaskCreate( prvPeerRingStream, ( const char * ) "TaskPEER", BENCH_STACK,
+			( void * ) ( uintptr_t ) wakeLevel, BENCH_PRIORITY + 1, &xPeer, STATIC_TASK_BUFFERS( benchPeer ) );
+	}
+
+	XTime_GetTime( &start );
+	for ( count = 0; count < BENCH_STREAM_MESSAGES; ++count ) {
+		if ( wakeLevel == 0 ) {
+			xQueueSend( xQueue, &count, portMAX_DELAY );
+		}
+		else {
+			while ( xSpscRingPush( &benchRing, &count ) != pdPASS ) {
+			}
+		}
+	}
+	if ( wakeLevel != 0 ) {
+		vSpscRingFlush( &benchRing );
+	}
+	while ( ( peerWakes - wakes ) != BENCH_STREAM_MESSAGES ) {
+	}
+	XTime_GetTime( &end );
+
+	vTaskDelete( xPeer );
+	xPeer = NULL;
+
+	us = ( u32 ) ( ( end - start ) / COUNTS_PER_USECOND );
+	if ( wakeLevel == 0 ) {
+		printf( "%-14s %4s", "queue stream", "-" );
+	}
+	else {
+		printf( "%-14s %4u", "ring stream", wakeLevel );
+	}
+	printf( " %8u\r\n", ( u32 ) ( ( BENCH_STREAM_MESSAGES * 1000ULL ) / us ) );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRunBurst( u32 burst, BaseType_t xBatch )
+{
+	XTime start, end;	/* Hold the global timer around the run. */
+	u32 wakes = peerWakes;	/* Hold the words received before the run. */
+	u32 count;			/* Hold the words sent. */
+	u32 length;			/* Hold the words of the burst. */
+	u32 index;			/* Hold the index of the word in the burst. */
+	u32 us;				/* Hold the length of the run in us. */
+
+	/* The receiver has the higher priority, so each word sent alone wakes it
+	 * and switches to it, while a batch wakes it once for the burst. */
+	xBurst = xQueueCreate( BENCH_BURST_MAX, sizeof( u32 ) );
+	configASSERT( xBurst != NULL );
+	prvBenchTaskCreate( prvPeerBurst, ( const char * ) "TaskPEER", BENCH_STACK,
+		( void * ) ( uintptr_t ) xBatch, BENCH_PRIORITY + 1, &xPeer, STATIC_TASK_BUFFERS( benchPeer ) );
+
+	XTime_GetTime( &start );
+	for ( count = 0; count < BENCH_STREAM_MESSAGES; count += length ) {
+		length = BENCH_STREAM_MESSAGES - count;
+		if ( length > burst ) {
+			length = burst;
+		}
+		for ( index = 0; index < length; ++index ) {
+			burstOut[index] = count + index;
+		}
+		if ( xBatch != pdFALSE ) {
+			xQueueSendMultiple( xBurst, burstOut, length, portMAX_DELAY );
+		}
+		else {
+			for ( index = 0; index < length; ++index ) {
+				xQueueSend( xBurst, &burstOut[index], portMAX_DELAY );
+			}
+		}
+	}
+	while ( ( peerWakes - wakes ) != BENCH_STREAM_MESSAGES ) {
+		taskYIELD();
+	}
+	XTime_GetTime( &end );
+
+	vTaskDelete( xPeer );
+	xPeer = NULL;
+	vQueueDelete( xBurst );
+
+	us = ( u32 ) ( ( end - start ) / COUNTS_PER_USECOND );
+	printf( "%-14s %4u %8u\r\n", ( xBatch != pdFALSE ) ? "queue batch" : "queue item", burst,
+		( u32 ) ( ( BENCH_STREAM_MESSAGES * 1000ULL ) / us ) );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRunByteStream( u32 triggerLevel, BaseType_t xRegions )
+{
+	XTime start, end;	/* Hold the global timer around the run. */
+	u32 wakes = peerWakes;	/* Hold the bytes received before the run. */
+	u32 count;			/* Hold the bytes written. */
+	u32 length;			/* Hold the bytes written at once. */
+	u32 offset;			/* Hold the offset of the next byte in the chunk. */
+	void *pvRegion;		/* Hold the free bytes of the stream buffer. */
+	u32 us;				/* Hold the length of the run in us. */
+
+	/* The reader has the higher priority, so it runs as soon as it is woken:
+	 * for each chunk through the queue, and once triggerLevel bytes are in the
+	 * stream buffer. */
+	if ( triggerLevel == 0 ) {
+		xBytes = xQueueCreate( BENCH_BYTES_SIZE, sizeof( u8 ) );
+		configASSERT( xBytes != NULL );
+		prvBenchTaskCreate( prvPeerBytes, ( const char * ) "TaskPEER", BENCH_STACK, NULL,
+			BENCH_PRIORITY + 1, &xPeer, STATIC_TASK_BUFFERS( benchPeer ) );
+	}
+	else {
+		xByteStream = xStreamBufferCreate( BENCH_BYTES_SIZE, triggerLevel );
+		configASSERT( xByteStream != NULL );
+		prvBenchTaskCreate( prvPeerStreamBuffer, ( const char * ) "TaskPEER", BENCH_STACK,
+			( void * ) ( uintptr_t ) xRegions, BENCH_PRIORITY + 1, &xPeer, STATIC_TASK_BUFFERS( benchPeer ) );
+	}
+
+	XTime_GetTime( &start );
+	for ( count = 0; count < BENCH_BYTES_TOTAL; count += length ) {
+		offset = count % BENCH_BYTES_CHUNK;
+		if ( triggerLevel == 0 ) {
+			length = ( u32 ) xQueueSendMultiple( xBytes, &bytesOut[offset], BENCH_BYTES_CHUNK - offset, portMAX_DELAY );
+		}
+		else if ( xRegions == pdFALSE ) {
+			length = ( u32 ) xStreamBufferSend( xByteStream, &bytesOut[offset], BENCH_BYTES_CHUNK - offset, portMAX_DELAY );
+		}
+		else {
+			/* The region may end before the chunk does, at the end of the
+			 * buffer, so the rest of the chunk goes in the next region. */
+			length = ( u32 ) xStreamBufferGetWriteRegion( xByteStream, &pvRegion, portMAX_DELAY );
+			if ( length > BENCH_BYTES_CHUNK - offset ) {
+				length = BENCH_BYTES_CHUNK - offset;
+			}
+			memcpy( pvRegion, &bytesOut[offset], length );
+			vStreamBufferCommitWrite( xByteStream, length );
+		}
+	}
+	while ( ( peerWakes - wakes ) != BENCH_BYTES_TOTAL ) {
+		taskYIELD();
+	}
+	XTime_GetTime( &end );
+
+	vTaskDelete( xPeer );
+	xPeer = NULL;
+	if ( triggerLevel == 0 ) {
+		vQueueDelete( xBytes );
+		xBytes = NULL;
+		printf( "%-14s %4s", "queue bytes", "-" );
+	}
+	else {
+		vStreamBufferDelete( xByteStream );
+		xByteStream = NULL;
+		printf( "%-14s %4u", ( xRegions != pdFALSE ) ? "stream region" : "stream", triggerLevel );
+	}
+
+	us = ( u32 ) ( ( end - start ) / COUNTS_PER_USECOND );
+	printf( " %8u\r\n", ( u32 ) ( ( BENCH_BYTES_TOTAL * 1000000ULL ) / ( us * 1024ULL ) ) );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRunCopy( u32 size, BaseType_t xTyped )
+{
+	u32 counters[ XPM_CTRCOUNT ];	/* Hold the event counters after the run. */
+	u32 sample;			/* Hold the latest sample. */
+	u32 index;			/* Hold the index of the sample. */
+
+	/* A queue of one item, so each sample copies the item in and out, and
+	 * neither call blocks or wakes a task. */
+	if ( xTyped == pdFALSE ) {
+		xCopy = xQueueCreate( 1, size );
+		configASSERT( xCopy != NULL );
+	}
+	else if ( size == sizeof( u32 ) ) {
+		xWords = xBenchWordQueueCreate( 1 );
+		configASSERT( xWords.xQueue != NULL );
+	}
+	else {
+		xStamps = xBenchStampQueueCreate( 1 );
+		configASSERT( xStamps.xQueue != NULL );
+	}
+
+	Xpm_SetEvents( XPM_CNTRCFG3 );
+	for ( index = 0; index < BENCH_WARMUP + BENCH_SAMPLES; ++index ) {
+		sample = prvSampleCopy( size, xTyped );
+		if ( index >= BENCH_WARMUP ) {
+			samples[index - BENCH_WARMUP] = sample;
+		}
+	}
+	Xpm_GetEventCounters( counters );
+
+	if ( xTyped == pdFALSE ) {
+		vQueueDelete( xCopy );
+		xCopy = NULL;
+		printf( "%-14s %4u", "item copy", size );
+	}
+	else {
+		vQueueDelete( ( size == sizeof( u32 ) ) ? xWords.xQueue : xStamps.xQueue );
+		xWords.xQueue = NULL;
+		xStamps.xQueue = NULL;
+		printf( "%-14s %4u", "typed queue", size );
+	}
+	prvReport( BENCH_SAMPLES, counters[BENCH_MISS_COUNTER] / ( BENCH_WARMUP + BENCH_SAMPLES ) );
+}
+
+
+#if DO_AMP && ( AMP_CORE == 0 )
+/*-----------------------------------------------------------*/
+static void prvRunAmpRoundTrip( u32 size )
+{
+	u32 counters[ XPM_CTRCOUNT ];	/* Hold the event counters after the run. */
+	AmpMessage *pxRequest;	/* Hold the message sent. */
+	void *pvReply;			/* Hold the message sent back. */
+	u32 length;				/* Hold the length of the reply. */
+	u32 start;				/* Hold the cycles before the message is sent. */
+	u32 index;				/* Hold the index of the sample. */
+
+	/* Core 1 sends the message back as it is, from a buffer of its own. */
+	Xpm_SetEvents( XPM_CNTRCFG3 );
+	for ( index = 0; index < BENCH_WARMUP + BENCH_SAMPLES; ++index ) {
+		start = prvReadCycles();
+		pxRequest = pvAmpChannelAcquire( AMP_TO_CORE1, portMAX_DELAY );
+		pxRequest->type = AMP_MSG_ECHO;
+		pxRequest->sequence = index;
+		xAmpChannelSend( AMP_TO_CORE1, pxRequest, size );
+		xAmpChannelReceive( AMP_TO_CORE0, &pvReply, &length, portMAX_DELAY );
+		if ( index >= BENCH_WARMUP ) {
+			samples[index - BENCH_WARMUP] = prvReadCycles() - start;
+		}
+		configASSERT( ( ( AmpMessage * ) pvReply )->sequence == index );
+		vAmpChannelRelease( AMP_TO_CORE0, pvReply );
+	}
+	Xpm_GetEventCounters( counters );
+	printf( "%-14s %4u", "amp round trip", size );
+	prvReport( BENCH_SAMPLES, counters[BENCH_MISS_COUNTER] / ( BENCH_WARMUP + BENCH_SAMPLES ) );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRunAmpStream( u32 size )
+{
+	XTime start, now;	/* Hold the global timer at the start of the run, and now. */
+	AmpMessage *pxMessage;	/* Hold the message sent. */
+	u32 count = 0;		/* Hold the messages sent. */
+	u32 ms;				/* Hold the length of the run in ms. */
+
+	/* Once the ring is full, each buffer core 1 releases is sent again at
+	 * once, so the rate is that of the slower core. */
+	XTime_GetTime( &start );
+	do {
+		pxMessage = pvAmpChannelAcquire( AMP_TO_CORE1, portMAX_DELAY );
+		pxMessage->type = AMP_MSG_STREAM;
+		pxMessage->sequence = count++;
+		xAmpChannelSend( AMP_TO_CORE1, pxMessage, size );
+		XTime_GetTime( &now );
+	} while ( ( now - start ) < ( BENCH_THROUGHPUT_MS * COUNTS_PER_MSECOND ) );
+
+	ms = ( u32 ) ( ( now - start ) / COUNTS_PER_MSECOND );
+	printf( "%-14s %4u %8u %8u\r\n", "amp stream", size, count / ms, ( u32 ) ( ( ( u64 ) count * size ) / ms ) );
+}
+#endif
+
+
+#if ( configNUMBER_OF_CORES > 1 )
+/*-----------------------------------------------------------*/
+static u32 prvRunThroughput( UBaseType_t uxCores, u32 oneCoreRate )
+{
+	XTime start, end;	/* Hold the global timer around the run. */
+	u64 total = 0;		/* Hold the iterations of all the workers. */
+	u32 rate;			/* Hold the iterations per ms. */
+	UBaseType_t index;	/* Hold the index of the worker. */
+	UBaseType_t first = uxCores * configNUMBER_OF_CORES;	/* Hold the first filler memory of the run. */
+
+	/* The same workers each run, spread over uxCores cores, at the priority of
+	 * this task, which delays for the run.  A worker deleted while it runs on
+	 * another core is only freed by the idle task, so each run has its own
+	 * memory. */
+	vTaskSuspendAll();
+	for ( index = 0; index < configNUMBER_OF_CORES; ++index ) {
+		work[index].count = 0;
+		xStaticTaskCreate( prvWorker, ( const char * ) "TaskWORK", configMINIMAL_STACK_SIZE,
+			( void * ) ( uintptr_t ) index, BENCH_PRIORITY, &workers[index], FILLER_BUFFERS( first + index ) );
+		vTaskCoreAffinitySet( workers[index], ( UBaseType_t ) 1U << ( index % uxCores ) );
+	}
+	XTime_GetTime( &start );
+	xTaskResumeAll();
+
+	vTaskDelay( pdMS_TO_TICKS( BENCH_THROUGHPUT_MS ) );
+
+	for ( index = 0; index < configNUMBER_OF_CORES; ++index ) {
+		total += work[index].count;
+	}
+	XTime_GetTime( &end );
+	for ( index = 0; index < configNUMBER_OF_CORES; ++index ) {
+		vTaskDelete( workers[index] );
+	}
+
+	rate = ( u32 ) ( total / ( ( end - start ) / COUNTS_PER_MSECOND ) );
+	printf( "%-14s %4u %8u %8u\r\n", "throughput", ( u32 ) uxCores, rate,
+		( oneCoreRate != 0 ) ? ( u32 ) ( ( ( u64 ) rate * 100 ) / oneCoreRate ) : 100 );
+	return rate;
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvBenchTaskCreate( TaskFunction_t pxTaskCode, const char * const pcName,
+	const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters, UBaseType_t uxPriority,
+	TaskHandle_t * const pxCreatedTask, StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer )
+{
+	/* Until it is kept on the core of this task, the new task could run on the
+	 * other core alongside this one, instead of at once in its place. */
+	vTaskSuspendAll();
+	xStaticTaskCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask,
+		puxStackBuffer, pxTaskBuffer );
+	vTaskCoreAffinitySet( *pxCreatedTask, BENCH_CORE_MASK );
+	xTaskResumeAll();
+}
+#else
+/*-----------------------------------------------------------*/
+static void prvBenchTaskCreate( TaskFunction_t pxTaskCode, const char * const pcName,
+	const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters, UBaseType_t uxPriority,
+	TaskHandle_t * const pxCreatedTask, StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer )
+{
+	xStaticTaskCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask,
+		puxStackBuffer, pxTaskBuffer );
+}
+#endif
+
+
+/*-----------------------------------------------------------*/
+static void prvReport( u32 count, u32 misses )
+{
+	u64 total = 0;	/* Hold the sum of the samples, for the mean. */
+	u32 index;		/* Hold the index of the sample. */
+
+	qsort( samples, count, sizeof( samples[0] ), prvCompareSamples );
+	for ( index = 0; index < count; ++index ) {
+		total += samples[index];
+	}
+
+	printf( " %8u %8u %8u %8u %8u\r\n", samples[0], ( u32 ) ( total / count ),
+		samples[ ( count * 99 ) / 100 ], samples[count - 1], misses );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerBlocked( void *pvParameters )
+{
+	for( ;; )
+	{
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+		peerStamp = prvReadCycles();
+		++peerWakes;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerSuspended( void *pvParameters )
+{
+	for( ;; )
+	{
+		vTaskSuspend( NULL );
+		peerStamp = prvReadCycles();
+		++peerWakes;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerQueue( void *pvParameters )
+{
+	u32 item;	/* Hold the item received. */
+
+	for( ;; )
+	{
+		xQueueReceive( xQueue, &item, portMAX_DELAY );
+		peerStamp = prvReadCycles();
+		++peerWakes;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerSemaphore( void *pvParameters )
+{
+	for( ;; )
+	{
+		xSemaphoreTake( xSemaphore, portMAX_DELAY );
+		peerStamp = prvReadCycles();
+		++peerWakes;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerPool( void *pvParameters )
+{
+	/* The pool has one block, so the first allocation empties it, and each
+	 * after that waits for the block to be freed. */
+	for( ;; )
+	{
+		poolBlock = pvMemPoolAlloc( xPool, portMAX_DELAY );
+		peerStamp = prvReadCycles();
+		++peerWakes;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerRing( void *pvParameters )
+{
+	u32 item;	/* Hold the item popped. */
+
+	vSpscRingSetConsumer( &benchRing, xTaskGetCurrentTaskHandle(), 1 );
+	for( ;; )
+	{
+		ulSpscRingWait( &benchRing, portMAX_DELAY );
+		peerStamp = prvReadCycles();
+		xSpscRingPop( &benchRing, &item );
+		++peerWakes;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerRingStream( void *pvParameters )
+{
+	u32 count;	/* Hold the items read at once. */
+
+	vSpscRingSetConsumer( &benchRing, xTaskGetCurrentTaskHandle(), ( u32 ) ( uintptr_t ) pvParameters );
+	for( ;; )
+	{
+		ulSpscRingWait( &benchRing, portMAX_DELAY );
+		count = ulSpscRingRead( &benchRing, ringIn, BENCH_RING_SIZE );
+		streamSum += ringIn[0];
+		peerWakes += count;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerBurst( void *pvParameters )
+{
+	u32 count;	/* Hold the words received at once. */
+
+	for( ;; )
+	{
+		if ( pvParameters != NULL ) {
+			count = ( u32 ) xQueueReceiveMultiple( xBurst, burstIn, BENCH_BURST_MAX, portMAX_DELAY );
+		}
+		else {
+			xQueueReceive( xBurst, burstIn, portMAX_DELAY );
+			count = 1;
+		}
+		streamSum += burstIn[0];
+		peerWakes += count;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerBytes( void *pvParameters )
+{
+	u32 count;	/* Hold the bytes received at once. */
+
+	for( ;; )
+	{
+		count = ( u32 ) xQueueReceiveMultiple( xBytes, bytesIn, BENCH_BYTES_SIZE, portMAX_DELAY );
+		streamSum += bytesIn[0];
+		peerWakes += count;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerStreamBuffer( void *pvParameters )
+{
+	void *pvRegion;	/* Hold the bytes to read of the stream buffer. */
+	u32 count;		/* Hold the bytes received at once. */
+
+	/* The wait times out on bytes left below the trigger level, as the reader
+	 * of a UART would at the end of a message. */
+	for( ;; )
+	{
+		if ( pvParameters != NULL ) {
+			count = ( u32 ) xStreamBufferGetReadRegion( xByteStream, &pvRegion, BENCH_BYTES_IDLE_TICKS );
+			if ( count != 0 ) {
+				streamSum += *( u8 * ) pvRegion;
+				vStreamBufferCommitRead( xByteStream, count );
+			}
+		}
+		else {
+			count = ( u32 ) xStreamBufferReceive( xByteStream, bytesIn, BENCH_BYTES_SIZE, BENCH_BYTES_IDLE_TICKS );
+			streamSum += bytesIn[0];
+		}
+		peerWakes += count;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerTimeout( void *pvParameters )
+{
+	for( ;; )
+	{
+		peerStamp = prvReadCycles();
+		++peerWakes;
+		ulTaskNotifyTake( pdTRUE, BENCH_TIMEOUT_TICKS );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPeerYield( void *pvParameters )
+{
+	if ( pvParameters != NULL ) {
+		portTASK_USES_FLOATING_POINT();
+	}
+
+	for( ;; )
+	{
+		peerStamp = prvReadCycles();
+		++peerWakes;
+		if ( pvParameters != NULL ) {
+			fpuValue = fpuValue * 0.5 + 1.0;
+		}
+		taskYIELD();
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvFiller( void *pvParameters )
+{
+	for( ;; )
+	{
+		vTaskDelay( BENCH_FILLER_TICKS + ( TickType_t ) ( uintptr_t ) pvParameters );
+	}
+}
+
+
+#if ( configNUMBER_OF_CORES > 1 )
+/*-----------------------------------------------------------*/
+/* Independent CPU-bound work, an xorshift step per iteration. */
+static void prvWorker( void *pvParameters )
+{
+	UBaseType_t index = ( UBaseType_t ) ( uintptr_t ) pvParameters;	/* Hold the index of the worker. */
+	u32 value = ( u32 ) index + 1;	/* Hold the value of the work. */
+
+	for( ;; )
+	{
+		value ^= value << 13;
+		value ^= value >> 17;
+		value ^= value << 5;
+		work[index].value = value;
+		++work[index].count;
+	}
+}
+#endif
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleSuspend( void )
+{
+	u32 start, end;	/* Hold the cycles around the call. */
+	u32 wakes = peerWakes;	/* Hold the runs of the woken task so far. */
+
+	start = prvReadCycles();
+	vTaskSuspend( xPeer );
+	end = prvReadCycles();
+
+	/* Resuming ends the wait of the task, which then waits again. */
+	vTaskResume( xPeer );
+	prvWaitForPeer( wakes );
+	return end - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleResume( void )
+{
+	u32 start;	/* Hold the cycles before the call. */
+	u32 wakes = peerWakes;	/* Hold the runs of the woken task so far. */
+
+	start = prvReadCycles();
+	vTaskResume( xPeer );
+	prvWaitForPeer( wakes );
+	return peerStamp - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleNotify( void )
+{
+	u32 start;	/* Hold the cycles before the call. */
+	u32 wakes = peerWakes;	/* Hold the runs of the woken task so far. */
+
+	start = prvReadCycles();
+	xTaskNotifyGive( xPeer );
+	prvWaitForPeer( wakes );
+	return peerStamp - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleQueueSend( void )
+{
+	u32 start, end;	/* Hold the cycles around the call. */
+	u32 item = 0;	/* Hold the item sent. */
+
+	start = prvReadCycles();
+	xQueueSend( xQueue, &item, 0 );
+	end = prvReadCycles();
+
+	xQueueReceive( xQueue, &item, 0 );
+	return end - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleCopy( u32 size, BaseType_t xTyped )
+{
+	u32 start, end;	/* Hold the cycles around the calls. */
+	u32 word = copyItem[0];	/* Hold the item of a typed queue of words. */
+	u64 stamp = word;	/* Hold the item of a typed queue of timestamps. */
+
+	start = prvReadCycles();
+	if ( xTyped == pdFALSE ) {
+		xQueueSend( xCopy, copyItem, 0 );
+		xQueueReceive( xCopy, copyItem, 0 );
+	}
+	else if ( size == sizeof( u32 ) ) {
+		xBenchWordQueueSend( xWords, word, 0 );
+		xBenchWordQueueReceive( xWords, &word, 0 );
+	}
+	else {
+		xBenchStampQueueSend( xStamps, stamp, 0 );
+		xBenchStampQueueReceive( xStamps, &stamp, 0 );
+	}
+	end = prvReadCycles();
+
+	copyItem[0] = word + ( u32 ) stamp;
+	return end - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleStream( u32 size, BaseType_t xByReference )
+{
+	u32 start, end;		/* Hold the cycles around the calls. */
+	u32 *pulMessage;	/* Hold the buffer sent and received, by reference. */
+
+	/* Only the first word of each message is written and read, so a copy
+	 * costs the copy alone. */
+	start = prvReadCycles();
+	if ( xByReference != pdFALSE ) {
+		pulMessage = pvQueueAcquireBuffer( xStream, 0 );
+		pulMessage[0] = streamSum;
+		xQueueSendReference( xStream, pulMessage, size, 0 );
+		xQueueReceiveReference( xStream, ( void ** ) &pulMessage, NULL, 0 );
+		streamSum += pulMessage[0];
+		vQueueReleaseBuffer( xStream, pulMessage );
+	}
+	else {
+		streamOut[0] = streamSum;
+		xQueueSend( xStream, streamOut, 0 );
+		xQueueReceive( xStream, streamIn, 0 );
+		streamSum += streamIn[0];
+	}
+	end = prvReadCycles();
+	return end - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleQueueReceive( void )
+{
+	u32 start, end;	/* Hold the cycles around the call. */
+	u32 item = 0;	/* Hold the item received. */
+
+	xQueueSend( xQueue, &item, 0 );
+
+	start = prvReadCycles();
+	xQueueReceive( xQueue, &item, 0 );
+	end = prvReadCycles();
+	return end - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleQueueWake( void )
+{
+	u32 start;	/* Hold the cycles before the call. */
+	u32 wakes = peerWakes;	/* Hold the runs of the woken task so far. */
+
+	start = prvReadCycles();
+	xQueueSend( xQueue, &start, 0 );
+	prvWaitForPeer( wakes );
+	return peerStamp - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleGive( void )
+{
+	u32 start, end;	/* Hold the cycles around the call. */
+
+	start = prvReadCycles();
+	xSemaphoreGive( xSemaphore );
+	end = prvReadCycles();
+
+	xSemaphoreTake( xSemaphore, 0 );
+	return end - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleTake( void )
+{
+	u32 start, end;	/* Hold the cycles around the call. */
+
+	xSemaphoreGive( xSemaphore );
+
+	start = prvReadCycles();
+	xSemaphoreTake( xSemaphore, 0 );
+	end = prvReadCycles();
+	return end - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleSemaphoreWake( void )
+{
+	u32 start;	/* Hold the cycles before the call. */
+	u32 wakes = peerWakes;	/* Hold the runs of the woken task so far. */
+
+	start = prvReadCycles();
+	xSemaphoreGive( xSemaphore );
+	prvWaitForPeer( wakes );
+	return peerStamp - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSamplePoolAlloc( void )
+{
+	u32 start, end;	/* Hold the cycles around the call. */
+	void *pvBlock;	/* Hold the block allocated. */
+
+	start = prvReadCycles();
+	pvBlock = pvMemPoolAlloc( xPool, 0 );
+	end = prvReadCycles();
+
+	vMemPoolFree( xPool, pvBlock );
+	return end - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSamplePoolFree( void )
+{
+	u32 start, end;	/* Hold the cycles around the call. */
+	void *pvBlock;	/* Hold the block freed. */
+
+	pvBlock = pvMemPoolAlloc( xPool, 0 );
+
+	start = prvReadCycles();
+	vMemPoolFree( xPool, pvBlock );
+	end = prvReadCycles();
+	return end - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSamplePoolWake( void )
+{
+	u32 start;	/* Hold the cycles before the call. */
+	u32 wakes = peerWakes;	/* Hold the runs of the woken task so far. */
+
+	/* The woken task of each priority finds the block held by the last. */
+	start = prvReadCycles();
+	vMemPoolFree( xPool, poolBlock );
+	prvWaitForPeer( wakes );
+	return peerStamp - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleRingPush( void )
+{
+	u32 start, end;	/* Hold the cycles around the call. */
+	u32 item = 0;	/* Hold the item pushed. */
+
+	start = prvReadCycles();
+	xSpscRingPush( &benchRing, &item );
+	end = prvReadCycles();
+
+	xSpscRingPop( &benchRing, &item );
+	return end - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleRingPop( void )
+{
+	u32 start, end;	/* Hold the cycles around the call. */
+	u32 item = 0;	/* Hold the item popped. */
+
+	xSpscRingPush( &benchRing, &item );
+
+	start = prvReadCycles();
+	xSpscRingPop( &benchRing, &item );
+	end = prvReadCycles();
+	return end - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleRingWake( void )
+{
+	u32 start;	/* Hold the cycles before the call. */
+	u32 wakes = peerWakes;	/* Hold the runs of the woken task so far. */
+
+	start = prvReadCycles();
+	xSpscRingPush( &benchRing, &start );
+	prvWaitForPeer( wakes );
+	return peerStamp - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleISR( void )
+{
+	u32 start;	/* Hold the cycles before the interrupt. */
+	u32 wakes = peerWakes;	/* Hold the runs of the woken task so far. */
+
+	start = prvReadCycles();
+	XScuGic_SoftwareIntr( &xInterruptController, BENCH_SGI_ID, XSCUGIC_SPI_CPU0_MASK );
+	prvWaitForPeer( wakes );
+	return peerStamp - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleBlock( void )
+{
+	u32 end;	/* Hold the cycles once the task has blocked. */
+	u32 wakes = peerWakes;	/* Hold the runs of the woken task so far. */
+
+	/* The woken task stamps the cycles, then blocks again before this task
+	 * runs. */
+	xTaskNotifyGive( xPeer );
+	end = prvReadCycles();
+	prvWaitForPeer( wakes );
+	return end - peerStamp;
+}
+
+
+/*-----------------------------------------------------------*/
+/* The longest gap between two reads of the cycles, while waiting for the next
+ * tick, is the tick interrupt. */
+static u32 prvSampleTick( void )
+{
+	TickType_t xTick = xTaskGetTickCount();	/* Hold the tick to wait out. */
+	u32 last, now;		/* Hold the cycles of the last two reads. */
+	u32 longest = 0;	/* Hold the longest gap. */
+
+	last = prvReadCycles();
+	do {
+		now = prvReadCycles();
+		if ( now - last > longest ) {
+			longest = now - last;
+		}
+		last = now;
+	} while ( xTaskGetTickCount() == xTick );
+
+	/* The tick may have come between the last read and the test. */
+	now = prvReadCycles();
+	if ( now - last > longest ) {
+		longest = now - last;
+	}
+	return longest;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvSampleSwitch( BaseType_t xUsesFPU )
+{
+	u32 start;	/* Hold the cycles before the yield. */
+	u32 wakes = peerWakes;	/* Hold the runs of the other task so far. */
+
+	/* The registers of this task are in the FPU as it is switched out. */
+	if ( xUsesFPU ) {
+		fpuValue = fpuValue * 0.5 + 1.0;
+	}
+
+	start = prvReadCycles();
+	taskYIELD();
+	prvWaitForPeer( wakes );
+	return peerStamp - start;
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvRandom( void )
+{
+	randomState ^= randomState << 13;
+	randomState ^= randomState >> 17;
+	randomState ^= randomState << 5;
+	return randomState;
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvBenchISR( void *pvCallBackRef )
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;	/* Hold whether to switch on exit. */
+
+	vTaskNotifyGiveFromISR( xPeer, &xHigherPriorityTaskWoken );
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+
+#endif /* DO_BENCHMARK */
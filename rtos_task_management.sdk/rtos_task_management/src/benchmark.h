@@ -0,0 +1,215 @@
+/*
+ * benchmark.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* The latency benchmark suite of the kernel paths the control logic depends
+* on.  With DO_BENCHMARK set to 1, main() runs the suite instead of the lab
+* tasks.  The Benchmark build configuration of the SDK project sets it, as
+* does "make bench" in the host build.
+*
+* Each path is measured BENCH_SAMPLES times, and reported as the min, mean,
+* 99th percentile and max in CPU clock cycles.  The paths that wake a task
+* are measured from the call until the woken task runs, once at each priority
+* of the woken task above BENCH_PRIORITY, up to configMAX_PRIORITIES - 1.
+* The paths that wake nothing are measured once.
+*
+* 	suspend			vTaskSuspend() of a blocked task
+* 	resume			vTaskResume() until the task runs
+* 	notify			xTaskNotifyGive() until ulTaskNotifyTake() returns
+* 	queue send		xQueueSend() with no task waiting
+* 	queue receive	xQueueReceive() of an item already queued
+* 	queue wake		xQueueSend() until xQueueReceive() returns
+* 	sem give		xSemaphoreGive() with no task waiting
+* 	sem take		xSemaphoreTake() of an available semaphore
+* 	sem wake		xSemaphoreGive() until xSemaphoreTake() returns
+* 	pool alloc		pvMemPoolAlloc() of a free block
+* 	pool free		vMemPoolFree() with no task waiting
+* 	pool wake		vMemPoolFree() until pvMemPoolAlloc() returns
+* 	ring push		xSpscRingPush() with no task waiting
+* 	ring pop		xSpscRingPop() of an item already pushed
+* 	ring wake		xSpscRingPush() until ulSpscRingWait() returns
+* 	ISR wake		a software generated interrupt until the task it
+* 					notifies runs
+*
+* Then the cost of the delayed task structure of the kernel, with 0, 16, 64
+* and BENCH_DELAYED_MAX other tasks delayed, each to a different tick:
+*
+* 	block			a task blocking with a timeout, from when it is woken
+* 					until it has blocked again and the measuring task runs
+* 	tick			the tick interrupt, while no delay expires, measured
+* 					BENCH_TICK_SAMPLES times
+*
+* The delayed lists of the kernel are kept in wake time order, so the block
+* grows with the delayed tasks while the tick does not.  With the timing wheel
+* of configUSE_DELAY_WHEEL the block is constant, while the tick grows with
+* the delayed tasks over configDELAY_WHEEL_SIZE.  "make bench-compare" in the
+* host build runs the suite with both.
+*
+* Then the heap, with a random sequence of allocations and frees of up to
+* BENCH_HEAP_SLOTS blocks, of up to BENCH_HEAP_MAX bytes, mostly small.  The
+* sequence is run twice, to measure each:
+*
+* 	malloc			pvPortMalloc() of a block
+* 	free			vPortFree() of a block
+*
+* Each also reports the fragmentation of the heap at the end of the sequence,
+* from xPortGetHeapFragmentation().  The first fit of heap_4.c walks its free
+* list on both, so its max grows with the fragmentation, while those of the
+* segregated fit of heap_tlsf.c, with configUSE_HEAP_TLSF, are bounded.
+* "make bench-compare" runs the suite with both heaps too.
+* The blocks of the memory pools of mem_pool.h are all of one size, so pool
+* alloc and pool free take the same time whatever the heap has been through.
+*
+* Then a buffer of BENCH_REGION_BYTES allocated with each placement hint of
+* pvPortMallocHint(), cleaned out of the caches before each sample:
+*
+* 	region read		reading a word of each cache line of the buffer
+*
+* With configUSE_HEAP_REGIONS, eHeapFast places the buffer in the on-chip
+* memory and eHeapBulk in the DDR, see heap_regions.h, and the use of each
+* region is printed after the runs.  Without it both are in the one heap.
+*
+* Then a message of 16, 64, 256, 1024 and BENCH_STREAM_MAX bytes sent and
+* received by this task, through a queue of one item, without blocking, so no
+* task is woken or switched to:
+*
+* 	queue copy		the message copied into the queue, and out of it, by
+* 					xQueueSend() and xQueueReceive()
+* 	queue ref		the message a buffer of a memory pool, acquired, handed
+* 					over by xQueueSendReference() and xQueueReceiveReference()
+* 					of a queue created by xQueueCreateByReference(), and
+* 					released
+*
+* The copy grows with the size of the message, while the reference copies
+* only the address and length of its buffer, but also allocates and frees the
+* buffer, so it only gains once the two copies of a message take longer than
+* that.  On the host each critical section is a system call, which outweighs
+* the copies, so there the copy only grows by tens of cycles up to
+* BENCH_STREAM_MAX bytes, and the reference gains at none of the sizes.
+*
+* Then a stream of BENCH_STREAM_MESSAGES words to a task of a higher priority,
+* in messages per ms:
+*
+* 	queue stream	through the queue, so each word wakes the task
+* 	ring stream		through the ring of spsc_ring.h, which wakes the task
+* 					once 1, 8 and 32 words are in it
+*
+* The ring enters no critical section, and a wake level above 1 spreads the
+* wake and the switch to the task over that many words.
+*
+* Then the same stream, sent in bursts of 4, 16 and BENCH_BURST_MAX words,
+* through a queue of BENCH_BURST_MAX words, in messages per ms:
+*
+* 	queue item		each word sent by xQueueSend() and received by
+* 					xQueueReceive(), so each wakes the task
+* 	queue batch		each burst sent by xQueueSendMultiple(), and all the
+* 					words in the queue received by xQueueReceiveMultiple()
+*
+* A batch enters one critical section, and wakes the task and switches to it
+* once, for the whole burst.
+*
+* Then BENCH_BYTES_TOTAL bytes, written BENCH_BYTES_CHUNK at a time, to a task
+* of a higher priority, through BENCH_BYTES_SIZE bytes, in KB per s:
+*
+* 	queue bytes		each chunk sent by xQueueSendMultiple() to a queue of
+* 					bytes, and all the bytes in it received at once
+* 	stream			each chunk sent by xStreamBufferSend(), and all the bytes
+* 					in the stream buffer received at once, once the trigger
+* 					level of 1 or 64 bytes is reached
+* 	stream region	each chunk written in place, into the region of
+* 					xStreamBufferGetWriteRegion(), and read in place
+*
+* The stream buffer wakes the task only at the trigger level, and copies the
+* bytes with no critical section.
+*
+* Then an item sent to a queue of one item and received from it, with no task
+* woken, in cycles, reported as the paths are:
+*
+* 	item copy		items of 4 and 8 bytes, which the queue copies as words,
+* 					and of 5 and 9 bytes, which it copies by memcpy()
+* 	typed queue		items of 4 and 8 bytes, through the functions of
+* 					TYPED_QUEUE() in typed_queue.h
+*
+* The difference between the sizes is that of the copies, without the rest of
+* the send and the receive.  On the host, memcpy() of a few bytes takes a few
+* cycles, so only the board shows the difference.
+*
+* With configNUMBER_OF_CORES above 1, the tasks above are kept on core 0, so
+* the paths are measured as on one core.  Then configNUMBER_OF_CORES workers,
+* each doing independent CPU-bound work, run for BENCH_THROUGHPUT_MS on 1 core
+* and then on each number of cores up to configNUMBER_OF_CORES:
+*
+* 	throughput		the iterations of all the workers per ms, and the scaling
+* 					over the run on 1 core, in percent
+*
+* On the dual-core QEMU machine the scaling is only close to 200% with a
+* thread for each CPU (-accel tcg,thread=multi).  On the host the idle task of
+* each core spins on a thread of its own, so the scaling only holds with a host
+* CPU for each core.
+*
+* With DO_AMP set, on core 0, the channels to core 1 of amp_channel.h are
+* measured last, with messages of 8 bytes, 256 bytes and AMP_BUFFER_SIZE:
+*
+* 	amp round trip	a message echoed by core 1, from acquiring its buffer
+* 					until the reply is received
+* 	amp stream		messages sent to core 1 for BENCH_THROUGHPUT_MS, each
+* 					summed there, in messages per ms and KB per second
+*
+* On the host each image is a process, and the idle task of each spins, so
+* with fewer than two host CPUs a message waits for the other process to be
+* scheduled.  "make amp TICKLESS=1" lets the idle tasks sleep instead.
+*
+* Last, the context switch, between this task and another at its priority,
+* with 0, 1 and BENCH_FPU_TASKS of the two using the FPU:
+*
+* 	switch			taskYIELD() until the other task runs
+*
+* With configUSE_TASK_FPU_SUPPORT the FPU registers of a task that called
+* vPortTaskUsesFPU() are saved and restored on each of its switches, so the
+* switch to the other task costs more once it uses the FPU.  With the lazy
+* switch of configUSE_TASK_FPU_LAZY, the FPU is only saved when another task
+* uses it, so the switch costs the same with one task using it, and more, by
+* the trap on the first floating point instruction, with two.
+*
+* The cycles are read from the clock cycle event counter of the PMU, as set
+* up by Xpm_SetEvents( XPM_CNTRCFG3 ).  Each run also reports the branch
+* mispredictions per sample from Xpm_GetEventCounters(), and the suite starts
+* by checking the rate of the cycle counter against the global timer.
+*
+* On the host, and under QEMU, the counts come from the host clock, so they
+* catch functional and gross timing regressions, not cycle-exact ones.
+*
+*******************************************************************************************/
+
+#ifndef BENCHMARK_H
+#define BENCHMARK_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+
+/* benchmark definitions */
+#ifndef DO_BENCHMARK
+#define DO_BENCHMARK	0							/* whether main() runs the benchmark suite */
+#endif
+#define BENCH_SAMPLES	1000						/* samples of each path at each priority */
+#define BENCH_WARMUP	16							/* samples discarded first, to warm the caches */
+#define BENCH_PRIORITY	1							/* priority of the task that measures */
+#define BENCH_STACK	( configMINIMAL_STACK_SIZE * 2 )	/* stack of each benchmark task */
+#define BENCH_SGI_ID	1							/* software generated interrupt of the ISR path */
+#define BENCH_DELAYED_MAX	256						/* most other delayed tasks of the delayed task runs */
+#define BENCH_TICK_SAMPLES	100						/* samples of the tick, one per tick */
+#define BENCH_THROUGHPUT_MS	1000					/* length of each throughput run */
+
+/* Create the task that runs the suite. */
+BaseType_t xBenchmarkStart( void );
+/* Called once the results are printed.  The default suspends the suite. */
+void vBenchmarkCompleteHook( void );
+
+#endif /* BENCHMARK_H */
@@ -0,0 +1,185 @@
+/*
+ * control.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+/* Application includes. */
+#include "control.h"
+#include "log.h"
+
+/* The groups of rules, and the input bits that trigger each.
+ *
+ *	X( group,		trigger,			... ) */
+#define CONTROL_GROUPS( X, ... ) \
+	X( LED_BY_BTN,	CONTROL_BTN_BITS,	__VA_ARGS__ ) \
+	X( SW_BY_BTN,	CONTROL_BTN_BITS,	__VA_ARGS__ ) \
+	X( BTN_BY_SW,	CONTROL_SW_BITS,	__VA_ARGS__ ) \
+	X( LED_BY_SW,	CONTROL_SW_BITS,	__VA_ARGS__ )
+
+/* The rules, in order of priority within each group.  A rule wins while the
+ * input bits in its mask equal its pattern.
+ *
+ *	X( ..., rule,				group,		mask,							pattern,						task,				action,		exit action ) */
+#define CONTROL_RULES( X, ... ) \
+	/* If BTN2 is depressed, regardless of the status of BTN0 and BTN1,	\
+	 * then TaskLED is resumed.  So BTN2 gets priority. */					\
+	X( __VA_ARGS__, BTN2_RESUMES_LED,	LED_BY_BTN,	CONTROL_BTN2,					CONTROL_BTN2,					CONTROL_TASK_LED,	RESUME,		NONE ) \
+	/* Otherwise if BTN0 and BTN1 are depressed together then TaskLED is	\
+	 * suspended. */														\
+	X( __VA_ARGS__, BTN10_SUSPENDS_LED,	LED_BY_BTN,	CONTROL_BTN1 | CONTROL_BTN0,	CONTROL_BTN1 | CONTROL_BTN0,	CONTROL_TASK_LED,	SUSPEND,	NONE ) \
+	/* If BTN3 is depressed then TaskSW is suspended, */					\
+	X( __VA_ARGS__, BTN3_SUSPENDS_SW,	SW_BY_BTN,	CONTROL_BTN3,					CONTROL_BTN3,					CONTROL_TASK_SW,	SUSPEND,	NONE ) \
+	/* and once it is released, TaskSW is resumed. */						\
+	X( __VA_ARGS__, BTN3_RESUMES_SW,	SW_BY_BTN,	CONTROL_BTN3,					0,								CONTROL_TASK_SW,	RESUME,		NONE ) \
+	/* If SW0 and SW1 are ON together then TaskBTN is suspended, */			\
+	X( __VA_ARGS__, SW10_SUSPENDS_BTN,	BTN_BY_SW,	CONTROL_SW1 | CONTROL_SW0,		CONTROL_SW1 | CONTROL_SW0,		CONTROL_TASK_BTN,	SUSPEND,	NONE ) \
+	/* and if they are both OFF then TaskBTN is resumed. */					\
+	X( __VA_ARGS__, SW10_RESUMES_BTN,	BTN_BY_SW,	CONTROL_SW1 | CONTROL_SW0,		0,								CONTROL_TASK_BTN,	RESUME,		NONE ) \
+	/* If SW3 is ON then TaskLED is suspended, and once it is turned OFF,	\
+	 * TaskLED is resumed. */												\
+	X( __VA_ARGS__, SW3_SUSPENDS_LED,	LED_BY_SW,	CONTROL_SW3,					CONTROL_SW3,					CONTROL_TASK_LED,	SUSPEND,	RESUME )
+
+/* What a rule does to its task. */
+typedef enum {
+	CONTROL_NONE,
+	CONTROL_SUSPEND,
+	CONTROL_RESUME
+} ControlAction;
+
+/* The index of each group. */
+#define prvGROUP_INDEX( group, trigger, ... )	CONTROL_GROUP_##group,
+typedef enum {
+	CONTROL_GROUPS( prvGROUP_INDEX, )
+	CONTROL_GROUP_COUNT		/* number of groups */
+} ControlGroup;
+
+/* The index of each rule.  Index 0 is no rule. */
+#define prvRULE_INDEX( unused, rule, ... )	CONTROL_RULE_##rule,
+typedef enum {
+	CONTROL_NO_RULE,
+	CONTROL_RULES( prvRULE_INDEX, )
+	CONTROL_RULE_COUNT		/* number of rules, plus no rule */
+} ControlRuleIndex;
+
+/* A rule, as declared in CONTROL_RULES. */
+typedef struct {
+	const char *pcName;		/* the name of the rule, for debugging */
+	u8 task;				/* the task the rule acts on */
+	u8 action;				/* the action while the rule wins */
+	u8 exitAction;			/* the action once another rule wins */
+} ControlRule;
+
+/* The winning rule of each group for one input value. */
+typedef struct {
+	u8 rule[ CONTROL_GROUP_COUNT ];
+} ControlEntry;
+
+/* The winning rule of the group for the input value, as a constant expression:
+ * the first rule of the group whose pattern matches, or else no rule. */
+#define prvRULE_MATCH( group, input, rule, ruleGroup, mask, pattern, ... ) \
+	( ( CONTROL_GROUP_##ruleGroup == ( group ) ) && ( ( ( input ) & ( mask ) ) == ( pattern ) ) ) ? CONTROL_RULE_##rule :
+#define prvGROUP_WINNER( group, trigger, input ) \
+	( CONTROL_RULES( prvRULE_MATCH, CONTROL_GROUP_##group, input ) CONTROL_NO_RULE ),
+
+/* The entries of the table for every input value, in order. */
+#define prvENTRY( input )		{ { CONTROL_GROUPS( prvGROUP_WINNER, input ) } },
+#define prvENTRIES4( input )	prvENTRY( input ) prvENTRY( input + 1 ) prvENTRY( input + 2 ) prvENTRY( input + 3 )
+#define prvENTRIES16( input )	prvENTRIES4( input ) prvENTRIES4( input + 4 ) prvENTRIES4( input + 8 ) prvENTRIES4( input + 12 )
+#define prvENTRIES64( input )	prvENTRIES16( input ) prvENTRIES16( input + 16 ) prvENTRIES16( input + 32 ) prvENTRIES16( input + 48 )
+#define prvENTRIES256( input )	prvENTRIES64( input ) prvENTRIES64( input + 64 ) prvENTRIES64( input + 128 ) prvENTRIES64( input + 192 )
+
+/* Perform an action on a task. */
+static void prvControlAct( ControlTask task, ControlAction action );
+/*-----------------------------------------------------------*/
+
+/* The rules, indexed by ControlRuleIndex. */
+#define prvRULE( unused, rule, group, mask, pattern, task, action, exitAction ) \
+	{ #rule, task, CONTROL_##action, CONTROL_##exitAction },
+static const ControlRule rules[ CONTROL_RULE_COUNT ] = {
+	{ "none", 0, CONTROL_NONE, CONTROL_NONE },
+	CONTROL_RULES( prvRULE, )
+};
+/* The input bits that trigger each group. */
+#define prvGROUP_TRIGGER( group, trigger, ... )	trigger,
+static const u32 groupTrigger[ CONTROL_GROUP_COUNT ] = {
+	CONTROL_GROUPS( prvGROUP_TRIGGER, )
+};
+/* The winning rules for every input value. */
+static const ControlEntry table[ CONTROL_INPUTS ] = {
+	prvENTRIES256( 0 )
+};
+/* The rule that won each group at its last dispatch. */
+static u8 activeRule[ CONTROL_GROUP_COUNT ];
+/* The tasks that the rules act on. */
+static TaskHandle_t tasks[ CONTROL_TASKS ];
+/* The releases of the periodic tasks, or NULL. */
+static PeriodicTask *periodic[ CONTROL_TASKS ];
+
+
+/*-----------------------------------------------------------*/
+void vControlSetTask( ControlTask task, TaskHandle_t xTask )
+{
+	tasks[ task ] = xTask;
+}
+
+
+/*-----------------------------------------------------------*/
+void vControlSetPeriodic( ControlTask task, PeriodicTask *pxPeriodic )
+{
+	periodic[ task ] = pxPeriodic;
+}
+
+
+/*-----------------------------------------------------------*/
+void vControlDispatch( u32 owner, u32 input )
+{
+	const ControlEntry *pxEntry = &table[ input & ( CONTROL_INPUTS - 1 ) ];	/* Hold the winners. */
+	UBaseType_t uxGroup;	/* Hold the index of the group. */
+	u8 rule;				/* Hold the winning rule of the group. */
+
+	for ( uxGroup = 0; uxGroup < CONTROL_GROUP_COUNT; ++uxGroup ) {
+		if ( ( groupTrigger[ uxGroup ] & owner ) == 0 ) {
+			continue;
+		}
+
+		/* The rule that lost the group acts on its way out. */
+		rule = pxEntry->rule[ uxGroup ];
+		if ( rule != activeRule[ uxGroup ] ) {
+			prvControlAct( rules[ activeRule[ uxGroup ] ].task, rules[ activeRule[ uxGroup ] ].exitAction );
+			activeRule[ uxGroup ] = rule;
+		}
+		prvControlAct( rules[ rule ].task, rules[ rule ].action );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvControlAct( ControlTask task, ControlAction action )
+{
+	if ( ( action == CONTROL_NONE ) || ( tasks[ task ] == NULL ) ) {
+		return;
+	}
+
+	/* Report a suspension first, in case the task suspends itself. */
+	if ( action == CONTROL_SUSPEND ) {
+		LOG_INFO("%s: %s is suspended.\r\n", pcTaskGetName( NULL ), pcTaskGetName( tasks[ task ] ));
+		vTaskSuspend( tasks[ task ] );
+	}
+	else {
+		if ( periodic[ task ] != NULL ) {
+			vPeriodicResume( periodic[ task ], tasks[ task ] );
+		}
+		else {
+			vTaskResume( tasks[ task ] );
+		}
+		LOG_INFO("%s: %s is resumed.\r\n", pcTaskGetName( NULL ), pcTaskGetName( tasks[ task ] ));
+	}
+}
@@ -0,0 +1,70 @@
+/*
+ * control.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* A table-driven engine for the rules that let the buttons and switches
+* suspend and resume the tasks.
+*
+* The rules are declared in CONTROL_RULES in control.c.  Each rule matches a
+* pattern of some input bits, and belongs to a group of rules that act on the
+* same task.  Within a group, the first rule that matches wins, so the order
+* of the rules is their priority.  A rule acts once on every dispatch while it
+* wins, and may act again once another rule takes its place.
+*
+* At build time, the rules are evaluated for every value of the input into a
+* table of 256 entries, indexed by the 4 buttons in bits 0-3 and the 4
+* switches in bits 4-7.  Each entry holds the winning rule of every group, so
+* a dispatch costs one table load plus the resulting actions.
+*
+*******************************************************************************************/
+
+#ifndef CONTROL_H
+#define CONTROL_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+/* Application includes. */
+#include "periodic.h"
+
+/* control definitions */
+#define CONTROL_SW_SHIFT	4							/* switches follow the buttons */
+#define CONTROL_BTN_BITS	0x0FUL						/* buttons in the input */
+#define CONTROL_SW_BITS	( 0x0FUL << CONTROL_SW_SHIFT )	/* switches in the input */
+#define CONTROL_INPUTS	256								/* number of input values */
+
+/* The bit of each input. */
+#define CONTROL_BTN0	( 1UL << 0 )
+#define CONTROL_BTN1	( 1UL << 1 )
+#define CONTROL_BTN2	( 1UL << 2 )
+#define CONTROL_BTN3	( 1UL << 3 )
+#define CONTROL_SW0 	( 1UL << ( CONTROL_SW_SHIFT + 0 ) )
+#define CONTROL_SW1 	( 1UL << ( CONTROL_SW_SHIFT + 1 ) )
+#define CONTROL_SW2 	( 1UL << ( CONTROL_SW_SHIFT + 2 ) )
+#define CONTROL_SW3 	( 1UL << ( CONTROL_SW_SHIFT + 3 ) )
+
+/* The tasks that the rules act on. */
+typedef enum {
+	CONTROL_TASK_LED,
+	CONTROL_TASK_BTN,
+	CONTROL_TASK_SW,
+	CONTROL_TASKS			/* number of tasks */
+} ControlTask;
+
+/* Let the rules act on xTask.  Rules on a task without a handle do nothing. */
+void vControlSetTask( ControlTask task, TaskHandle_t xTask );
+/* Resume xTask through the releases of pxPeriodic, if it is a periodic task. */
+void vControlSetPeriodic( ControlTask task, PeriodicTask *pxPeriodic );
+/* Apply the rules of the groups triggered by the owner bits to the input. */
+void vControlDispatch( u32 owner, u32 input );
+
+#endif /* CONTROL_H */
@@ -0,0 +1,240 @@
+/*
+ * cpu_load.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* Standard includes. */
+#include <string.h>
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+#include "xtime_l.h"
+/* Application includes. */
+#include "cpu_load.h"
+#include "log.h"
+
+#define CPU_LOAD_SAMPLES	( CPU_LOAD_WINDOW + 1 )		/* samples in the ring */
+#define CPU_LOAD_PERMILLE	1000ULL						/* parts of the window in a report */
+
+/* The counters at one sample. */
+typedef struct {
+	XTime stamp;				/* the global time of the sample */
+	UBaseType_t uxTasks;		/* number of tasks */
+	TaskHandle_t xTask[ CPU_LOAD_MAX_TASKS ];	/* the tasks */
+	configRUN_TIME_COUNTER_TYPE runTime[ CPU_LOAD_MAX_TASKS ];	/* the run time of each task */
+	UBaseType_t uxInterrupts;	/* number of interrupts */
+	PortInterruptRunTime_t interrupts[ CPU_LOAD_MAX_INTERRUPTS ];	/* the handler time of each */
+} CpuLoadSample;
+
+/* The load over one window. */
+typedef struct {
+	XTime window;				/* the length of the window */
+	configRUN_TIME_COUNTER_TYPE totalRunTime;	/* the run time of all the tasks */
+	UBaseType_t uxTasks;		/* number of tasks */
+	TaskStatus_t tasks[ CPU_LOAD_MAX_TASKS ];	/* the tasks, with their run time */
+	UBaseType_t uxInterrupts;	/* number of interrupts */
+	PortInterruptRunTime_t interrupts[ CPU_LOAD_MAX_INTERRUPTS ];	/* the handler time of each */
+} CpuLoadWindow;
+
+/* Sample the counters and publish the window, as the timer callback. */
+static void prvCpuLoadSample( TimerHandle_t xTimer );
+/* Work out the window from the oldest to the newest sample into pxWindow. */
+static void prvCpuLoadDelta( CpuLoadWindow *pxWindow, const CpuLoadSample *pxOldest, const CpuLoadSample *pxNewest );
+/* Log the load over the published window. */
+static void prvCpuLoadReport( void );
+/*-----------------------------------------------------------*/
+
+/* The timer that samples the counters. */
+static TimerHandle_t xCpuLoadTimer;
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+static StaticTimer_t xCpuLoadTimerBuffer;
+#endif
+/* The ring of samples, the next sample to take, and the samples taken. */
+static CpuLoadSample samples[ CPU_LOAD_SAMPLES ];
+static UBaseType_t uxNextSample;
+static u32 sampleCount;
+/* The two windows, and the index of the one published. */
+static CpuLoadWindow windows[ 2 ];
+static volatile UBaseType_t uxPublished;
+/* Whether a window has been published yet. */
+static volatile BaseType_t xValid;
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xCpuLoadInit( void )
+{
+	TickType_t period = pdMS_TO_TICKS( CPU_LOAD_PERIOD_MS );	/* Hold the sampling period. */
+
+	/* The timer cannot sample faster than the tick. */
+	if ( period == 0 ) {
+		period = 1;
+	}
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xCpuLoadTimer = xTimerCreateStatic( "CpuLoad", period, pdTRUE, NULL, prvCpuLoadSample,
+		&xCpuLoadTimerBuffer );
+#else
+	xCpuLoadTimer = xTimerCreate( "CpuLoad", period, pdTRUE, NULL, prvCpuLoadSample );
+#endif
+	if ( xCpuLoadTimer == NULL ) {
+		return pdFAIL;
+	}
+
+	return xTimerStart( xCpuLoadTimer, 0 );
+}
+
+
+/*-----------------------------------------------------------*/
+UBaseType_t uxCpuLoadGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize,
+	configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
+{
+	const CpuLoadWindow *pxWindow;	/* Hold the published window. */
+	UBaseType_t uxTasks = 0;		/* Hold the number of tasks copied. */
+
+	/* The sampler cannot flip the windows during the copy. */
+	taskENTER_CRITICAL();
+	pxWindow = &windows[ uxPublished ];
+	if ( xValid && ( pxWindow->uxTasks <= uxArraySize ) ) {
+		uxTasks = pxWindow->uxTasks;
+		memcpy( pxTaskStatusArray, pxWindow->tasks, uxTasks * sizeof( TaskStatus_t ) );
+		if ( pulTotalRunTime != NULL ) {
+			*pulTotalRunTime = pxWindow->totalRunTime;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return uxTasks;
+}
+
+
+/*-----------------------------------------------------------*/
+UBaseType_t uxCpuLoadGetInterrupts( PortInterruptRunTime_t *pxInterrupts, UBaseType_t uxArraySize, XTime *pxWindow )
+{
+	const CpuLoadWindow *pxPublished;	/* Hold the published window. */
+	UBaseType_t uxInterrupts = 0;		/* Hold the number of interrupts copied. */
+
+	taskENTER_CRITICAL();
+	pxPublished = &windows[ uxPublished ];
+	if ( xValid ) {
+		uxInterrupts = ( pxPublished->uxInterrupts < uxArraySize ) ? pxPublished->uxInterrupts : uxArraySize;
+		memcpy( pxInterrupts, pxPublished->interrupts, uxInterrupts * sizeof( PortInterruptRunTime_t ) );
+		if ( pxWindow != NULL ) {
+			*pxWindow = pxPublished->window;
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return uxInterrupts;
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvCpuLoadSample( TimerHandle_t xTimer )
+{
+	CpuLoadSample *pxNewest = &samples[ uxNextSample ];	/* Hold the sample taken now. */
+	const CpuLoadSample *pxOldest;	/* Hold the sample at the start of the window. */
+	CpuLoadWindow *pxBack = &windows[ !uxPublished ];	/* Hold the window not published. */
+	UBaseType_t uxIndex;	/* Hold the index of the task. */
+
+	/* The back window holds the task status while the sample is taken. */
+	pxNewest->uxTasks = uxTaskGetSystemState( pxBack->tasks, CPU_LOAD_MAX_TASKS, NULL );
+	XTime_GetTime( &pxNewest->stamp );
+	if ( pxNewest->uxTasks == 0 ) {
+		LOG_WARN("CPU load: more than %d tasks.\r\n", CPU_LOAD_MAX_TASKS);
+		return;
+	}
+	for ( uxIndex = 0; uxIndex < pxNewest->uxTasks; ++uxIndex ) {
+		pxNewest->xTask[uxIndex] = pxBack->tasks[uxIndex].xHandle;
+		pxNewest->runTime[uxIndex] = pxBack->tasks[uxIndex].ulRunTimeCounter;
+	}
+	pxNewest->uxInterrupts = uxPortGetInterruptRunTime( pxNewest->interrupts, CPU_LOAD_MAX_INTERRUPTS );
+
+	/* The window starts at the oldest sample, until the ring has filled. */
+	++sampleCount;
+	uxNextSample = ( uxNextSample + 1 ) % CPU_LOAD_SAMPLES;
+	pxOldest = &samples[ ( sampleCount < CPU_LOAD_SAMPLES ) ? 0 : uxNextSample ];
+	if ( pxOldest == pxNewest ) {
+		return;
+	}
+
+	/* Publish the window.  A query copies in a critical section, so it sees
+	 * either window whole. */
+	prvCpuLoadDelta( pxBack, pxOldest, pxNewest );
+	uxPublished = !uxPublished;
+	xValid = pdTRUE;
+
+	if ( ( CPU_LOAD_REPORT_PERIODS > 0 ) && ( ( sampleCount % CPU_LOAD_REPORT_PERIODS ) == 0 ) ) {
+		prvCpuLoadReport();
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvCpuLoadDelta( CpuLoadWindow *pxWindow, const CpuLoadSample *pxOldest, const CpuLoadSample *pxNewest )
+{
+	configRUN_TIME_COUNTER_TYPE before;	/* Hold the counter at the start of the window. */
+	UBaseType_t uxIndex;	/* Hold the index in the newest sample. */
+	UBaseType_t uxOld;		/* Hold the index in the oldest sample. */
+
+	pxWindow->window = pxNewest->stamp - pxOldest->stamp;
+	pxWindow->totalRunTime = 0;
+
+	/* A task created during the window started from 0.  So did one that
+	 * reuses the TCB of a task deleted during the window. */
+	pxWindow->uxTasks = pxNewest->uxTasks;
+	for ( uxIndex = 0; uxIndex < pxNewest->uxTasks; ++uxIndex ) {
+		before = 0;
+		for ( uxOld = 0; uxOld < pxOldest->uxTasks; ++uxOld ) {
+			if ( pxOldest->xTask[uxOld] == pxNewest->xTask[uxIndex] ) {
+				if ( pxOldest->runTime[uxOld] <= pxNewest->runTime[uxIndex] ) {
+					before = pxOldest->runTime[uxOld];
+				}
+				break;
+			}
+		}
+		pxWindow->tasks[uxIndex].ulRunTimeCounter = pxNewest->runTime[uxIndex] - before;
+		pxWindow->totalRunTime += pxWindow->tasks[uxIndex].ulRunTimeCounter;
+	}
+
+	/* The interrupts never restart from 0. */
+	pxWindow->uxInterrupts = pxNewest->uxInterrupts;
+	for ( uxIndex = 0; uxIndex < pxNewest->uxInterrupts; ++uxIndex ) {
+		pxWindow->interrupts[uxIndex] = pxNewest->interrupts[uxIndex];
+		for ( uxOld = 0; uxOld < pxOldest->uxInterrupts; ++uxOld ) {
+			if ( pxOldest->interrupts[uxOld].ulInterruptID == pxNewest->interrupts[uxIndex].ulInterruptID ) {
+				pxWindow->interrupts[uxIndex].ulCount -= pxOldest->interrupts[uxOld].ulCount;
+				pxWindow->interrupts[uxIndex].ullRunTime -= pxOldest->interrupts[uxOld].ullRunTime;
+				break;
+			}
+		}
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvCpuLoadReport( void )
+{
+	const CpuLoadWindow *pxWindow = &windows[ uxPublished ];	/* Hold the published window. */
+	u32 permille;			/* Hold the load of a task or interrupt. */
+	UBaseType_t uxIndex;	/* Hold the index of the task or interrupt. */
+
+	/* Only the sampler writes the windows, so it can read them as it likes.
+	 * The task names are those of live tasks, which outlive the log record. */
+	LOG_INFO("CPU load over the last %d ms:\r\n", ( int ) ( pxWindow->window / ( COUNTS_PER_SECOND / 1000UL ) ));
+	for ( uxIndex = 0; uxIndex < pxWindow->uxTasks; ++uxIndex ) {
+		permille = ( u32 ) ( ( pxWindow->tasks[uxIndex].ulRunTimeCounter * CPU_LOAD_PERMILLE ) / pxWindow->window );
+		LOG_INFO("\t%-10s %3d.%d%%\r\n", pxWindow->tasks[uxIndex].pcTaskName,
+			( int ) ( permille / 10 ), ( int ) ( permille % 10 ));
+	}
+	for ( uxIndex = 0; uxIndex < pxWindow->uxInterrupts; ++uxIndex ) {
+		permille = ( u32 ) ( ( pxWindow->interrupts[uxIndex].ullRunTime * CPU_LOAD_PERMILLE ) / pxWindow->window );
+		LOG_INFO("\tIRQ %-6d %3d.%d%%\r\n", ( int ) pxWindow->interrupts[uxIndex].ulInterruptID,
+			( int ) ( permille / 10 ), ( int ) ( permille % 10 ));
+	}
+}
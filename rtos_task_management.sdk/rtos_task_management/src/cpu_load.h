@@ -0,0 +1,64 @@
+/*
+ * cpu_load.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* The CPU load of each task and interrupt over a sliding window.  The run time
+* stats of the kernel count the 64-bit global timer, less the time spent in
+* interrupt handlers, which the port accounts for by interrupt ID.  Those
+* counters only ever grow, so they tell the load since boot.
+*
+* A timer samples the counters every CPU_LOAD_PERIOD_MS into a ring of the
+* last CPU_LOAD_WINDOW + 1 samples, and works out the load over the window
+* from the newest and the oldest.  The result is written to the back of two
+* buffers, and then published by flipping the index of the front.  A query
+* only copies the front, in a critical section as short as the copy.  The
+* scheduler is suspended only while uxTaskGetSystemState() takes a sample.
+*
+* Every CPU_LOAD_REPORT_PERIODS samples, the load of each task and interrupt
+* is logged in tenths of a percent of the window.  With more than one core,
+* the run time stats of a task count the time of the core it runs on, so the
+* loads are of one core, and add up to configNUMBER_OF_CORES times 100%.
+*
+*******************************************************************************************/
+
+#ifndef CPU_LOAD_H
+#define CPU_LOAD_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+#include "xtime_l.h"
+
+/* CPU load definitions */
+#define CPU_LOAD_PERIOD_MS	250UL						/* time between samples */
+#define CPU_LOAD_WINDOW	4								/* samples in the window, 1 s */
+#define CPU_LOAD_MAX_TASKS	16							/* most tasks sampled */
+#define CPU_LOAD_MAX_INTERRUPTS	8						/* most interrupts sampled */
+#define CPU_LOAD_REPORT_PERIODS	40						/* samples between logs, 0 for none */
+
+#if ( configGENERATE_RUN_TIME_STATS != 1 ) || ( configUSE_TRACE_FACILITY != 1 )
+#error "The CPU load needs configGENERATE_RUN_TIME_STATS and configUSE_TRACE_FACILITY."
+#endif
+
+/* Start sampling the load. */
+BaseType_t xCpuLoadInit( void );
+/* Fill pxTaskStatusArray as uxTaskGetSystemState() does, except that the run
+ * time counter of each task, and *pulTotalRunTime, cover only the window.
+ * Returns 0 if uxArraySize is too small, or before the first window. */
+UBaseType_t uxCpuLoadGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize,
+	configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime );
+/* Fill pxInterrupts with the handler time of each interrupt over the window,
+ * and *pxWindow with the length of the window, in global timer counts.
+ * Returns the number of interrupts filled in. */
+UBaseType_t uxCpuLoadGetInterrupts( PortInterruptRunTime_t *pxInterrupts, UBaseType_t uxArraySize, XTime *pxWindow );
+
+#endif /* CPU_LOAD_H */
@@ -0,0 +1,216 @@
+/*
+ * debounce.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+#include "xtime_l.h"
+/* Application includes. */
+#include "debounce.h"
+
+#define DEBOUNCE_BITS	32								/* number of input bits */
+
+/* An edge subscriber. */
+typedef struct {
+	u32 mask;						/* the bits subscribed to */
+	DebounceEdgeFunction pxCallback;	/* the function to publish to */
+	void *pvContext;				/* passed back to the callback */
+} DebounceSubscriber;
+
+/* Sample the input and publish the edges, as the timer callback. */
+static void prvDebounceSample( TimerHandle_t xTimer );
+/* Start the timer sampling from an ISR. */
+static void prvDebounceStartFromISR( BaseType_t *pxHigherPriorityTaskWoken );
+/*-----------------------------------------------------------*/
+
+/* The timer that samples the input. */
+static TimerHandle_t xDebounceTimer;
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+static StaticTimer_t xDebounceTimerBuffer;
+#endif
+/* Reads the raw input. */
+static DebounceReadFunction pxReadInput;
+/* The integrator of each input bit, from 0 to DEBOUNCE_SAMPLES. */
+static u8 integrator[ DEBOUNCE_BITS ];
+/* The stable value of the input bits. */
+static volatile u32 stableState;
+/* Whether the timer is sampling. */
+static volatile BaseType_t xSampling;
+/* Whether the timer failed to start, so the input may not have settled. */
+static volatile BaseType_t xRetry;
+/* The edge subscribers. */
+static DebounceSubscriber subscribers[ DEBOUNCE_MAX_SUBSCRIBERS ];
+static UBaseType_t uxSubscriberCount;
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xDebounceInit( DebounceReadFunction pxRead )
+{
+	TickType_t period = pdMS_TO_TICKS( DEBOUNCE_PERIOD_MS );	/* Hold the sampling period. */
+	u32 bit;	/* Hold the index of the bit. */
+
+	/* The timer cannot sample faster than the tick. */
+	if ( period == 0 ) {
+		period = 1;
+	}
+
+	pxReadInput = pxRead;
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	xDebounceTimer = xTimerCreateStatic( "Debounce", period, pdFALSE, NULL, prvDebounceSample,
+		&xDebounceTimerBuffer );
+#else
+	xDebounceTimer = xTimerCreate( "Debounce", period, pdFALSE, NULL, prvDebounceSample );
+#endif
+	if ( xDebounceTimer == NULL ) {
+		return pdFAIL;
+	}
+
+	/* Start as if the input has been stable forever. */
+	stableState = pxReadInput();
+	for ( bit = 0; bit < DEBOUNCE_BITS; ++bit ) {
+		integrator[bit] = ( stableState & ( 1UL << bit ) ) ? DEBOUNCE_SAMPLES : 0;
+	}
+
+	return pdPASS;
+}
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xDebounceSubscribe( u32 mask, DebounceEdgeFunction pxCallback, void *pvContext )
+{
+	DebounceSubscriber *pxSubscriber;	/* Hold the new subscriber. */
+
+	if ( uxSubscriberCount >= DEBOUNCE_MAX_SUBSCRIBERS ) {
+		return pdFAIL;
+	}
+
+	/* Fill in the subscriber before publishing can see it. */
+	pxSubscriber = &subscribers[ uxSubscriberCount ];
+	pxSubscriber->mask = mask;
+	pxSubscriber->pxCallback = pxCallback;
+	pxSubscriber->pvContext = pvContext;
+	taskENTER_CRITICAL();
+	++uxSubscriberCount;
+	taskEXIT_CRITICAL();
+
+	return pdPASS;
+}
+
+
+/*-----------------------------------------------------------*/
+void vDebounceInputChangedFromISR( BaseType_t *pxHigherPriorityTaskWoken )
+{
+	/* If the timer is already sampling, it will see the change. */
+	if ( !xSampling && ( xDebounceTimer != NULL ) ) {
+		prvDebounceStartFromISR( pxHigherPriorityTaskWoken );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+void vDebounceRetryFromISR( BaseType_t *pxHigherPriorityTaskWoken )
+{
+	if ( xRetry && !xSampling ) {
+		prvDebounceStartFromISR( pxHigherPriorityTaskWoken );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+u32 ulDebounceGetState( void )
+{
+	return stableState;
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvDebounceSample( TimerHandle_t xTimer )
+{
+	DebounceEdge edge;	/* Hold the edge to publish. */
+	u32 raw;			/* Hold the raw input. */
+	u32 state;			/* Hold the new stable state. */
+	u32 bit;			/* Hold the index of the bit. */
+	u32 unsettled = 0;	/* Hold the bits still between 0 and DEBOUNCE_SAMPLES. */
+	UBaseType_t uxIndex;	/* Hold the index of the subscriber. */
+
+	raw = pxReadInput();
+	state = stableState;
+
+	/* Integrate each bit, and change its stable value once it saturates. */
+	for ( bit = 0; bit < DEBOUNCE_BITS; ++bit ) {
+		if ( raw & ( 1UL << bit ) ) {
+			if ( integrator[bit] < DEBOUNCE_SAMPLES ) {
+				++integrator[bit];
+			}
+		}
+		else if ( integrator[bit] > 0 ) {
+			--integrator[bit];
+		}
+
+		if ( integrator[bit] == DEBOUNCE_SAMPLES ) {
+			state |= ( 1UL << bit );
+		}
+		else if ( integrator[bit] == 0 ) {
+			state &= ~( 1UL << bit );
+		}
+		else {
+			unsettled |= ( 1UL << bit );
+		}
+	}
+
+	/* Publish the bits that changed. */
+	if ( state != stableState ) {
+		edge.changed = state ^ stableState;
+		edge.state = state;
+		XTime_GetTime( &edge.stamp );
+		stableState = state;
+
+		for ( uxIndex = 0; uxIndex < uxSubscriberCount; ++uxIndex ) {
+			if ( subscribers[uxIndex].mask & edge.changed ) {
+				subscribers[uxIndex].pxCallback( &edge, subscribers[uxIndex].pvContext );
+			}
+		}
+	}
+
+	/* Stop sampling once every bit has settled on its raw value.  The ISR
+	 * cannot see xSampling change in between, so no input change is lost. */
+	taskENTER_CRITICAL();
+	if ( ( unsettled == 0 ) && ( pxReadInput() == stableState ) ) {
+		xSampling = pdFALSE;
+	}
+	taskEXIT_CRITICAL();
+
+	/* Otherwise sample again after another period.  If the timer queue is
+	 * full, stop, and let the next call to vDebounceRetryFromISR() start the
+	 * timer again. */
+	if ( xSampling && ( xTimerStart( xTimer, 0 ) != pdPASS ) ) {
+		taskENTER_CRITICAL();
+		xSampling = pdFALSE;
+		xRetry = pdTRUE;
+		taskEXIT_CRITICAL();
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvDebounceStartFromISR( BaseType_t *pxHigherPriorityTaskWoken )
+{
+	/* If the timer queue is full, the change is not lost, but sampled
+	 * once vDebounceRetryFromISR() starts the timer. */
+	xSampling = pdTRUE;
+	if ( xTimerStartFromISR( xDebounceTimer, pxHigherPriorityTaskWoken ) == pdPASS ) {
+		xRetry = pdFALSE;
+	}
+	else {
+		xSampling = pdFALSE;
+		xRetry = pdTRUE;
+	}
+}
@@ -0,0 +1,68 @@
+/*
+ * debounce.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* A debounce engine for up to 32 input bits.  Each bit has its own integrator,
+* which counts up while the raw bit reads 1 and down while it reads 0.  The
+* stable bit only changes when its integrator reaches DEBOUNCE_SAMPLES or 0, so
+* a bit settles DEBOUNCE_SAMPLES samples after its last bounce, independently
+* of every other bit.  BTN0 and BTN1 pressed together are each debounced on
+* their own and are reported with the full stable state at each edge.
+*
+* Sampling is done by one software timer.  It only runs between a call to
+* vDebounceInputChangedFromISR() and the moment every bit has settled, so an
+* idle input costs nothing.  If the timer command queue is full, the timer does
+* not start, and vDebounceRetryFromISR(), called by an ISR that samples the
+* input, such as the tick hook, starts it again.
+*
+* Each stable edge is published, with the time it became stable, to every
+* subscriber whose mask includes one of the changed bits.  The callbacks run in
+* the timer service task, so they must not block.
+*
+*******************************************************************************************/
+
+#ifndef DEBOUNCE_H
+#define DEBOUNCE_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+#include "xtime_l.h"
+
+/* debounce definitions */
+#define DEBOUNCE_PERIOD_MS	10UL						/* time between samples, at least one tick */
+#define DEBOUNCE_SAMPLES	2							/* samples a bit must hold to be stable */
+#define DEBOUNCE_MAX_SUBSCRIBERS	4					/* number of edge subscribers */
+
+/* A stable edge of one or more input bits. */
+typedef struct {
+	u32 changed;	/* the bits that changed */
+	u32 state;		/* the stable value of all bits after the change */
+	XTime stamp;	/* the global time at which the change became stable */
+} DebounceEdge;
+
+/* Reads the raw value of all input bits. */
+typedef u32 ( *DebounceReadFunction )( void );
+/* Called with each stable edge that includes a subscribed bit. */
+typedef void ( *DebounceEdgeFunction )( const DebounceEdge *pxEdge, void *pvContext );
+
+/* Create the sampling timer and take the current input as the stable state. */
+BaseType_t xDebounceInit( DebounceReadFunction pxRead );
+/* Publish the stable edges of the bits in mask to pxCallback. */
+BaseType_t xDebounceSubscribe( u32 mask, DebounceEdgeFunction pxCallback, void *pvContext );
+/* Start sampling after the raw input has changed.  For ISRs only. */
+void vDebounceInputChangedFromISR( BaseType_t *pxHigherPriorityTaskWoken );
+/* Start sampling again if the timer failed to start.  For ISRs only. */
+void vDebounceRetryFromISR( BaseType_t *pxHigherPriorityTaskWoken );
+/* The current stable value of all input bits. */
+u32 ulDebounceGetState( void );
+
+#endif /* DEBOUNCE_H */
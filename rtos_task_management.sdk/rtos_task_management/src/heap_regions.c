@@ -0,0 +1,62 @@
+/*
+ * heap_regions.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Xilinx includes. */
+#include "xil_printf.h"
+#include "xil_types.h"
+/* Application includes. */
+#include "heap_regions.h"
+
+#if ( configUSE_HEAP_REGIONS == 1 )
+
+/* The bounds of the regions, from lscript.ld. */
+extern u8 __start_heap_fast[], __stop_heap_fast[];
+extern u8 __start_heap_bulk[], __stop_heap_bulk[];
+
+/* The names of the regions, in the order they are passed, fastest first. */
+static const char * const regionNames[] = { "fast", "bulk" };
+
+#endif /* configUSE_HEAP_REGIONS */
+
+
+/*-----------------------------------------------------------*/
+void vHeapRegionsInit( void )
+{
+#if ( configUSE_HEAP_REGIONS == 1 )
+	/* Hold the regions, ended by one of no size.  Only read by the call. */
+	HeapRegion_t xRegions[] = {
+		{ __start_heap_fast, ( size_t ) ( __stop_heap_fast - __start_heap_fast ) },
+		{ __start_heap_bulk, ( size_t ) ( __stop_heap_bulk - __start_heap_bulk ) },
+		{ NULL, 0 }
+	};
+
+	vPortDefineHeapRegions( xRegions );
+#endif
+}
+
+
+/*-----------------------------------------------------------*/
+void vHeapRegionsReport( void )
+{
+#if ( configUSE_HEAP_REGIONS == 1 )
+	HeapRegionStats_t xStats;	/* Hold the use of the region. */
+	UBaseType_t uxRegion;		/* Hold the index of the region. */
+
+	xil_printf( "%-6s %10s %8s %8s %8s %8s %8s %8s\r\n",
+		"region", "start", "total", "free", "min", "largest", "allocs", "frees" );
+	for ( uxRegion = 0; uxRegion < uxPortGetHeapRegionCount(); ++uxRegion ) {
+		vPortGetHeapRegionStats( uxRegion, &xStats );
+		xil_printf( "%-6s 0x%08x %8u %8u %8u %8u %8u %8u\r\n", regionNames[uxRegion],
+			( u32 ) ( UINTPTR ) xStats.pucStartAddress, ( u32 ) xStats.xTotalBytes, ( u32 ) xStats.xFreeBytes,
+			( u32 ) xStats.xMinimumEverFreeBytes, ( u32 ) xStats.xLargestFreeBlock,
+			( u32 ) xStats.xAllocations, ( u32 ) xStats.xFrees );
+	}
+#endif
+}
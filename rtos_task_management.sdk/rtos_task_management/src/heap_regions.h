@@ -0,0 +1,49 @@
+/*
+ * heap_regions.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* The regions of the kernel heap.  With configUSE_HEAP_REGIONS set to 1,
+* heap_tlsf.c allocates from the regions that lscript.ld lays out, instead of
+* the configTOTAL_HEAP_SIZE array in the DDR:
+*
+* 	fast	the on-chip memory at 0x0 left after the TCBs, in heap_fast
+* 	bulk	_HEAP_BULK_SIZE of the DDR, in heap_bulk
+*
+* The OCM is read by the cores without going through the L2 cache, so a
+* block in it that misses the L1 cache takes less time, and a time that varies
+* less, than one in the DDR.  pvPortMalloc(), which the kernel uses for its
+* TCBs, stacks and queue storage, tries the fast region first, as does
+* pvPortMallocHint() with eHeapFast.  Large buffers should be allocated with
+* eHeapBulk, which tries the bulk region first.  Either falls back to the other
+* region once its own is full.
+*
+* The linker script places each region in a section of its own, whose name is
+* a C identifier, so the linker of the host defines the same __start_ and
+* __stop_ symbols for the sections of sim/heap_regions_sim.c.  The 64KB of the
+* OCM mapped high is left to the channels of amp_channel.h.
+*
+* vHeapRegionsInit() must be called before anything is allocated, first in
+* main().  Without configUSE_HEAP_REGIONS it does nothing, and the heap is the
+* one array of heap_4.c or heap_tlsf.c.
+*
+*******************************************************************************************/
+
+#ifndef HEAP_REGIONS_H
+#define HEAP_REGIONS_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+
+/* Pass the regions of lscript.ld to the kernel heap. */
+void vHeapRegionsInit( void );
+/* Print the use of each region, with its name. */
+void vHeapRegionsReport( void );
+
+#endif /* HEAP_REGIONS_H */
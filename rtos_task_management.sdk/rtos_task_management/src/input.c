@@ -0,0 +1,169 @@
+/*
+ * input.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+#include "xtime_l.h"
+/* Application includes. */
+#include "control.h"
+#include "debounce.h"
+#include "input.h"
+
+#define INPUT_QUEUE_MASK	( INPUT_QUEUE_SIZE - 1 )	/* index of an event in the queue */
+#define INPUT_MAX_CONSUMERS	4						/* number of consumers */
+#define INPUT_BITS	( CONTROL_BTN_BITS | CONTROL_SW_BITS )	/* bits with events */
+
+/* Queue the events of a stable edge, as a debounce subscriber. */
+static void prvInputEdge( const DebounceEdge *pxEdge, void *pvContext );
+/* Copy the pending events that the consumer wants. */
+static UBaseType_t prvInputCopy( InputConsumer *pxConsumer, InputEvent *pxEvents, UBaseType_t uxMax );
+/*-----------------------------------------------------------*/
+
+/* The queue of events, and the position of the next event to write. */
+static InputEvent queue[ INPUT_QUEUE_SIZE ];
+static u32 head;
+/* The input bit of each event in the queue, for the consumer masks. */
+static u32 queueBit[ INPUT_QUEUE_SIZE ];
+/* The consumers. */
+static InputConsumer *consumers[ INPUT_MAX_CONSUMERS ];
+static UBaseType_t uxConsumerCount;
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xInputInit( void )
+{
+	return xDebounceSubscribe( INPUT_BITS, prvInputEdge, NULL );
+}
+
+
+/*-----------------------------------------------------------*/
+void vInputSubscribe( InputConsumer *pxConsumer, TaskHandle_t xTask, u32 mask )
+{
+	configASSERT( uxConsumerCount < INPUT_MAX_CONSUMERS );
+
+	pxConsumer->xTask = xTask;
+	pxConsumer->mask = mask;
+	pxConsumer->lost = 0;
+
+	/* Start from the current state, with no pending events. */
+	taskENTER_CRITICAL();
+	pxConsumer->cursor = head;
+	pxConsumer->state = ulDebounceGetState() & mask;
+	consumers[ uxConsumerCount++ ] = pxConsumer;
+	taskEXIT_CRITICAL();
+}
+
+
+/*-----------------------------------------------------------*/
+UBaseType_t uxInputRead( InputConsumer *pxConsumer, InputEvent *pxEvents, UBaseType_t uxMax, TickType_t xTicksToWait )
+{
+	UBaseType_t uxCount;	/* Hold the number of events read. */
+
+	uxCount = prvInputCopy( pxConsumer, pxEvents, uxMax );
+	if ( ( uxCount == 0 ) && ( xTicksToWait != 0 ) ) {
+		/* A notification means a wanted event may have arrived since. */
+		ulTaskNotifyTake( pdTRUE, xTicksToWait );
+		uxCount = prvInputCopy( pxConsumer, pxEvents, uxMax );
+	}
+
+	return uxCount;
+}
+
+
+/*-----------------------------------------------------------*/
+static UBaseType_t prvInputCopy( InputConsumer *pxConsumer, InputEvent *pxEvents, UBaseType_t uxMax )
+{
+	UBaseType_t uxCount = 0;	/* Hold the number of events read. */
+	u32 index;					/* Hold the index of the event in the queue. */
+	u32 position;				/* Hold the position of the event in the queue. */
+
+	taskENTER_CRITICAL();
+	/* Skip the events that have been overwritten.  Their edges are lost with
+	 * them, so take the state from the debounced input, as subscribing does,
+	 * and undo the edges still queued, newest first, to have it as of the
+	 * oldest event left. */
+	if ( ( head - pxConsumer->cursor ) > INPUT_QUEUE_SIZE ) {
+		pxConsumer->lost += ( head - pxConsumer->cursor ) - INPUT_QUEUE_SIZE;
+		pxConsumer->cursor = head - INPUT_QUEUE_SIZE;
+
+		pxConsumer->state = ulDebounceGetState() & pxConsumer->mask;
+		for ( position = head; position != pxConsumer->cursor; ) {
+			index = --position & INPUT_QUEUE_MASK;
+			if ( queueBit[ index ] & pxConsumer->mask ) {
+				if ( queue[ index ].edge == INPUT_RISING ) {
+					pxConsumer->state &= ~queueBit[ index ];
+				}
+				else {
+					pxConsumer->state |= queueBit[ index ];
+				}
+			}
+		}
+	}
+
+	while ( ( pxConsumer->cursor != head ) && ( uxCount < uxMax ) ) {
+		index = pxConsumer->cursor & INPUT_QUEUE_MASK;
+		++pxConsumer->cursor;
+
+		if ( queueBit[ index ] & pxConsumer->mask ) {
+			pxEvents[ uxCount++ ] = queue[ index ];
+			if ( queue[ index ].edge == INPUT_RISING ) {
+				pxConsumer->state |= queueBit[ index ];
+			}
+			else {
+				pxConsumer->state &= ~queueBit[ index ];
+			}
+		}
+	}
+	taskEXIT_CRITICAL();
+
+	return uxCount;
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvInputEdge( const DebounceEdge *pxEdge, void *pvContext )
+{
+	u32 changed = pxEdge->changed & INPUT_BITS;	/* Hold the bits left to queue. */
+	u32 wanted = 0;			/* Hold the bits queued. */
+	u32 bit;				/* Hold the index of the bit in the input. */
+	u32 index;				/* Hold the index of the event in the queue. */
+	UBaseType_t uxIndex;	/* Hold the index of the consumer. */
+
+	taskENTER_CRITICAL();
+	for ( bit = 0; changed != 0; ++bit, changed >>= 1 ) {
+		if ( ( changed & 1 ) == 0 ) {
+			continue;
+		}
+
+		index = head & INPUT_QUEUE_MASK;
+		queue[ index ].stamp = pxEdge->stamp;
+		if ( bit < CONTROL_SW_SHIFT ) {
+			queue[ index ].channel = INPUT_BTN_CHANNEL;
+			queue[ index ].bit = bit;
+		}
+		else {
+			queue[ index ].channel = INPUT_SW_CHANNEL;
+			queue[ index ].bit = bit - CONTROL_SW_SHIFT;
+		}
+		queue[ index ].edge = ( pxEdge->state & ( 1UL << bit ) ) ? INPUT_RISING : INPUT_FALLING;
+		queueBit[ index ] = 1UL << bit;
+		wanted |= 1UL << bit;
+		++head;
+	}
+	taskEXIT_CRITICAL();
+
+	/* Wake the consumers that want one of the events. */
+	for ( uxIndex = 0; uxIndex < uxConsumerCount; ++uxIndex ) {
+		if ( consumers[ uxIndex ]->mask & wanted ) {
+			xTaskNotifyGive( consumers[ uxIndex ]->xTask );
+		}
+	}
+}
@@ -0,0 +1,74 @@
+/*
+ * input.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* The input event service.  Each stable edge of a button or a switch, from
+* the debounce engine, becomes one event per changed bit, with its GPIO
+* channel, its bit, whether it rose or fell, and the time it became stable.
+*
+* The events go into one fixed-size queue, in the order they happened.  Any
+* number of consumer tasks subscribe to it, each with its own cursor and a
+* mask of the input bits it wants.  A consumer reads all of its pending events
+* in one call, and is woken by a notification when a wanted event arrives.  A
+* consumer that falls more than INPUT_QUEUE_SIZE events behind loses the
+* oldest, and counts them.
+*
+* Each consumer also keeps the state of its input bits as of the last event it
+* read, so no task has to read the GPIO itself.
+*
+*******************************************************************************************/
+
+#ifndef INPUT_H
+#define INPUT_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+#include "xtime_l.h"
+
+/* input definitions */
+#define INPUT_QUEUE_SIZE	32							/* events in the queue, a power of 2 */
+#define INPUT_BTN_CHANNEL	1							/* GPIO port of the buttons */
+#define  INPUT_SW_CHANNEL	2							/* GPIO port of the switches */
+
+/* The direction of an edge. */
+typedef enum {
+	INPUT_FALLING,
+	INPUT_RISING
+} InputEdge;
+
+/* A stable edge of one input bit. */
+typedef struct {
+	XTime stamp;	/* the global time at which the edge became stable */
+	u8 channel;		/* the GPIO port of the input */
+	u8 bit;			/* the bit of the input in its port */
+	u8 edge;		/* the direction, as an InputEdge */
+} InputEvent;
+
+/* A consumer of the events. */
+typedef struct {
+	TaskHandle_t xTask;	/* the task notified of new events */
+	u32 mask;			/* the input bits wanted, as in the debounced input */
+	u32 cursor;			/* the next event to read */
+	u32 state;			/* the wanted input bits, as of the last event read */
+	u32 lost;			/* number of wanted events lost to a full queue */
+} InputConsumer;
+
+/* Turn the stable edges of the debounce engine into events. */
+BaseType_t xInputInit( void );
+/* Subscribe xTask to the events of the input bits in mask, from now on. */
+void vInputSubscribe( InputConsumer *pxConsumer, TaskHandle_t xTask, u32 mask );
+/* Read up to uxMax pending events, waiting up to xTicksToWait for the first.
+ * Returns the number of events read.  For the subscribed task only. */
+UBaseType_t uxInputRead( InputConsumer *pxConsumer, InputEvent *pxEvents, UBaseType_t uxMax, TickType_t xTicksToWait );
+
+#endif /* INPUT_H */
@@ -0,0 +1,239 @@
+/*
+ * log.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+#include "xil_printf.h"
+#include "xtime_l.h"
+#define	printf	xil_printf
+/* Application includes. */
+#include "log.h"
+#include "static_alloc.h"
+
+#define LOG_RING_MASK	( LOG_RING_SIZE - 1 )		/* index of a position in a ring */
+#define LOG_CACHE_LINE	32							/* Cortex-A9 L1 and L2 cache line */
+
+/* A log record. */
+typedef struct {
+	volatile u32 sequence;		/* the position it was written at plus 1, or that it is free for */
+	u32 level;					/* the level of the record */
+	XTime stamp;				/* the global time it was written at, to merge the rings */
+	const char *format;			/* the format string */
+	UINTPTR args[ LOG_MAX_ARGS ];	/* the arguments */
+} LogRecord;
+
+/* The ring of records of one core.  The head, the tail and the records each
+ * start a cache line, so the rings of the cores share none. */
+typedef struct {
+	volatile u32 head __attribute__(( aligned( LOG_CACHE_LINE ) ));	/* the next position to write, shared by the producers of the core */
+	volatile u32 lost;			/* the number of records lost to a full ring */
+	u32 tail __attribute__(( aligned( LOG_CACHE_LINE ) ));	/* the next position to read, owned by the drain */
+	LogRecord records[ LOG_RING_SIZE ] __attribute__(( aligned( LOG_CACHE_LINE ) ));	/* the records */
+} LogRing;
+
+/* Format and print the records, as a task. */
+static void prvLogDrain( void *pvParameters );
+/* Print the records that are ready, returning how many there were. */
+static u32 prvLogPrintReady( void );
+/* Return the next record of a ring if it is ready to read, or NULL. */
+static LogRecord *prvLogNextReady( LogRing *pxRing );
+/*-----------------------------------------------------------*/
+
+/* The ring of each core. */
+static LogRing rings[ configNUMBER_OF_CORES ];
+/* Set by the drain while it waits for a ring to be written. */
+static volatile u32 waiting;
+/* The drain task, notified as a record is written to the empty rings. */
+static TaskHandle_t drainTask;
+/* The memory of the drain task. */
+STATIC_TASK_MEMORY( drain, LOG_DRAIN_STACK );
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xLogInit( void )
+{
+	UBaseType_t uxCore;	/* Hold the index of the core. */
+	u32 position;		/* Hold the position of the record. */
+
+	/* Every record is free for its first position. */
+	for ( uxCore = 0; uxCore < configNUMBER_OF_CORES; ++uxCore ) {
+		for ( position = 0; position < LOG_RING_SIZE; ++position ) {
+			rings[ uxCore ].records[ position ].sequence = position;
+		}
+	}
+
+	return xStaticTaskCreate( prvLogDrain, "TaskLOG", LOG_DRAIN_STACK, NULL, tskIDLE_PRIORITY, &drainTask,
+		STATIC_TASK_BUFFERS( drain ) );
+}
+
+
+/*-----------------------------------------------------------*/
+void vLogWrite( u32 level, const char *format, UINTPTR a0, UINTPTR a1, UINTPTR a2, UINTPTR a3 )
+{
+	LogRing *pxRing;		/* Hold the ring of the core. */
+	LogRecord *pxRecord;	/* Hold the record to write. */
+	u32 position;			/* Hold the position of the record. */
+	s32 ahead;				/* Hold how far the record is ahead of the position. */
+
+	/* Write to the ring of this core, so the cores do not fight over one
+	 * head.  A task moved to another core before it claims its record only
+	 * shares the ring of the core it left, which is as safe. */
+	pxRing = &rings[ portGET_CORE_ID() ];
+
+	/* Claim the record at the head.  The ring is full only if the drain has
+	 * not read the record yet.  If another producer has claimed the record
+	 * since head was read, the record is ahead, so read head again. */
+	position = __atomic_load_n( &pxRing->head, __ATOMIC_RELAXED );
+	for( ;; )
+	{
+		pxRecord = &pxRing->records[ position & LOG_RING_MASK ];
+		ahead = ( s32 ) ( __atomic_load_n( &pxRecord->sequence, __ATOMIC_ACQUIRE ) - position );
+		if ( ahead == 0 ) {
+			if ( __atomic_compare_exchange_n( &pxRing->head, &position, position + 1,
+				pdTRUE, __ATOMIC_RELAXED, __ATOMIC_RELAXED ) ) {
+				break;
+			}
+		}
+		else if ( ahead < 0 ) {
+			__atomic_fetch_add( &pxRing->lost, 1, __ATOMIC_RELAXED );
+			return;
+		}
+		else {
+			position = __atomic_load_n( &pxRing->head, __ATOMIC_RELAXED );
+		}
+	}
+
+	XTime_GetTime( &pxRecord->stamp );
+	pxRecord->level = level;
+	pxRecord->format = format;
+	pxRecord->args[0] = a0;
+	pxRecord->args[1] = a1;
+	pxRecord->args[2] = a2;
+	pxRecord->args[3] = a3;
+
+	/* Hand the record to the drain, and wake it if it waits.  The fence
+	 * orders the record before the read of waiting, as the drain orders
+	 * waiting before its last look at the rings, so either it sees the
+	 * record or this sees it waiting. */
+	__atomic_store_n( &pxRecord->sequence, position + 1, __ATOMIC_RELEASE );
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );
+	if ( ( waiting != 0 ) && ( __atomic_exchange_n( &waiting, 0, __ATOMIC_RELAXED ) != 0 ) ) {
+		if ( xPortIsInsideInterrupt() != pdFALSE ) {
+			vTaskNotifyGiveFromISR( drainTask, NULL );
+		}
+		else {
+			xTaskNotifyGive( drainTask );
+		}
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+u32 ulLogGetLost( void )
+{
+	UBaseType_t uxCore;	/* Hold the index of the core. */
+	u32 total = 0;		/* Hold the records lost by all of the rings. */
+
+	for ( uxCore = 0; uxCore < configNUMBER_OF_CORES; ++uxCore ) {
+		total += rings[ uxCore ].lost;
+	}
+
+	return total;
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvLogDrain( void *pvParameters )
+{
+	u32 reported = 0;	/* Hold the lost records reported so far. */
+	u32 nowLost;		/* Hold the lost records now. */
+	UBaseType_t uxCore;	/* Hold the index of the core. */
+	BaseType_t xEmpty;	/* Hold whether every ring is empty. */
+
+	for( ;; )
+	{
+		/* Block while the rings are empty, until a producer writes to one,
+		 * so the tick can stay off in tickless idle.  Look at the rings
+		 * again after setting waiting, for a record written before it was
+		 * set.  A notification left from a record read since only wakes it
+		 * once. */
+		if ( prvLogPrintReady() == 0 ) {
+			waiting = 1;
+			__atomic_thread_fence( __ATOMIC_SEQ_CST );
+			xEmpty = pdTRUE;
+			for ( uxCore = 0; uxCore < configNUMBER_OF_CORES; ++uxCore ) {
+				if ( prvLogNextReady( &rings[ uxCore ] ) != NULL ) {
+					xEmpty = pdFALSE;
+				}
+			}
+			if ( xEmpty != pdFALSE ) {
+				( void ) ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+			}
+			waiting = 0;
+		}
+
+		nowLost = ulLogGetLost();
+		if ( nowLost != reported ) {
+			printf("log: %d records lost.\r\n", ( int ) ( nowLost - reported ));
+			reported = nowLost;
+		}
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static u32 prvLogPrintReady( void )
+{
+	LogRing *pxOldest;		/* Hold the ring of the oldest record ready. */
+	LogRecord *pxRecord;	/* Hold the record to read. */
+	LogRecord *pxNext;		/* Hold the next record of a ring. */
+	LogRecord record;		/* Hold a copy of the record. */
+	UBaseType_t uxCore;		/* Hold the index of the core. */
+	u32 count = 0;			/* Hold the number of records printed. */
+
+	for( ;; )
+	{
+		/* Merge the rings, printing the oldest of their next records. */
+		pxOldest = NULL;
+		pxRecord = NULL;
+		for ( uxCore = 0; uxCore < configNUMBER_OF_CORES; ++uxCore ) {
+			pxNext = prvLogNextReady( &rings[ uxCore ] );
+			if ( ( pxNext != NULL ) && ( ( pxRecord == NULL ) || ( pxNext->stamp < pxRecord->stamp ) ) ) {
+				pxOldest = &rings[ uxCore ];
+				pxRecord = pxNext;
+			}
+		}
+		if ( pxRecord == NULL ) {
+			return count;
+		}
+
+		/* Free the record before printing, so the producers can use it. */
+		record = *pxRecord;
+		__atomic_store_n( &pxRecord->sequence, pxOldest->tail + LOG_RING_SIZE, __ATOMIC_RELEASE );
+		++pxOldest->tail;
+
+		printf( record.format, record.args[0], record.args[1], record.args[2], record.args[3] );
+		++count;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static LogRecord *prvLogNextReady( LogRing *pxRing )
+{
+	LogRecord *pxRecord = &pxRing->records[ pxRing->tail & LOG_RING_MASK ];	/* Hold the next record. */
+
+	if ( __atomic_load_n( &pxRecord->sequence, __ATOMIC_ACQUIRE ) != ( pxRing->tail + 1 ) ) {
+		return NULL;
+	}
+
+	return pxRecord;
+}
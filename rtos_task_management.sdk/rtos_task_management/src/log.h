@@ -0,0 +1,83 @@
+/*
+ * log.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* Deferred logging.  A log statement only stores its level, its format string
+* and up to LOG_MAX_ARGS arguments into a ring of records.  A drain task at
+* the idle priority formats the records and prints them, so the time the UART
+* takes is spent when there is nothing else to do.
+*
+* Each core has its own ring, written by the tasks and ISRs running on it, so
+* the cores do not contend for the head of one ring.  Each record is stamped with
+* the global timer, and the drain merges the rings by the stamps of their next
+* records.
+*
+* A ring is lock-free.  Each record has a sequence number that tells whether
+* it is free or written, and a producer claims a record by a compare and swap
+* on the head.  So tasks and ISRs can log at any time, without a critical
+* section, and a producer preempted halfway through its record holds up only
+* the drain.  A record that finds its ring full is counted as lost, and the
+* drain reports the count.  The drain blocks while the rings are empty, and the
+* producer that writes the first record notifies it, so an idle logger keeps
+* no tick running.
+*
+* The format string is printed later, so it must be a string literal, and the
+* arguments must be integers or pointers to strings that outlive the record.
+* Log statements above LOG_LEVEL are removed by the compiler.
+*
+*******************************************************************************************/
+
+#ifndef LOG_H
+#define LOG_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+
+/* log levels */
+#define LOG_LEVEL_NONE	0							/* no logging */
+#define LOG_LEVEL_ERROR	1
+#define LOG_LEVEL_WARN	2
+#define LOG_LEVEL_INFO	3
+#define LOG_LEVEL_DEBUG	4
+
+/* log definitions */
+#ifndef LOG_LEVEL
+#define LOG_LEVEL	LOG_LEVEL_INFO						/* most detailed level compiled in */
+#endif
+#define LOG_RING_SIZE	64							/* records in the ring of each core, a power of 2 */
+#define LOG_MAX_ARGS	4							/* arguments of a record */
+#define LOG_DRAIN_STACK	( configMINIMAL_STACK_SIZE * 2 )	/* stack of the drain task */
+
+/* Log a format string with up to LOG_MAX_ARGS arguments at a level. */
+#define LOG_AT( level, ... ) \
+	do { \
+		if ( ( level ) <= LOG_LEVEL ) { \
+			vLogWrite( ( level ), prvLOG_ARGS( __VA_ARGS__, 0, 0, 0, 0, 0 ) ); \
+		} \
+	} while ( 0 )
+#define LOG_ERROR( ... )	LOG_AT( LOG_LEVEL_ERROR, __VA_ARGS__ )
+#define LOG_WARN( ... )	LOG_AT( LOG_LEVEL_WARN,  __VA_ARGS__ )
+#define LOG_INFO( ... )	LOG_AT( LOG_LEVEL_INFO,  __VA_ARGS__ )
+#define LOG_DEBUG( ... )	LOG_AT( LOG_LEVEL_DEBUG, __VA_ARGS__ )
+
+/* Pad the arguments of a log statement to LOG_MAX_ARGS. */
+#define prvLOG_ARGS( format, a0, a1, a2, a3, ... ) \
+	( format ), ( UINTPTR ) ( a0 ), ( UINTPTR ) ( a1 ), ( UINTPTR ) ( a2 ), ( UINTPTR ) ( a3 )
+
+/* Create the drain task. */
+BaseType_t xLogInit( void );
+/* Store a record, from a task or an ISR.  Use the LOG_ macros instead. */
+void vLogWrite( u32 level, const char *format, UINTPTR a0, UINTPTR a1, UINTPTR a2, UINTPTR a3 );
+/* The number of records lost to a full ring, by all of the cores. */
+u32 ulLogGetLost( void );
+
+#endif /* LOG_H */
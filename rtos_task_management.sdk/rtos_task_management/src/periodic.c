@@ -0,0 +1,132 @@
+/*
+ * periodic.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+#include "xtime_l.h"
+/* Application includes. */
+#include "periodic.h"
+
+#define COUNTS_PER_TICK	( COUNTS_PER_SECOND / configTICK_RATE_HZ )	/* global timer counts per tick */
+#define COUNTS_PER_USECOND	( COUNTS_PER_SECOND / 1000000UL )		/* global timer counts per us */
+
+/* Add a time to a histogram. */
+static void prvRecord( u32 *histogram, XTime *pxMax, XTime time );
+
+
+/*-----------------------------------------------------------*/
+void vPeriodicInit( PeriodicTask *pxTask, TickType_t period )
+{
+	pxTask->period = period;
+	pxTask->periodCounts = ( XTime ) period * COUNTS_PER_TICK;
+
+	/* The releases follow the ticks, so the first one is on a tick. */
+	pxTask->lastWake = xTaskGetTickCount();
+	vTaskDelayUntil( &pxTask->lastWake, 1 );
+	XTime_GetTime( &pxTask->release );
+}
+
+
+/*-----------------------------------------------------------*/
+void vPeriodicWait( PeriodicTask *pxTask )
+{
+	XTime now;			/* Hold the time of completion, then of the release. */
+	XTime response;		/* Hold the response time of the job. */
+	TickType_t late;	/* Hold the ticks since the current release, or the release of the wake. */
+	TickType_t skip;	/* Hold the number of releases to skip. */
+	BaseType_t resumed;	/* Hold whether vPeriodicResume() woke the task. */
+
+	/* Complete the current job. */
+	XTime_GetTime( &now );
+	response = now - pxTask->release;
+	prvRecord( pxTask->stats.response, &pxTask->stats.maxResponse, response );
+	++pxTask->stats.jobs;
+	if ( response > pxTask->periodCounts ) {
+		++pxTask->stats.missed;
+	}
+
+	/* vTaskDelayUntil() would release every missed job at once, so skip the
+	 * releases that have already passed, but for the last.  Its deadline,
+	 * the release after it, is still ahead, so it runs late. */
+	late = xTaskGetTickCount() - pxTask->lastWake;
+	if ( late >= ( 2 * pxTask->period ) ) {
+		skip = ( late / pxTask->period ) - 1;
+		pxTask->lastWake += skip * pxTask->period;
+		pxTask->release += ( XTime ) skip * pxTask->periodCounts;
+		pxTask->stats.skipped += skip;
+	}
+
+	/* Sleep until the next release. */
+	vTaskDelayUntil( &pxTask->lastWake, pxTask->period );
+	pxTask->release += pxTask->periodCounts;
+
+	/* Start the next job.  A task woken by vPeriodicResume() restarts its
+	 * releases from the tick of the wake, so the later jobs are timed on the
+	 * grid they run on.  The tick may also run a little ahead of the global
+	 * timer, so a job started before its release starts the grid anew.  Any
+	 * other late start is the jitter of the job. */
+	XTime_GetTime( &now );
+	late = xTaskGetTickCount() - pxTask->lastWake;
+	resumed = __atomic_exchange_n( &pxTask->resumed, pdFALSE, __ATOMIC_ACQUIRE );
+	if ( now < pxTask->release ) {
+		pxTask->lastWake += late;
+		pxTask->release = now;
+	}
+	else if ( resumed != pdFALSE ) {
+		pxTask->stats.skipped += late / pxTask->period;
+		pxTask->lastWake += late;
+		pxTask->release = now;
+	}
+	prvRecord( pxTask->stats.jitter, &pxTask->stats.maxJitter, now - pxTask->release );
+}
+
+
+/*-----------------------------------------------------------*/
+void vPeriodicResume( PeriodicTask *pxTask, TaskHandle_t xTask )
+{
+	/* A resume of a task that is not suspended must not move its releases,
+	 * and no other task may suspend or resume it in between. */
+	taskENTER_CRITICAL();
+	if ( eTaskGetState( xTask ) == eSuspended ) {
+		__atomic_store_n( &pxTask->resumed, pdTRUE, __ATOMIC_RELEASE );
+		vTaskResume( xTask );
+	}
+	taskEXIT_CRITICAL();
+}
+
+
+/*-----------------------------------------------------------*/
+void vPeriodicGetStats( const PeriodicTask *pxTask, PeriodicStats *pxStats )
+{
+	/* The task must not update its timing halfway through the copy. */
+	taskENTER_CRITICAL();
+	*pxStats = pxTask->stats;
+	taskEXIT_CRITICAL();
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvRecord( u32 *histogram, XTime *pxMax, XTime time )
+{
+	XTime us = time / COUNTS_PER_USECOND;	/* Hold the time in us. */
+	u32 bucket = 0;							/* Hold the bucket of the time. */
+
+	/* The bucket is the number of significant bits of the time in us. */
+	while ( ( us != 0 ) && ( bucket < ( PERIODIC_BUCKETS - 1 ) ) ) {
+		us >>= 1;
+		++bucket;
+	}
+	++histogram[ bucket ];
+
+	if ( time > *pxMax ) {
+		*pxMax = time;
+	}
+}
@@ -0,0 +1,79 @@
+/*
+ * periodic.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* Drift-free periodic tasks.  A periodic task is released every period ticks
+* by vTaskDelayUntil(), so the time that a job takes does not move the release
+* of the next job.
+*
+* The ideal release times are kept on the global timer.  Each job records its
+* release jitter, from its ideal release until it starts, and its response
+* time, from its ideal release until it calls vPeriodicWait() again.  Each is
+* kept as a histogram with power of 2 buckets in microseconds: bucket 0 holds
+* times under 1 us, and bucket k holds times from 2^(k-1) us to under 2^k us.
+* The last bucket also holds every longer time.  The deadline of a job is the
+* release of the next.
+*
+* A job that misses whole periods skips the releases it missed, instead of
+* running late jobs back to back.  A job released late, by an overload, keeps
+* its release, so the delay counts as its jitter, and the job misses its
+* deadline if it starts too late to meet it.
+*
+* A suspended periodic task must be resumed by vPeriodicResume() rather than
+* by vTaskResume().  It restarts its releases from the tick it was woken on,
+* and counts the releases that passed while it was suspended as skipped, so a
+* suspension is not charged to its timing.
+*
+*******************************************************************************************/
+
+#ifndef PERIODIC_H
+#define PERIODIC_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+#include "xtime_l.h"
+
+/* periodic definitions */
+#define PERIODIC_BUCKETS	16							/* histogram buckets, up to 16 ms */
+
+/* The timing of the jobs of a periodic task. */
+typedef struct {
+	u32 jitter[ PERIODIC_BUCKETS ];		/* histogram of the release jitter */
+	u32 response[ PERIODIC_BUCKETS ];	/* histogram of the response time */
+	XTime maxJitter;	/* longest release jitter, in global timer counts */
+	XTime maxResponse;	/* longest response time, in global timer counts */
+	u32 jobs;			/* number of jobs completed */
+	u32 missed;			/* number of jobs that missed their deadline */
+	u32 skipped;		/* number of releases skipped after a missed deadline */
+} PeriodicStats;
+
+/* A periodic task. */
+typedef struct {
+	TickType_t period;		/* the period, in ticks */
+	TickType_t lastWake;	/* the release of the current job, in ticks */
+	XTime periodCounts;		/* the period, in global timer counts */
+	XTime release;			/* the release of the current job, in global timer counts */
+	BaseType_t resumed;		/* whether vPeriodicResume() has woken the task since its last release */
+	PeriodicStats stats;	/* the timing of the jobs */
+} PeriodicTask;
+
+/* Start releasing the calling task every period ticks, from the next tick. */
+void vPeriodicInit( PeriodicTask *pxTask, TickType_t period );
+/* Complete the current job and sleep until the release of the next. */
+void vPeriodicWait( PeriodicTask *pxTask );
+/* Resume xTask, the task of pxTask, if it is suspended. */
+void vPeriodicResume( PeriodicTask *pxTask, TaskHandle_t xTask );
+/* Copy the timing of the jobs so far, from any task. */
+void vPeriodicGetStats( const PeriodicTask *pxTask, PeriodicStats *pxStats );
+
+#endif /* PERIODIC_H */
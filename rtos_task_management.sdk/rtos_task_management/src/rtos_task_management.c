@@ -31,12 +31,107 @@
  *
  * Created on: 	15 September 2020 (based on FreeRTOS_Hello_World.c)
  *     Author: 	Leomar Duran
- *    Version: 	1.5
+ *    Version: 	1.28
  */
 
 /********************************************************************************************
 * VERSION HISTORY
 ********************************************************************************************
+* 	v1.28 - 17 October 2026
+* 		Queues copy items of 4 and 8 bytes as words, typed_queue.h defines
+* 		queues of one type of item, and the benchmark suite times the copies.
+*
+* 	v1.27 - 17 October 2026
+* 		The kernel builds stream and message buffers, whose bytes can be filled
+* 		and read in place, and the benchmark suite streams bytes through them.
+*
+* 	v1.26 - 17 October 2026
+* 		Queues send and receive batches of items, and the benchmark suite
+* 		sends bursts both item by item and as batches.
+*
+* 	v1.25 - 17 October 2026
+* 		A lock-free ring passes items from one producer to one consumer, and
+* 		the benchmark suite streams items through it and through a queue.
+*
+* 	v1.24 - 17 October 2026
+* 		Queues can carry the buffers of a memory pool by reference, and the
+* 		benchmark suite streams messages through queues of both kinds.
+*
+* 	v1.23 - 17 October 2026
+* 		With configUSE_MEM_POOLS, the kernel has fixed block memory pools, and
+* 		the benchmark suite measures allocating, freeing and waiting on one.
+*
+* 	v1.22 - 17 October 2026
+* 		With configUSE_HEAP_REGIONS, the heap is split into the on-chip memory
+* 		and the DDR regions of lscript.ld, with a placement hint for each
+* 		allocation and the use of each region.
+*
+* 	v1.21 - 17 October 2026
+* 		With configUSE_HEAP_TLSF, the heap is a two level segregated fit, whose
+* 		allocations and frees take a bounded time, in place of heap_4.c.  The
+* 		benchmark suite measures both heaps.
+*
+* 	v1.20 - 17 October 2026
+* 		With configUSE_STACK_GUARD_PAGES, an unmapped page below each task
+* 		stack catches an overflow as it happens, instead of the check of the
+* 		stack at each context switch.
+*
+* 	v1.19 - 17 October 2026
+* 		The FPU registers are switched lazily, saved only when another task
+* 		uses the FPU, and the benchmark measures the context switch.
+*
+* 	v1.18 - 17 October 2026
+* 		With DO_AMP set, each core runs its own image, and core 1 does the
+* 		data processing of core 0 through channels in the on-chip memory.
+*
+* 	v1.17 - 17 October 2026
+* 		With configNUMBER_OF_CORES set to 2, the kernel schedules the tasks on
+* 		both Cortex-A9 cores, and the benchmark measures the scaling.
+*
+* 	v1.16 - 17 October 2026
+* 		With configUSE_TRACE_RECORDER, the kernel events are recorded into a
+* 		ring in RAM and dumped after the run, for the host to decode.
+*
+* 	v1.15 - 17 October 2026
+* 		The CPU load of each task and interrupt is sampled over a sliding
+* 		window from the run time stats, and logged now and then.
+*
+* 	v1.14 - 17 October 2026
+* 		Tickless idle is refused at compile time while the input is sampled
+* 		in the tick hook, as the hook is not called while the tick is stopped.
+*
+* 	v1.13 - 17 October 2026
+* 		With DO_BENCHMARK set, main() runs the latency benchmark suite of the
+* 		kernel paths instead of the tasks.
+*
+* 	v1.12 - 17 October 2026
+* 		The tasks are created from static memory placed at link time, with
+* 		configSUPPORT_STATIC_ALLOCATION.
+*
+* 	v1.11 - 17 October 2026
+* 		TaskBTN and TaskSW read timestamped edge events from the input event
+* 		service, instead of notifications and the global btn.
+*
+* 	v1.10 - 17 October 2026
+* 		The tasks log through the deferred logging ring instead of printing
+* 		with xil_printf inside their time slice.
+*
+* 	v1.9 - 17 October 2026
+* 		TaskLED is a drift-free periodic task, with histograms of its release
+* 		jitter and response time.
+*
+* 	v1.8 - 17 October 2026
+* 		The control logic of TaskBTN and TaskSW is a declarative rule table,
+* 		compiled into a 256-entry lookup by the control engine.
+*
+* 	v1.7 - 17 October 2026
+* 		Buttons and switches are debounced by the timer-driven debounce engine
+* 		instead of a 250 ms vTaskDelay in TaskBTN.
+*
+* 	v1.6 - 17 October 2026
+* 		TaskBTN and TaskSW block on input notifications instead of polling.
+* 		Input-to-action latency is measured with the global timer.
+*
 * 	v1.5 - 16 September 2020
 * 		Added TaskBTN feature that controls TaskSW.
 *
@@ -61,11 +156,22 @@
 * TASK DESCRIPTION
 ********************************************************************************************
 * TaskLED := a counter from 0 to 15, then looping back to 0 that is displayed in the LEDs.
+*            It is released every LED_DELAY ms, however long the display takes, and
+*            reports its timing every 16 counts.
 *
 * TaskBTN := reads the buttons to control the other tasks
 *
 * TaskSW  := reads the switches to control the other tasks
 *
+* TaskBTN and TaskSW sleep until their GPIO channel changes.  A raw change is
+* seen by an ISR: the AXI GPIO interrupt if the hardware has one, or otherwise
+* the tick hook, which samples the inputs once per tick.  The ISR starts the
+* debounce engine.  The input event service turns each stable edge into
+* events, which TaskBTN and TaskSW read in batches.
+*
+* The suspend and resume actions of TaskBTN and TaskSW are the rules in
+* control.c.  Each task dispatches its input to the rules that it owns.
+*
 *******************************************************************************************/
 
 /* FreeRTOS includes. */
@@ -79,6 +185,20 @@
 #include "xparameters.h"
 #include "xgpio.h"
 #include "xstatus.h"
+#include "xtime_l.h"
+/* Application includes. */
+#include "amp_channel.h"
+#include "amp_service.h"
+#include "benchmark.h"
+#include "control.h"
+#include "cpu_load.h"
+#include "debounce.h"
+#include "heap_regions.h"
+#include "input.h"
+#include "log.h"
+#include "periodic.h"
+#include "static_alloc.h"
+#include "trace_dump.h"
 
 /* task definitions */
 #define	DO_TASK_LED	1								/* whether to do TaskLED */
@@ -89,89 +209,154 @@
 #define  IN_DEVICE_ID	XPAR_AXI_GPIO_0_DEVICE_ID	/* GPIO device for input */
 #define OUT_DEVICE_ID	XPAR_AXI_GPIO_1_DEVICE_ID	/* GPIO device that LEDs are connected to */
 #define LED 0b0000									/* Initial LED value - 0000 */
-#define BTN_DELAY	250UL							/* button delay length for debounce */
 #define LED_DELAY	500UL							/* LED delay length for visualization */
 #define BTN_CHANNEL	1								/* GPIO port for buttons */
 #define  SW_CHANNEL	2								/* GPIO port for switches */
 #define LED_CHANNEL	1								/* GPIO port for LEDs */
 
+/* input interrupt definitions */
+#define INPUT_USES_GPIO_IRQ	XPAR_AXI_GPIO_0_INTERRUPT_PRESENT	/* else sample in the tick hook */
+#define INPUT_IRQ_ID	XPAR_FABRIC_AXI_GPIO_0_IP2INTC_IRPT_INTR	/* GIC ID of the input GPIO */
+#define INPUT_IRQ_MASK	XGPIO_IR_MASK					/* GPIO interrupt bits for both channels */
+#define  SW_SHIFT	CONTROL_SW_SHIFT				/* switches follow the buttons in the input */
+#define BTN_BITS	CONTROL_BTN_BITS				/* buttons in the debounced input */
+#define  SW_BITS	CONTROL_SW_BITS					/* switches in the debounced input */
+#define INPUT_BATCH	8								/* events read at once */
+#define COUNTS_PER_USECOND	( COUNTS_PER_SECOND / 1000000UL )	/* global timer counts per us */
+
+/* Without the GPIO interrupt, an input change is only seen on a tick, and
+ * tickless idle stops the ticks until a task is due.  Core 1 of the AMP build
+ * does not read the input. */
+#if ( configUSE_TICKLESS_IDLE == 1 ) && !INPUT_USES_GPIO_IRQ && !DO_BENCHMARK && !( DO_AMP && ( AMP_CORE == 1 ) )
+#error "Tickless idle needs the interrupt of the input GPIO."
+#endif
+
 /* GPIO instances */
 XGpio  InInst;									/* GPIO Device driver instance for input */
 XGpio OutInst;									/* GPIO Device driver instance for output */
 
-/* bit masks for on */
+/* bit mask for on */
 #define	      ON4 	0b1111						/* 4 bit on  */
-#define	BTN10_ON  	0b1100
-#define	 BTN2_ON  	0b1011
-#define	 BTN3_ON  	0b0111
-#define	 SW10_ON  	0b1100
-#define	  SW2_ON  	0b1011
-#define	  SW3_ON  	0b0111
-
-/* bit masks for off */
-#define       OFF4	0b0000						/* 4 bit off */
-#define	BTN10_OFF 	0b0011
-#define	 BTN2_OFF 	0b0100
-#define	 BTN3_OFF 	0b1000
-#define	 SW10_OFF 	0b0011
-#define	  SW2_OFF 	0b0100
-#define	  SW3_OFF 	0b1000
 /*-----------------------------------------------------------*/
 
 /* The tasks as described at the top of this file. */
 static void prvTaskLED( void *pvParameters );
 static void prvTaskBTN( void *pvParameters );
 static void prvTaskSW ( void *pvParameters );
+
+/* Reading the buttons and switches, and posting their changes. */
+static u32 prvReadInput( void );
+static void prvPostInput( BaseType_t *pxHigherPriorityTaskWoken );
+#if INPUT_USES_GPIO_IRQ
+static void prvInputISR( void *pvCallBackRef );
+#endif
+/*-----------------------------------------------------------*/
+
+/* Input-to-action latency, in global timer counts. */
+typedef struct {
+	XTime min;		/* shortest latency seen */
+	XTime max;		/* longest latency seen */
+	XTime total;	/* sum of all latencies, for the mean */
+	u32 count;		/* number of latencies measured */
+} InputLatency;
+static void prvRecordLatency( InputLatency *pxLatency, XTime stamp );
 /*-----------------------------------------------------------*/
 
 /* The task handles to control other tasks. */
 static TaskHandle_t xTaskLED;
 static TaskHandle_t xTaskBTN;
 static TaskHandle_t xTaskSW;
+/* The memory of the tasks, without the heap. */
+STATIC_TASK_MEMORY( taskLED, configMINIMAL_STACK_SIZE );
+STATIC_TASK_MEMORY( taskBTN, configMINIMAL_STACK_SIZE );
+STATIC_TASK_MEMORY( taskSW,  configMINIMAL_STACK_SIZE );
 /* The LED Counter. */
 int ledCntr = LED;
-/* The last value of button. */
-int btn;
+/* The releases of TaskLED and their timing. */
+PeriodicTask ledPeriodic;
+/* The input events of TaskBTN and TaskSW. */
+static InputConsumer btnEvents;
+static InputConsumer  swEvents;
+/* The last raw input seen by the ISR, and when each channel changed. */
+static u32 postedIn;
+static volatile XTime btnStamp;
+static volatile XTime  swStamp;
+/* The input-to-action latency of each task. */
+InputLatency btnLatency;
+InputLatency  swLatency;
 
 int main( void )
 {
 	int Status;
 
+	/* the kernel heap is in the regions of the linker script, when it is
+	 * split into them, before anything is allocated */
+	vHeapRegionsInit();
+
+	/* with an image on each core, set up the channels between them */
+	if (xAmpInit() != pdPASS) {
+		printf("AMP channels could not be set up!\r\n");
+		return 0;
+	}
+
+#if DO_AMP && ( AMP_CORE == 1 )
+	/* do the data processing of core 0 instead of running the tasks */
+	if (xAmpServiceStart() != pdPASS) {
+		printf("AMP service could not be started!\r\n");
+		return 0;
+	}
+	vTaskStartScheduler();
+	for( ;; );
+#endif
+
+#if DO_BENCHMARK
+	/* measure the kernel instead of running the tasks */
+	if (xBenchmarkStart() != pdPASS) {
+		printf("Benchmark could not be started!\r\n");
+		return 0;
+	}
+	vTaskStartScheduler();
+	for( ;; );
+#endif
+
 	if (DO_TASK_LED) {
 		printf( "Starting TaskLED. . .\r\n" );
 		/* Create TaskLED with priority 1. */
-		xTaskCreate( 	prvTaskLED, 				/* The function that implements the task. */
+		xStaticTaskCreate( 	prvTaskLED, 			/* The function that implements the task. */
 				( const char * ) "TaskLED", 		/* Text name for the task, provided to assist debugging only. */
 						configMINIMAL_STACK_SIZE, 	/* The stack allocated to the task. */
 						NULL, 						/* The task parameter is not used, so set to NULL. */
 						( UBaseType_t ) 1,			/* The next to lowest priority. */
-						&xTaskLED );
+						&xTaskLED,
+						STATIC_TASK_BUFFERS( taskLED ) );	/* The memory of the task. */
 		printf( "\tSuccessful\r\n" );
 	}
 
 	if (DO_TASK_BTN) {
 		printf( "Starting TaskBTN. . .\r\n" );
 		/* Create TaskBTN with priority 1. */
-		xTaskCreate(
+		xStaticTaskCreate(
 					prvTaskBTN,						/* The function implementing the task. */
 				( const char * ) "TaskBTN",			/* Text name provided for debugging. */
 					configMINIMAL_STACK_SIZE,		/* Not much need for a stack. */
 					NULL,							/* The task parameter, not in use. */
 					( UBaseType_t ) 1,				/* The next to lowest priority. */
-					&xTaskBTN );
+					&xTaskBTN,
+					STATIC_TASK_BUFFERS( taskBTN ) );	/* The memory of the task. */
 		printf( "\tSuccessful\r\n" );
 	}
 
 	if (DO_TASK_SW) {
 		printf( "Starting TaskSW . . .\r\n" );
 		/* Create TaskSW with priority 1. */
-		xTaskCreate(
+		xStaticTaskCreate(
 					prvTaskSW,						/* The function implementing the task. */
 				( const char * ) "TaskSW",			/* Text name provided for debugging. */
 					configMINIMAL_STACK_SIZE,		/* Not much need for a stack. */
 					NULL,							/* The task parameter, not in use. */
 					( UBaseType_t ) 1,				/* The next to lowest priority. */
-					&xTaskSW );
+					&xTaskSW,
+					STATIC_TASK_BUFFERS( taskSW ) );	/* The memory of the task. */
 		printf( "\tSuccessful\r\n" );
 	}
 
@@ -195,6 +380,54 @@ int main( void )
 	/* set switches to input */
 	XGpio_SetDataDirection( &InInst,  SW_CHANNEL, 0xFF);
 
+	/* the tasks log through the drain task */
+	if (xLogInit() != pdPASS) {
+		printf("Log drain task could not be created!\r\n");
+		return 0;
+	}
+
+	/* find out which tasks are eating the CPU */
+	if (xCpuLoadInit() != pdPASS) {
+		printf("CPU load timer could not be created!\r\n");
+		return 0;
+	}
+
+	/* dump the kernel trace after the run, if it is recorded */
+	if (xTraceDumpInit() != pdPASS) {
+		printf("Trace dump task could not be created!\r\n");
+		return 0;
+	}
+
+	/* debounce the buttons and switches, posting the edges as events */
+	if (xDebounceInit( prvReadInput ) != pdPASS) {
+		printf("Debounce timer could not be created!\r\n");
+		return 0;
+	}
+	xInputInit();
+	if (DO_TASK_BTN) {
+		vInputSubscribe( &btnEvents, xTaskBTN, BTN_BITS );
+	}
+	if (DO_TASK_SW) {
+		vInputSubscribe(  &swEvents, xTaskSW,   SW_BITS );
+	}
+
+	/* the rules act on the tasks */
+	vControlSetTask( CONTROL_TASK_LED, xTaskLED );
+	vControlSetPeriodic( CONTROL_TASK_LED, &ledPeriodic );
+	vControlSetTask( CONTROL_TASK_BTN, xTaskBTN );
+	vControlSetTask( CONTROL_TASK_SW,  xTaskSW );
+
+	/* the ISR compares against the input as it is at start up */
+	postedIn = ulDebounceGetState();
+
+#if INPUT_USES_GPIO_IRQ
+	/* interrupt on any change of the buttons or switches */
+	xPortInstallInterruptHandler( INPUT_IRQ_ID, prvInputISR, &InInst );
+	XGpio_InterruptEnable( &InInst, INPUT_IRQ_MASK );
+	XGpio_InterruptGlobalEnable( &InInst );
+	vPortEnableInterrupt( INPUT_IRQ_ID );
+#endif
+
 	/* Start the tasks and timer running. */
 	vTaskStartScheduler();
 
@@ -211,15 +444,26 @@ int main( void )
 static void prvTaskLED( void *pvParameters )
 {
 const TickType_t LEDseconds = pdMS_TO_TICKS( LED_DELAY );
+PeriodicStats stats;	/* Hold the timing of TaskLED. */
 
+	vPeriodicInit( &ledPeriodic, LEDseconds );
 	for( ;; )
 	{
 		/* display the counter */
 		XGpio_DiscreteWrite(&OutInst, LED_CHANNEL, ledCntr);
-		printf("TaskLED: count := %d\r\n", ledCntr);
+		LOG_INFO("TaskLED: count := %d\r\n", ledCntr);
+
+		/* report the timing once the counter loops */
+		if ( ( ledCntr & ON4 ) == ON4 ) {
+			vPeriodicGetStats( &ledPeriodic, &stats );
+			LOG_INFO("TaskLED: jitter max %d us, response max %d us, %d of %d deadlines missed.\r\n",
+				( int ) ( stats.maxJitter / COUNTS_PER_USECOND ),
+				( int ) ( stats.maxResponse / COUNTS_PER_USECOND ),
+				( int ) stats.missed, ( int ) stats.jobs);
+		}
 
-		/* Delay for visualization. */
-		vTaskDelay( LEDseconds );
+		/* Wait for the next release, for visualization. */
+		vPeriodicWait( &ledPeriodic );
 
 		/* update the counter */
 		++ledCntr;
@@ -230,54 +474,27 @@ const TickType_t LEDseconds = pdMS_TO_TICKS( LED_DELAY );
 /*-----------------------------------------------------------*/
 static void prvTaskBTN( void *pvParameters )
 {
-const TickType_t BTNseconds = pdMS_TO_TICKS( BTN_DELAY );
-	int nextBtn;	/* Hold the new button value. */
+	InputEvent events[ INPUT_BATCH ];	/* Hold the events read. */
+	u32 btn = btnEvents.state;	/* Hold the last button value. */
 	for( ;; )
 	{
-		/* Read input from the buttons. */
-		nextBtn = XGpio_DiscreteRead(&InInst, BTN_CHANNEL);
+		/* Sleep until the buttons change.  A vTaskResume() also ends the
+		 * wait, without an event. */
+		if ( uxInputRead( &btnEvents, events, INPUT_BATCH, portMAX_DELAY ) == 0 ) {
+			continue;
+		}
 
-		/* Debounce: */
 		/* If the button has changed, */
-		if ( btn != nextBtn ) {
-			btn = nextBtn;	/* store the old value */
-			vTaskDelay( BTNseconds );	/* delay until the end of the bounce */
-			nextBtn = XGpio_DiscreteRead( &InInst, BTN_CHANNEL );	/* read again */
-			/* if the button value is still the same, continue */
-			if ( btn == nextBtn ) {
-				printf("TaskBTN: Button changed to 0x%x.\r\n", btn);
-
-				btn = nextBtn;	/* update btn */
-				/* If BTN2 is depressed, regardless of the
-				 * status of BTN0 and BTN1, then TaskLED is
-				 * resumed.  So BTN2 gets priority. */
-				if ( ( btn | BTN2_ON ) == ON4 ) {
-					vTaskResume(xTaskLED);
-					printf("TaskBTN: TaskLED is resumed.\r\n");
-				}
-				/* Otherwise if BTN0 and BTN1 are depressed at
-				 * some point together then TaskLED is
-				 * suspended */
-				else if ( ( btn | BTN10_ON ) == ON4 ) {
-					vTaskSuspend(xTaskLED);
-					printf("TaskBTN: TaskLED is suspended.\r\n");
-				}
-
-				/* This logic below is independent from those above. */
-				/* If BTN3 is depressed then TaskSW is suspended */
-				if ( ( btn | BTN3_ON ) == ON4 ) {
-					vTaskSuspend(xTaskSW);
-					printf("TaskBTN: TaskSW  is suspended.\r\n");
-				}
-				/* Either BTN3 is depressed or it is released. */
-				/* If BTN3 is released then TaskSW is resumed */
-				else {
-					vTaskResume(xTaskSW);
-					printf("TaskBTN: TaskSW  is resumed.\r\n");
-				}
-
-			} /* end if ( btn == nextBtn ) check if button is consistent */
-		} /* end if ( btn != nextBtn ) check if button has changed since last call */
+		if ( btn != btnEvents.state ) {
+			btn = btnEvents.state;	/* update btn */
+			LOG_INFO("TaskBTN: Button changed to 0x%x.\r\n", btn);
+
+			/* act on the rules of the buttons */
+			vControlDispatch( BTN_BITS, btn );
+
+			/* The debounce time is part of the latency. */
+			prvRecordLatency( &btnLatency, btnStamp );
+		} /* end if ( btn != btnEvents.state ) check if button has changed since last read */
 	} /* end for( ;; ) */
 }
 
@@ -285,33 +502,109 @@ const TickType_t BTNseconds = pdMS_TO_TICKS( BTN_DELAY );
 /*-----------------------------------------------------------*/
 static void prvTaskSW( void *pvParameters )
 {
-	int sw;	/* Hold the current switch value. */
+	InputEvent events[ INPUT_BATCH ];	/* Hold the events read. */
+
+	/* act on the switches as they are at start up */
+	vControlDispatch( SW_BITS, swEvents.state );
+
 	for( ;; )
 	{
-		/* Read input from the switches. */
-		sw = XGpio_DiscreteRead(&InInst,  SW_CHANNEL);
+		/* Sleep until the switches change.  A vTaskResume() also ends the
+		 * wait, without an event. */
+		if ( uxInputRead( &swEvents, events, INPUT_BATCH, portMAX_DELAY ) == 0 ) {
+			continue;
+		}
+
+		/* act on the rules of the switches */
+		vControlDispatch( SW_BITS, swEvents.state );
 
-		/* If SW0 and SW1 are ON together at some point then
-		 * TaskBTN is suspended */
-		if ( ( sw | SW10_ON ) == ON4 ) {
-			vTaskSuspend(xTaskBTN);
+		prvRecordLatency( &swLatency, swStamp );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+/* Read the buttons and the switches into one input value. */
+static u32 prvReadInput( void )
+{
+	return ( XGpio_DiscreteRead( &InInst, BTN_CHANNEL ) & ON4 )
+		| ( ( XGpio_DiscreteRead( &InInst,  SW_CHANNEL ) & ON4 ) << SW_SHIFT );
+}
+
+
+/*-----------------------------------------------------------*/
+/* Read the input and start the debounce engine if it has changed.
+ * Called from interrupt context only. */
+static void prvPostInput( BaseType_t *pxHigherPriorityTaskWoken )
+{
+	u32 value;	/* Hold the input value. */
+
+	value = prvReadInput();
+	if ( value != postedIn ) {
+		/* time the latency from the last raw change of each channel */
+		if ( ( value ^ postedIn ) & BTN_BITS ) {
+			XTime_GetTime( (XTime *) &btnStamp );
 		}
-		/* Switches 0 and 1 cannot both be off if they're both on. */
-		/* If SW0 and SW1 are OFF then TaskBTN is resumed. */
-		else if ( (sw & SW10_OFF ) == OFF4 ) {
-			vTaskResume(xTaskBTN);
+		if ( ( value ^ postedIn ) &  SW_BITS ) {
+			XTime_GetTime( (XTime *) &swStamp );
 		}
+		postedIn = value;
+		vDebounceInputChangedFromISR( pxHigherPriorityTaskWoken );
+	}
+	else {
+		vDebounceRetryFromISR( pxHigherPriorityTaskWoken );
+	}
+}
 
-		/* This logic below is independent from those above. */
-		/* If SW3 is ON then TaskLED is suspended. */
-		if ( ( sw | SW3_ON ) == ON4 ) {
-			vTaskSuspend(xTaskLED);
-			/* If SW3 is then turned OFF, then resume TaskLED. */
-			sw = XGpio_DiscreteRead(&InInst,  SW_CHANNEL);
-			if ( ( sw & SW3_OFF ) == OFF4 ) {
-				vTaskResume(xTaskLED);
-				printf("TaskSW : TaskLED is resumed.\r\n");
-			}
-		}
+
+#if INPUT_USES_GPIO_IRQ
+/*-----------------------------------------------------------*/
+/* The AXI GPIO interrupt: post the input once either channel changes. */
+static void prvInputISR( void *pvCallBackRef )
+{
+	XGpio *pxGpio = ( XGpio * ) pvCallBackRef;
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+	u32 status;	/* Hold the channels that interrupted. */
+
+	status = XGpio_InterruptGetStatus( pxGpio );
+	XGpio_InterruptClear( pxGpio, status );
+	prvPostInput( &xHigherPriorityTaskWoken );
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+#else
+/*-----------------------------------------------------------*/
+/* Without a GPIO interrupt, sample both channels once per tick, so a
+ * change is seen within one tick period. */
+void vApplicationTickHook( void )
+{
+	BaseType_t xHigherPriorityTaskWoken = pdFALSE;
+
+	prvPostInput( &xHigherPriorityTaskWoken );
+	portYIELD_FROM_ISR( xHigherPriorityTaskWoken );
+}
+#endif
+
+
+/*-----------------------------------------------------------*/
+/* Add the time from the input change at stamp until now to the latency. */
+static void prvRecordLatency( InputLatency *pxLatency, XTime stamp )
+{
+	XTime now;	/* Hold the time of the action. */
+	XTime latency;	/* Hold the time from the input to the action. */
+
+	XTime_GetTime( &now );
+	latency = now - stamp;
+
+	if ( ( pxLatency->count == 0 ) || ( latency < pxLatency->min ) ) {
+		pxLatency->min = latency;
+	}
+	if ( latency > pxLatency->max ) {
+		pxLatency->max = latency;
 	}
+	pxLatency->total += latency;
+	++pxLatency->count;
+
+	LOG_INFO("Latency: %d us (max %d us).\r\n",
+		( int ) ( latency / COUNTS_PER_USECOND ),
+		( int ) ( pxLatency->max / COUNTS_PER_USECOND ));
 }
@@ -0,0 +1,216 @@
+/*
+ * spsc_ring.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* Standard includes. */
+#include <string.h>
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+/* Application includes. */
+#include "spsc_ring.h"
+
+/* Copy an item into the ring, waking the consumer from a task or an ISR. */
+static BaseType_t prvSpscRingPush( SpscRing *pxRing, const void *pvItem, BaseType_t xFromISR,
+	BaseType_t *pxHigherPriorityTaskWoken );
+/* Notify the consumer if it waits and wakeLevel items are in the ring, from a task or an ISR. */
+static void prvSpscRingWake( SpscRing *pxRing, u32 wakeLevel, BaseType_t xFromISR,
+	BaseType_t *pxHigherPriorityTaskWoken );
+/*-----------------------------------------------------------*/
+
+
+/*-----------------------------------------------------------*/
+void vSpscRingInit( SpscRing *pxRing, void *pvStorage, u32 itemSize, u32 capacity )
+{
+	configASSERT( ( capacity != 0 ) && ( ( capacity & ( capacity - 1 ) ) == 0 ) );
+
+	memset( pxRing, 0, sizeof( *pxRing ) );
+	pxRing->storage = ( u8 * ) pvStorage;
+	pxRing->itemSize = itemSize;
+	pxRing->mask = capacity - 1;
+	pxRing->wakeLevel = 1;
+}
+
+
+/*-----------------------------------------------------------*/
+void vSpscRingSetConsumer( SpscRing *pxRing, TaskHandle_t xConsumer, u32 wakeLevel )
+{
+	configASSERT( ( wakeLevel != 0 ) && ( wakeLevel <= pxRing->mask + 1 ) );
+
+	pxRing->wakeLevel = wakeLevel;
+	pxRing->xConsumer = xConsumer;
+}
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xSpscRingPush( SpscRing *pxRing, const void *pvItem )
+{
+	return prvSpscRingPush( pxRing, pvItem, pdFALSE, NULL );
+}
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xSpscRingPushFromISR( SpscRing *pxRing, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	return prvSpscRingPush( pxRing, pvItem, pdTRUE, pxHigherPriorityTaskWoken );
+}
+
+
+/*-----------------------------------------------------------*/
+void vSpscRingFlush( SpscRing *pxRing )
+{
+	prvSpscRingWake( pxRing, 0, pdFALSE, NULL );
+}
+
+
+/*-----------------------------------------------------------*/
+void vSpscRingFlushFromISR( SpscRing *pxRing, BaseType_t *pxHigherPriorityTaskWoken )
+{
+	prvSpscRingWake( pxRing, 0, pdTRUE, pxHigherPriorityTaskWoken );
+}
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xSpscRingPop( SpscRing *pxRing, void *pvItem )
+{
+	return ( ulSpscRingRead( pxRing, pvItem, 1 ) != 0 ) ? pdPASS : pdFAIL;
+}
+
+
+/*-----------------------------------------------------------*/
+u32 ulSpscRingRead( SpscRing *pxRing, void *pvItems, u32 maxItems )
+{
+	u32 tail = pxRing->tail;	/* Hold the tail, which only the consumer writes. */
+	u32 count;		/* Hold the items read. */
+	u32 first;		/* Hold the items before the end of the storage. */
+	u32 index;		/* Hold the index of the first item in the storage. */
+
+	/* The acquire orders the reads of the items after that of the head that
+	 * hands them over. */
+	count = pxRing->headSeen - tail;
+	if ( count < maxItems ) {
+		pxRing->headSeen = __atomic_load_n( &pxRing->head, __ATOMIC_ACQUIRE );
+		count = pxRing->headSeen - tail;
+	}
+	if ( count > maxItems ) {
+		count = maxItems;
+	}
+	if ( count == 0 ) {
+		return 0;
+	}
+
+	index = tail & pxRing->mask;
+	first = pxRing->mask + 1 - index;
+	if ( first > count ) {
+		first = count;
+	}
+	memcpy( pvItems, &pxRing->storage[ index * pxRing->itemSize ], first * pxRing->itemSize );
+	memcpy( ( u8 * ) pvItems + first * pxRing->itemSize, pxRing->storage, ( count - first ) * pxRing->itemSize );
+
+	/* The release orders the reads of the items before the producer can see
+	 * their places are free. */
+	__atomic_store_n( &pxRing->tail, tail + count, __ATOMIC_RELEASE );
+	return count;
+}
+
+
+/*-----------------------------------------------------------*/
+u32 ulSpscRingWait( SpscRing *pxRing, TickType_t xTicksToWait )
+{
+	u32 count;			/* Hold the items in the ring. */
+	u32 notified = 0;	/* Hold whether the producer notified this task. */
+
+	configASSERT( pxRing->xConsumer == xTaskGetCurrentTaskHandle() );
+
+	count = ulSpscRingCount( pxRing );
+	if ( ( count >= pxRing->wakeLevel ) || ( xTicksToWait == 0 ) ) {
+		return count;
+	}
+
+	/* The fence pairs with that of the producer, so either the producer sees
+	 * the flag, or this task sees the items the producer pushed. */
+	__atomic_store_n( &pxRing->waiting, 1, __ATOMIC_RELAXED );
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );
+	if ( ulSpscRingCount( pxRing ) < pxRing->wakeLevel ) {
+		notified = ulTaskNotifyTake( pdTRUE, xTicksToWait );
+	}
+
+	/* A producer that cleared the flag notifies this task, so if it did so
+	 * as the wait ended, its notification is taken here, not by the next
+	 * wait. */
+	if ( ( __atomic_exchange_n( &pxRing->waiting, 0, __ATOMIC_RELAXED ) == 0 ) && ( notified == 0 ) ) {
+		ulTaskNotifyTake( pdTRUE, portMAX_DELAY );
+	}
+
+	return ulSpscRingCount( pxRing );
+}
+
+
+/*-----------------------------------------------------------*/
+u32 ulSpscRingCount( const SpscRing *pxRing )
+{
+	return __atomic_load_n( &pxRing->head, __ATOMIC_ACQUIRE ) - __atomic_load_n( &pxRing->tail, __ATOMIC_ACQUIRE );
+}
+
+
+/*-----------------------------------------------------------*/
+static BaseType_t prvSpscRingPush( SpscRing *pxRing, const void *pvItem, BaseType_t xFromISR,
+	BaseType_t *pxHigherPriorityTaskWoken )
+{
+	u32 head = pxRing->head;	/* Hold the head, which only the producer writes. */
+
+	/* The acquire orders the reads of the consumer from the place of the
+	 * item before it is written again. */
+	if ( ( head - pxRing->tailSeen ) > pxRing->mask ) {
+		pxRing->tailSeen = __atomic_load_n( &pxRing->tail, __ATOMIC_ACQUIRE );
+		if ( ( head - pxRing->tailSeen ) > pxRing->mask ) {
+			return pdFAIL;
+		}
+	}
+
+	/* The release orders the item before the head that hands it over. */
+	memcpy( &pxRing->storage[ ( head & pxRing->mask ) * pxRing->itemSize ], pvItem, pxRing->itemSize );
+	__atomic_store_n( &pxRing->head, head + 1, __ATOMIC_RELEASE );
+
+	/* The tail last read is never ahead of the consumer, so the ring holds at
+	 * most this many. */
+	if ( ( pxRing->xConsumer != NULL ) && ( ( head + 1 - pxRing->tailSeen ) >= pxRing->wakeLevel ) ) {
+		prvSpscRingWake( pxRing, pxRing->wakeLevel, xFromISR, pxHigherPriorityTaskWoken );
+	}
+	return pdPASS;
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvSpscRingWake( SpscRing *pxRing, u32 wakeLevel, BaseType_t xFromISR,
+	BaseType_t *pxHigherPriorityTaskWoken )
+{
+	/* The fence pairs with that of the consumer, between setting the flag and
+	 * counting the items. */
+	__atomic_thread_fence( __ATOMIC_SEQ_CST );
+	if ( pxRing->waiting == 0 ) {
+		return;
+	}
+
+	/* The consumer pops nothing while it waits, so the tail is read again
+	 * for the items in the ring now.  Only the side that clears the flag
+	 * notifies. */
+	pxRing->tailSeen = __atomic_load_n( &pxRing->tail, __ATOMIC_ACQUIRE );
+	if ( ( ( pxRing->head - pxRing->tailSeen ) < wakeLevel )
+			|| ( __atomic_exchange_n( &pxRing->waiting, 0, __ATOMIC_RELAXED ) == 0 ) ) {
+		return;
+	}
+
+	if ( xFromISR != pdFALSE ) {
+		vTaskNotifyGiveFromISR( pxRing->xConsumer, pxHigherPriorityTaskWoken );
+	}
+	else {
+		xTaskNotifyGive( pxRing->xConsumer );
+	}
+}
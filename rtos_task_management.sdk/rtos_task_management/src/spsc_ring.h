@@ -0,0 +1,94 @@
+/*
+ * spsc_ring.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* A ring of fixed-size items from one producer to one consumer, for data that
+* arrives too fast to pass through a kernel queue, such as received UART
+* bytes, XADC samples or Ethernet descriptors.  xQueueSendFromISR() masks
+* interrupts and xQueueReceive() enters a critical section on every item,
+* while the ring enters neither.
+*
+* The producer only writes the head, and the consumer only the tail, each on
+* its own cache line.  Each index only grows, and is published with a release
+* store, and read with an acquire load, so on the Cortex-A9 a DMB orders the
+* item before the index that hands it over, even from the other core.  Each
+* side keeps a copy of the other's index, and only reads it again when the
+* copy says the ring is full, or empty.  So neither operation waits on the
+* other side, and the producer may be an ISR.
+*
+* Waking the consumer is optional.  A consumer task that calls
+* vSpscRingSetConsumer() can wait in ulSpscRingWait() until wakeLevel items
+* are in the ring, and the producer notifies it, with xTaskNotifyGive(), only
+* as the ring reaches that level while the consumer waits.  A wakeLevel above
+* 1 batches the items, so they cost one wake and one switch between them.  The
+* items below the level are picked up when the wait times out, or at once
+* after vSpscRingFlush() or vSpscRingFlushFromISR(), as at the end of a frame.
+* The ring uses the notification value of the consumer, which must not be
+* notified otherwise while it waits.
+*
+* Only one task or ISR may push, and only one task may pop.
+*
+*******************************************************************************************/
+
+#ifndef SPSC_RING_H
+#define SPSC_RING_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+
+/* SPSC ring definitions */
+#define SPSC_CACHE_LINE	32							/* Cortex-A9 L1 and L2 cache line */
+
+/* A ring.  The fields are private to spsc_ring.c. */
+typedef struct {
+	/* The producer's line. */
+	volatile u32 head __attribute__(( aligned( SPSC_CACHE_LINE ) ));	/* items pushed */
+	u32 tailSeen;				/* the tail, as the producer last read it */
+	/* The consumer's line. */
+	volatile u32 tail __attribute__(( aligned( SPSC_CACHE_LINE ) ));	/* items popped */
+	u32 headSeen;				/* the head, as the consumer last read it */
+	volatile u32 waiting;		/* whether the consumer waits for wakeLevel items */
+	/* Set up once. */
+	u8 *storage __attribute__(( aligned( SPSC_CACHE_LINE ) ));	/* the items */
+	u32 itemSize;				/* bytes of each item */
+	u32 mask;					/* index of an item in the storage */
+	TaskHandle_t xConsumer;		/* the task woken, or NULL */
+	u32 wakeLevel;				/* items in the ring that wake the consumer */
+} SpscRing;
+
+/* Set up a ring of capacity items of itemSize bytes in pvStorage, which holds
+ * capacity * itemSize bytes.  The capacity is a power of 2. */
+void vSpscRingInit( SpscRing *pxRing, void *pvStorage, u32 itemSize, u32 capacity );
+/* Let xConsumer wait in ulSpscRingWait() for wakeLevel items, from 1 up to the
+ * capacity. */
+void vSpscRingSetConsumer( SpscRing *pxRing, TaskHandle_t xConsumer, u32 wakeLevel );
+/* Copy an item into the ring, from a task.  Returns pdFAIL if it is full. */
+BaseType_t xSpscRingPush( SpscRing *pxRing, const void *pvItem );
+/* Copy an item into the ring, from an ISR.  *pxHigherPriorityTaskWoken is set
+ * to pdTRUE if that wakes the consumer, as by vTaskNotifyGiveFromISR(). */
+BaseType_t xSpscRingPushFromISR( SpscRing *pxRing, const void *pvItem, BaseType_t *pxHigherPriorityTaskWoken );
+/* Wake the consumer for the items in the ring, even below wakeLevel. */
+void vSpscRingFlush( SpscRing *pxRing );
+void vSpscRingFlushFromISR( SpscRing *pxRing, BaseType_t *pxHigherPriorityTaskWoken );
+/* Copy the oldest item out of the ring.  Returns pdFAIL if it is empty. */
+BaseType_t xSpscRingPop( SpscRing *pxRing, void *pvItem );
+/* Copy up to maxItems of the oldest items out of the ring, into pvItems, and
+ * return how many. */
+u32 ulSpscRingRead( SpscRing *pxRing, void *pvItems, u32 maxItems );
+/* Wait up to xTicksToWait for wakeLevel items, or a flush.  Returns the items
+ * in the ring, which are fewer on a timeout or a flush. */
+u32 ulSpscRingWait( SpscRing *pxRing, TickType_t xTicksToWait );
+/* The items in the ring. */
+u32 ulSpscRingCount( const SpscRing *pxRing );
+
+#endif /* SPSC_RING_H */
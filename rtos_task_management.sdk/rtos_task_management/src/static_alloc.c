@@ -0,0 +1,178 @@
+/*
+ * static_alloc.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "timers.h"
+/* Xilinx includes. */
+#if ( configUSE_STACK_GUARD_PAGES == 1 )
+#include "xil_exception.h"
+#include "xil_mmu.h"
+#include "xpseudo_asm.h"
+#include "xreg_cortexa9.h"
+#include "xstatus.h"
+#endif
+/* Application includes. */
+#include "static_alloc.h"
+
+#if ( configUSE_STACK_GUARD_PAGES == 1 )
+#define STATIC_FAULT_STATUS( dfsr )	( ( ( ( dfsr ) >> 6 ) & 0x10U ) | ( ( dfsr ) & 0xFU ) )	/* FS[4:0] of the DFSR */
+#define STATIC_PAGE_TRANSLATION_FAULT	0x07U		/* the fault status of an unmapped page */
+
+/* Make the page below the stack at puxStackBuffer no-access. */
+static void prvGuardStack( StackType_t *puxStackBuffer );
+/* Take a data abort, as a stack overflow if it is in a guard page. */
+static void prvStackGuardAbort( void *pvCallBackRef );
+/*-----------------------------------------------------------*/
+
+/* Called by the data abort in a guard page.  The kernel calls it too with
+ * configCHECK_FOR_STACK_OVERFLOW. */
+extern void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName );
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+/* The memory of the idle task and of the timer service task. */
+STATIC_TASK_MEMORY( idle, configMINIMAL_STACK_SIZE );
+STATIC_TASK_MEMORY( timer, configTIMER_TASK_STACK_DEPTH );
+#if ( configNUMBER_OF_CORES > 1 )
+/* The memory of the idle tasks of the other cores. */
+static StaticTask_t coreIdleTCB[ configNUMBER_OF_CORES - 1 ] STATIC_TCB;
+static STATIC_STACK_TYPE( configMINIMAL_STACK_SIZE ) coreIdleStack[ configNUMBER_OF_CORES - 1 ] STATIC_STACK;
+#endif
+#endif
+
+#if ( configUSE_STACK_GUARD_PAGES == 1 )
+/* The lowest and the highest guard page, between which a page translation
+ * fault can only be in a guard page, as the stacks fill the space between. */
+static UINTPTR lowestGuard = ( UINTPTR ) -1;
+static UINTPTR highestGuard;
+#endif
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xStaticTaskCreate( TaskFunction_t pxTaskCode, const char * const pcName,
+	const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters, UBaseType_t uxPriority,
+	TaskHandle_t * const pxCreatedTask, StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer )
+{
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	TaskHandle_t xTask;	/* Hold the new task. */
+
+#if ( configUSE_STACK_GUARD_PAGES == 1 )
+	prvGuardStack( puxStackBuffer );
+#endif
+	xTask = xTaskCreateStatic( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority,
+		puxStackBuffer, pxTaskBuffer );
+	if ( pxCreatedTask != NULL ) {
+		*pxCreatedTask = xTask;
+	}
+	return ( xTask != NULL ) ? pdPASS : pdFAIL;
+#else
+	( void ) puxStackBuffer;
+	( void ) pxTaskBuffer;
+	return xTaskCreate( pxTaskCode, pcName, usStackDepth, pvParameters, uxPriority, pxCreatedTask );
+#endif
+}
+
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+/*-----------------------------------------------------------*/
+/* The memory of the idle task, for vTaskStartScheduler(). */
+void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+	uint32_t *pulIdleTaskStackSize )
+{
+#if ( configUSE_STACK_GUARD_PAGES == 1 )
+	prvGuardStack( idleStack.stack );
+#endif
+	*ppxIdleTaskTCBBuffer = &idleTCB;
+	*ppxIdleTaskStackBuffer = idleStack.stack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+
+
+#if ( configNUMBER_OF_CORES > 1 )
+/*-----------------------------------------------------------*/
+/* The memory of the idle task of core 1 and up, for vTaskStartScheduler(). */
+void vApplicationGetCoreIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer,
+	uint32_t *pulIdleTaskStackSize, BaseType_t xCoreID )
+{
+	configASSERT( ( xCoreID > 0 ) && ( xCoreID < configNUMBER_OF_CORES ) );
+#if ( configUSE_STACK_GUARD_PAGES == 1 )
+	prvGuardStack( coreIdleStack[ xCoreID - 1 ].stack );
+#endif
+	*ppxIdleTaskTCBBuffer = &coreIdleTCB[ xCoreID - 1 ];
+	*ppxIdleTaskStackBuffer = coreIdleStack[ xCoreID - 1 ].stack;
+	*pulIdleTaskStackSize = configMINIMAL_STACK_SIZE;
+}
+#endif
+
+
+/*-----------------------------------------------------------*/
+/* The memory of the timer service task, for xTimerCreateTimerTask(). */
+void vApplicationGetTimerTaskMemory( StaticTask_t **ppxTimerTaskTCBBuffer, StackType_t **ppxTimerTaskStackBuffer,
+	uint32_t *pulTimerTaskStackSize )
+{
+#if ( configUSE_STACK_GUARD_PAGES == 1 )
+	prvGuardStack( timerStack.stack );
+#endif
+	*ppxTimerTaskTCBBuffer = &timerTCB;
+	*ppxTimerTaskStackBuffer = timerStack.stack;
+	*pulTimerTaskStackSize = configTIMER_TASK_STACK_DEPTH;
+}
+#endif
+
+
+#if ( configUSE_STACK_GUARD_PAGES == 1 )
+/*-----------------------------------------------------------*/
+static void prvGuardStack( StackType_t *puxStackBuffer )
+{
+	UINTPTR guard = ( UINTPTR ) puxStackBuffer - STATIC_PAGE;	/* Hold the guard page. */
+	s32 status;		/* Hold the status of the MMU update. */
+
+	configASSERT( ( ( UINTPTR ) puxStackBuffer % STATIC_PAGE ) == 0 );
+
+	/* The translation table is shared with the other core, and a stack may
+	 * be guarded again as its task is created again. */
+	taskENTER_CRITICAL();
+	if ( lowestGuard == ( UINTPTR ) -1 ) {
+		Xil_ExceptionRegisterHandler( XIL_EXCEPTION_ID_DATA_ABORT_INT, prvStackGuardAbort, NULL );
+	}
+	if ( guard < lowestGuard ) {
+		lowestGuard = guard;
+	}
+	if ( guard > highestGuard ) {
+		highestGuard = guard;
+	}
+	status = Xil_SetTlbPageAttributes( ( INTPTR ) guard, PAGE_NO_ACCESS );
+	taskEXIT_CRITICAL();
+
+	configASSERT( status == XST_SUCCESS );
+	( void ) status;
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvStackGuardAbort( void *pvCallBackRef )
+{
+	UINTPTR address = ( UINTPTR ) mfcp( XREG_CP15_DATA_FAULT_ADDRESS );	/* Hold the address accessed. */
+	u32 status = mfcp( XREG_CP15_DATA_FAULT_STATUS );	/* Hold the cause of the abort. */
+
+	/* The abort is precise, so the running task is the one that overflowed,
+	 * even in the middle of saving its context. */
+	if ( ( STATIC_FAULT_STATUS( status ) == STATIC_PAGE_TRANSLATION_FAULT )
+			&& ( address >= lowestGuard ) && ( address < highestGuard + STATIC_PAGE ) ) {
+		vApplicationStackOverflowHook( xTaskGetCurrentTaskHandle(), pcTaskGetName( NULL ) );
+	}
+	else {
+		Xil_DataAbortHandler( pvCallBackRef );
+	}
+
+	/* The access would only abort again. */
+	for( ;; );
+}
+#endif
@@ -0,0 +1,80 @@
+/*
+ * static_alloc.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* The static allocation profile.  With configSUPPORT_STATIC_ALLOCATION set to
+* 1, the application's tasks, the timer service task and the idle task run
+* from TCBs and stacks that are placed at link time, so nothing is allocated
+* from the heap on the way to the scheduler.  With it set to 0, the same code
+* creates the tasks from the heap as before.
+*
+* Each TCB and stack starts on its own cache line.  The TCBs are placed in the
+* .task_tcb section, which lscript.ld puts in the on-chip memory, and the
+* stacks in the .task_stack section in the DDR.  Neither section is loaded or
+* cleared at boot, as the kernel initialises both.  The linker reports the use
+* of each memory after every build.
+*
+* With configUSE_STACK_GUARD_PAGES set to 1, each stack starts on a 4KB page,
+* after a guard page of its own, which xStaticTaskCreate() and the memory
+* callbacks of the kernel make no-access through the MMU.  A task that runs
+* past the bottom of its stack then takes a data abort at the first word it
+* writes, which calls vApplicationStackOverflowHook() for the running task.
+* configCHECK_FOR_STACK_OVERFLOW is 0 then, as the check of the stack at each
+* context switch is no longer needed.  Each stack is rounded up to whole pages,
+* so the stacks take more memory, in the DDR.
+*
+*******************************************************************************************/
+
+#ifndef STATIC_ALLOC_H
+#define STATIC_ALLOC_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* static allocation definitions */
+#define STATIC_CACHE_LINE	32							/* Cortex-A9 L1 and L2 cache line */
+#define STATIC_PAGE	4096						/* MMU small page, the guard below each stack */
+#define STATIC_TCB	__attribute__(( section( ".task_tcb" ), aligned( STATIC_CACHE_LINE ) ))
+
+#if ( configUSE_STACK_GUARD_PAGES == 1 )
+	#if ( configSUPPORT_STATIC_ALLOCATION == 0 )
+		#error configUSE_STACK_GUARD_PAGES needs configSUPPORT_STATIC_ALLOCATION
+	#endif
+	/* A stack of depth words, after its guard page, as a type. */
+	#define STATIC_STACK_TYPE( depth ) \
+		struct __attribute__(( aligned( STATIC_PAGE ) )) { uint8_t guard[ STATIC_PAGE ]; StackType_t stack[ depth ]; }
+	#define STATIC_STACK	__attribute__(( section( ".task_stack" ), aligned( STATIC_PAGE ) ))
+#else
+	#define STATIC_STACK_TYPE( depth )	struct { StackType_t stack[ depth ]; }
+	#define STATIC_STACK	__attribute__(( section( ".task_stack" ), aligned( STATIC_CACHE_LINE ) ))
+#endif
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	/* Define the TCB and the stack of a task. */
+	#define STATIC_TASK_MEMORY( name, depth ) \
+		static StaticTask_t name##TCB STATIC_TCB; \
+		static STATIC_STACK_TYPE( depth ) name##Stack STATIC_STACK
+	/* The TCB and the stack of a task, as the last arguments of xStaticTaskCreate(). */
+	#define STATIC_TASK_BUFFERS( name )	name##Stack.stack, &name##TCB
+#else
+	#define STATIC_TASK_MEMORY( name, depth )	struct name##Unused
+	#define STATIC_TASK_BUFFERS( name )	NULL, NULL
+#endif
+
+/* Create a task in the memory of STATIC_TASK_BUFFERS(), or from the heap
+ * without static allocation.  pxCreatedTask may be NULL.  With
+ * configUSE_STACK_GUARD_PAGES, the stack must be the stack member of a
+ * STATIC_STACK_TYPE(). */
+BaseType_t xStaticTaskCreate( TaskFunction_t pxTaskCode, const char * const pcName,
+	const configSTACK_DEPTH_TYPE usStackDepth, void * const pvParameters, UBaseType_t uxPriority,
+	TaskHandle_t * const pxCreatedTask, StackType_t * const puxStackBuffer, StaticTask_t * const pxTaskBuffer );
+
+#endif /* STATIC_ALLOC_H */
@@ -0,0 +1,72 @@
+/*
+ * trace_dump.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+#include "xil_printf.h"
+/* Application includes. */
+#include "static_alloc.h"
+#include "trace_dump.h"
+#if TRACE_DUMP_DCC
+#include "xcoresightpsdcc.h"
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/* Wait for the end of the run, then dump the recorder, as a task. */
+static void prvTraceDump( void *pvParameters );
+/* Send one character of the dump. */
+static void prvTraceDumpPutChar( char cChar );
+/*-----------------------------------------------------------*/
+
+/* The memory of the dump task. */
+STATIC_TASK_MEMORY( dump, TRACE_DUMP_STACK );
+
+#endif /* configUSE_TRACE_RECORDER */
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xTraceDumpInit( void )
+{
+#if ( configUSE_TRACE_RECORDER == 1 )
+	return xStaticTaskCreate( prvTraceDump, "TaskTRC", TRACE_DUMP_STACK, NULL, TRACE_DUMP_PRIORITY, NULL,
+		STATIC_TASK_BUFFERS( dump ) );
+#else
+	return pdPASS;
+#endif
+}
+
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+
+/*-----------------------------------------------------------*/
+static void prvTraceDump( void *pvParameters )
+{
+	vTaskDelay( pdMS_TO_TICKS( TRACE_DUMP_AFTER_MS ) );
+	vTraceRecorderDump( prvTraceDumpPutChar );
+
+	/* The ring holds the run, for a debugger to read again. */
+	vTaskSuspend( NULL );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvTraceDumpPutChar( char cChar )
+{
+#if TRACE_DUMP_DCC
+	/* The driver ignores the base address. */
+	XCoresightPs_DccSendByte( 0, ( u8 ) cChar );
+#else
+	outbyte( cChar );
+#endif
+}
+
+#endif /* configUSE_TRACE_RECORDER */
@@ -0,0 +1,41 @@
+/*
+ * trace_dump.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* Dumps the kernel trace recorder after a run.  With configUSE_TRACE_RECORDER,
+* the kernel records its events into a ring in RAM, see FreeRTOSRingTrace.h.
+* A task waits TRACE_DUMP_AFTER_MS, stops the recorder and sends the ring as
+* lines of hex, over the UART, or over JTAG DCC with TRACE_DUMP_DCC.  The host
+* build decodes a captured dump into a Gantt chart of the tasks and a latency
+* report, with make trace.
+*
+* The dump task runs above the log drain, so log lines are not printed into
+* the middle of the dump.  Over DCC, sending blocks until the debugger reads.
+* Without configUSE_TRACE_RECORDER, nothing is created.
+*
+*******************************************************************************************/
+
+#ifndef TRACE_DUMP_H
+#define TRACE_DUMP_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* trace dump definitions */
+#define TRACE_DUMP_AFTER_MS	10000UL						/* time recorded before the dump */
+#define TRACE_DUMP_DCC	0								/* dump over JTAG DCC instead of the UART */
+#define TRACE_DUMP_PRIORITY	( tskIDLE_PRIORITY + 1 )	/* above the log drain */
+#define TRACE_DUMP_STACK	configMINIMAL_STACK_SIZE	/* stack of the dump task */
+
+/* Create the dump task. */
+BaseType_t xTraceDumpInit( void );
+
+#endif /* TRACE_DUMP_H */
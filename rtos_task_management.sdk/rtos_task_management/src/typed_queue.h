@@ -0,0 +1,86 @@
+/*
+ * typed_queue.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* Queues of one type of item, whose size is known when the code is compiled.
+* TYPED_QUEUE( Name, Type ) defines the type Name, a queue of Type items, and
+* inline functions that create it and send and receive its items:
+*
+* 	Name xNameCreate( uxLength )
+* 	Name xNameCreateStatic( uxLength, Type pxStorage[ uxLength ], pxStaticQueue )
+* 	BaseType_t xNameSend( xQueue, xItem, xTicksToWait )
+* 	BaseType_t xNameSendFromISR( xQueue, xItem, pxHigherPriorityTaskWoken )
+* 	BaseType_t xNameReceive( xQueue, pxItem, xTicksToWait )
+* 	BaseType_t xNameReceiveFromISR( xQueue, pxItem, pxHigherPriorityTaskWoken )
+*
+* An item is sent by value, so the compiler checks its type, and the queue is
+* created with sizeof( Type ), so it cannot be created with the wrong size.  A
+* queue of 4-byte or 8-byte items, such as pointers, handles or timestamps,
+* copies each as words.  The handle of the kernel queue is the xQueue member,
+* for the other functions of queue.h.
+*
+* Nothing is compiled unless a queue is defined, and then only the functions
+* called, so the header is optional.
+*
+*******************************************************************************************/
+
+#ifndef TYPED_QUEUE_H
+#define TYPED_QUEUE_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "queue.h"
+
+#if ( configSUPPORT_STATIC_ALLOCATION == 1 )
+	/* Create a queue of uxLength items in pxStorage and pxStaticQueue. */
+	#define TYPED_QUEUE_CREATE_STATIC( Name, Type ) \
+		static inline Name x##Name##CreateStatic( UBaseType_t uxLength, Type *pxStorage, StaticQueue_t *pxStaticQueue ) \
+		{ \
+			Name xTyped = { xQueueCreateStatic( uxLength, sizeof( Type ), ( uint8_t * ) pxStorage, pxStaticQueue ) }; \
+			return xTyped; \
+		}
+#else
+	#define TYPED_QUEUE_CREATE_STATIC( Name, Type )
+#endif
+
+/* Define Name, a queue of Type items, and its functions. */
+#define TYPED_QUEUE( Name, Type ) \
+	typedef struct { QueueHandle_t xQueue; } Name; \
+	\
+	/* Create a queue of uxLength items from the heap.  Its xQueue is NULL if \
+	 * the heap has no room for it. */ \
+	static inline Name x##Name##Create( UBaseType_t uxLength ) \
+	{ \
+		Name xTyped = { xQueueCreate( uxLength, sizeof( Type ) ) }; \
+		return xTyped; \
+	} \
+	TYPED_QUEUE_CREATE_STATIC( Name, Type ) \
+	\
+	static inline BaseType_t x##Name##Send( Name xTyped, Type xItem, TickType_t xTicksToWait ) \
+	{ \
+		return xQueueSend( xTyped.xQueue, &xItem, xTicksToWait ); \
+	} \
+	\
+	static inline BaseType_t x##Name##SendFromISR( Name xTyped, Type xItem, BaseType_t *pxHigherPriorityTaskWoken ) \
+	{ \
+		return xQueueSendFromISR( xTyped.xQueue, &xItem, pxHigherPriorityTaskWoken ); \
+	} \
+	\
+	static inline BaseType_t x##Name##Receive( Name xTyped, Type *pxItem, TickType_t xTicksToWait ) \
+	{ \
+		return xQueueReceive( xTyped.xQueue, pxItem, xTicksToWait ); \
+	} \
+	\
+	static inline BaseType_t x##Name##ReceiveFromISR( Name xTyped, Type *pxItem, BaseType_t *pxHigherPriorityTaskWoken ) \
+	{ \
+		return xQueueReceiveFromISR( xTyped.xQueue, pxItem, pxHigherPriorityTaskWoken ); \
+	}
+
+#endif /* TYPED_QUEUE_H */
@@ -58,6 +58,12 @@ extern "C" {
 /* Basic FreeRTOS definitions. */
 #include "projdefs.h"
 
+/* Must be defaulted before the port is included, as the port layer of a target
+with more than one core depends on it. */
+#ifndef configNUMBER_OF_CORES
+	#define configNUMBER_OF_CORES 1
+#endif
+
 /* Definitions specific to the port being used. */
 #include "portable.h"
 
@@ -288,6 +294,15 @@ extern "C" {
 	#define portPOINTER_SIZE_TYPE uint32_t
 #endif
 
+#ifndef configUSE_TRACE_RECORDER
+	#define configUSE_TRACE_RECORDER 0
+#endif
+
+#if ( configUSE_TRACE_RECORDER == 1 )
+	/* Record the kernel events into a ring in RAM, see FreeRTOSRingTrace.h. */
+	#include "FreeRTOSRingTrace.h"
+#endif
+
 /* Remove any unused trace macros. */
 #ifndef traceSTART
 	/* Used to perform any necessary initialisation - for example, open a file
@@ -374,6 +389,13 @@ extern "C" {
 	#define configCHECK_FOR_STACK_OVERFLOW 0
 #endif
 
+/* Set configUSE_STACK_GUARD_PAGES to 1 when the application places a page the
+MMU does not map below each task stack, so an overflow aborts at once instead
+of being found by configCHECK_FOR_STACK_OVERFLOW at the next context switch. */
+#ifndef configUSE_STACK_GUARD_PAGES
+	#define configUSE_STACK_GUARD_PAGES 0
+#endif
+
 #ifndef configRECORD_STACK_HIGH_ADDRESS
 	#define configRECORD_STACK_HIGH_ADDRESS 0
 #endif
@@ -688,10 +710,27 @@ extern "C" {
 	#define traceSTREAM_BUFFER_RECEIVE_FROM_ISR( xStreamBuffer, xReceivedLength )
 #endif
 
+#ifndef traceISR_ENTER
+	/* Called by the port before the handler of an interrupt is called. */
+	#define traceISR_ENTER( ulInterruptID )
+#endif
+
+#ifndef traceISR_EXIT
+	/* Called by the port after the handler of an interrupt returns. */
+	#define traceISR_EXIT( ulInterruptID )
+#endif
+
 #ifndef configGENERATE_RUN_TIME_STATS
 	#define configGENERATE_RUN_TIME_STATS 0
 #endif
 
+/* The type of the run time counters.  A 32-bit counter clocked fast enough to
+give useful resolution wraps within seconds, so a port with a 64-bit time base
+can set this to uint64_t. */
+#ifndef configRUN_TIME_COUNTER_TYPE
+	#define configRUN_TIME_COUNTER_TYPE uint32_t
+#endif
+
 #if ( configGENERATE_RUN_TIME_STATS == 1 )
 
 	#ifndef portCONFIGURE_TIMER_FOR_RUN_TIME_STATS
@@ -719,7 +758,12 @@ extern "C" {
 #endif
 
 #ifndef portYIELD_WITHIN_API
-	#define portYIELD_WITHIN_API portYIELD
+	#if ( configNUMBER_OF_CORES == 1 )
+		#define portYIELD_WITHIN_API portYIELD
+	#else
+		/* A yield inside a critical section is held pending until its exit. */
+		#define portYIELD_WITHIN_API vTaskYieldWithinAPI
+	#endif
 #endif
 
 #ifndef portSUPPRESS_TICKS_AND_SLEEP
@@ -738,6 +782,68 @@ extern "C" {
 	#define configUSE_TICKLESS_IDLE 0
 #endif
 
+#ifndef configUSE_DELAY_WHEEL
+	#define configUSE_DELAY_WHEEL 0
+#endif
+
+#ifndef configDELAY_WHEEL_SIZE
+	#define configDELAY_WHEEL_SIZE 64
+#endif
+
+#if ( configUSE_DELAY_WHEEL == 1 ) && ( ( configDELAY_WHEEL_SIZE & ( configDELAY_WHEEL_SIZE - 1 ) ) != 0 )
+	#error configDELAY_WHEEL_SIZE must be a power of 2
+#endif
+
+#if ( configNUMBER_OF_CORES > 1 )
+
+	/* The port layer of a target with more than one core provides the ID of
+	the calling core, a way to interrupt another core so that it switches
+	context, two recursive spin locks, and a critical nesting count for each
+	core.  The task lock is taken first, and is held while the scheduler is
+	suspended.  The ISR lock is taken second, and guards the ready lists
+	against the interrupts of every core. */
+	#ifndef portGET_CORE_ID
+		#error configNUMBER_OF_CORES is greater than 1, so the port must define portGET_CORE_ID()
+	#endif
+
+	#ifndef portYIELD_CORE
+		#error configNUMBER_OF_CORES is greater than 1, so the port must define portYIELD_CORE( xCoreID )
+	#endif
+
+	#if !defined( portGET_TASK_LOCK ) || !defined( portRELEASE_TASK_LOCK ) || !defined( portGET_ISR_LOCK ) || !defined( portRELEASE_ISR_LOCK )
+		#error configNUMBER_OF_CORES is greater than 1, so the port must define the task and ISR locks
+	#endif
+
+	#if !defined( portGET_CRITICAL_NESTING_COUNT ) || !defined( portSET_CRITICAL_NESTING_COUNT )
+		#error configNUMBER_OF_CORES is greater than 1, so the port must keep a critical nesting count for each core
+	#endif
+
+	#if ( portCRITICAL_NESTING_IN_TCB == 1 )
+		#error portCRITICAL_NESTING_IN_TCB must be 0 if configNUMBER_OF_CORES is greater than 1
+	#endif
+
+	#if ( configUSE_TICKLESS_IDLE != 0 )
+		/* The tick is stopped by the idle task of one core, while the other
+		cores may still have tasks to time slice. */
+		#error configUSE_TICKLESS_IDLE must be 0 if configNUMBER_OF_CORES is greater than 1
+	#endif
+
+	#if ( configUSE_TRACE_RECORDER == 1 )
+		/* The records do not tell the core, and the decoder models one. */
+		#error configUSE_TRACE_RECORDER must be 0 if configNUMBER_OF_CORES is greater than 1
+	#endif
+
+	#if ( configUSE_CO_ROUTINES != 0 )
+		#error configUSE_CO_ROUTINES must be 0 if configNUMBER_OF_CORES is greater than 1
+	#endif
+
+	#if ( configUSE_NEWLIB_REENTRANT != 0 )
+		/* _impure_ptr is one for every core. */
+		#error configUSE_NEWLIB_REENTRANT must be 0 if configNUMBER_OF_CORES is greater than 1
+	#endif
+
+#endif /* configNUMBER_OF_CORES */
+
 #ifndef configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING
 	#define configPRE_SUPPRESS_TICKS_AND_SLEEP_PROCESSING( x )
 #endif
@@ -802,6 +908,39 @@ extern "C" {
 	#define configAPPLICATION_ALLOCATED_HEAP 0
 #endif
 
+/* Set configUSE_HEAP_TLSF to 1 to build heap_tlsf.c, whose pvPortMalloc() and
+vPortFree() take a bounded time, in place of the first fit of heap_4.c. */
+#ifndef configUSE_HEAP_TLSF
+	#define configUSE_HEAP_TLSF 0
+#endif
+
+/* Set configUSE_HEAP_REGIONS to 1 for heap_tlsf.c to allocate from the regions
+passed to vPortDefineHeapRegions(), up to configHEAP_REGIONS_MAX of them,
+instead of ucHeap. */
+#ifndef configUSE_HEAP_REGIONS
+	#define configUSE_HEAP_REGIONS 0
+#endif
+
+#ifndef configHEAP_REGIONS_MAX
+	#define configHEAP_REGIONS_MAX 2
+#endif
+
+#if( ( configUSE_HEAP_REGIONS == 1 ) && ( configUSE_HEAP_TLSF == 0 ) )
+	#error configUSE_HEAP_REGIONS needs configUSE_HEAP_TLSF
+#endif
+
+/* Set configUSE_MEM_POOLS to 1 to build the fixed block memory pools of
+mem_pool.c. */
+#ifndef configUSE_MEM_POOLS
+	#define configUSE_MEM_POOLS 0
+#endif
+
+/* Set configUSE_STREAM_BUFFER_REGIONS to 1 to build the functions that let
+the writer and the reader of a stream buffer use its bytes where they are. */
+#ifndef configUSE_STREAM_BUFFER_REGIONS
+	#define configUSE_STREAM_BUFFER_REGIONS 0
+#endif
+
 #ifndef configUSE_TASK_NOTIFICATIONS
 	#define configUSE_TASK_NOTIFICATIONS 1
 #endif
@@ -950,6 +1089,12 @@ point support. */
 	#define configUSE_TASK_FPU_SUPPORT 1
 #endif
 
+/* Set configUSE_TASK_FPU_LAZY to 1 to save and restore the FPU registers of a
+task only when another task uses the FPU, in the ports that support it. */
+#ifndef configUSE_TASK_FPU_LAZY
+	#define configUSE_TASK_FPU_LAZY 0
+#endif
+
 /*
  * In line with software engineering best practice, FreeRTOS implements a strict
  * data hiding policy, so the real structures used by FreeRTOS to maintain the
@@ -1025,7 +1170,7 @@ typedef struct xSTATIC_TCB
 		void			*pvDummy15[ configNUM_THREAD_LOCAL_STORAGE_POINTERS ];
 	#endif
 	#if ( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulDummy16;
+		configRUN_TIME_COUNTER_TYPE	ulDummy16;
 	#endif
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		struct	_reent	xDummy17;
@@ -1044,6 +1189,10 @@ typedef struct xSTATIC_TCB
 	#if ( configUSE_POSIX_ERRNO == 1 )
 		int				iDummy22;
 	#endif
+	#if ( configNUMBER_OF_CORES > 1 )
+		BaseType_t		xDummy23;
+		UBaseType_t		uxDummy24[ 2 ];
+	#endif
 } StaticTask_t;
 
 /*
@@ -1087,6 +1236,10 @@ typedef struct xSTATIC_QUEUE
 		uint8_t ucDummy9;
 	#endif
 
+	#if ( configUSE_MEM_POOLS == 1 )
+		void *pvDummy10;
+	#endif
+
 } StaticQueue_t;
 typedef StaticQueue_t StaticSemaphore_t;
 
@@ -0,0 +1,278 @@
+/*
+ * FreeRTOS Kernel V10.0.0
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*****************************************************************************/
+/**
+*
+* @file FreeRTOSRingTrace.h
+*
+* Contains FreeRTOS trace macros that record the kernel events as fixed size
+* binary records in a RAM ring buffer, for dumping after a run.
+*
+* Each record holds the event, the task, queue or other object it is on, one
+* value, and the low word of the global timer.  A record is claimed with an
+* atomic increment of the head of the ring, so the macros can be used from
+* tasks and nested interrupts without masking interrupts.  Once the ring is
+* full the oldest records are overwritten.
+*
+* Recording runs from boot.  vTraceRecorderDump() stops it and
+* writes the ring as lines of hex between begin and end markers, through a
+* function that sends one character, such as outbyte() for the UART or
+* XCoresightPs_DccSendByte() for JTAG DCC.  The host build decodes the dump
+* into a Gantt chart of the tasks and a latency report, see tracedecode.c.
+*
+* The types and the event IDs below only need stdint.h, so the decoder uses
+* this header as is.
+*
+******************************************************************************/
+
+#ifndef FREERTOS_RING_TRACE_H
+#define FREERTOS_RING_TRACE_H
+
+#include <stdint.h>
+
+#ifdef FREERTOS_ENABLE_TRACE
+	#error The trace recorder and the STM trace both define the trace macros.
+#endif
+
+/* The number of records in the ring, a power of 2. */
+#ifndef configTRACE_RECORDER_SIZE
+	#define configTRACE_RECORDER_SIZE 4096
+#endif
+
+#if( ( configTRACE_RECORDER_SIZE & ( configTRACE_RECORDER_SIZE - 1 ) ) != 0 )
+	#error configTRACE_RECORDER_SIZE must be a power of 2.
+#endif
+
+/* The number of task names kept for the dump. */
+#ifndef configTRACE_RECORDER_MAX_TASKS
+	#define configTRACE_RECORDER_MAX_TASKS 64
+#endif
+
+/* The first word of a dump, "FRTR", and the version of its format. */
+#define traceRECORDER_MAGIC			0x52545246UL
+#define traceRECORDER_VERSION		1
+
+/* The lines around a dump. */
+#define traceRECORDER_BEGIN			"-----BEGIN FREERTOS TRACE-----"
+#define traceRECORDER_END			"-----END FREERTOS TRACE-----"
+
+/* The longest task name kept, with its terminator. */
+#define traceRECORDER_NAME_LEN		12
+
+/* The events recorded.  The object and the value of each are in brackets;
+the blocking and delay events are on the running task. */
+typedef enum
+{
+	eTraceNone = 0,
+	eTraceTaskSwitchedIn,		/* ( task, priority ) */
+	eTraceTaskReady,			/* ( task, priority ) */
+	eTraceTaskCreate,			/* ( task, priority ) */
+	eTraceTaskDelete,			/* ( task, 0 ) */
+	eTraceTaskDelay,			/* ( task, ticks to delay ) */
+	eTraceTaskDelayUntil,		/* ( task, tick to wake ) */
+	eTraceTaskSuspend,			/* ( task, 0 ) */
+	eTraceTaskResume,			/* ( task, 0 ) */
+	eTraceTaskResumeFromISR,	/* ( task, 0 ) */
+	eTraceTaskPrioritySet,		/* ( task, new priority ) */
+	eTraceTaskPriorityInherit,	/* ( mutex holder, inherited priority ) */
+	eTraceTaskPriorityDisinherit,	/* ( mutex holder, original priority ) */
+	eTraceTick,					/* ( 0, tick count ) */
+	eTraceIncreaseTickCount,	/* ( 0, ticks stepped ) */
+	eTraceLowPowerIdleBegin,	/* ( 0, 0 ) */
+	eTraceLowPowerIdleEnd,		/* ( 0, 0 ) */
+	eTraceISREnter,				/* ( interrupt ID, 0 ) */
+	eTraceISRExit,				/* ( interrupt ID, 0 ) */
+	eTraceQueueSend,			/* ( queue, items before ) */
+	eTraceQueueSendFailed,		/* ( queue, items ) */
+	eTraceQueueSendFromISR,		/* ( queue, items before ) */
+	eTraceQueueSendFromISRFailed,	/* ( queue, items ) */
+	eTraceQueueReceive,			/* ( queue, items before ) */
+	eTraceQueueReceiveFailed,	/* ( queue, items ) */
+	eTraceQueueReceiveFromISR,	/* ( queue, items before ) */
+	eTraceQueueReceiveFromISRFailed,	/* ( queue, items ) */
+	eTraceQueuePeek,			/* ( queue, items ) */
+	eTraceBlockingOnQueueSend,	/* ( queue, items ) */
+	eTraceBlockingOnQueueReceive,	/* ( queue, items ) */
+	eTraceBlockingOnQueuePeek,	/* ( queue, items ) */
+	eTraceTaskNotify,			/* ( task notified, 0 ) */
+	eTraceTaskNotifyFromISR,	/* ( task notified, 0 ) */
+	eTraceTaskNotifyGiveFromISR,	/* ( task notified, 0 ) */
+	eTraceTaskNotifyTakeBlock,	/* ( task, ticks to wait ) */
+	eTraceTaskNotifyWaitBlock,	/* ( task, ticks to wait ) */
+	eTraceEventGroupWaitBitsBlock,	/* ( event group, bits to wait for ) */
+	eTraceEventGroupSyncBlock,	/* ( event group, bits to wait for ) */
+	eTraceEventGroupSetBits,	/* ( event group, bits to set ) */
+	eTraceEventGroupSetBitsFromISR,	/* ( event group, bits to set ) */
+	eTraceTimerExpired,			/* ( timer, 0 ) */
+	eTraceEventCount
+} eTraceEvent;
+
+/* One record of the ring, and one line of a dump. */
+typedef struct xTRACE_RECORD
+{
+	uint32_t ulTimestamp;		/* The low word of the global timer. */
+	uint32_t ulEvent;			/* An eTraceEvent. */
+	uint32_t ulObject;			/* The address of the object, or the interrupt ID. */
+	uint32_t ulValue;			/* The value of the event. */
+} TraceRecord_t;
+
+/* The start of a dump, two lines. */
+typedef struct xTRACE_DUMP_HEADER
+{
+	uint32_t ulMagic;			/* traceRECORDER_MAGIC. */
+	uint16_t usVersion;			/* traceRECORDER_VERSION. */
+	uint16_t usRecordSize;		/* sizeof( TraceRecord_t ). */
+	uint32_t ulTimestampHz;		/* The rate of the timestamps. */
+	uint32_t ulTasks;			/* The task names that follow the header. */
+	uint32_t ulRecords;			/* The records that follow the task names, oldest first. */
+	uint32_t ulLost;			/* The records overwritten before the dump. */
+	uint32_t ulReserved[ 2 ];
+} TraceDumpHeader_t;
+
+/* The name of a task, one line of a dump. */
+typedef struct xTRACE_TASK_NAME
+{
+	uint32_t ulTask;			/* The address of the task. */
+	char cName[ traceRECORDER_NAME_LEN ];	/* Its name, as created. */
+} TraceTaskName_t;
+
+/* Sends one character of a dump. */
+typedef void ( *TraceRecorderPutChar_t )( char cChar );
+
+/* Start recording again, from an empty ring. */
+void vTraceRecorderStart( void );
+
+/* Stop recording.  The ring keeps what was recorded. */
+void vTraceRecorderStop( void );
+
+/* Record an event.  Use the trace macros instead. */
+void vTraceRecorderWrite( uint32_t ulEvent, uint32_t ulObject, uint32_t ulValue );
+
+/* Keep the name of a task, and record its creation. */
+void vTraceRecorderTaskCreated( uint32_t ulTask, const char *pcName, uint32_t ulPriority );
+
+/* Stop recording, and send the ring through pxPutChar. */
+void vTraceRecorderDump( TraceRecorderPutChar_t pxPutChar );
+
+/* The object of a record, from a pointer. */
+#define traceRECORDER_ID( pxObject )	( ( uint32_t ) ( portPOINTER_SIZE_TYPE ) ( pxObject ) )
+
+/* The trace macros recorded.  The rest keep their empty defaults. */
+#define traceTASK_SWITCHED_IN()	\
+	vTraceRecorderWrite( eTraceTaskSwitchedIn, traceRECORDER_ID( pxCurrentTCB ), pxCurrentTCB->uxPriority )
+
+#define traceMOVED_TASK_TO_READY_STATE( pxTCB )	\
+	vTraceRecorderWrite( eTraceTaskReady, traceRECORDER_ID( pxTCB ), ( pxTCB )->uxPriority )
+
+#define traceTASK_CREATE( pxNewTCB )	\
+	vTraceRecorderTaskCreated( traceRECORDER_ID( pxNewTCB ), ( pxNewTCB )->pcTaskName, ( pxNewTCB )->uxPriority )
+
+#define traceTASK_DELETE( pxTaskToDelete )	\
+	vTraceRecorderWrite( eTraceTaskDelete, traceRECORDER_ID( pxTaskToDelete ), 0 )
+
+#define traceTASK_DELAY()	\
+	vTraceRecorderWrite( eTraceTaskDelay, traceRECORDER_ID( pxCurrentTCB ), xTicksToDelay )
+
+#define traceTASK_DELAY_UNTIL( xTimeToWake )	\
+	vTraceRecorderWrite( eTraceTaskDelayUntil, traceRECORDER_ID( pxCurrentTCB ), ( xTimeToWake ) )
+
+#define traceTASK_SUSPEND( pxTaskToSuspend )	\
+	vTraceRecorderWrite( eTraceTaskSuspend, traceRECORDER_ID( pxTaskToSuspend ), 0 )
+
+#define traceTASK_RESUME( pxTaskToResume )	\
+	vTraceRecorderWrite( eTraceTaskResume, traceRECORDER_ID( pxTaskToResume ), 0 )
+
+#define traceTASK_RESUME_FROM_ISR( pxTaskToResume )	\
+	vTraceRecorderWrite( eTraceTaskResumeFromISR, traceRECORDER_ID( pxTaskToResume ), 0 )
+
+#define traceTASK_PRIORITY_SET( pxTask, uxNewPriority )	\
+	vTraceRecorderWrite( eTraceTaskPrioritySet, traceRECORDER_ID( pxTask ), ( uxNewPriority ) )
+
+#define traceTASK_PRIORITY_INHERIT( pxTCBOfMutexHolder, uxInheritedPriority )	\
+	vTraceRecorderWrite( eTraceTaskPriorityInherit, traceRECORDER_ID( pxTCBOfMutexHolder ), ( uxInheritedPriority ) )
+
+#define traceTASK_PRIORITY_DISINHERIT( pxTCBOfMutexHolder, uxOriginalPriority )	\
+	vTraceRecorderWrite( eTraceTaskPriorityDisinherit, traceRECORDER_ID( pxTCBOfMutexHolder ), ( uxOriginalPriority ) )
+
+#define traceTASK_INCREMENT_TICK( xTickCount )	\
+	vTraceRecorderWrite( eTraceTick, 0, ( xTickCount ) )
+
+#define traceINCREASE_TICK_COUNT( xTicksToJump )	\
+	vTraceRecorderWrite( eTraceIncreaseTickCount, 0, ( xTicksToJump ) )
+
+#define traceLOW_POWER_IDLE_BEGIN()	vTraceRecorderWrite( eTraceLowPowerIdleBegin, 0, 0 )
+#define traceLOW_POWER_IDLE_END()	vTraceRecorderWrite( eTraceLowPowerIdleEnd, 0, 0 )
+
+#define traceISR_ENTER( ulInterruptID )	vTraceRecorderWrite( eTraceISREnter, ( ulInterruptID ), 0 )
+#define traceISR_EXIT( ulInterruptID )	vTraceRecorderWrite( eTraceISRExit, ( ulInterruptID ), 0 )
+
+#define traceQUEUE_SEND( pxQueue )	\
+	vTraceRecorderWrite( eTraceQueueSend, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FAILED( pxQueue )	\
+	vTraceRecorderWrite( eTraceQueueSendFailed, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR( pxQueue )	\
+	vTraceRecorderWrite( eTraceQueueSendFromISR, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue )	\
+	vTraceRecorderWrite( eTraceQueueSendFromISRFailed, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE( pxQueue )	\
+	vTraceRecorderWrite( eTraceQueueReceive, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FAILED( pxQueue )	\
+	vTraceRecorderWrite( eTraceQueueReceiveFailed, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR( pxQueue )	\
+	vTraceRecorderWrite( eTraceQueueReceiveFromISR, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue )	\
+	vTraceRecorderWrite( eTraceQueueReceiveFromISRFailed, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceQUEUE_PEEK( pxQueue )	\
+	vTraceRecorderWrite( eTraceQueuePeek, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_SEND( pxQueue )	\
+	vTraceRecorderWrite( eTraceBlockingOnQueueSend, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue )	\
+	vTraceRecorderWrite( eTraceBlockingOnQueueReceive, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+#define traceBLOCKING_ON_QUEUE_PEEK( pxQueue )	\
+	vTraceRecorderWrite( eTraceBlockingOnQueuePeek, traceRECORDER_ID( pxQueue ), ( pxQueue )->uxMessagesWaiting )
+
+#define traceTASK_NOTIFY()	\
+	vTraceRecorderWrite( eTraceTaskNotify, traceRECORDER_ID( pxTCB ), 0 )
+#define traceTASK_NOTIFY_FROM_ISR()	\
+	vTraceRecorderWrite( eTraceTaskNotifyFromISR, traceRECORDER_ID( pxTCB ), 0 )
+#define traceTASK_NOTIFY_GIVE_FROM_ISR()	\
+	vTraceRecorderWrite( eTraceTaskNotifyGiveFromISR, traceRECORDER_ID( pxTCB ), 0 )
+#define traceTASK_NOTIFY_TAKE_BLOCK()	\
+	vTraceRecorderWrite( eTraceTaskNotifyTakeBlock, traceRECORDER_ID( pxCurrentTCB ), xTicksToWait )
+#define traceTASK_NOTIFY_WAIT_BLOCK()	\
+	vTraceRecorderWrite( eTraceTaskNotifyWaitBlock, traceRECORDER_ID( pxCurrentTCB ), xTicksToWait )
+
+#define traceEVENT_GROUP_WAIT_BITS_BLOCK( xEventGroup, uxBitsToWaitFor )	\
+	vTraceRecorderWrite( eTraceEventGroupWaitBitsBlock, traceRECORDER_ID( xEventGroup ), ( uxBitsToWaitFor ) )
+#define traceEVENT_GROUP_SYNC_BLOCK( xEventGroup, uxBitsToSet, uxBitsToWaitFor )	\
+	vTraceRecorderWrite( eTraceEventGroupSyncBlock, traceRECORDER_ID( xEventGroup ), ( uxBitsToWaitFor ) )
+#define traceEVENT_GROUP_SET_BITS( xEventGroup, uxBitsToSet )	\
+	vTraceRecorderWrite( eTraceEventGroupSetBits, traceRECORDER_ID( xEventGroup ), ( uxBitsToSet ) )
+#define traceEVENT_GROUP_SET_BITS_FROM_ISR( xEventGroup, uxBitsToSet )	\
+	vTraceRecorderWrite( eTraceEventGroupSetBitsFromISR, traceRECORDER_ID( xEventGroup ), ( uxBitsToSet ) )
+
+#define traceTIMER_EXPIRED( pxTimer )	\
+	vTraceRecorderWrite( eTraceTimerExpired, traceRECORDER_ID( pxTimer ), 0 )
+
+#endif /* FREERTOS_RING_TRACE_H */
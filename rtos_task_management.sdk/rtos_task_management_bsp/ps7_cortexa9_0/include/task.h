@@ -134,7 +134,7 @@ typedef struct xTASK_STATUS
 	eTaskState eCurrentState;		/* The state in which the task existed when the structure was populated. */
 	UBaseType_t uxCurrentPriority;	/* The priority at which the task was running (may be inherited) when the structure was populated. */
 	UBaseType_t uxBasePriority;		/* The priority to which the task will return if the task's current priority has been inherited to avoid unbounded priority inversion when obtaining a mutex.  Only valid if configUSE_MUTEXES is defined as 1 in FreeRTOSConfig.h. */
-	uint32_t ulRunTimeCounter;		/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
+	configRUN_TIME_COUNTER_TYPE ulRunTimeCounter;	/* The total run time allocated to the task so far, as defined by the run time stats clock.  See http://www.freertos.org/rtos-run-time-stats.html.  Only valid when configGENERATE_RUN_TIME_STATS is defined as 1 in FreeRTOSConfig.h. */
 	StackType_t *pxStackBase;		/* Points to the lowest address of the task's stack area. */
 	configSTACK_DEPTH_TYPE usStackHighWaterMark;	/* The minimum amount of stack space that has remained for the task since the task was created.  The closer this value is to zero the closer the task has come to overflowing its stack. */
 } TaskStatus_t;
@@ -154,6 +154,16 @@ typedef enum
  */
 #define tskIDLE_PRIORITY			( ( UBaseType_t ) 0U )
 
+/**
+ * The core affinity mask of a task that may run on any core.  A task is created
+ * with this mask.
+ *
+ * \ingroup TaskUtils
+ */
+#if ( configNUMBER_OF_CORES > 1 )
+	#define tskNO_AFFINITY			( ( UBaseType_t ) -1 )
+#endif
+
 /**
  * task. h
  *
@@ -176,8 +186,16 @@ typedef enum
  * \defgroup taskENTER_CRITICAL taskENTER_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskENTER_CRITICAL()		portENTER_CRITICAL()
-#define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#if ( configNUMBER_OF_CORES == 1 )
+	#define taskENTER_CRITICAL()		portENTER_CRITICAL()
+	#define taskENTER_CRITICAL_FROM_ISR() portSET_INTERRUPT_MASK_FROM_ISR()
+#else
+	/* With more than one core, masking interrupts only keeps out the
+	interrupts of the calling core, so a critical section also takes the
+	kernel locks. */
+	#define taskENTER_CRITICAL()		vTaskEnterCritical()
+	#define taskENTER_CRITICAL_FROM_ISR() uxTaskEnterCriticalFromISR()
+#endif
 
 /**
  * task. h
@@ -191,8 +209,14 @@ typedef enum
  * \defgroup taskEXIT_CRITICAL taskEXIT_CRITICAL
  * \ingroup SchedulerControl
  */
-#define taskEXIT_CRITICAL()			portEXIT_CRITICAL()
-#define taskEXIT_CRITICAL_FROM_ISR( x ) portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#if ( configNUMBER_OF_CORES == 1 )
+	#define taskEXIT_CRITICAL()			portEXIT_CRITICAL()
+	#define taskEXIT_CRITICAL_FROM_ISR( x ) portCLEAR_INTERRUPT_MASK_FROM_ISR( x )
+#else
+	#define taskEXIT_CRITICAL()			vTaskExitCritical()
+	#define taskEXIT_CRITICAL_FROM_ISR( x ) vTaskExitCriticalFromISR( x )
+#endif
+
 /**
  * task. h
  *
@@ -1484,6 +1508,48 @@ BaseType_t xTaskCallApplicationTaskHook( TaskHandle_t xTask, void *pvParameter )
  */
 TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+	/**
+	 * Only available when configNUMBER_OF_CORES is greater than 1.
+	 *
+	 * Returns the handle of the idle task created for core xCoreID.  Each core
+	 * has an idle task of its own, which only runs on that core.
+	 * xTaskGetIdleTaskHandle() returns that of core 0.
+	 */
+	TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * Only available when configNUMBER_OF_CORES is greater than 1.
+	 *
+	 * Returns the handle of the task running on core xCoreID.
+	 */
+	TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * Only available when configNUMBER_OF_CORES is greater than 1.
+	 *
+	 * Sets the cores xTask may run on, as a mask with bit n set for core n.
+	 * Passing xTask as NULL sets the mask of the calling task.  A task running
+	 * on a core its new mask leaves out is moved off it at once.  Tasks are
+	 * created with the mask tskNO_AFFINITY, to run on any core.
+	 *
+	 * Example usage, to keep a task on core 1:
+	 *
+	 * vTaskCoreAffinitySet( xHandle, ( 1 << 1 ) );
+	 */
+	void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask ) PRIVILEGED_FUNCTION;
+
+	/**
+	 * Only available when configNUMBER_OF_CORES is greater than 1.
+	 *
+	 * Returns the core affinity mask of xTask, or of the calling task if xTask
+	 * is NULL.
+	 */
+	UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
 /**
  * configUSE_TRACE_FACILITY must be defined as 1 in FreeRTOSConfig.h for
  * uxTaskGetSystemState() to be available.
@@ -1511,7 +1577,9 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
  * FreeRTOSConfig.h then *pulTotalRunTime is set by uxTaskGetSystemState() to the
  * total run time (as defined by the run time stats clock, see
  * http://www.freertos.org/rtos-run-time-stats.html) since the target booted.
- * pulTotalRunTime can be set to NULL to omit the total run time information.
+ * pulTotalRunTime can be set to NULL to omit the total run time information.  The
+ * counters are of configRUN_TIME_COUNTER_TYPE, uint32_t unless
+ * FreeRTOSConfig.h sets it.
  *
  * @return The number of TaskStatus_t structures that were populated by
  * uxTaskGetSystemState().  This should equal the number returned by the
@@ -1581,7 +1649,7 @@ TaskHandle_t xTaskGetIdleTaskHandle( void ) PRIVILEGED_FUNCTION;
 	}
 	</pre>
  */
-UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
+UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime ) PRIVILEGED_FUNCTION;
 
 /**
  * task. h
@@ -2220,7 +2288,9 @@ void vTaskRemoveFromUnorderedEventList( ListItem_t * pxEventListItem, const Tick
  * AN INTERFACE WHICH IS FOR THE EXCLUSIVE USE OF THE SCHEDULER.
  *
  * Sets the pointer to the current TCB to the TCB of the highest priority task
- * that is ready to run.
+ * that is ready to run.  With more than one core, it sets that of the calling
+ * core, which must have its interrupts masked, to the highest priority task
+ * that is ready to run on it and not running on another core.
  */
 void vTaskSwitchContext( void ) PRIVILEGED_FUNCTION;
 
@@ -2329,6 +2399,29 @@ TaskHandle_t pvTaskIncrementMutexHeldCount( void ) PRIVILEGED_FUNCTION;
  */
 void vTaskInternalSetTimeOutState( TimeOut_t * const pxTimeOut ) PRIVILEGED_FUNCTION;
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+	/*
+	 * For internal use only.  The critical sections of the kernel with more
+	 * than one core, behind taskENTER_CRITICAL() and taskEXIT_CRITICAL() and
+	 * their FromISR versions.  Each masks the interrupts of the calling core
+	 * and holds the kernel locks until the outermost exit.
+	 */
+	void vTaskEnterCritical( void ) PRIVILEGED_FUNCTION;
+	void vTaskExitCritical( void ) PRIVILEGED_FUNCTION;
+	UBaseType_t uxTaskEnterCriticalFromISR( void ) PRIVILEGED_FUNCTION;
+	void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * For internal use only.  portYIELD_WITHIN_API() with more than one core.
+	 * Inside a critical section the yield is held pending until the critical
+	 * section is exited, as a task must not be switched out holding the kernel
+	 * locks.
+	 */
+	void vTaskYieldWithinAPI( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
 
 #ifdef __cplusplus
 }
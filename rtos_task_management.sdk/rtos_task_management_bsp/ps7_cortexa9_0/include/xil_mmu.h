@@ -46,6 +46,8 @@
 *					  u32 which resolves issue of CR#805869
 * 5.4	pkp	 23/11/15 Added attribute definitions for Xil_SetTlbAttributes API
 * 6.8   aru  09/06/18 Removed compilation warnings for ARMCC toolchain.
+* 7.0   ld   10/17/26 Added Xil_SetTlbPageAttributes for 4KB pages, and the
+*		      attribute definitions for it
 * </pre>
 *
 *
@@ -87,11 +89,16 @@ extern "C" {
 /* Execution type */
 #define EXECUTE_NEVER ((0x1 << 4) | (0x1 << 0))
 
+/* Page attributes, for Xil_SetTlbPageAttributes */
+#define PAGE_NORM_WB_CACHE 0x576	/* Normal write back cacheable shareable */
+#define PAGE_NO_ACCESS 0x0		/* Generates a translation fault if accessed */
+
 /************************** Variable Definitions *****************************/
 
 /************************** Function Prototypes ******************************/
 
 void Xil_SetTlbAttributes(INTPTR Addr, u32 attrib);
+s32 Xil_SetTlbPageAttributes(INTPTR Addr, u32 attrib);
 void Xil_EnableMMU(void);
 void Xil_DisableMMU(void);
 void* Xil_MemMap(UINTPTR PhysAddr, size_t size, u32 flags);
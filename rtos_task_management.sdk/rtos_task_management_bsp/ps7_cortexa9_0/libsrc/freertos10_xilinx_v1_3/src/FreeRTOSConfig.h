@@ -46,7 +46,7 @@
 
 #define configUSE_IDLE_HOOK 0
 
-#define configUSE_TICK_HOOK 0
+#define configUSE_TICK_HOOK 1
 
 #define configUSE_DAEMON_TASK_STARTUP_HOOK 0
 
@@ -56,11 +56,11 @@
 
 #define configUSE_NEWLIB_REENTRANT 0
 
-#define configSTREAM_BUFFER 0
+#define configSTREAM_BUFFER 1
 
-#define configMESSAGE_BUFFER 0
+#define configMESSAGE_BUFFER 1
 
-#define configSUPPORT_STATIC_ALLOCATION 0
+#define configSUPPORT_STATIC_ALLOCATION 1
 
 #define configUSE_16_BIT_TICKS 0
 
@@ -96,9 +96,11 @@
 
 #define configUSE_TASK_NOTIFICATIONS 1
 
-#define configCHECK_FOR_STACK_OVERFLOW 2
+#define configUSE_STACK_GUARD_PAGES	1	/* a no-access MMU page below each task stack, see static_alloc.h */
+#define configCHECK_FOR_STACK_OVERFLOW ( ( configUSE_STACK_GUARD_PAGES == 1 ) ? 0 : 2 )
 
 #define configUSE_TASK_FPU_SUPPORT 1
+#define configUSE_TASK_FPU_LAZY	( configNUMBER_OF_CORES == 1 )	/* lazy FPU switching needs one core */
 
 #define configQUEUE_REGISTRY_SIZE 10
 
@@ -106,13 +108,22 @@
 
 #define configNUM_THREAD_LOCAL_STORAGE_POINTERS 0
 
-#define configGENERATE_RUN_TIME_STATS 0
+#define configGENERATE_RUN_TIME_STATS 1
 
-#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
+#define portCONFIGURE_TIMER_FOR_RUN_TIME_STATS() xCONFIGURE_TIMER_FOR_RUN_TIME_STATS()
 
-#define portGET_RUN_TIME_COUNTER_VALUE()
+#define portGET_RUN_TIME_COUNTER_VALUE() xGET_RUN_TIME_COUNTER_VALUE()
+
+#define configRUN_TIME_COUNTER_TYPE	uint64_t
 
 #define configUSE_TICKLESS_IDLE	0
+#define configUSE_DELAY_WHEEL	0
+#define configUSE_TRACE_RECORDER	0
+#define configUSE_HEAP_TLSF	0
+#define configUSE_HEAP_REGIONS	0	/* the OCM and DDR regions of lscript.ld, see heap_regions.h */
+#define configUSE_MEM_POOLS	1
+#define configUSE_STREAM_BUFFER_REGIONS	1
+#define configNUMBER_OF_CORES	1
 #define configTASK_RETURN_ADDRESS    NULL
 #define INCLUDE_vTaskPrioritySet             1
 #define INCLUDE_uxTaskPriorityGet            1
@@ -135,11 +146,13 @@
 #define configINTERRUPT_CONTROLLER_BASE_ADDRESS         ( XPAR_PS7_SCUGIC_0_DIST_BASEADDR )
 #define configINTERRUPT_CONTROLLER_CPU_INTERFACE_OFFSET ( -0xf00 )
 #define configUNIQUE_INTERRUPT_PRIORITIES                32
+/* portASM.S includes this file for configNUMBER_OF_CORES. */
+#ifndef __ASSEMBLER__
 void vApplicationAssert( const char *pcFile, uint32_t ulLine );
 void FreeRTOS_SetupTickInterrupt( void );
-#define configSETUP_TICK_INTERRUPT() FreeRTOS_SetupTickInterrupt()
-
 void FreeRTOS_ClearTickInterrupt( void );
+#endif
+#define configSETUP_TICK_INTERRUPT() FreeRTOS_SetupTickInterrupt()
 #define configCLEAR_TICK_INTERRUPT()	FreeRTOS_ClearTickInterrupt()
 
 #define portSET_INTERRUPT_MASK_FROM_ISR()	ulPortSetInterruptMask()
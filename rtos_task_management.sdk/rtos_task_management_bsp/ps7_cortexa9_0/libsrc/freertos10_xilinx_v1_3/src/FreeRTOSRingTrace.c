@@ -0,0 +1,203 @@
+/*
+ * FreeRTOS Kernel V10.0.0
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <string.h>
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+#if( configUSE_TRACE_RECORDER == 1 )
+
+/* Xilinx includes. */
+#include "xtime_l.h"
+
+/* The bytes of one line of a dump. */
+#define traceDUMP_LINE_BYTES	( 16 )
+
+/*
+ * Send one line of a dump, as the hex of the traceDUMP_LINE_BYTES bytes at
+ * pvLine, in the order they are in memory.
+ */
+static void prvTraceDumpLine( TraceRecorderPutChar_t pxPutChar, const void *pvLine );
+
+/*
+ * Send a string, without its terminator.
+ */
+static void prvTraceDumpString( TraceRecorderPutChar_t pxPutChar, const char *pcString );
+
+/*-----------------------------------------------------------*/
+
+/* The ring of records, and the number of records claimed since the start.  The
+record claimed is the number modulo the size of the ring. */
+static TraceRecord_t xTraceRing[ configTRACE_RECORDER_SIZE ];
+static volatile uint32_t ulTraceHead = 0UL;
+
+/* Whether events are recorded. */
+static volatile BaseType_t xTraceRunning = pdTRUE;
+
+/* The names of the tasks created, kept whether or not events are recorded. */
+static TraceTaskName_t xTraceTaskNames[ configTRACE_RECORDER_MAX_TASKS ];
+static uint32_t ulTraceTasks = 0UL;
+
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStart( void )
+{
+	taskENTER_CRITICAL();
+	{
+		ulTraceHead = 0UL;
+		xTraceRunning = pdTRUE;
+	}
+	taskEXIT_CRITICAL();
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderStop( void )
+{
+	xTraceRunning = pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderWrite( uint32_t ulEvent, uint32_t ulObject, uint32_t ulValue )
+{
+uint32_t ulIndex;
+TraceRecord_t *pxRecord;
+
+	if( xTraceRunning != pdFALSE )
+	{
+		/* Claim the next record.  An interrupt nested between the claim and the
+		timestamp writes its own record, stamped earlier than this one, so the
+		decoder orders the records by their timestamps. */
+		ulIndex = __atomic_fetch_add( &ulTraceHead, 1UL, __ATOMIC_RELAXED );
+		pxRecord = &( xTraceRing[ ulIndex & ( configTRACE_RECORDER_SIZE - 1UL ) ] );
+
+		pxRecord->ulTimestamp = portGET_TRACE_TIMESTAMP();
+		pxRecord->ulEvent = ulEvent;
+		pxRecord->ulObject = ulObject;
+		pxRecord->ulValue = ulValue;
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderTaskCreated( uint32_t ulTask, const char *pcName, uint32_t ulPriority )
+{
+uint32_t ulIndex;
+
+	/* Called from the critical section that adds the task to the ready list,
+	so the table needs no other protection.  A task created with the TCB of
+	one deleted takes over its entry. */
+	for( ulIndex = 0UL; ulIndex < ulTraceTasks; ulIndex++ )
+	{
+		if( xTraceTaskNames[ ulIndex ].ulTask == ulTask )
+		{
+			break;
+		}
+	}
+
+	if( ulIndex < configTRACE_RECORDER_MAX_TASKS )
+	{
+		xTraceTaskNames[ ulIndex ].ulTask = ulTask;
+		strncpy( xTraceTaskNames[ ulIndex ].cName, pcName, traceRECORDER_NAME_LEN - 1 );
+		xTraceTaskNames[ ulIndex ].cName[ traceRECORDER_NAME_LEN - 1 ] = '\0';
+
+		if( ulIndex == ulTraceTasks )
+		{
+			ulTraceTasks++;
+		}
+	}
+
+	vTraceRecorderWrite( eTraceTaskCreate, ulTask, ulPriority );
+}
+/*-----------------------------------------------------------*/
+
+void vTraceRecorderDump( TraceRecorderPutChar_t pxPutChar )
+{
+TraceDumpHeader_t xHeader;
+uint32_t ulHead, ulFirst, ulIndex;
+
+	configASSERT( sizeof( TraceRecord_t ) == traceDUMP_LINE_BYTES );
+	configASSERT( sizeof( TraceTaskName_t ) == traceDUMP_LINE_BYTES );
+	configASSERT( sizeof( TraceDumpHeader_t ) == ( 2 * traceDUMP_LINE_BYTES ) );
+
+	/* An event claimed before the stop may still be written part way through
+	the dump, into the oldest record sent. */
+	vTraceRecorderStop();
+	ulHead = ulTraceHead;
+	ulFirst = ( ulHead > configTRACE_RECORDER_SIZE ) ? ( ulHead - configTRACE_RECORDER_SIZE ) : 0UL;
+
+	memset( &xHeader, 0x00, sizeof( xHeader ) );
+	xHeader.ulMagic = traceRECORDER_MAGIC;
+	xHeader.usVersion = traceRECORDER_VERSION;
+	xHeader.usRecordSize = ( uint16_t ) sizeof( TraceRecord_t );
+	xHeader.ulTimestampHz = ( uint32_t ) COUNTS_PER_SECOND;
+	xHeader.ulTasks = ulTraceTasks;
+	xHeader.ulRecords = ulHead - ulFirst;
+	xHeader.ulLost = ulFirst;
+
+	prvTraceDumpString( pxPutChar, "\r\n" traceRECORDER_BEGIN "\r\n" );
+	prvTraceDumpLine( pxPutChar, &xHeader );
+	prvTraceDumpLine( pxPutChar, ( ( const uint8_t * ) &xHeader ) + traceDUMP_LINE_BYTES );
+
+	for( ulIndex = 0UL; ulIndex < xHeader.ulTasks; ulIndex++ )
+	{
+		prvTraceDumpLine( pxPutChar, &( xTraceTaskNames[ ulIndex ] ) );
+	}
+
+	for( ulIndex = ulFirst; ulIndex != ulHead; ulIndex++ )
+	{
+		prvTraceDumpLine( pxPutChar, &( xTraceRing[ ulIndex & ( configTRACE_RECORDER_SIZE - 1UL ) ] ) );
+	}
+
+	prvTraceDumpString( pxPutChar, traceRECORDER_END "\r\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTraceDumpLine( TraceRecorderPutChar_t pxPutChar, const void *pvLine )
+{
+static const char cHexDigits[] = "0123456789abcdef";
+const uint8_t *pucByte = ( const uint8_t * ) pvLine;
+UBaseType_t uxByte;
+
+	for( uxByte = 0; uxByte < traceDUMP_LINE_BYTES; uxByte++ )
+	{
+		pxPutChar( cHexDigits[ pucByte[ uxByte ] >> 4 ] );
+		pxPutChar( cHexDigits[ pucByte[ uxByte ] & 0x0fU ] );
+	}
+
+	prvTraceDumpString( pxPutChar, "\r\n" );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTraceDumpString( TraceRecorderPutChar_t pxPutChar, const char *pcString )
+{
+	while( *pcString != '\0' )
+	{
+		pxPutChar( *pcString );
+		pcString++;
+	}
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_TRACE_RECORDER */
@@ -32,6 +32,7 @@
  *
  * See heap_1.c, heap_2.c and heap_3.c for alternative implementations, and the
  * memory management pages of http://www.FreeRTOS.org for more information.
+ * heap_tlsf.c is built in place of this file when configUSE_HEAP_TLSF is 1.
  */
 #include <stdlib.h>
 
@@ -45,6 +46,8 @@ task.h is included from an application file. */
 
 #undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
 
+#if( configUSE_HEAP_TLSF == 0 )
+
 #if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
 	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
 #endif
@@ -320,6 +323,37 @@ size_t xPortGetMinimumEverFreeHeapSize( void )
 }
 /*-----------------------------------------------------------*/
 
+size_t xPortGetHeapFragmentation( void )
+{
+BlockLink_t *pxBlock;
+size_t xLargest = 0U, xFragmentation = 0U;
+
+	vTaskSuspendAll();
+	{
+		/* The free list is walked for its largest block. */
+		if( ( pxEnd != NULL ) && ( xFreeBytesRemaining != 0U ) )
+		{
+			for( pxBlock = xStart.pxNextFreeBlock; pxBlock != pxEnd; pxBlock = pxBlock->pxNextFreeBlock )
+			{
+				if( pxBlock->xBlockSize > xLargest )
+				{
+					xLargest = pxBlock->xBlockSize;
+				}
+			}
+
+			xFragmentation = 100U - ( ( xLargest * 100U ) / xFreeBytesRemaining );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return xFragmentation;
+}
+/*-----------------------------------------------------------*/
+
 void vPortInitialiseBlocks( void )
 {
 	/* This just exists to keep the linker quiet. */
@@ -434,3 +468,4 @@ uint8_t *puc;
 	}
 }
 
+#endif /* configUSE_HEAP_TLSF */
@@ -0,0 +1,860 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * An implementation of pvPortMalloc() and vPortFree() with a two level
+ * segregated fit (TLSF) of the free blocks, as an alternative to the first fit
+ * of heap_4.c.  Set configUSE_HEAP_TLSF to 1 to build it in place of heap_4.c.
+ *
+ * The free blocks are kept in a list for each range of sizes.  The first level
+ * splits the sizes by powers of two, and the second splits each power of two
+ * into heapSL_INDEX_COUNT equal ranges.  A bitmap of the lists that are not
+ * empty is kept for each level, so a list with a block of at least the wanted
+ * size is found with two bit scans, whatever the number of free blocks.  Each
+ * block also records the block before it in memory, so a freed block is merged
+ * with the free blocks either side of it without walking a list.  Both
+ * pvPortMalloc() and vPortFree() so take a time that is bounded and does not
+ * grow with the fragmentation of the heap.
+ *
+ * The wanted size is rounded up to the start of the next range before the
+ * search, so the first block of the list found is always large enough.  A
+ * block can so be left unused in the range below when a block of a size in
+ * that range would have fitted.  Only when nothing larger is free is the first
+ * block of the range of the wanted size checked as well, so no list is ever
+ * searched.
+ *
+ * With configUSE_HEAP_REGIONS set to 1 the heap is made of up to
+ * configHEAP_REGIONS_MAX regions of memory, passed to vPortDefineHeapRegions()
+ * before the first allocation, instead of ucHeap.  Each region has free lists
+ * of its own, so a block is always allocated whole from one region.  The
+ * regions are passed fastest first.  pvPortMallocHint() with eHeapFast tries
+ * them in that order, and with eHeapBulk in the reverse order, so each falls
+ * back to the other regions once its own is full.  pvPortMalloc() is
+ * eHeapFast, as most of its callers are kernel objects.  A freed block is
+ * returned to the region that holds its address, found by comparing it with
+ * the bounds of each region.  vPortGetHeapRegionStats() reports the use of
+ * each region.
+ *
+ * See heap_4.c for the first fit, and the memory management pages of
+ * http://www.FreeRTOS.org for more information.
+ */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#include "FreeRTOS.h"
+#include "task.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configUSE_HEAP_TLSF == 1 )
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 0 )
+	#error This file must not be used if configSUPPORT_DYNAMIC_ALLOCATION is 0
+#endif
+
+/* The log2 of portBYTE_ALIGNMENT, the size of the smallest range. */
+#if portBYTE_ALIGNMENT == 16
+	#define heapALIGNMENT_LOG2	4
+#elif portBYTE_ALIGNMENT == 8
+	#define heapALIGNMENT_LOG2	3
+#elif portBYTE_ALIGNMENT == 4
+	#define heapALIGNMENT_LOG2	2
+#else
+	#error heap_tlsf.c needs a portBYTE_ALIGNMENT of 4, 8 or 16
+#endif
+
+/* Each power of two is split into heapSL_INDEX_COUNT ranges. */
+#define heapSL_INDEX_COUNT_LOG2	4
+#define heapSL_INDEX_COUNT		( 1U << heapSL_INDEX_COUNT_LOG2 )
+
+/* The blocks below heapSMALL_BLOCK_SIZE all go in the first list of the first
+level, which is split into ranges of portBYTE_ALIGNMENT. */
+#define heapFL_INDEX_SHIFT		( heapSL_INDEX_COUNT_LOG2 + heapALIGNMENT_LOG2 )
+#define heapSMALL_BLOCK_SIZE	( ( size_t ) 1 << heapFL_INDEX_SHIFT )
+
+/* The largest block is below 2 to the power of heapFL_INDEX_MAX + 1, 32MB,
+which each region must be below. */
+#define heapFL_INDEX_MAX		24
+#define heapFL_INDEX_COUNT		( heapFL_INDEX_MAX - heapFL_INDEX_SHIFT + 2 )
+#define heapMAXIMUM_BLOCK_SIZE	( ( ( size_t ) 1 << ( heapFL_INDEX_MAX + 1 ) ) - 1 )
+
+/* Set in the xBlockSize member of a BlockLink_t structure while the block is
+free.  The sizes are multiples of portBYTE_ALIGNMENT, so the bit is not part of
+the size. */
+#define heapBLOCK_FREE_BIT		( ( size_t ) 1 )
+#define heapBLOCK_SIZE( pxBlock )	( ( pxBlock )->xBlockSize & ~heapBLOCK_FREE_BIT )
+#define heapBLOCK_IS_FREE( pxBlock )	( ( ( pxBlock )->xBlockSize & heapBLOCK_FREE_BIT ) != 0 )
+
+/* The index of the highest and the lowest bit set in a non zero value. */
+#define heapFLS( ulValue )		( 31U - ( uint32_t ) __builtin_clz( ( uint32_t ) ( ulValue ) ) )
+#define heapFFS( ulValue )		( ( uint32_t ) __builtin_ctz( ( uint32_t ) ( ulValue ) ) )
+
+/* Block sizes must not get too small. */
+#define heapMINIMUM_BLOCK_SIZE	( xHeapBlockSize )
+
+#if( configUSE_HEAP_REGIONS == 1 )
+	/* The regions are passed to vPortDefineHeapRegions(). */
+	#define heapREGIONS			configHEAP_REGIONS_MAX
+#else
+	/* Allocate the memory for the heap. */
+	#define heapREGIONS			1
+	#if( configAPPLICATION_ALLOCATED_HEAP == 1 )
+		/* The application writer has already defined the array used for the RTOS
+		heap - probably so it can be placed in a special segment or address. */
+		extern uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#else
+		static uint8_t ucHeap[ configTOTAL_HEAP_SIZE ];
+	#endif /* configAPPLICATION_ALLOCATED_HEAP */
+#endif /* configUSE_HEAP_REGIONS */
+
+/* The header of every block.  The links of the free list only exist while the
+block is free, and take the place of the memory returned by pvPortMalloc(). */
+typedef struct A_BLOCK_LINK
+{
+	struct A_BLOCK_LINK *pxPrevPhysBlock;	/*<< The block before this one in memory, or NULL for the first. */
+	size_t xBlockSize;						/*<< The size of the block, header included, and heapBLOCK_FREE_BIT. */
+	struct A_BLOCK_LINK *pxNextFreeBlock;	/*<< The next free block in the list of its range. */
+	struct A_BLOCK_LINK *pxPrevFreeBlock;	/*<< The previous free block in the list of its range. */
+} BlockLink_t;
+
+/* The free lists of a region, and its use. */
+typedef struct A_HEAP_REGION
+{
+	uint32_t ulFirstLevelMap;				/*<< The bitmap of the first level lists that are not empty. */
+	uint32_t ulSecondLevelMap[ heapFL_INDEX_COUNT ];	/*<< The bitmaps of the second level lists of each. */
+	BlockLink_t *pxFreeLists[ heapFL_INDEX_COUNT ][ heapSL_INDEX_COUNT ];	/*<< The lists. */
+	BlockLink_t *pxEnd;						/*<< Marks the end of the region.  It is never free, so no block is merged past it. */
+	uint8_t *pucStart;						/*<< The first block of the region. */
+	size_t xTotalBytes;						/*<< The bytes of the region that can be allocated. */
+	size_t xFreeBytesRemaining;				/*<< The free bytes of the region. */
+	size_t xMinimumEverFreeBytesRemaining;	/*<< The fewest free bytes the region has had. */
+	size_t xAllocations;					/*<< The successful allocations from the region. */
+	size_t xFrees;							/*<< The frees to the region. */
+} HeapControl_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Allocate a block of xWantedSize bytes, header included, from a region, or
+ * return NULL.
+ */
+static void *prvAllocateFromRegion( HeapControl_t *pxHeap, size_t xWantedSize );
+
+/*
+ * The region that holds a block, or NULL.
+ */
+static HeapControl_t *prvRegionOf( const BlockLink_t *pxBlock );
+
+/*
+ * The largest free block of a region, which is in the highest list that is not
+ * empty, the only list walked.
+ */
+static size_t prvLargestFreeBlock( const HeapControl_t *pxHeap );
+
+/*
+ * The list of the range that holds a block of xBlockSize bytes.
+ */
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFirst, UBaseType_t *puxSecond );
+
+/*
+ * The first list that is not empty, and that only holds blocks of at least
+ * xWantedSize bytes, or NULL if there is none.  The wanted size must have been
+ * rounded up by the caller.
+ */
+static BlockLink_t *prvFindSuitableBlock( HeapControl_t *pxHeap, size_t xWantedSize );
+
+/*
+ * The first block of the list that holds blocks of xWantedSize bytes, if it is
+ * at least that large, or NULL.
+ */
+static BlockLink_t *prvFindExactBlock( HeapControl_t *pxHeap, size_t xWantedSize );
+
+/*
+ * Add a free block to, and remove it from, the list of its range.
+ */
+static void prvInsertFreeBlock( HeapControl_t *pxHeap, BlockLink_t *pxBlock );
+static void prvRemoveFreeBlock( HeapControl_t *pxHeap, BlockLink_t *pxBlock );
+
+/*
+ * The block after this one in memory.
+ */
+static BlockLink_t *prvNextPhysBlock( BlockLink_t *pxBlock );
+
+/*
+ * Set up the free lists of a region of xTotalHeapSize bytes at pucStart.
+ */
+static void prvHeapRegionInit( HeapControl_t *pxHeap, uint8_t *pucStart, size_t xTotalHeapSize );
+
+#if( configUSE_HEAP_REGIONS == 0 )
+	/*
+	 * Called automatically to setup the required heap structures the first
+	 * time pvPortMalloc() is called.
+	 */
+	static void prvHeapInit( void );
+#endif
+
+/*-----------------------------------------------------------*/
+
+/* The size of the header placed at the beginning of each allocated memory
+block, which holds the first two members of the BlockLink_t structure, and the
+size of the smallest block, which holds all of them.  Both must be correctly
+byte aligned. */
+static const size_t xHeapStructSize	= ( offsetof( BlockLink_t, pxNextFreeBlock ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+static const size_t xHeapBlockSize	= ( sizeof( BlockLink_t ) + ( ( size_t ) ( portBYTE_ALIGNMENT - 1 ) ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+
+/* The regions, fastest first, and how many are set up. */
+static HeapControl_t xHeapRegions[ heapREGIONS ];
+static UBaseType_t uxHeapRegionCount = 0U;
+
+/* Keeps track of the number of free bytes remaining in all the regions, but
+says nothing about fragmentation. */
+static size_t xFreeBytesRemaining = 0U;
+static size_t xMinimumEverFreeBytesRemaining = 0U;
+
+/*-----------------------------------------------------------*/
+
+void *pvPortMalloc( size_t xWantedSize )
+{
+	return pvPortMallocHint( xWantedSize, eHeapFast );
+}
+/*-----------------------------------------------------------*/
+
+void *pvPortMallocHint( size_t xWantedSize, eHeapHint eHint )
+{
+UBaseType_t uxIndex, uxRegion;
+void *pvReturn = NULL;
+
+	vTaskSuspendAll();
+	{
+		#if( configUSE_HEAP_REGIONS == 1 )
+		{
+			/* The regions must have been defined before the first call. */
+			configASSERT( uxHeapRegionCount != 0U );
+		}
+		#else
+		{
+			/* If this is the first call to malloc then the heap will require
+			initialisation to setup the free lists. */
+			if( uxHeapRegionCount == 0U )
+			{
+				prvHeapInit();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif
+
+		/* Check the requested block size is not so large that no list could
+		hold it, which also keeps the sums below from overflowing. */
+		if( ( xWantedSize > 0 ) && ( xWantedSize <= ( heapMAXIMUM_BLOCK_SIZE - xHeapBlockSize ) ) )
+		{
+			/* The wanted size is increased so it can contain the header in
+			addition to the requested amount of bytes, and is always aligned
+			to the required number of bytes. */
+			xWantedSize += xHeapStructSize;
+			xWantedSize = ( xWantedSize + portBYTE_ALIGNMENT_MASK ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+			if( xWantedSize < heapMINIMUM_BLOCK_SIZE )
+			{
+				xWantedSize = heapMINIMUM_BLOCK_SIZE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Each region is tried in the order of the hint, until one has a
+			block. */
+			for( uxIndex = 0U; ( uxIndex < uxHeapRegionCount ) && ( pvReturn == NULL ); uxIndex++ )
+			{
+				uxRegion = ( eHint == eHeapBulk ) ? ( uxHeapRegionCount - 1U - uxIndex ) : uxIndex;
+				pvReturn = prvAllocateFromRegion( &xHeapRegions[ uxRegion ], xWantedSize );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		traceMALLOC( pvReturn, xWantedSize );
+	}
+	( void ) xTaskResumeAll();
+
+	#if( configUSE_MALLOC_FAILED_HOOK == 1 )
+	{
+		if( pvReturn == NULL )
+		{
+			extern void vApplicationMallocFailedHook( void );
+			vApplicationMallocFailedHook();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif
+
+	configASSERT( ( ( ( size_t ) pvReturn ) & ( size_t ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	return pvReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vPortFree( void *pv )
+{
+uint8_t *puc = ( uint8_t * ) pv;
+BlockLink_t *pxLink, *pxNeighbour;
+HeapControl_t *pxHeap;
+
+	if( pv != NULL )
+	{
+		/* The memory being freed will have a header immediately before it.
+		This casting is to keep the compiler from issuing warnings. */
+		puc -= xHeapStructSize;
+		pxLink = ( void * ) puc;
+
+		/* Check the block is actually allocated, from one of the regions. */
+		pxHeap = prvRegionOf( pxLink );
+		configASSERT( pxHeap != NULL );
+		configASSERT( heapBLOCK_IS_FREE( pxLink ) == pdFALSE );
+
+		if( ( pxHeap != NULL ) && ( heapBLOCK_IS_FREE( pxLink ) == pdFALSE ) )
+		{
+			vTaskSuspendAll();
+			{
+				pxHeap->xFreeBytesRemaining += pxLink->xBlockSize;
+				pxHeap->xFrees++;
+				xFreeBytesRemaining += pxLink->xBlockSize;
+				traceFREE( pv, pxLink->xBlockSize );
+
+				/* Merge the block with the block after it, if that is free. */
+				pxNeighbour = prvNextPhysBlock( pxLink );
+				if( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE )
+				{
+					prvRemoveFreeBlock( pxHeap, pxNeighbour );
+					pxLink->xBlockSize += heapBLOCK_SIZE( pxNeighbour );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* And into the block before it, if that is free. */
+				pxNeighbour = pxLink->pxPrevPhysBlock;
+				if( ( pxNeighbour != NULL ) && ( heapBLOCK_IS_FREE( pxNeighbour ) != pdFALSE ) )
+				{
+					prvRemoveFreeBlock( pxHeap, pxNeighbour );
+					pxNeighbour->xBlockSize = heapBLOCK_SIZE( pxNeighbour ) + pxLink->xBlockSize;
+					pxLink = pxNeighbour;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				/* The block is being returned to the heap - it is no longer
+				allocated. */
+				prvNextPhysBlock( pxLink )->pxPrevPhysBlock = pxLink;
+				prvInsertFreeBlock( pxHeap, pxLink );
+			}
+			( void ) xTaskResumeAll();
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetFreeHeapSize( void )
+{
+	return xFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetMinimumEverFreeHeapSize( void )
+{
+	return xMinimumEverFreeBytesRemaining;
+}
+/*-----------------------------------------------------------*/
+
+size_t xPortGetHeapFragmentation( void )
+{
+UBaseType_t uxRegion;
+size_t xLargest = 0U, xFragmentation = 0U;
+
+	vTaskSuspendAll();
+	{
+		/* A block is never allocated across regions, so each region that is
+		one free block counts as not fragmented. */
+		for( uxRegion = 0U; uxRegion < uxHeapRegionCount; uxRegion++ )
+		{
+			xLargest += prvLargestFreeBlock( &xHeapRegions[ uxRegion ] );
+		}
+
+		if( xFreeBytesRemaining != 0U )
+		{
+			xFragmentation = 100U - ( ( xLargest * 100U ) / xFreeBytesRemaining );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	( void ) xTaskResumeAll();
+
+	return xFragmentation;
+}
+/*-----------------------------------------------------------*/
+
+void vPortInitialiseBlocks( void )
+{
+	/* This just exists to keep the linker quiet. */
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_HEAP_REGIONS == 1 )
+
+	void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions )
+	{
+	const HeapRegion_t *pxHeapRegion;
+
+		/* Can only call once! */
+		configASSERT( uxHeapRegionCount == 0U );
+
+		for( pxHeapRegion = pxHeapRegions; pxHeapRegion->xSizeInBytes > 0; pxHeapRegion++ )
+		{
+			configASSERT( uxHeapRegionCount < configHEAP_REGIONS_MAX );
+			if( uxHeapRegionCount < configHEAP_REGIONS_MAX )
+			{
+				prvHeapRegionInit( &xHeapRegions[ uxHeapRegionCount ], pxHeapRegion->pucStartAddress, pxHeapRegion->xSizeInBytes );
+				xFreeBytesRemaining += xHeapRegions[ uxHeapRegionCount ].xFreeBytesRemaining;
+				uxHeapRegionCount++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+
+		xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+
+		/* Check something was actually defined before it is accessed. */
+		configASSERT( xFreeBytesRemaining != 0U );
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxPortGetHeapRegionCount( void )
+	{
+		return uxHeapRegionCount;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortGetHeapRegionStats( UBaseType_t uxRegion, HeapRegionStats_t *pxStats )
+	{
+	const HeapControl_t *pxHeap = &xHeapRegions[ uxRegion ];
+
+		configASSERT( uxRegion < uxHeapRegionCount );
+
+		vTaskSuspendAll();
+		{
+			pxStats->pucStartAddress = pxHeap->pucStart;
+			pxStats->xTotalBytes = pxHeap->xTotalBytes;
+			pxStats->xFreeBytes = pxHeap->xFreeBytesRemaining;
+			pxStats->xMinimumEverFreeBytes = pxHeap->xMinimumEverFreeBytesRemaining;
+			pxStats->xLargestFreeBlock = prvLargestFreeBlock( pxHeap );
+			pxStats->xAllocations = pxHeap->xAllocations;
+			pxStats->xFrees = pxHeap->xFrees;
+		}
+		( void ) xTaskResumeAll();
+	}
+	/*-----------------------------------------------------------*/
+
+#else
+
+	static void prvHeapInit( void )
+	{
+		prvHeapRegionInit( &xHeapRegions[ 0 ], ucHeap, configTOTAL_HEAP_SIZE );
+		uxHeapRegionCount = 1U;
+		xFreeBytesRemaining = xHeapRegions[ 0 ].xFreeBytesRemaining;
+		xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_REGIONS */
+
+static void *prvAllocateFromRegion( HeapControl_t *pxHeap, size_t xWantedSize )
+{
+BlockLink_t *pxBlock = NULL, *pxNewBlockLink;
+size_t xSearchSize;
+
+	if( xWantedSize <= pxHeap->xFreeBytesRemaining )
+	{
+		/* Round up to the start of the next range, so any block of the list
+		found is large enough. */
+		xSearchSize = xWantedSize;
+		if( xSearchSize >= heapSMALL_BLOCK_SIZE )
+		{
+			xSearchSize += ( ( size_t ) 1 << ( heapFLS( xSearchSize ) - heapSL_INDEX_COUNT_LOG2 ) ) - 1;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		pxBlock = prvFindSuitableBlock( pxHeap, xSearchSize );
+
+		/* Failing that, the first block of the range of the wanted size may
+		still be large enough, as when the whole region is wanted. */
+		if( pxBlock == NULL )
+		{
+			pxBlock = prvFindExactBlock( pxHeap, xWantedSize );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock == NULL )
+	{
+		return NULL;
+	}
+
+	/* This block is being returned for use so must be taken out of the free
+	lists, which marks it as owned by the application. */
+	prvRemoveFreeBlock( pxHeap, pxBlock );
+
+	/* If the block is larger than required it can be split into two. */
+	if( ( heapBLOCK_SIZE( pxBlock ) - xWantedSize ) >= heapMINIMUM_BLOCK_SIZE )
+	{
+		/* This block is to be split into two.  Create a new block following
+		the number of bytes requested.  The void cast is used to prevent byte
+		alignment warnings from the compiler. */
+		pxNewBlockLink = ( void * ) ( ( ( uint8_t * ) pxBlock ) + xWantedSize );
+		configASSERT( ( ( ( size_t ) pxNewBlockLink ) & portBYTE_ALIGNMENT_MASK ) == 0 );
+
+		/* Calculate the sizes of two blocks split from the single block.  The
+		block after the new one cannot be free, as free blocks are always
+		merged, so the new one is only listed. */
+		pxNewBlockLink->xBlockSize = heapBLOCK_SIZE( pxBlock ) - xWantedSize;
+		pxNewBlockLink->pxPrevPhysBlock = pxBlock;
+		prvNextPhysBlock( pxNewBlockLink )->pxPrevPhysBlock = pxNewBlockLink;
+		pxBlock->xBlockSize = xWantedSize;
+		prvInsertFreeBlock( pxHeap, pxNewBlockLink );
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	pxHeap->xFreeBytesRemaining -= pxBlock->xBlockSize;
+	pxHeap->xAllocations++;
+	if( pxHeap->xFreeBytesRemaining < pxHeap->xMinimumEverFreeBytesRemaining )
+	{
+		pxHeap->xMinimumEverFreeBytesRemaining = pxHeap->xFreeBytesRemaining;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xFreeBytesRemaining -= pxBlock->xBlockSize;
+	if( xFreeBytesRemaining < xMinimumEverFreeBytesRemaining )
+	{
+		xMinimumEverFreeBytesRemaining = xFreeBytesRemaining;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* Return the memory space pointed to - jumping over the header at its
+	start. */
+	return ( void * ) ( ( ( uint8_t * ) pxBlock ) + xHeapStructSize );
+}
+/*-----------------------------------------------------------*/
+
+static HeapControl_t *prvRegionOf( const BlockLink_t *pxBlock )
+{
+UBaseType_t uxRegion;
+HeapControl_t *pxHeap;
+
+	for( uxRegion = 0U; uxRegion < uxHeapRegionCount; uxRegion++ )
+	{
+		pxHeap = &xHeapRegions[ uxRegion ];
+		if( ( ( const uint8_t * ) pxBlock >= pxHeap->pucStart ) && ( pxBlock < pxHeap->pxEnd ) )
+		{
+			return pxHeap;
+		}
+	}
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static size_t prvLargestFreeBlock( const HeapControl_t *pxHeap )
+{
+const BlockLink_t *pxBlock;
+UBaseType_t uxFirst;
+size_t xLargest = 0U;
+
+	if( pxHeap->ulFirstLevelMap != 0U )
+	{
+		uxFirst = heapFLS( pxHeap->ulFirstLevelMap );
+		for( pxBlock = pxHeap->pxFreeLists[ uxFirst ][ heapFLS( pxHeap->ulSecondLevelMap[ uxFirst ] ) ]; pxBlock != NULL; pxBlock = pxBlock->pxNextFreeBlock )
+		{
+			if( heapBLOCK_SIZE( pxBlock ) > xLargest )
+			{
+				xLargest = heapBLOCK_SIZE( pxBlock );
+			}
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xLargest;
+}
+/*-----------------------------------------------------------*/
+
+static void prvMappingInsert( size_t xBlockSize, UBaseType_t *puxFirst, UBaseType_t *puxSecond )
+{
+UBaseType_t uxFirst;
+
+	if( xBlockSize < heapSMALL_BLOCK_SIZE )
+	{
+		/* The small blocks are split into ranges of portBYTE_ALIGNMENT. */
+		*puxFirst = 0;
+		*puxSecond = ( UBaseType_t ) ( xBlockSize >> heapALIGNMENT_LOG2 );
+	}
+	else
+	{
+		/* The bits below the highest give the range within its power of
+		two. */
+		uxFirst = heapFLS( xBlockSize );
+		*puxSecond = ( UBaseType_t ) ( ( xBlockSize >> ( uxFirst - heapSL_INDEX_COUNT_LOG2 ) ) ^ heapSL_INDEX_COUNT );
+		*puxFirst = uxFirst - ( heapFL_INDEX_SHIFT - 1 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t *prvFindSuitableBlock( HeapControl_t *pxHeap, size_t xWantedSize )
+{
+UBaseType_t uxFirst, uxSecond;
+uint32_t ulMap;
+
+	prvMappingInsert( xWantedSize, &uxFirst, &uxSecond );
+	if( uxFirst >= heapFL_INDEX_COUNT )
+	{
+		return NULL;
+	}
+
+	/* A list of the same power of two, at or above the range, or else the
+	lowest list of a higher power of two. */
+	ulMap = pxHeap->ulSecondLevelMap[ uxFirst ] & ( ~0UL << uxSecond );
+	if( ulMap == 0U )
+	{
+		ulMap = pxHeap->ulFirstLevelMap & ( ~0UL << ( uxFirst + 1 ) );
+		if( ulMap == 0U )
+		{
+			return NULL;
+		}
+
+		uxFirst = heapFFS( ulMap );
+		ulMap = pxHeap->ulSecondLevelMap[ uxFirst ];
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxHeap->pxFreeLists[ uxFirst ][ heapFFS( ulMap ) ];
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t *prvFindExactBlock( HeapControl_t *pxHeap, size_t xWantedSize )
+{
+UBaseType_t uxFirst, uxSecond;
+BlockLink_t *pxBlock = NULL;
+
+	prvMappingInsert( xWantedSize, &uxFirst, &uxSecond );
+	if( uxFirst < heapFL_INDEX_COUNT )
+	{
+		pxBlock = pxHeap->pxFreeLists[ uxFirst ][ uxSecond ];
+		if( ( pxBlock != NULL ) && ( heapBLOCK_SIZE( pxBlock ) < xWantedSize ) )
+		{
+			pxBlock = NULL;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return pxBlock;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInsertFreeBlock( HeapControl_t *pxHeap, BlockLink_t *pxBlock )
+{
+UBaseType_t uxFirst, uxSecond;
+
+	prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFirst, &uxSecond );
+
+	pxBlock->xBlockSize |= heapBLOCK_FREE_BIT;
+	pxBlock->pxPrevFreeBlock = NULL;
+	pxBlock->pxNextFreeBlock = pxHeap->pxFreeLists[ uxFirst ][ uxSecond ];
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+	pxHeap->pxFreeLists[ uxFirst ][ uxSecond ] = pxBlock;
+
+	pxHeap->ulFirstLevelMap |= 1UL << uxFirst;
+	pxHeap->ulSecondLevelMap[ uxFirst ] |= 1UL << uxSecond;
+}
+/*-----------------------------------------------------------*/
+
+static void prvRemoveFreeBlock( HeapControl_t *pxHeap, BlockLink_t *pxBlock )
+{
+UBaseType_t uxFirst, uxSecond;
+
+	prvMappingInsert( heapBLOCK_SIZE( pxBlock ), &uxFirst, &uxSecond );
+
+	if( pxBlock->pxNextFreeBlock != NULL )
+	{
+		pxBlock->pxNextFreeBlock->pxPrevFreeBlock = pxBlock->pxPrevFreeBlock;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	if( pxBlock->pxPrevFreeBlock != NULL )
+	{
+		pxBlock->pxPrevFreeBlock->pxNextFreeBlock = pxBlock->pxNextFreeBlock;
+	}
+	else
+	{
+		/* The block was the first of its list.  Clear the bits of the list,
+		and of its power of two, once they are empty. */
+		pxHeap->pxFreeLists[ uxFirst ][ uxSecond ] = pxBlock->pxNextFreeBlock;
+		if( pxHeap->pxFreeLists[ uxFirst ][ uxSecond ] == NULL )
+		{
+			pxHeap->ulSecondLevelMap[ uxFirst ] &= ~( 1UL << uxSecond );
+			if( pxHeap->ulSecondLevelMap[ uxFirst ] == 0U )
+			{
+				pxHeap->ulFirstLevelMap &= ~( 1UL << uxFirst );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+	pxBlock->xBlockSize &= ~heapBLOCK_FREE_BIT;
+}
+/*-----------------------------------------------------------*/
+
+static BlockLink_t *prvNextPhysBlock( BlockLink_t *pxBlock )
+{
+	/* The void cast is used to prevent byte alignment warnings from the
+	compiler. */
+	return ( void * ) ( ( ( uint8_t * ) pxBlock ) + heapBLOCK_SIZE( pxBlock ) );
+}
+/*-----------------------------------------------------------*/
+
+static void prvHeapRegionInit( HeapControl_t *pxHeap, uint8_t *pucStart, size_t xTotalHeapSize )
+{
+BlockLink_t *pxFirstFreeBlock;
+uint8_t *pucAlignedHeap;
+size_t uxAddress;
+
+	/* The first level bitmap, and the sizes, must hold the whole region. */
+	configASSERT( xTotalHeapSize <= heapMAXIMUM_BLOCK_SIZE );
+
+	/* Ensure the region starts on a correctly aligned boundary. */
+	uxAddress = ( size_t ) pucStart;
+
+	if( ( uxAddress & portBYTE_ALIGNMENT_MASK ) != 0 )
+	{
+		uxAddress += ( portBYTE_ALIGNMENT - 1 );
+		uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+		xTotalHeapSize -= uxAddress - ( size_t ) pucStart;
+	}
+
+	pucAlignedHeap = ( uint8_t * ) uxAddress;
+
+	/* pxEnd is used to mark the end of the region, and is a header with no
+	space after it at the end of the region. */
+	uxAddress = ( ( size_t ) pucAlignedHeap ) + xTotalHeapSize;
+	uxAddress -= xHeapStructSize;
+	uxAddress &= ~( ( size_t ) portBYTE_ALIGNMENT_MASK );
+	pxHeap->pxEnd = ( void * ) uxAddress;
+	pxHeap->pucStart = pucAlignedHeap;
+
+	/* To start with there is a single free block that is sized to take up the
+	entire region, minus the space taken by pxEnd. */
+	pxFirstFreeBlock = ( void * ) pucAlignedHeap;
+	pxFirstFreeBlock->xBlockSize = uxAddress - ( size_t ) pxFirstFreeBlock;
+	pxFirstFreeBlock->pxPrevPhysBlock = NULL;
+	pxHeap->pxEnd->xBlockSize = 0;
+	pxHeap->pxEnd->pxPrevPhysBlock = pxFirstFreeBlock;
+	prvInsertFreeBlock( pxHeap, pxFirstFreeBlock );
+
+	/* Only one block exists - and it covers the entire usable region. */
+	pxHeap->xTotalBytes = heapBLOCK_SIZE( pxFirstFreeBlock );
+	pxHeap->xMinimumEverFreeBytesRemaining = pxHeap->xTotalBytes;
+	pxHeap->xFreeBytesRemaining = pxHeap->xTotalBytes;
+}
+/*-----------------------------------------------------------*/
+
+#endif /* configUSE_HEAP_TLSF */
@@ -0,0 +1,311 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Fixed block memory pools, see mem_pool.h.
+ *
+ * The free blocks of a pool are held by a queue of their addresses, created
+ * in the memory of the pool, so a pool needs no list or locking of its own.
+ * Allocating a block receives its address from the queue, and freeing it sends
+ * the address back, each a copy of one pointer in a critical section.  A freed
+ * block is sent to the front of the queue, so it is the next to be allocated,
+ * while it is still likely to be in the cache.  A task that allocates from an
+ * empty pool waits on the queue as on any other, so the first block freed goes
+ * to the waiting task of the highest priority.  Nothing ever waits to send to
+ * the queue, as it has room for every block of the pool.
+ */
+
+/* Standard includes. */
+#include <stdlib.h>
+
+/* Defining MPU_WRAPPERS_INCLUDED_FROM_API_FILE prevents task.h from redefining
+all the API functions to use the MPU wrappers.  That should only be done when
+task.h is included from an application file. */
+#define MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+#include "queue.h"
+#include "mem_pool.h"
+
+#undef MPU_WRAPPERS_INCLUDED_FROM_API_FILE
+
+#if( configUSE_MEM_POOLS == 1 )
+
+#if( configSUPPORT_STATIC_ALLOCATION == 0 )
+	#error mem_pool.c creates the queue of each pool statically, so needs configSUPPORT_STATIC_ALLOCATION
+#endif
+
+typedef struct MemPoolDef_t
+{
+	StaticQueue_t xFreeBlocks;		/*< The queue of the addresses of the free blocks. */
+	uint8_t *pucBlocks;				/*< The first block. */
+	uint8_t *pucBlocksEnd;			/*< The end of the last block, and the storage of the queue. */
+	size_t xBlockSize;				/*< The size of each block, a multiple of portBYTE_ALIGNMENT. */
+	UBaseType_t uxBlockCount;		/*< The number of blocks. */
+	uint8_t ucStaticallyAllocated;	/*< Set to pdTRUE if the pool is statically allocated, so its memory is not freed. */
+} MemPool_t;
+
+/* The queue of the free blocks of a pool. */
+#define memPOOL_QUEUE( pxPool ) ( ( QueueHandle_t ) &( ( pxPool )->xFreeBlocks ) )
+
+/*-----------------------------------------------------------*/
+
+/*
+ * Set up a pool of uxBlockCount blocks of xBlockSize bytes in pucPoolStorage,
+ * with all of its blocks free.
+ */
+static void prvInitialiseNewMemPool( size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t *pucPoolStorage,
+	MemPool_t *pxPool, uint8_t ucStaticallyAllocated ) PRIVILEGED_FUNCTION;
+
+/*-----------------------------------------------------------*/
+
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+
+	MemPoolHandle_t xMemPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount )
+	{
+	MemPool_t *pxPool;
+	const size_t xHeaderSize = memPOOL_BLOCK_SIZE( sizeof( MemPool_t ) );
+
+		configASSERT( xBlockSize > ( size_t ) 0 );
+		configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+
+		/* The pool and its storage are allocated together, the storage after
+		the pool so it keeps the alignment of the allocation. */
+		pxPool = ( MemPool_t * ) pvPortMalloc( xHeaderSize + memPOOL_STORAGE_SIZE( xBlockSize, uxBlockCount ) ); /*lint !e9087 !e9079 pvPortMalloc() always returns memory aligned for the port. */
+
+		if( pxPool != NULL )
+		{
+			prvInitialiseNewMemPool( xBlockSize, uxBlockCount, ( ( uint8_t * ) pxPool ) + xHeaderSize, pxPool, pdFALSE );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxPool;
+	}
+
+#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+/*-----------------------------------------------------------*/
+
+MemPoolHandle_t xMemPoolCreateStatic( size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t *pucPoolStorage,
+	StaticMemPool_t *pxStaticPool )
+{
+MemPool_t *pxPool = ( MemPool_t * ) pxStaticPool; /*lint !e740 !e9087 MemPool_t and StaticMemPool_t are deliberately aliased for data hiding purposes. */
+
+	configASSERT( pxStaticPool );
+	configASSERT( pucPoolStorage );
+	configASSERT( ( ( ( portPOINTER_SIZE_TYPE ) pucPoolStorage ) & ( portPOINTER_SIZE_TYPE ) portBYTE_ALIGNMENT_MASK ) == 0 );
+	configASSERT( xBlockSize > ( size_t ) 0 );
+	configASSERT( uxBlockCount > ( UBaseType_t ) 0 );
+
+	#if( configASSERT_DEFINED == 1 )
+	{
+		/* Sanity check that the size of the structure used to declare a
+		variable of type StaticMemPool_t equals the size of the real pool
+		structure. */
+		volatile size_t xSize = sizeof( StaticMemPool_t );
+		configASSERT( xSize == sizeof( MemPool_t ) );
+	} /*lint !e529 xSize is referenced if configASSERT() is defined. */
+	#endif /* configASSERT_DEFINED */
+
+	if( ( pxPool != NULL ) && ( pucPoolStorage != NULL ) )
+	{
+		prvInitialiseNewMemPool( xBlockSize, uxBlockCount, pucPoolStorage, pxPool, pdTRUE );
+	}
+	else
+	{
+		pxPool = NULL;
+	}
+
+	return pxPool;
+}
+/*-----------------------------------------------------------*/
+
+static void prvInitialiseNewMemPool( size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t *pucPoolStorage,
+	MemPool_t *pxPool, uint8_t ucStaticallyAllocated )
+{
+uint8_t *pucBlock;
+
+	pxPool->xBlockSize = memPOOL_BLOCK_SIZE( xBlockSize );
+	pxPool->uxBlockCount = uxBlockCount;
+	pxPool->pucBlocks = pucPoolStorage;
+	pxPool->pucBlocksEnd = pucPoolStorage + ( pxPool->xBlockSize * ( size_t ) uxBlockCount );
+	pxPool->ucStaticallyAllocated = ucStaticallyAllocated;
+
+	/* Each block is a multiple of portBYTE_ALIGNMENT, so the storage of the
+	queue after the last block is aligned for the addresses it holds. */
+	( void ) xQueueGenericCreateStatic( uxBlockCount, ( UBaseType_t ) sizeof( void * ), pxPool->pucBlocksEnd,
+		&( pxPool->xFreeBlocks ), queueQUEUE_TYPE_MEM_POOL );
+
+	/* The blocks are allocated in the order of their addresses at first. */
+	for( pucBlock = pxPool->pucBlocks; pucBlock < pxPool->pucBlocksEnd; pucBlock += pxPool->xBlockSize )
+	{
+		( void ) xQueueSendToBack( memPOOL_QUEUE( pxPool ), &pucBlock, ( TickType_t ) 0 );
+	}
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolDelete( MemPoolHandle_t xPool )
+{
+MemPool_t *pxPool = xPool;
+
+	configASSERT( pxPool );
+
+	vQueueDelete( memPOOL_QUEUE( pxPool ) );
+
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	{
+		if( pxPool->ucStaticallyAllocated == ( uint8_t ) pdFALSE )
+		{
+			vPortFree( pxPool );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configSUPPORT_DYNAMIC_ALLOCATION */
+}
+/*-----------------------------------------------------------*/
+
+void *pvMemPoolAlloc( MemPoolHandle_t xPool, TickType_t xTicksToWait )
+{
+MemPool_t *pxPool = xPool;
+void *pvBlock = NULL;
+
+	configASSERT( pxPool );
+
+	/* The queue is only written on success, so pvBlock is left NULL on a
+	timeout. */
+	( void ) xQueueReceive( memPOOL_QUEUE( pxPool ), &pvBlock, xTicksToWait );
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void *pvMemPoolAllocFromISR( MemPoolHandle_t xPool )
+{
+MemPool_t *pxPool = xPool;
+void *pvBlock = NULL;
+
+	configASSERT( pxPool );
+
+	/* No task waits to send to the queue, so receiving from it never wakes
+	one. */
+	( void ) xQueueReceiveFromISR( memPOOL_QUEUE( pxPool ), &pvBlock, NULL );
+
+	return pvBlock;
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFree( MemPoolHandle_t xPool, void *pvBlock )
+{
+MemPool_t *pxPool = xPool;
+BaseType_t xReturn;
+
+	configASSERT( pxPool );
+	configASSERT( xMemPoolContains( pxPool, pvBlock ) );
+
+	xReturn = xQueueSendToFront( memPOOL_QUEUE( pxPool ), &pvBlock, ( TickType_t ) 0 );
+
+	/* The queue has room for every block, so it is only full if a block is
+	freed twice. */
+	configASSERT( xReturn == pdPASS );
+	( void ) xReturn;
+}
+/*-----------------------------------------------------------*/
+
+void vMemPoolFreeFromISR( MemPoolHandle_t xPool, void *pvBlock, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+MemPool_t *pxPool = xPool;
+BaseType_t xReturn;
+
+	configASSERT( pxPool );
+	configASSERT( xMemPoolContains( pxPool, pvBlock ) );
+
+	xReturn = xQueueSendToFrontFromISR( memPOOL_QUEUE( pxPool ), &pvBlock, pxHigherPriorityTaskWoken );
+
+	configASSERT( xReturn == pdPASS );
+	( void ) xReturn;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xMemPoolContains( MemPoolHandle_t xPool, const void *pvBlock )
+{
+const MemPool_t *pxPool = xPool;
+const uint8_t *pucBlock = ( const uint8_t * ) pvBlock;
+BaseType_t xReturn = pdFALSE;
+
+	configASSERT( pxPool );
+
+	if( ( pucBlock >= pxPool->pucBlocks ) && ( pucBlock < pxPool->pucBlocksEnd ) )
+	{
+		if( ( ( size_t ) ( pucBlock - pxPool->pucBlocks ) % pxPool->xBlockSize ) == ( size_t ) 0 )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxMemPoolGetFreeCount( MemPoolHandle_t xPool )
+{
+	configASSERT( xPool );
+
+	return uxQueueMessagesWaiting( memPOOL_QUEUE( xPool ) );
+}
+/*-----------------------------------------------------------*/
+
+size_t xMemPoolGetBlockSize( MemPoolHandle_t xPool )
+{
+	configASSERT( xPool );
+
+	return xPool->xBlockSize;
+}
+/*-----------------------------------------------------------*/
+
+QueueHandle_t xMemPoolGetQueue( MemPoolHandle_t xPool )
+{
+	configASSERT( xPool );
+
+	return memPOOL_QUEUE( xPool );
+}
+
+#endif /* configUSE_MEM_POOLS == 1 */
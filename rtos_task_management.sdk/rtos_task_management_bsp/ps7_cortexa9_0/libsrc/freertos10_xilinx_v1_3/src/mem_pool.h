@@ -0,0 +1,167 @@
+/*
+ * FreeRTOS Kernel V10.1.1
+ * Copyright (C) 2018 Amazon.com, Inc. or its affiliates.  All Rights Reserved.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * http://www.FreeRTOS.org
+ * http://aws.amazon.com/freertos
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/*
+ * Memory pools hand out blocks of one fixed size, from a fixed number of
+ * blocks, in a time that depends on neither the number of blocks nor what else
+ * has been allocated.  They suit messages and buffers that are all of a size,
+ * which the first fit of heap_4.c allocates in a time that varies and which
+ * fragment its free list.
+ *
+ * A pool is a queue of the free blocks, which holds the address of each, so
+ * the blocks are handed out and returned with the critical sections, the
+ * priority ordered waiting and the timeouts of queue.c.  pvMemPoolAlloc() can
+ * block until another task or an interrupt frees a block, as a task can on a
+ * counting semaphore, and pvMemPoolAllocFromISR() and vMemPoolFreeFromISR()
+ * can be called from interrupts.  The address of a block is a pointer, so
+ * blocks are passed between tasks on any queue of void * items, and freed by
+ * whichever task ends up with them.
+ *
+ * Set configUSE_MEM_POOLS to 1 in FreeRTOSConfig.h to build mem_pool.c.
+ */
+
+#ifndef MEM_POOL_H
+#define MEM_POOL_H
+
+#ifndef INC_FREERTOS_H
+	#error "include FreeRTOS.h" must appear in source files before "include mem_pool.h"
+#endif
+
+/* FreeRTOS includes. */
+#include "queue.h"
+
+#if defined( __cplusplus )
+extern "C" {
+#endif
+
+/*
+ * Type by which memory pools are referenced.  For example, a call to
+ * xMemPoolCreate() returns a MemPoolHandle_t variable that can then be used
+ * as a parameter to pvMemPoolAlloc(), vMemPoolFree(), etc.
+ */
+struct MemPoolDef_t;
+typedef struct MemPoolDef_t * MemPoolHandle_t;
+
+/*
+ * The memory of a pool created by xMemPoolCreateStatic(), other than that of
+ * its blocks.  Its contents are opaque, but its size is that of the pool.
+ */
+typedef struct xSTATIC_MEM_POOL
+{
+	StaticQueue_t xDummy1;
+	void *pvDummy2[ 2 ];
+	size_t xDummy3;
+	UBaseType_t uxDummy4;
+	uint8_t ucDummy5;
+} StaticMemPool_t;
+
+/*
+ * The size of each block of a pool of blocks of xBlockSize bytes, rounded up
+ * so that each block is aligned to portBYTE_ALIGNMENT.
+ */
+#define memPOOL_BLOCK_SIZE( xBlockSize ) \
+	( ( ( size_t ) ( xBlockSize ) + ( portBYTE_ALIGNMENT - 1 ) ) & ~( ( size_t ) portBYTE_ALIGNMENT_MASK ) )
+
+/*
+ * The bytes of storage passed to xMemPoolCreateStatic() for uxBlockCount
+ * blocks of xBlockSize bytes: the blocks, then the queue of free blocks.
+ */
+#define memPOOL_STORAGE_SIZE( xBlockSize, uxBlockCount ) \
+	( ( memPOOL_BLOCK_SIZE( xBlockSize ) + sizeof( void * ) ) * ( size_t ) ( uxBlockCount ) )
+
+/*
+ * Create a pool of uxBlockCount blocks of xBlockSize bytes, all free, in one
+ * allocation from the heap.  Returns NULL if the heap has no room for it.
+ */
+#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+	MemPoolHandle_t xMemPoolCreate( size_t xBlockSize, UBaseType_t uxBlockCount ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Create a pool of uxBlockCount blocks of xBlockSize bytes, all free, in
+ * pucPoolStorage, which is aligned to portBYTE_ALIGNMENT and holds at least
+ * memPOOL_STORAGE_SIZE( xBlockSize, uxBlockCount ) bytes, and pxStaticPool.
+ */
+MemPoolHandle_t xMemPoolCreateStatic( size_t xBlockSize, UBaseType_t uxBlockCount, uint8_t *pucPoolStorage,
+	StaticMemPool_t *pxStaticPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Delete a pool, and free its memory if it was created by xMemPoolCreate().
+ * Its blocks must not be used once it is deleted.
+ */
+void vMemPoolDelete( MemPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocate a block of a pool, waiting up to xTicksToWait for one to be freed
+ * if none is free.  Returns NULL on a timeout.  Of the tasks waiting, the one
+ * of the highest priority is given the next block freed.
+ */
+void *pvMemPoolAlloc( MemPoolHandle_t xPool, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+
+/*
+ * Allocate a block of a pool from an interrupt.  Returns NULL at once if none
+ * is free.
+ */
+void *pvMemPoolAllocFromISR( MemPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return a block to the pool it was allocated from, so to a task waiting for
+ * one if there is one.
+ */
+void vMemPoolFree( MemPoolHandle_t xPool, void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * Return a block to the pool it was allocated from, from an interrupt.
+ * *pxHigherPriorityTaskWoken is set to pdTRUE if that wakes a task of a
+ * higher priority than the task interrupted, as by xQueueSendFromISR().
+ */
+void vMemPoolFreeFromISR( MemPoolHandle_t xPool, void *pvBlock,
+	BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+/*
+ * Whether pvBlock is the start of a block of the pool.
+ */
+BaseType_t xMemPoolContains( MemPoolHandle_t xPool, const void *pvBlock ) PRIVILEGED_FUNCTION;
+
+/*
+ * The number of blocks of a pool that are free, and the size of each block.
+ */
+UBaseType_t uxMemPoolGetFreeCount( MemPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+size_t xMemPoolGetBlockSize( MemPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+/*
+ * The queue of the free blocks of a pool, to add to a queue set, so that a
+ * task can wait on a free block along with other queues.  A block must only
+ * be taken from it by pvMemPoolAlloc() once xQueueSelectFromSet() returns it.
+ */
+QueueHandle_t xMemPoolGetQueue( MemPoolHandle_t xPool ) PRIVILEGED_FUNCTION;
+
+#if defined( __cplusplus )
+}
+#endif
+
+#endif /* MEM_POOL_H */
@@ -34,6 +34,10 @@
 
 /* Xilinx includes. */
 #include "xscugic.h"
+#if( configNUMBER_OF_CORES > 1 )
+	#include "xil_cache.h"
+	#include "xil_io.h"
+#endif
 
 #ifndef configINTERRUPT_CONTROLLER_BASE_ADDRESS
 	#error configINTERRUPT_CONTROLLER_BASE_ADDRESS must be defined.  See http://www.freertos.org/Using-FreeRTOS-on-Cortex-A-Embedded-Processors.html
@@ -75,6 +79,12 @@
 	#error configMAX_API_CALL_INTERRUPT_PRIORITY must be greater than ( configUNIQUE_INTERRUPT_PRIORITIES / 2 )
 #endif
 
+/* The FPU registers of a task are found in the FPU of the core it last ran on,
+and a task may move to the other core. */
+#if( configUSE_TASK_FPU_LAZY == 1 ) && ( configNUMBER_OF_CORES > 1 )
+	#error configUSE_TASK_FPU_LAZY can only be set to 1 when configNUMBER_OF_CORES is 1
+#endif
+
 /* Some vendor specific files default configCLEAR_TICK_INTERRUPT() in
 portmacro.h. */
 #ifndef configCLEAR_TICK_INTERRUPT
@@ -154,6 +164,34 @@ debugger. */
 registers, plus a 32-bit status register. */
 #define portFPU_REGISTER_WORDS	( ( 32 * 2 ) + 1 )
 
+#if( configNUMBER_OF_CORES > 1 )
+	/* The boot ROM holds core 1 in a WFE loop until this word holds the address
+	to start it at. */
+	#define portCORE1_START_ADDRESS			( 0xFFFFFFF0UL )
+
+	/* The stacks of the IRQ and supervisor modes of core 1. */
+	#define portCORE1_IRQ_STACK_WORDS		( 256 )
+	#define portCORE1_SVC_STACK_WORDS		( 1024 )
+
+	/* The CPU interface control register, and the value that enables the
+	group 0 and group 1 interrupts, as XScuGic_CfgInitialize() sets it on core
+	0. */
+	#define portICCICR_CPU_INTERFACE_CONTROL_OFFSET	( 0x00 )
+	#define portICCICR_ENABLE_ALL					( 0x07UL )
+
+	/* The number of kernel locks. */
+	#define portLOCKS						( 2 )
+
+	/* The registers core 1 copies from core 0 before turning on its MMU. */
+	#define portCORE0_TTBR0					( 0 )
+	#define portCORE0_DACR					( 1 )
+	#define portCORE0_VBAR					( 2 )
+	#define portCORE0_ACTLR					( 3 )
+	#define portCORE0_CPACR					( 4 )
+	#define portCORE0_SCTLR					( 5 )
+	#define portCORE0_REGISTERS				( 6 )
+#endif /* configNUMBER_OF_CORES */
+
 /*-----------------------------------------------------------*/
 
 /*
@@ -204,32 +242,86 @@ extern XScuGic xInterruptController;
  */
 void vApplicationFPUSafeIRQHandler( uint32_t ulICCIAR ) __attribute__((weak) );
 
+#if( configNUMBER_OF_CORES > 1 )
+
+	/*
+	 * Where core 1 starts once released from the boot ROM.  It sets up its
+	 * stacks and its MMU as core 0 has them, then calls vPortStartCore1().
+	 * Implemented in portASM.S.
+	 */
+	extern void FreeRTOS_Core1_Entry( void );
+
+	/*
+	 * Sets up the GIC CPU interface of core 1, then starts the first task of
+	 * core 1.
+	 */
+	void vPortStartCore1( void );
+
+	/*
+	 * Releases core 1 from the boot ROM.
+	 */
+	static void prvStartCore1( void );
+
+	/*
+	 * Enables the software generated interrupt that makes the calling core
+	 * switch tasks.  The SGIs are banked, so each core enables its own.
+	 */
+	static void prvEnableYieldInterrupt( void );
+
+	/*
+	 * The handler of that interrupt.
+	 */
+	static void prvYieldCoreHandler( void *pvCallBackRef );
+
+#endif /* configNUMBER_OF_CORES */
+
 /*-----------------------------------------------------------*/
 
+/* Each of the variables below is kept for each core, indexed by
+portGET_CORE_ID(), as is the current TCB. */
+
 /* A variable is used to keep track of the critical section nesting.  This
 variable has to be stored as part of the task context and must be initialised to
 a non zero value to ensure interrupts don't inadvertently become unmasked before
 the scheduler starts.  As it is stored as part of the task context it will
 automatically be set to 0 when the first task is started. */
-volatile uint32_t ulCriticalNesting = 9999UL;
+volatile uint32_t ulCriticalNesting[ configNUMBER_OF_CORES ] = { [ 0 ... ( configNUMBER_OF_CORES - 1 ) ] = 9999UL };
 
 /* Saved as part of the task context.  If ulPortTaskHasFPUContext is non-zero then
 a floating point context must be saved and restored for the task. */
-volatile uint32_t ulPortTaskHasFPUContext = pdFALSE;
+volatile uint32_t ulPortTaskHasFPUContext[ configNUMBER_OF_CORES ] = { pdFALSE };
+
+#if( configUSE_TASK_FPU_LAZY == 1 )
+	/* The TCB of the task whose registers are in the FPU, or NULL if none are.
+	The FPU is enabled only while this task runs, and the registers are saved
+	only when another task uses the FPU, by FreeRTOS_FPU_Trap in portASM.S. */
+	void * volatile pxPortFPUOwner = NULL;
+#endif
 
 /* Set to 1 to pend a context switch from an ISR. */
-volatile uint32_t ulPortYieldRequired = pdFALSE;
+volatile uint32_t ulPortYieldRequired[ configNUMBER_OF_CORES ] = { pdFALSE };
 
 /* Counts the interrupt nesting depth.  A context switch is only performed if
 if the nesting depth is 0. */
-volatile uint32_t ulPortInterruptNesting = 0UL;
-/*
- * Global counter used for calculation of run time statistics of tasks.
- * Defined only when the relevant option is turned on
- */
-#if (configGENERATE_RUN_TIME_STATS==1)
-volatile uint32_t ulHighFrequencyTimerTicks;
-#endif
+volatile uint32_t ulPortInterruptNesting[ configNUMBER_OF_CORES ] = { 0UL };
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	/* The core that holds each kernel lock, plus one, or 0 while the lock is
+	free, and the number of times that core has taken it. */
+	static volatile uint32_t ulLockOwner[ portLOCKS ] = { 0UL };
+	static uint32_t ulLockCount[ portLOCKS ] = { 0UL };
+
+	/* The stacks of core 1, and the registers of core 0 that core 1 copies. */
+	static uint32_t ulCore1IRQStack[ portCORE1_IRQ_STACK_WORDS ] __attribute__(( aligned( 8 ) ));
+	static uint32_t ulCore1SVCStack[ portCORE1_SVC_STACK_WORDS ] __attribute__(( aligned( 8 ) ));
+	__attribute__(( used )) uint32_t ulPortCore0Registers[ portCORE0_REGISTERS ];
+
+	/* Used in the asm file. */
+	__attribute__(( used )) const uint32_t ulPortCore1IRQStackTop = ( uint32_t ) &( ulCore1IRQStack[ portCORE1_IRQ_STACK_WORDS ] );
+	__attribute__(( used )) const uint32_t ulPortCore1SVCStackTop = ( uint32_t ) &( ulCore1SVCStack[ portCORE1_SVC_STACK_WORDS ] );
+
+#endif /* configNUMBER_OF_CORES */
 
 /* Used in the asm file. */
 __attribute__(( used )) const uint32_t ulICCIAR = portICCIAR_INTERRUPT_ACKNOWLEDGE_REGISTER_ADDRESS;
@@ -304,11 +396,13 @@ StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t px
 	enabled. */
 	*pxTopOfStack = portNO_CRITICAL_NESTING;
 
-	#if( configUSE_TASK_FPU_SUPPORT == 1 )
+	#if( configUSE_TASK_FPU_SUPPORT == 1 ) || ( configUSE_TASK_FPU_LAZY == 1 )
 	{
 		/* The task will start without a floating point context.  A task that
 		uses the floating point hardware must call vPortTaskUsesFPU() before
-		executing any floating point instructions. */
+		executing any floating point instructions, unless the context is
+		switched lazily, in which case the first such instruction gives it
+		one. */
 		pxTopOfStack--;
 		*pxTopOfStack = portNO_FLOATING_POINT_CONTEXT;
 	}
@@ -321,7 +415,7 @@ StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t px
 
 		pxTopOfStack--;
 		*pxTopOfStack = pdTRUE;
-		ulPortTaskHasFPUContext = pdTRUE;
+		ulPortTaskHasFPUContext[ portGET_CORE_ID() ] = pdTRUE;
 	}
 	#else
 	{
@@ -341,7 +435,7 @@ static void prvTaskExitError( void )
 
 	Artificially force an assert() to be triggered if configASSERT() is
 	defined, then stop here so application writers can catch the error. */
-	configASSERT( ulPortInterruptNesting == ~0UL );
+	configASSERT( ulPortInterruptNesting[ portGET_CORE_ID() ] == ~0UL );
 	portDISABLE_INTERRUPTS();
 	for( ;; );
 }
@@ -507,6 +601,16 @@ uint32_t ulAPSR;
 			/* Start the timer that generates the tick ISR. */
 			configSETUP_TICK_INTERRUPT();
 
+			#if( configNUMBER_OF_CORES > 1 )
+			{
+				/* The tick and the peripheral interrupts are taken on core 0
+				only.  Each core takes the interrupt that makes it yield. */
+				XScuGic_Connect( &xInterruptController, portYIELD_CORE_SGI_ID, prvYieldCoreHandler, NULL );
+				prvEnableYieldInterrupt();
+				prvStartCore1();
+			}
+			#endif /* configNUMBER_OF_CORES */
+
 			/* Start the first task executing. */
 			vPortRestoreTaskContext();
 		}
@@ -526,7 +630,7 @@ void vPortEndScheduler( void )
 {
 	/* Not implemented in ports where there is nothing to return to.
 	Artificially force an assert. */
-	configASSERT( ulCriticalNesting == 1000UL );
+	configASSERT( ulCriticalNesting[ portGET_CORE_ID() ] == 1000UL );
 }
 /*-----------------------------------------------------------*/
 
@@ -538,31 +642,31 @@ void vPortEnterCritical( void )
 	/* Now interrupts are disabled ulCriticalNesting can be accessed
 	directly.  Increment ulCriticalNesting to keep a count of how many times
 	portENTER_CRITICAL() has been called. */
-	ulCriticalNesting++;
+	ulCriticalNesting[ portGET_CORE_ID() ]++;
 
 	/* This is not the interrupt safe version of the enter critical function so
 	assert() if it is being called from an interrupt context.  Only API
 	functions that end in "FromISR" can be used in an interrupt.  Only assert if
 	the critical nesting count is 1 to protect against recursive calls if the
 	assert function also uses a critical section. */
-	if( ulCriticalNesting == 1 )
+	if( ulCriticalNesting[ portGET_CORE_ID() ] == 1 )
 	{
-		configASSERT( ulPortInterruptNesting == 0 );
+		configASSERT( ulPortInterruptNesting[ portGET_CORE_ID() ] == 0 );
 	}
 }
 /*-----------------------------------------------------------*/
 
 void vPortExitCritical( void )
 {
-	if( ulCriticalNesting > portNO_CRITICAL_NESTING )
+	if( ulCriticalNesting[ portGET_CORE_ID() ] > portNO_CRITICAL_NESTING )
 	{
 		/* Decrement the nesting count as the critical section is being
 		exited. */
-		ulCriticalNesting--;
+		ulCriticalNesting[ portGET_CORE_ID() ]--;
 
 		/* If the nesting level has reached zero then all interrupt
 		priorities must be re-enabled. */
-		if( ulCriticalNesting == portNO_CRITICAL_NESTING )
+		if( ulCriticalNesting[ portGET_CORE_ID() ] == portNO_CRITICAL_NESTING )
 		{
 			/* Critical nesting has reached zero so all interrupt priorities
 			should be unmasked. */
@@ -572,21 +676,23 @@ void vPortExitCritical( void )
 }
 /*-----------------------------------------------------------*/
 
+BaseType_t xPortIsInsideInterrupt( void )
+{
+uint32_t ulMask;
+BaseType_t xInside;
+
+	/* Mask interrupts, so a task cannot be switched to the other core between
+	reading its core ID and reading the nesting count of the core. */
+	ulMask = ulPortSetInterruptMask();
+	xInside = ( ulPortInterruptNesting[ portGET_CORE_ID() ] != 0UL ) ? pdTRUE : pdFALSE;
+	vPortClearInterruptMask( ulMask );
+
+	return xInside;
+}
+/*-----------------------------------------------------------*/
+
 void FreeRTOS_Tick_Handler( void )
 {
-	/*
-	 * The Xilinx implementation of generating run time task stats uses the same timer used for generating
-	 * FreeRTOS ticks. In case user decides to generate run time stats the tick handler is called more
-	 * frequently (10 times faster). The timer/tick handler uses logic to handle the same. It handles
-	 * the FreeRTOS tick once per 10 interrupts.
-	 * For handling generation of run time stats, it increments a pre-defined counter every time the
-	 * interrupt handler executes.
-	 */
-#if (configGENERATE_RUN_TIME_STATS == 1)
-	ulHighFrequencyTimerTicks++;
-	if (!(ulHighFrequencyTimerTicks % 10))
-#endif
-	{
 	/* Set interrupt mask before altering scheduler structures.   The tick
 	handler runs at the lowest priority, so interrupts cannot already be masked,
 	so there is no need to save and restore the current mask value.  It is
@@ -601,8 +707,7 @@ void FreeRTOS_Tick_Handler( void )
 	/* Increment the RTOS tick. */
 	if( xTaskIncrementTick() != pdFALSE )
 	{
-		ulPortYieldRequired = pdTRUE;
-	}
+		ulPortYieldRequired[ portGET_CORE_ID() ] = pdTRUE;
 	}
 
 	/* Ensure all interrupt priorities are active again. */
@@ -618,8 +723,14 @@ void FreeRTOS_Tick_Handler( void )
 	uint32_t ulInitialFPSCR = 0;
 
 		/* A task is registering the fact that it needs an FPU context.  Set the
-		FPU flag (which is saved as part of the task context). */
-		ulPortTaskHasFPUContext = pdTRUE;
+		FPU flag (which is saved as part of the task context).  With the lazy
+		context switch the flag stays clear, and the FPSCR write below gives
+		the task the FPU. */
+		#if( configUSE_TASK_FPU_LAZY == 0 )
+		{
+			ulPortTaskHasFPUContext[ portGET_CORE_ID() ] = pdTRUE;
+		}
+		#endif
 
 		/* Initialise the floating point status register. */
 		__asm volatile ( "FMXR 	FPSCR, %0" :: "r" (ulInitialFPSCR) : "memory" );
@@ -628,6 +739,20 @@ void FreeRTOS_Tick_Handler( void )
 #endif /* configUSE_TASK_FPU_SUPPORT */
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TASK_FPU_LAZY == 1 )
+
+	void vPortCleanUpTCB( void *pxTCB )
+	{
+		/* The registers of a deleted task are not saved for it. */
+		if( pxPortFPUOwner == pxTCB )
+		{
+			pxPortFPUOwner = NULL;
+		}
+	}
+
+#endif /* configUSE_TASK_FPU_LAZY */
+/*-----------------------------------------------------------*/
+
 void vPortClearInterruptMask( uint32_t ulNewMaskValue )
 {
 	if( ulNewMaskValue == pdFALSE )
@@ -703,24 +828,112 @@ void vApplicationFPUSafeIRQHandler( uint32_t ulICCIAR )
 	( void ) ulICCIAR;
 	configASSERT( ( volatile void * ) NULL );
 }
+/*-----------------------------------------------------------*/
 
-#if( configGENERATE_RUN_TIME_STATS == 1 )
-/*
- * For Xilinx implementation this is a dummy function that does a redundant operation
- * of zeroing out the global counter.
- * It is called by FreeRTOS kernel.
- */
-void xCONFIGURE_TIMER_FOR_RUN_TIME_STATS (void)
-{
-	ulHighFrequencyTimerTicks = 0;
-}
-/*
- * For Xilinx implementation this function returns the global counter used for
- * run time task stats calculation.
- * It is called by FreeRTOS kernel task handling logic.
- */
-uint32_t xGET_RUN_TIME_COUNTER_VALUE (void)
-{
-	return ulHighFrequencyTimerTicks;
-}
-#endif
+#if( configNUMBER_OF_CORES > 1 )
+
+	void vPortYieldCore( BaseType_t xCoreID )
+	{
+		/* The kernel yields the calling core itself, so xCoreID is always the
+		other core. */
+		XScuGic_SoftwareIntr( &xInterruptController, portYIELD_CORE_SGI_ID, ( 1UL << xCoreID ) );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortGetLock( BaseType_t xLock )
+	{
+	const uint32_t ulOwner = ( uint32_t ) portGET_CORE_ID() + 1UL;
+	uint32_t ulValue, ulFailed;
+
+		/* Only the owner writes its own ID, so the check needs no exclusive
+		access. */
+		if( ulLockOwner[ xLock ] != ulOwner )
+		{
+			/* Wait for an event while another core holds the lock.  The owner
+			sends one as it releases it. */
+			do
+			{
+				__asm volatile (	"LDREX		%0, [%2]		\n"
+									"CMP		%0, #0			\n"
+									"MOVNE		%1, #1			\n"
+									"WFENE						\n"
+									"STREXEQ	%1, %3, [%2]	\n"
+									: "=&r" ( ulValue ), "=&r" ( ulFailed )
+									: "r" ( &( ulLockOwner[ xLock ] ) ), "r" ( ulOwner )
+									: "cc", "memory" );
+			} while( ulFailed != 0UL );
+
+			__asm volatile ( "DMB" ::: "memory" );
+		}
+
+		ulLockCount[ xLock ]++;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortReleaseLock( BaseType_t xLock )
+	{
+		configASSERT( ulLockOwner[ xLock ] == ( ( uint32_t ) portGET_CORE_ID() + 1UL ) );
+
+		ulLockCount[ xLock ]--;
+
+		if( ulLockCount[ xLock ] == 0UL )
+		{
+			__asm volatile ( "DMB" ::: "memory" );
+			ulLockOwner[ xLock ] = 0UL;
+			__asm volatile (	"DSB		\n"
+								"SEV		\n" ::: "memory" );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvStartCore1( void )
+	{
+		/* Core 1 runs with the translation table, domains, vector table, SMP
+		coherency, coprocessor access and caches of core 0. */
+		__asm volatile ( "MRC p15, 0, %0, c2, c0, 0" : "=r" ( ulPortCore0Registers[ portCORE0_TTBR0 ] ) );
+		__asm volatile ( "MRC p15, 0, %0, c3, c0, 0" : "=r" ( ulPortCore0Registers[ portCORE0_DACR ] ) );
+		__asm volatile ( "MRC p15, 0, %0, c12, c0, 0" : "=r" ( ulPortCore0Registers[ portCORE0_VBAR ] ) );
+		__asm volatile ( "MRC p15, 0, %0, c1, c0, 1" : "=r" ( ulPortCore0Registers[ portCORE0_ACTLR ] ) );
+		__asm volatile ( "MRC p15, 0, %0, c1, c0, 2" : "=r" ( ulPortCore0Registers[ portCORE0_CPACR ] ) );
+		__asm volatile ( "MRC p15, 0, %0, c1, c0, 0" : "=r" ( ulPortCore0Registers[ portCORE0_SCTLR ] ) );
+
+		/* Core 1 reads them, and the kernel, before its caches are on, so
+		they are written back to memory before it is released. */
+		Xil_Out32( portCORE1_START_ADDRESS, ( uint32_t ) FreeRTOS_Core1_Entry );
+		Xil_DCacheFlush();
+		__asm volatile (	"DSB		\n"
+							"SEV		\n" ::: "memory" );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortStartCore1( void )
+	{
+		/* Mask the interrupts the kernel uses until the first task starts, as
+		core 0 has them masked until then. */
+		portICCPMR_PRIORITY_MASK_REGISTER = ( uint32_t ) ( configMAX_API_CALL_INTERRUPT_PRIORITY << portPRIORITY_SHIFT );
+		*( ( volatile uint32_t * ) ( portINTERRUPT_CONTROLLER_CPU_INTERFACE_ADDRESS + portICCBPR_BINARY_POINT_OFFSET ) ) = 0UL;
+		*( ( volatile uint32_t * ) ( portINTERRUPT_CONTROLLER_CPU_INTERFACE_ADDRESS + portICCICR_CPU_INTERFACE_CONTROL_OFFSET ) ) = portICCICR_ENABLE_ALL;
+		prvEnableYieldInterrupt();
+
+		/* Start the task the kernel selected for core 1 as the scheduler
+		started. */
+		vPortRestoreTaskContext();
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvEnableYieldInterrupt( void )
+	{
+		XScuGic_SetPriorityTriggerType( &xInterruptController, portYIELD_CORE_SGI_ID, portLOWEST_USABLE_INTERRUPT_PRIORITY << portPRIORITY_SHIFT, 0x03U );
+		XScuGic_Enable( &xInterruptController, portYIELD_CORE_SGI_ID );
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvYieldCoreHandler( void *pvCallBackRef )
+	{
+		( void ) pvCallBackRef;
+
+		/* The switch is made as the interrupt returns. */
+		ulPortYieldRequired[ portGET_CORE_ID() ] = pdTRUE;
+	}
+
+#endif /* configNUMBER_OF_CORES */
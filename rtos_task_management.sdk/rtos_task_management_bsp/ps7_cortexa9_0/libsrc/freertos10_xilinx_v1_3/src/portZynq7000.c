@@ -33,9 +33,19 @@
 /* Xilinx includes. */
 #include "xscutimer.h"
 #include "xscugic.h"
+#include "xil_io.h"
+#include "xtime_l.h"
 
 #define XSCUTIMER_CLOCK_HZ ( XPAR_CPU_CORTEXA9_0_CPU_CLK_FREQ_HZ / 2UL )
 
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+	/* An estimate of the timer counts lost each time the timer is stopped to be
+	reprogrammed, subtracted from the counts of the sleep. */
+	#define portMISSED_COUNTS_FACTOR ( 45UL )
+
+#endif /* configUSE_TICKLESS_IDLE */
+
 /*
  * Some FreeRTOSConfig.h settings require the application writer to provide the
  * implementation of a callback function that has a specific name, and a linker
@@ -55,6 +65,36 @@ void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName ) __att
 /* Timer used to generate the tick interrupt. */
 static XScuTimer xTimer;
 XScuGic xInterruptController; 	/* Interrupt controller instance */
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+	/* The timer counts of one tick, and the most ticks the 32-bit counter can
+	count down in one sleep. */
+	static uint32_t ulTimerCountsForOneTick = 0;
+	static uint32_t ulMaximumPossibleSuppressedTicks = 0;
+
+#endif /* configUSE_TICKLESS_IDLE */
+
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+
+	/* Each of the times below is kept for each core, as each core takes its
+	own interrupts and runs its own tasks. */
+
+	/* The time spent in the handler of each interrupt, less the time of the
+	handlers that nested in it, and the number of times it ran.  The counts
+	are of the global timer, as are the run time stats. */
+	static volatile uint64_t ullInterruptRunTime[ configNUMBER_OF_CORES ][ XSCUGIC_MAX_NUM_INTR_INPUTS ];
+	static volatile uint32_t ulInterruptCount[ configNUMBER_OF_CORES ][ XSCUGIC_MAX_NUM_INTR_INPUTS ];
+
+	/* The time spent in all the handlers, and the number of handlers run, so
+	the run time counter can leave it out. */
+	static volatile uint64_t ullTotalInterruptRunTime[ configNUMBER_OF_CORES ];
+	static volatile uint32_t ulTotalInterruptCount[ configNUMBER_OF_CORES ];
+
+	/* The time of the handlers that nested in the running handler. */
+	static uint64_t ullNestedRunTime[ configNUMBER_OF_CORES ];
+
+#endif /* configGENERATE_RUN_TIME_STATS */
 /*-----------------------------------------------------------*/
 
 void FreeRTOS_SetupTickInterrupt( void )
@@ -96,15 +136,13 @@ const uint8_t ucRisingEdge = 3;
 	/* Ensure there is no prescale. */
 	XScuTimer_SetPrescaler( &xTimer, 0 );
 
-	/* Load the timer counter register.
-	 * The Xilinx implementation of generating run time task stats uses the same timer used for generating
-	 * FreeRTOS ticks. In case user decides to generate run time stats the timer time out interval is changed
-	 * as "configured tick rate * 10". The multiplying factor of 10 is hard coded for Xilinx FreeRTOS ports.
-	 */
-#if (configGENERATE_RUN_TIME_STATS == 1)
-	XScuTimer_LoadTimer( &xTimer, XSCUTIMER_CLOCK_HZ / (configTICK_RATE_HZ * 10) );
-#else
+	/* Load the timer counter register.  The run time stats count the global
+	timer, so the tick timer always runs at the tick rate. */
 	XScuTimer_LoadTimer( &xTimer, XSCUTIMER_CLOCK_HZ / configTICK_RATE_HZ );
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+	ulTimerCountsForOneTick = XSCUTIMER_CLOCK_HZ / configTICK_RATE_HZ;
+	ulMaximumPossibleSuppressedTicks = 0xFFFFFFFFUL / ulTimerCountsForOneTick;
 #endif
 
 	/* Start the timer counter and then wait for it to timeout a number of
@@ -126,12 +164,108 @@ void FreeRTOS_ClearTickInterrupt( void )
 }
 /*-----------------------------------------------------------*/
 
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+	uint32_t ulCounter, ulReloadValue, ulCompleteTickPeriods, ulCompletedCounts;
+	TickType_t xModifiableIdleTime;
+
+		/* Make sure the counter can hold the sleep. */
+		if( xExpectedIdleTime > ulMaximumPossibleSuppressedTicks )
+		{
+			xExpectedIdleTime = ulMaximumPossibleSuppressedTicks;
+		}
+
+		/* Mask interrupts in the CPU rather than in the GIC.  An interrupt that
+		becomes pending still ends the WFI, but is not taken until the tick
+		count has been corrected. */
+		__asm volatile ( "CPSID i	\n"
+						 "DSB		\n"
+						 "ISB		\n" ::: "memory" );
+
+		/* Stop the timer while it is reprogrammed.  The counter holds what is
+		left of the current tick period. */
+		XScuTimer_Stop( &xTimer );
+		ulCounter = XScuTimer_GetCounterValue( &xTimer );
+
+		/* Do not sleep if the tick became pending after the kernel worked out
+		the idle time, or if a task was readied since. */
+		if( ( XScuTimer_IsExpired( &xTimer ) ) || ( eTaskConfirmSleepModeStatus() == eAbortSleep ) )
+		{
+			XScuTimer_Start( &xTimer );
+			__asm volatile ( "CPSIE i" ::: "memory" );
+			return;
+		}
+
+		/* Count down to the end of the expected idle time.  Only the counter
+		is written, so the load register keeps one tick period, and the timer
+		carries on with ordinary ticks once it expires. */
+		ulReloadValue = ulCounter + ( ulTimerCountsForOneTick * ( xExpectedIdleTime - 1UL ) );
+		if( ulReloadValue > portMISSED_COUNTS_FACTOR )
+		{
+			ulReloadValue -= portMISSED_COUNTS_FACTOR;
+		}
+		XScuTimer_SetCounterReg( xTimer.Config.BaseAddr, ulReloadValue );
+		XScuTimer_Start( &xTimer );
+
+		/* The application may sleep itself, setting xModifiableIdleTime to 0
+		so the WFI is skipped. */
+		xModifiableIdleTime = xExpectedIdleTime;
+		configPRE_SLEEP_PROCESSING( xModifiableIdleTime );
+		if( xModifiableIdleTime > 0 )
+		{
+			__asm volatile ( "DSB	\n"
+							 "WFI	\n"
+							 "ISB	\n" ::: "memory" );
+		}
+		configPOST_SLEEP_PROCESSING( xExpectedIdleTime );
+
+		XScuTimer_Stop( &xTimer );
+		ulCounter = XScuTimer_GetCounterValue( &xTimer );
+
+		if( XScuTimer_IsExpired( &xTimer ) )
+		{
+			/* The timer counted down the whole sleep and reloaded one tick
+			period.  The tick interrupt is pending, and counts the last tick
+			of the sleep once interrupts are unmasked. */
+			ulCompleteTickPeriods = xExpectedIdleTime - 1UL;
+		}
+		else
+		{
+			/* Another interrupt ended the sleep.  Count the tick periods that
+			completed, and leave the counter with what is left of the current
+			one. */
+			ulCompletedCounts = ( xExpectedIdleTime * ulTimerCountsForOneTick ) - ulCounter;
+			ulCompleteTickPeriods = ulCompletedCounts / ulTimerCountsForOneTick;
+			XScuTimer_SetCounterReg( xTimer.Config.BaseAddr, ( ( ulCompleteTickPeriods + 1UL ) * ulTimerCountsForOneTick ) - ulCompletedCounts );
+		}
+
+		/* The step is less than the expected idle time, so the tick that
+		unblocks the next task is always taken by the tick interrupt. */
+		XScuTimer_Start( &xTimer );
+		vTaskStepTick( ulCompleteTickPeriods );
+
+		__asm volatile ( "CPSIE i	\n"
+						 "DSB		\n"
+						 "ISB		\n" ::: "memory" );
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
 void vApplicationIRQHandler( uint32_t ulICCIAR )
 {
 extern const XScuGic_Config XScuGic_ConfigTable[];
+extern volatile uint32_t ulPortInterruptNesting[];
 static const XScuGic_VectorTableEntry *pxVectorTable = XScuGic_ConfigTable[ XPAR_SCUGIC_SINGLE_DEVICE_ID ].HandlerTable;
 uint32_t ulInterruptID;
 const XScuGic_VectorTableEntry *pxVectorEntry;
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+	const BaseType_t xCoreID = portGET_CORE_ID();
+	XTime xStart, xEnd;
+	uint64_t ullOuterNestedRunTime, ullElapsed;
+#endif
 
 	/* The ID of the interrupt is obtained by bitwise anding the ICCIAR value
 	with 0x3FF. */
@@ -140,11 +274,124 @@ const XScuGic_VectorTableEntry *pxVectorEntry;
 	{
 		/* Call the function installed in the array of installed handler functions. */
 		pxVectorEntry = &( pxVectorTable[ ulInterruptID ] );
-		pxVectorEntry->Handler( pxVectorEntry->CallBackRef );
+		traceISR_ENTER( ulInterruptID );
+
+		#if( configGENERATE_RUN_TIME_STATS == 1 )
+		{
+			/* The IRQ is still masked in the CPU on entry.  A handler that
+			unmasks it, as the tick handler does, can be nested in, so the
+			handlers nested in this one are timed from zero and their time
+			added back to the handler this one is nested in. */
+			ullOuterNestedRunTime = ullNestedRunTime[ xCoreID ];
+			ullNestedRunTime[ xCoreID ] = 0;
+			XTime_GetTime( &xStart );
+
+			pxVectorEntry->Handler( pxVectorEntry->CallBackRef );
+
+			/* Mask the IRQ again while the times are updated.  It stays masked
+			until the asm wrapper returns from the interrupt. */
+			__asm volatile ( "CPSID i	\n"
+							 "DSB		\n"
+							 "ISB		\n" ::: "memory" );
+			XTime_GetTime( &xEnd );
+			ullElapsed = ( uint64_t ) ( xEnd - xStart );
+			ullInterruptRunTime[ xCoreID ][ ulInterruptID ] += ullElapsed - ullNestedRunTime[ xCoreID ];
+			ulInterruptCount[ xCoreID ][ ulInterruptID ]++;
+			ullNestedRunTime[ xCoreID ] = ullOuterNestedRunTime + ullElapsed;
+
+			/* The outermost handler covers the time of those nested in it. */
+			if( ulPortInterruptNesting[ xCoreID ] == 1UL )
+			{
+				ullTotalInterruptRunTime[ xCoreID ] += ullElapsed;
+			}
+			ulTotalInterruptCount[ xCoreID ]++;
+		}
+		#else
+		{
+			pxVectorEntry->Handler( pxVectorEntry->CallBackRef );
+		}
+		#endif /* configGENERATE_RUN_TIME_STATS */
+
+		traceISR_EXIT( ulInterruptID );
 	}
 }
 /*-----------------------------------------------------------*/
 
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+
+	void xCONFIGURE_TIMER_FOR_RUN_TIME_STATS( void )
+	{
+		/* The global timer is free running from boot, as XTime_GetTime()
+		relies on throughout the BSP.  Only make sure it is enabled. */
+		if( ( Xil_In32( GLOBAL_TMR_BASEADDR + GTIMER_CONTROL_OFFSET ) & 0x1UL ) == 0UL )
+		{
+			Xil_Out32( GLOBAL_TMR_BASEADDR + GTIMER_CONTROL_OFFSET, 0x1UL );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	uint64_t xGET_RUN_TIME_COUNTER_VALUE( void )
+	{
+	const BaseType_t xCoreID = portGET_CORE_ID();
+	XTime xNow;
+	uint64_t ullInterruptTime;
+	uint32_t ulCount;
+
+		/* The 64-bit global timer, less the time spent in the interrupt
+		handlers of the calling core, so a task is not charged for the
+		interrupts that preempt it.  Read again if a handler ran part way
+		through.  The kernel calls this with the interrupts of the core masked,
+		so the caller stays on the core. */
+		do
+		{
+			ulCount = ulTotalInterruptCount[ xCoreID ];
+			ullInterruptTime = ullTotalInterruptRunTime[ xCoreID ];
+			XTime_GetTime( &xNow );
+		} while( ulCount != ulTotalInterruptCount[ xCoreID ] );
+
+		return ( uint64_t ) xNow - ullInterruptTime;
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxPortGetInterruptRunTime( PortInterruptRunTime_t *pxInterruptRunTime, UBaseType_t uxArraySize )
+	{
+	UBaseType_t uxCount = 0;
+	uint32_t ulInterruptID, ulCount;
+	uint64_t ullRunTime;
+	BaseType_t xCoreID;
+
+		for( ulInterruptID = 0; ( ulInterruptID < XSCUGIC_MAX_NUM_INTR_INPUTS ) && ( uxCount < uxArraySize ); ulInterruptID++ )
+		{
+			pxInterruptRunTime[ uxCount ].ulCount = 0UL;
+			pxInterruptRunTime[ uxCount ].ullRunTime = 0ULL;
+
+			/* The interrupt as taken on every core. */
+			for( xCoreID = 0; xCoreID < configNUMBER_OF_CORES; xCoreID++ )
+			{
+				/* Read again if the handler ran part way through. */
+				do
+				{
+					ulCount = ulInterruptCount[ xCoreID ][ ulInterruptID ];
+					ullRunTime = ullInterruptRunTime[ xCoreID ][ ulInterruptID ];
+				} while( ulCount != ulInterruptCount[ xCoreID ][ ulInterruptID ] );
+
+				pxInterruptRunTime[ uxCount ].ulCount += ulCount;
+				pxInterruptRunTime[ uxCount ].ullRunTime += ullRunTime;
+			}
+
+			if( pxInterruptRunTime[ uxCount ].ulCount != 0UL )
+			{
+				pxInterruptRunTime[ uxCount ].ulInterruptID = ulInterruptID;
+				uxCount++;
+			}
+		}
+
+		return uxCount;
+	}
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+/*-----------------------------------------------------------*/
+
 /* This version of vApplicationAssert() is declared as a weak symbol to allow it
 to be overridden by a version implemented within the application that is using
 this BSP. */
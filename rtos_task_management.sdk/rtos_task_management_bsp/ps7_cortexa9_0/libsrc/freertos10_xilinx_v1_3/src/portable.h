@@ -102,7 +102,7 @@ extern "C" {
 	StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters ) PRIVILEGED_FUNCTION;
 #endif
 
-/* Used by heap_5.c. */
+/* Used by heap_5.c, and by heap_tlsf.c with configUSE_HEAP_REGIONS. */
 typedef struct HeapRegion
 {
 	uint8_t *pucStartAddress;
@@ -118,10 +118,47 @@ typedef struct HeapRegion
  * pxHeapRegions passes in an array of HeapRegion_t structures - each of which
  * defines a region of memory that can be used as the heap.  The array is
  * terminated by a HeapRegions_t structure that has a size of 0.  The region
- * with the lowest start address must appear first in the array.
+ * with the lowest start address must appear first in the array.  heap_tlsf.c
+ * takes the regions in any order of address, fastest first instead.
  */
 void vPortDefineHeapRegions( const HeapRegion_t * const pxHeapRegions ) PRIVILEGED_FUNCTION;
 
+/* Where pvPortMallocHint() places a block, among the heap regions. */
+typedef enum
+{
+	eHeapFast = 0,	/* The fastest region with room, for kernel objects, hot stacks and queue storage. */
+	eHeapBulk		/* The slowest region with room, for large buffers. */
+} eHeapHint;
+
+/* The use of a heap region, from vPortGetHeapRegionStats(). */
+typedef struct xHEAP_REGION_STATS
+{
+	uint8_t *pucStartAddress;		/* The start of the region. */
+	size_t xTotalBytes;				/* The bytes that can be allocated, headers included. */
+	size_t xFreeBytes;				/* The bytes free now. */
+	size_t xMinimumEverFreeBytes;	/* The fewest bytes that have been free. */
+	size_t xLargestFreeBlock;		/* The largest block that is free now. */
+	size_t xAllocations;			/* The successful allocations from the region. */
+	size_t xFrees;					/* The frees to the region. */
+} HeapRegionStats_t;
+
+/*
+ * Allocate from the heap regions in the order of eHint, see heap_tlsf.c.  The
+ * other heaps have one region, so the hint is ignored.
+ */
+#if( configUSE_HEAP_TLSF == 1 )
+	void *pvPortMallocHint( size_t xSize, eHeapHint eHint ) PRIVILEGED_FUNCTION;
+#else
+	#define pvPortMallocHint( xSize, eHint ) pvPortMalloc( xSize )
+#endif
+
+/*
+ * The number of regions passed to vPortDefineHeapRegions(), and the use of
+ * each, with configUSE_HEAP_REGIONS.
+ */
+UBaseType_t uxPortGetHeapRegionCount( void ) PRIVILEGED_FUNCTION;
+void vPortGetHeapRegionStats( UBaseType_t uxRegion, HeapRegionStats_t *pxStats ) PRIVILEGED_FUNCTION;
+
 
 /*
  * Map to the memory management routines required for the port.
@@ -132,6 +169,14 @@ void vPortInitialiseBlocks( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 size_t xPortGetMinimumEverFreeHeapSize( void ) PRIVILEGED_FUNCTION;
 
+/*
+ * The percentage of the free heap that is outside its largest free block, so
+ * 0 while the free heap is one block.  With the regions of heap_tlsf.c, it is
+ * outside the largest free block of each region.  Provided by heap_4.c and
+ * heap_tlsf.c.
+ */
+size_t xPortGetHeapFragmentation( void ) PRIVILEGED_FUNCTION;
+
 /*
  * Setup the hardware ready for the scheduler to take control.  This generally
  * sets up a tick interrupt and sets timers for the correct tick frequency.
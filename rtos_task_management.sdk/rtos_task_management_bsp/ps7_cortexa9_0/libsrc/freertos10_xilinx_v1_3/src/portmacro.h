@@ -75,11 +75,11 @@ typedef uint32_t TickType_t;
 /* Called at the end of an ISR that can cause a context switch. */
 #define portEND_SWITCHING_ISR( xSwitchRequired )\
 {												\
-extern uint32_t ulPortYieldRequired;			\
+extern volatile uint32_t ulPortYieldRequired[];	\
 												\
 	if( xSwitchRequired != pdFALSE )			\
 	{											\
-		ulPortYieldRequired = pdTRUE;			\
+		ulPortYieldRequired[ portGET_CORE_ID() ] = pdTRUE;	\
 	}											\
 }
 
@@ -96,6 +96,9 @@ extern void vPortExitCritical( void );
 extern uint32_t ulPortSetInterruptMask( void );
 extern void vPortClearInterruptMask( uint32_t ulNewMaskValue );
 extern void vPortInstallFreeRTOSVectorTable( void );
+/* pdTRUE if called from an interrupt handler, for code shared by tasks and
+ISRs that must choose between an API function and its FromISR form. */
+extern BaseType_t xPortIsInsideInterrupt( void );
 
 /* These macros do not globally disable/enable interrupts.  They do mask off
 interrupts that have a priority below configMAX_API_CALL_INTERRUPT_PRIORITY. */
@@ -104,6 +107,47 @@ interrupts that have a priority below configMAX_API_CALL_INTERRUPT_PRIORITY. */
 #define portDISABLE_INTERRUPTS()	ulPortSetInterruptMask()
 #define portENABLE_INTERRUPTS()		vPortClearInterruptMask( 0 )
 
+/*-----------------------------------------------------------
+ * Multiple cores
+ *
+ * With configNUMBER_OF_CORES set to 2 the kernel schedules the tasks on both
+ * Cortex-A9 cores.  The port keeps the critical nesting, the interrupt nesting,
+ * the pending yield and the FPU flag of each core, indexed by the CPU ID field
+ * of the MPIDR.  A core is made to switch tasks by the software generated
+ * interrupt portYIELD_CORE_SGI_ID, and the two kernel locks are spin locks
+ * taken with LDREX/STREX.  With one core, only core 0 runs the kernel.
+ *----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+	#define portYIELD_CORE_SGI_ID				( 0U )
+	#define portTASK_LOCK						0
+	#define portISR_LOCK						1
+
+	static __inline BaseType_t xPortGetCoreID( void )
+	{
+	uint32_t ulMPIDR;
+
+		__asm volatile ( "MRC p15, 0, %0, c0, c0, 5" : "=r" ( ulMPIDR ) );
+		return ( BaseType_t ) ( ulMPIDR & 0x03UL );
+	}
+
+	extern volatile uint32_t ulCriticalNesting[];
+	void vPortYieldCore( BaseType_t xCoreID );
+	void vPortGetLock( BaseType_t xLock );
+	void vPortReleaseLock( BaseType_t xLock );
+
+	#define portGET_CORE_ID()					xPortGetCoreID()
+	#define portYIELD_CORE( xCoreID )			vPortYieldCore( xCoreID )
+	#define portGET_TASK_LOCK()					vPortGetLock( portTASK_LOCK )
+	#define portRELEASE_TASK_LOCK()				vPortReleaseLock( portTASK_LOCK )
+	#define portGET_ISR_LOCK()					vPortGetLock( portISR_LOCK )
+	#define portRELEASE_ISR_LOCK()				vPortReleaseLock( portISR_LOCK )
+	#define portGET_CRITICAL_NESTING_COUNT()	( ulCriticalNesting[ portGET_CORE_ID() ] )
+	#define portSET_CRITICAL_NESTING_COUNT( x )	( ulCriticalNesting[ portGET_CORE_ID() ] = ( x ) )
+#else
+	#define portGET_CORE_ID()					( ( BaseType_t ) 0 )
+#endif /* configNUMBER_OF_CORES */
+
 /*-----------------------------------------------------------*/
 
 /* Task function macros as described on the FreeRTOS.org WEB site.  These are
@@ -181,6 +225,49 @@ by default. */
 #endif
 #define portTASK_USES_FLOATING_POINT() vPortTaskUsesFPU()
 
+/* If configUSE_TASK_FPU_LAZY is set to 1, the FPU is disabled whenever the task
+that last used it is switched out, and the first floating point instruction of
+another task traps, saves the registers of the last on its stack and gives the
+FPU to the new one.  So no task needs vPortTaskUsesFPU(), and tasks that do not
+use the FPU never pay for saving it.  Every task that uses the FPU needs stack
+space for its registers, and interrupt handlers must not use the FPU unless
+they are called through vApplicationFPUSafeIRQHandler(). */
+#if( configUSE_TASK_FPU_LAZY == 1 )
+	void vPortCleanUpTCB( void *pxTCB );
+	#define portCLEAN_UP_TCB( pxTCB ) vPortCleanUpTCB( pxTCB )
+#endif
+
+/* With tickless idle, the idle task stops the tick until the next task is due
+to unblock, by reprogramming the SCU private timer in portZynq7000.c. */
+#if( configUSE_TICKLESS_IDLE == 1 )
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
+/* With the run time stats, portZynq7000.c counts the 64-bit global timer, less
+the time spent in interrupt handlers, which it accounts for by interrupt ID. */
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+	/* The handler time of one interrupt, in global timer counts. */
+	typedef struct xPORT_INTERRUPT_RUN_TIME
+	{
+		uint32_t ulInterruptID;		/* The ID of the interrupt. */
+		uint32_t ulCount;			/* The number of times its handler ran. */
+		uint64_t ullRunTime;		/* The time spent in its handler, less that of the handlers nested in it. */
+	} PortInterruptRunTime_t;
+
+	void xCONFIGURE_TIMER_FOR_RUN_TIME_STATS( void );
+	uint64_t xGET_RUN_TIME_COUNTER_VALUE( void );
+
+	/* Fill pxInterruptRunTime with up to uxArraySize of the interrupts that
+	have run, in order of ID, returning how many were filled in. */
+	UBaseType_t uxPortGetInterruptRunTime( PortInterruptRunTime_t *pxInterruptRunTime, UBaseType_t uxArraySize );
+#endif
+
+/* The trace recorder stamps its records with the low word of the global timer,
+read in place rather than through XTime_GetTime() to keep an event short. */
+#define portGLOBAL_TIMER_COUNTER_LOWER ( 0xF8F00200UL )
+#define portGET_TRACE_TIMESTAMP() ( *( ( volatile uint32_t * ) portGLOBAL_TIMER_COUNTER_LOWER ) )
+
 #define portLOWEST_INTERRUPT_PRIORITY ( ( ( uint32_t ) configUNIQUE_INTERRUPT_PRIORITIES ) - 1UL )
 #define portLOWEST_USABLE_INTERRUPT_PRIORITY ( portLOWEST_INTERRUPT_PRIORITY - 1UL )
 
@@ -37,6 +37,10 @@ task.h is included from an application file. */
 #include "task.h"
 #include "queue.h"
 
+#if ( configUSE_MEM_POOLS == 1 )
+	#include "mem_pool.h"
+#endif
+
 #if ( configUSE_CO_ROUTINES == 1 )
 	#include "croutine.h"
 #endif
@@ -51,6 +55,7 @@ correct privileged Vs unprivileged linkage and placement. */
 /* Constants used with the cRxLock and cTxLock structure members. */
 #define queueUNLOCKED					( ( int8_t ) -1 )
 #define queueLOCKED_UNMODIFIED			( ( int8_t ) 0 )
+#define queueINT8_MAX					( ( int8_t ) 127 )
 
 /* When the Queue_t structure is used to represent a base queue its pcHead and
 pcTail members are used as pointers into the queue storage area.  When the
@@ -128,6 +133,10 @@ typedef struct QueueDefinition /* The old naming convention is used to prevent b
 		uint8_t ucQueueType;
 	#endif
 
+	#if ( configUSE_MEM_POOLS == 1 )
+		struct MemPoolDef_t *pxPool;	/*< The pool of the buffers of a queue by reference, or NULL. */
+	#endif
+
 } xQUEUE;
 
 /* The old xQUEUE name is maintained above then typedefed to the new Queue_t
@@ -198,12 +207,46 @@ static BaseType_t prvCopyDataToQueue( Queue_t * const pxQueue, const void *pvIte
  */
 static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer ) PRIVILEGED_FUNCTION;
 
+/*
+ * Copies uxCount items to the back of a queue, or out of the front of it.  The
+ * items are copied in at most two blocks, as they can wrap around the end of
+ * the storage area.
+ */
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks up to uxCount tasks of an event list, one for each item sent or
+ * received by a batch, and returns pdTRUE if any of them has a priority above
+ * that of the running task.  Must be called from a critical section.
+ */
+static BaseType_t prvUnblockTasks( List_t * const pxEventList, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Unblocks the tasks waiting to receive the uxCount items a batch sent to a
+ * queue, or notifies the queue set of the queue of all of the items at once.
+ */
+static BaseType_t prvNotifyItemsSent( Queue_t * const pxQueue, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
+/*
+ * Adds the items a batch moved while the queue was locked to a lock count,
+ * which then stays at its largest value rather than overflow.
+ */
+static int8_t prvAddToLockCount( const int8_t cLock, const UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
+
 #if ( configUSE_QUEUE_SETS == 1 )
 	/*
 	 * Checks to see if a queue is a member of a queue set, and if so, notifies
 	 * the queue set that the queue contains data.
 	 */
 	static BaseType_t prvNotifyQueueSetContainer( const Queue_t * const pxQueue, const BaseType_t xCopyPosition ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Notifies the queue set of a queue that a batch sent uxCount items to the
+	 * queue, in one post that unblocks the tasks waiting on the set at most
+	 * once each.
+	 */
+	static BaseType_t prvNotifyQueueSetContainerItems( const Queue_t * const pxQueue, UBaseType_t uxCount ) PRIVILEGED_FUNCTION;
 #endif
 
 /*
@@ -252,6 +295,33 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	taskEXIT_CRITICAL()
 /*-----------------------------------------------------------*/
 
+/*
+ * Macro to copy one item into or out of the queue storage area.  Most items
+ * are pointers, handles or timestamps, of 4 or 8 bytes.  These are copied by
+ * memcpy() of a constant size, which the compiler turns into a word load and
+ * store, without a call.  The items of the caller need not be aligned, so
+ * they are not copied through uint32_t or uint64_t pointers, which the
+ * compiler may load with double word accesses that fault when not aligned.
+ * Other sizes are copied by a call of memcpy() for uxItemSize bytes.
+ */
+#define prvCopyItem( pxQueue, pvTo, pvFrom )													\
+	do																							\
+	{																							\
+		switch( ( pxQueue )->uxItemSize )														\
+		{																						\
+			case sizeof( uint32_t ):															\
+				( void ) memcpy( ( void * ) ( pvTo ), ( const void * ) ( pvFrom ), sizeof( uint32_t ) );	\
+				break;																			\
+			case sizeof( uint64_t ):															\
+				( void ) memcpy( ( void * ) ( pvTo ), ( const void * ) ( pvFrom ), sizeof( uint64_t ) );	\
+				break;																			\
+			default:																			\
+				( void ) memcpy( ( void * ) ( pvTo ), ( const void * ) ( pvFrom ), ( size_t ) ( pxQueue )->uxItemSize );	\
+				break;																			\
+		}																						\
+	} while( 0 )
+/*-----------------------------------------------------------*/
+
 BaseType_t xQueueGenericReset( QueueHandle_t xQueue, BaseType_t xNewQueue )
 {
 Queue_t * const pxQueue = xQueue;
@@ -464,6 +534,12 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 	}
 	#endif /* configUSE_QUEUE_SETS */
 
+	#if( configUSE_MEM_POOLS == 1 )
+	{
+		pxNewQueue->pxPool = NULL;
+	}
+	#endif /* configUSE_MEM_POOLS */
+
 	traceQUEUE_CREATE( pxNewQueue );
 }
 /*-----------------------------------------------------------*/
@@ -716,6 +792,159 @@ static void prvInitialiseNewQueue( const UBaseType_t uxQueueLength, const UBaseT
 #endif /* ( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if( ( configUSE_MEM_POOLS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
+
+	QueueHandle_t xQueueCreateByReference( const UBaseType_t uxQueueLength, MemPoolHandle_t pxPool )
+	{
+	Queue_t *pxNewQueue;
+
+		configASSERT( pxPool );
+
+		pxNewQueue = xQueueGenericCreate( uxQueueLength, ( UBaseType_t ) sizeof( QueueReference_t ), queueQUEUE_TYPE_BASE );
+
+		if( pxNewQueue != NULL )
+		{
+			pxNewQueue->pxPool = pxPool;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewQueue;
+	}
+
+#endif /* ( ( configUSE_MEM_POOLS == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) ) */
+/*-----------------------------------------------------------*/
+
+#if( configUSE_MEM_POOLS == 1 )
+
+	QueueHandle_t xQueueCreateByReferenceStatic( const UBaseType_t uxQueueLength, MemPoolHandle_t pxPool, uint8_t *pucQueueStorage, StaticQueue_t *pxStaticQueue )
+	{
+	Queue_t *pxNewQueue;
+
+		configASSERT( pxPool );
+
+		pxNewQueue = xQueueGenericCreateStatic( uxQueueLength, ( UBaseType_t ) sizeof( QueueReference_t ), pucQueueStorage, pxStaticQueue, queueQUEUE_TYPE_BASE );
+
+		if( pxNewQueue != NULL )
+		{
+			pxNewQueue->pxPool = pxPool;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return pxNewQueue;
+	}
+	/*-----------------------------------------------------------*/
+
+	void *pvQueueAcquireBuffer( QueueHandle_t xQueue, TickType_t xTicksToWait )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pxPool != NULL );
+
+		return pvMemPoolAlloc( pxQueue->pxPool, xTicksToWait );
+	}
+	/*-----------------------------------------------------------*/
+
+	void *pvQueueAcquireBufferFromISR( QueueHandle_t xQueue )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pxPool != NULL );
+
+		return pvMemPoolAllocFromISR( pxQueue->pxPool );
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xQueueSendReference( QueueHandle_t xQueue, void *pvBuffer, size_t xLength, TickType_t xTicksToWait )
+	{
+	Queue_t * const pxQueue = xQueue;
+	QueueReference_t xReference;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pxPool != NULL );
+		configASSERT( xMemPoolContains( pxQueue->pxPool, pvBuffer ) );
+		configASSERT( xLength <= xMemPoolGetBlockSize( pxQueue->pxPool ) );
+
+		xReference.pvBuffer = pvBuffer;
+		xReference.xLength = xLength;
+
+		/* Only the reference is copied into the queue, so the buffer is handed
+		over where it is. */
+		return xQueueGenericSend( xQueue, &xReference, xTicksToWait, queueSEND_TO_BACK );
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xQueueSendReferenceFromISR( QueueHandle_t xQueue, void *pvBuffer, size_t xLength, BaseType_t * const pxHigherPriorityTaskWoken )
+	{
+	Queue_t * const pxQueue = xQueue;
+	QueueReference_t xReference;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pxPool != NULL );
+		configASSERT( xMemPoolContains( pxQueue->pxPool, pvBuffer ) );
+		configASSERT( xLength <= xMemPoolGetBlockSize( pxQueue->pxPool ) );
+
+		xReference.pvBuffer = pvBuffer;
+		xReference.xLength = xLength;
+
+		return xQueueGenericSendFromISR( xQueue, &xReference, pxHigherPriorityTaskWoken, queueSEND_TO_BACK );
+	}
+	/*-----------------------------------------------------------*/
+
+	BaseType_t xQueueReceiveReference( QueueHandle_t xQueue, void **ppvBuffer, size_t *pxLength, TickType_t xTicksToWait )
+	{
+	Queue_t * const pxQueue = xQueue;
+	QueueReference_t xReference;
+	BaseType_t xReturn;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pxPool != NULL );
+		configASSERT( ppvBuffer );
+
+		xReturn = xQueueReceive( xQueue, &xReference, xTicksToWait );
+
+		if( xReturn == pdPASS )
+		{
+			*ppvBuffer = xReference.pvBuffer;
+
+			if( pxLength != NULL )
+			{
+				*pxLength = xReference.xLength;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			*ppvBuffer = NULL;
+		}
+
+		return xReturn;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vQueueReleaseBuffer( QueueHandle_t xQueue, void *pvBuffer )
+	{
+	Queue_t * const pxQueue = xQueue;
+
+		configASSERT( pxQueue );
+		configASSERT( pxQueue->pxPool != NULL );
+
+		vMemPoolFree( pxQueue->pxPool, pvBuffer );
+	}
+
+#endif /* configUSE_MEM_POOLS */
+/*-----------------------------------------------------------*/
+
 #if( ( configUSE_COUNTING_SEMAPHORES == 1 ) && ( configSUPPORT_DYNAMIC_ALLOCATION == 1 ) )
 
 	QueueHandle_t xQueueCreateCountingSemaphore( const UBaseType_t uxMaxCount, const UBaseType_t uxInitialCount )
@@ -985,7 +1214,7 @@ Queue_t * const pxQueue = xQueue;
 	read, instead return a flag to say whether a context switch is required or
 	not (i.e. has a task with a higher priority than us been woken by this
 	post). */
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		if( ( pxQueue->uxMessagesWaiting < pxQueue->uxLength ) || ( xCopyPosition == queueOVERWRITE ) )
 		{
@@ -1099,7 +1328,7 @@ Queue_t * const pxQueue = xQueue;
 			xReturn = errQUEUE_FULL;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1144,7 +1373,7 @@ Queue_t * const pxQueue = xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1264,7 +1493,7 @@ Queue_t * const pxQueue = xQueue;
 			xReturn = errQUEUE_FULL;
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
@@ -1803,7 +2032,7 @@ Queue_t * const pxQueue = xQueue;
 	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
 	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 	{
 		const UBaseType_t uxMessagesWaiting = pxQueue->uxMessagesWaiting;
 
@@ -1863,96 +2092,479 @@ Queue_t * const pxQueue = xQueue;
 			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
 		}
 	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 	return xReturn;
 }
 /*-----------------------------------------------------------*/
 
-BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,  void * const pvBuffer )
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait )
 {
-BaseType_t xReturn;
-UBaseType_t uxSavedInterruptStatus;
-int8_t *pcOriginalReadPosition;
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+UBaseType_t uxSent = ( UBaseType_t ) 0, uxCount;
 Queue_t * const pxQueue = xQueue;
 
 	configASSERT( pxQueue );
-	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
-	configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
-
-	/* RTOS ports that support interrupt nesting have the concept of a maximum
-	system call (or maximum API call) interrupt priority.  Interrupts that are
-	above the maximum system call priority are kept permanently enabled, even
-	when the RTOS kernel is in a critical section, but cannot make any calls to
-	FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
-	then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
-	failure if a FreeRTOS API function is called from an interrupt that has been
-	assigned a priority above the configured maximum system call priority.
-	Only FreeRTOS functions that end in FromISR can be called from interrupts
-	that have been assigned a priority at or (logically) below the maximum
-	system call	interrupt priority.  FreeRTOS maintains a separate interrupt
-	safe API to ensure interrupt entry is as fast and as simple as possible.
-	More information (albeit Cortex-M specific) is provided on the following
-	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
-	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
 
-	uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+	/*lint -save -e904 This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
 	{
-		/* Cannot block in an ISR, so check there is data available. */
-		if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+		taskENTER_CRITICAL();
 		{
-			traceQUEUE_PEEK_FROM_ISR( pxQueue );
+			/* Send as many of the items left as there is room for, all in
+			this critical section. */
+			uxCount = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+			if( uxCount > ( uxItemCount - uxSent ) )
+			{
+				uxCount = uxItemCount - uxSent;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-			/* Remember the read position so it can be reset as nothing is
-			actually being removed from the queue. */
-			pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
-			prvCopyDataFromQueue( pxQueue, pvBuffer );
-			pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+			if( uxCount > ( UBaseType_t ) 0 )
+			{
+				traceQUEUE_SEND( pxQueue );
+				prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItems + ( ( size_t ) uxSent * ( size_t ) pxQueue->uxItemSize ), uxCount );
+				uxSent += uxCount;
 
-			xReturn = pdPASS;
-		}
-		else
-		{
-			xReturn = pdFAIL;
-			traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
-		}
-	}
-	portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+				/* Unblock the tasks waiting for the items, and yield once if
+				any has a priority above our own. */
+				if( prvNotifyItemsSent( pxQueue, uxCount ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 
-	return xReturn;
-}
-/*-----------------------------------------------------------*/
+			if( uxSent == uxItemCount )
+			{
+				taskEXIT_CRITICAL();
+				return ( BaseType_t ) uxSent;
+			}
+			else if( xTicksToWait == ( TickType_t ) 0 )
+			{
+				/* The queue is full and no block time is specified (or the
+				block time has expired) so leave with the items sent. */
+				taskEXIT_CRITICAL();
+				traceQUEUE_SEND_FAILED( pxQueue );
+				return ( BaseType_t ) uxSent;
+			}
+			else if( xEntryTimeSet == pdFALSE )
+			{
+				vTaskInternalSetTimeOutState( &xTimeOut );
+				xEntryTimeSet = pdTRUE;
+			}
+			else
+			{
+				/* Entry time was already set. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
 
-UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
-{
-UBaseType_t uxReturn;
+		/* Block until there is room for more, as xQueueGenericSend() does. */
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
 
-	configASSERT( xQueue );
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueFull( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_SEND( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToSend ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
 
-	taskENTER_CRITICAL();
-	{
-		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
-	}
-	taskEXIT_CRITICAL();
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+			}
+			else
+			{
+				/* Try again. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* The timeout has expired. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
 
-	return uxReturn;
-} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+			traceQUEUE_SEND_FAILED( pxQueue );
+			return ( BaseType_t ) uxSent;
+		}
+	} /*lint -restore */
+}
 /*-----------------------------------------------------------*/
 
-UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken )
 {
-UBaseType_t uxReturn;
+UBaseType_t uxCount;
+UBaseType_t uxSavedInterruptStatus;
 Queue_t * const pxQueue = xQueue;
 
 	configASSERT( pxQueue );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	configASSERT( !( ( pvItems == NULL ) && ( uxItemCount != ( UBaseType_t ) 0U ) ) );
 
-	taskENTER_CRITICAL();
-	{
-		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
-	}
-	taskEXIT_CRITICAL();
+	/* See the comments in xQueueGenericSendFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-	return uxReturn;
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		uxCount = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+		if( uxCount > uxItemCount )
+		{
+			uxCount = uxItemCount;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxCount > ( UBaseType_t ) 0 )
+		{
+			const int8_t cTxLock = pxQueue->cTxLock;
+
+			traceQUEUE_SEND_FROM_ISR( pxQueue );
+			prvCopyItemsToQueue( pxQueue, ( const int8_t * ) pvItems, uxCount );
+
+			/* The event list is not altered if the queue is locked.  This will
+			be done when the queue is unlocked later, once for each item. */
+			if( cTxLock == queueUNLOCKED )
+			{
+				if( prvNotifyItemsSent( pxQueue, uxCount ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxQueue->cTxLock = prvAddToLockCount( cTxLock, uxCount );
+			}
+		}
+		else
+		{
+			traceQUEUE_SEND_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return ( BaseType_t ) uxCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait )
+{
+BaseType_t xEntryTimeSet = pdFALSE;
+TimeOut_t xTimeOut;
+UBaseType_t uxCount;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	configASSERT( pvBuffer != NULL );
+	configASSERT( uxMaxItems != ( UBaseType_t ) 0U );
+	#if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
+	{
+		configASSERT( !( ( xTaskGetSchedulerState() == taskSCHEDULER_SUSPENDED ) && ( xTicksToWait != 0 ) ) );
+	}
+	#endif
+
+	/*lint -save -e904  This function relaxes the coding standard somewhat to
+	allow return statements within the function itself.  This is done in the
+	interest of execution time efficiency. */
+	for( ;; )
+	{
+		taskENTER_CRITICAL();
+		{
+			uxCount = pxQueue->uxMessagesWaiting;
+			if( uxCount > uxMaxItems )
+			{
+				uxCount = uxMaxItems;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* Take all the items there are, up to uxMaxItems, without waiting
+			for more once there is one. */
+			if( uxCount > ( UBaseType_t ) 0 )
+			{
+				prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxCount );
+				traceQUEUE_RECEIVE( pxQueue );
+
+				/* There is now room for uxCount items, so unblock up to as
+				many tasks waiting to send, and yield once if any has a
+				priority above our own. */
+				if( prvUnblockTasks( &( pxQueue->xTasksWaitingToSend ), uxCount ) != pdFALSE )
+				{
+					queueYIELD_IF_USING_PREEMPTION();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+
+				taskEXIT_CRITICAL();
+				return ( BaseType_t ) uxCount;
+			}
+			else
+			{
+				if( xTicksToWait == ( TickType_t ) 0 )
+				{
+					taskEXIT_CRITICAL();
+					traceQUEUE_RECEIVE_FAILED( pxQueue );
+					return 0;
+				}
+				else if( xEntryTimeSet == pdFALSE )
+				{
+					vTaskInternalSetTimeOutState( &xTimeOut );
+					xEntryTimeSet = pdTRUE;
+				}
+				else
+				{
+					/* Entry time was already set. */
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		taskEXIT_CRITICAL();
+
+		/* Block until there is an item, as xQueueReceive() does. */
+		vTaskSuspendAll();
+		prvLockQueue( pxQueue );
+
+		if( xTaskCheckForTimeOut( &xTimeOut, &xTicksToWait ) == pdFALSE )
+		{
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceBLOCKING_ON_QUEUE_RECEIVE( pxQueue );
+				vTaskPlaceOnEventList( &( pxQueue->xTasksWaitingToReceive ), xTicksToWait );
+				prvUnlockQueue( pxQueue );
+				if( xTaskResumeAll() == pdFALSE )
+				{
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				/* The queue contains data again.  Loop back to try and read the
+				data. */
+				prvUnlockQueue( pxQueue );
+				( void ) xTaskResumeAll();
+			}
+		}
+		else
+		{
+			/* Timed out.  If there is no data in the queue exit, otherwise loop
+			back and attempt to read the data. */
+			prvUnlockQueue( pxQueue );
+			( void ) xTaskResumeAll();
+
+			if( prvIsQueueEmpty( pxQueue ) != pdFALSE )
+			{
+				traceQUEUE_RECEIVE_FAILED( pxQueue );
+				return 0;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+	} /*lint -restore */
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken )
+{
+UBaseType_t uxCount;
+UBaseType_t uxSavedInterruptStatus;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( pxQueue->uxItemSize != ( UBaseType_t ) 0U );
+	configASSERT( pvBuffer != NULL );
+
+	/* See the comments in xQueueReceiveFromISR(). */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		uxCount = pxQueue->uxMessagesWaiting;
+		if( uxCount > uxMaxItems )
+		{
+			uxCount = uxMaxItems;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxCount > ( UBaseType_t ) 0 )
+		{
+			const int8_t cRxLock = pxQueue->cRxLock;
+
+			traceQUEUE_RECEIVE_FROM_ISR( pxQueue );
+			prvCopyItemsFromQueue( pxQueue, ( int8_t * ) pvBuffer, uxCount );
+
+			/* If the queue is locked the event list will not be modified.
+			Instead the lock count records the items removed. */
+			if( cRxLock == queueUNLOCKED )
+			{
+				if( prvUnblockTasks( &( pxQueue->xTasksWaitingToSend ), uxCount ) != pdFALSE )
+				{
+					if( pxHigherPriorityTaskWoken != NULL )
+					{
+						*pxHigherPriorityTaskWoken = pdTRUE;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				pxQueue->cRxLock = prvAddToLockCount( cRxLock, uxCount );
+			}
+		}
+		else
+		{
+			traceQUEUE_RECEIVE_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return ( BaseType_t ) uxCount;
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xQueuePeekFromISR( QueueHandle_t xQueue,  void * const pvBuffer )
+{
+BaseType_t xReturn;
+UBaseType_t uxSavedInterruptStatus;
+int8_t *pcOriginalReadPosition;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+	configASSERT( !( ( pvBuffer == NULL ) && ( pxQueue->uxItemSize != ( UBaseType_t ) 0U ) ) );
+	configASSERT( pxQueue->uxItemSize != 0 ); /* Can't peek a semaphore. */
+
+	/* RTOS ports that support interrupt nesting have the concept of a maximum
+	system call (or maximum API call) interrupt priority.  Interrupts that are
+	above the maximum system call priority are kept permanently enabled, even
+	when the RTOS kernel is in a critical section, but cannot make any calls to
+	FreeRTOS API functions.  If configASSERT() is defined in FreeRTOSConfig.h
+	then portASSERT_IF_INTERRUPT_PRIORITY_INVALID() will result in an assertion
+	failure if a FreeRTOS API function is called from an interrupt that has been
+	assigned a priority above the configured maximum system call priority.
+	Only FreeRTOS functions that end in FromISR can be called from interrupts
+	that have been assigned a priority at or (logically) below the maximum
+	system call	interrupt priority.  FreeRTOS maintains a separate interrupt
+	safe API to ensure interrupt entry is as fast and as simple as possible.
+	More information (albeit Cortex-M specific) is provided on the following
+	link: http://www.freertos.org/RTOS-Cortex-M3-M4.html */
+	portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
+
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+	{
+		/* Cannot block in an ISR, so check there is data available. */
+		if( pxQueue->uxMessagesWaiting > ( UBaseType_t ) 0 )
+		{
+			traceQUEUE_PEEK_FROM_ISR( pxQueue );
+
+			/* Remember the read position so it can be reset as nothing is
+			actually being removed from the queue. */
+			pcOriginalReadPosition = pxQueue->u.xQueue.pcReadFrom;
+			prvCopyDataFromQueue( pxQueue, pvBuffer );
+			pxQueue->u.xQueue.pcReadFrom = pcOriginalReadPosition;
+
+			xReturn = pdPASS;
+		}
+		else
+		{
+			xReturn = pdFAIL;
+			traceQUEUE_PEEK_FROM_ISR_FAILED( pxQueue );
+		}
+	}
+	taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueMessagesWaiting( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+
+	configASSERT( xQueue );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = ( ( Queue_t * ) xQueue )->uxMessagesWaiting;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
+} /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxQueueSpacesAvailable( const QueueHandle_t xQueue )
+{
+UBaseType_t uxReturn;
+Queue_t * const pxQueue = xQueue;
+
+	configASSERT( pxQueue );
+
+	taskENTER_CRITICAL();
+	{
+		uxReturn = pxQueue->uxLength - pxQueue->uxMessagesWaiting;
+	}
+	taskEXIT_CRITICAL();
+
+	return uxReturn;
 } /*lint !e818 Pointer cannot be declared const as xQueue is a typedef not pointer. */
 /*-----------------------------------------------------------*/
 
@@ -2095,7 +2707,7 @@ UBaseType_t uxMessagesWaiting;
 	}
 	else if( xPosition == queueSEND_TO_BACK )
 	{
-		( void ) memcpy( ( void * ) pxQueue->pcWriteTo, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+		prvCopyItem( pxQueue, pxQueue->pcWriteTo, pvItemToQueue ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports, plus previous logic ensures a null pointer can only be passed to memcpy() if the copy size is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
 		pxQueue->pcWriteTo += pxQueue->uxItemSize; /*lint !e9016 Pointer arithmetic on char types ok, especially in this use case where it is the clearest way of conveying intent. */
 		if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
 		{
@@ -2108,7 +2720,7 @@ UBaseType_t uxMessagesWaiting;
 	}
 	else
 	{
-		( void ) memcpy( ( void * ) pxQueue->u.xQueue.pcReadFrom, pvItemToQueue, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
+		prvCopyItem( pxQueue, pxQueue->u.xQueue.pcReadFrom, pvItemToQueue ); /*lint !e961 !e9087 !e418 MISRA exception as the casts are only redundant for some ports.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes.  Assert checks null pointer only used when length is 0. */
 		pxQueue->u.xQueue.pcReadFrom -= pxQueue->uxItemSize;
 		if( pxQueue->u.xQueue.pcReadFrom < pxQueue->pcHead ) /*lint !e946 MISRA exception justified as comparison of pointers is the cleanest solution. */
 		{
@@ -2159,11 +2771,181 @@ static void prvCopyDataFromQueue( Queue_t * const pxQueue, void * const pvBuffer
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
-		( void ) memcpy( ( void * ) pvBuffer, ( void * ) pxQueue->u.xQueue.pcReadFrom, ( size_t ) pxQueue->uxItemSize ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
+		prvCopyItem( pxQueue, pvBuffer, pxQueue->u.xQueue.pcReadFrom ); /*lint !e961 !e418 !e9087 MISRA exception as the casts are only redundant for some ports.  Also previous logic ensures a null pointer can only be passed to memcpy() when the count is 0.  Cast to void required by function signature and safe as no alignment requirement and copy length specified in bytes. */
 	}
 }
 /*-----------------------------------------------------------*/
 
+static void prvCopyItemsToQueue( Queue_t * const pxQueue, const int8_t *pcItems, const UBaseType_t uxCount )
+{
+const size_t xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+size_t xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pxQueue->pcWriteTo );
+
+	/* This function is called from a critical section, with room in the queue
+	for all uxCount items. */
+
+	if( xFirstBytes > xBytes )
+	{
+		xFirstBytes = xBytes;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) pcItems, xFirstBytes );
+	pxQueue->pcWriteTo += xFirstBytes;
+	if( pxQueue->pcWriteTo >= pxQueue->u.xQueue.pcTail )
+	{
+		pxQueue->pcWriteTo = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* The items that did not fit before the end of the storage area. */
+	( void ) memcpy( ( void * ) pxQueue->pcWriteTo, ( const void * ) ( pcItems + xFirstBytes ), xBytes - xFirstBytes );
+	pxQueue->pcWriteTo += xBytes - xFirstBytes;
+
+	pxQueue->uxMessagesWaiting += uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static void prvCopyItemsFromQueue( Queue_t * const pxQueue, int8_t *pcBuffer, const UBaseType_t uxCount )
+{
+const size_t xBytes = ( size_t ) uxCount * ( size_t ) pxQueue->uxItemSize;
+int8_t *pcReadFrom = pxQueue->u.xQueue.pcReadFrom + pxQueue->uxItemSize;
+size_t xFirstBytes;
+
+	/* This function is called from a critical section, with at least uxCount
+	items in the queue.  pcReadFrom points to the last item read, so the first
+	item to read follows it. */
+
+	if( pcReadFrom >= pxQueue->u.xQueue.pcTail )
+	{
+		pcReadFrom = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	xFirstBytes = ( size_t ) ( pxQueue->u.xQueue.pcTail - pcReadFrom );
+	if( xFirstBytes > xBytes )
+	{
+		xFirstBytes = xBytes;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	( void ) memcpy( ( void * ) pcBuffer, ( void * ) pcReadFrom, xFirstBytes );
+	pcReadFrom += xFirstBytes;
+	if( pcReadFrom >= pxQueue->u.xQueue.pcTail )
+	{
+		pcReadFrom = pxQueue->pcHead;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	/* The items that wrapped around to the start of the storage area. */
+	( void ) memcpy( ( void * ) ( pcBuffer + xFirstBytes ), ( void * ) pcReadFrom, xBytes - xFirstBytes );
+	pcReadFrom += xBytes - xFirstBytes;
+
+	/* Leave pcReadFrom on the last item read, as prvCopyDataFromQueue() does. */
+	if( pcReadFrom == pxQueue->pcHead )
+	{
+		pxQueue->u.xQueue.pcReadFrom = pxQueue->u.xQueue.pcTail - pxQueue->uxItemSize;
+	}
+	else
+	{
+		pxQueue->u.xQueue.pcReadFrom = pcReadFrom - pxQueue->uxItemSize;
+	}
+
+	pxQueue->uxMessagesWaiting -= uxCount;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvUnblockTasks( List_t * const pxEventList, UBaseType_t uxCount )
+{
+BaseType_t xReturn = pdFALSE;
+const UBaseType_t uxWaiting = listCURRENT_LIST_LENGTH( pxEventList );
+
+	/* One task is unblocked for each item, as the per item calls would, but
+	the caller yields at most once for all of them.  No more tasks are removed
+	than are waiting, so a single waiter is removed once for the whole batch,
+	and the list is not looked at again for the rest of the items. */
+	if( uxCount > uxWaiting )
+	{
+		uxCount = uxWaiting;
+	}
+	else
+	{
+		mtCOVERAGE_TEST_MARKER();
+	}
+
+	while( uxCount > ( UBaseType_t ) 0 )
+	{
+		if( xTaskRemoveFromEventList( pxEventList ) != pdFALSE )
+		{
+			xReturn = pdTRUE;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		--uxCount;
+	}
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static BaseType_t prvNotifyItemsSent( Queue_t * const pxQueue, const UBaseType_t uxCount )
+{
+BaseType_t xReturn = pdFALSE;
+
+	#if ( configUSE_QUEUE_SETS == 1 )
+	{
+		if( pxQueue->pxQueueSetContainer != NULL )
+		{
+			return prvNotifyQueueSetContainerItems( pxQueue, uxCount );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	#endif /* configUSE_QUEUE_SETS */
+
+	xReturn = prvUnblockTasks( &( pxQueue->xTasksWaitingToReceive ), uxCount );
+
+	return xReturn;
+}
+/*-----------------------------------------------------------*/
+
+static int8_t prvAddToLockCount( const int8_t cLock, const UBaseType_t uxCount )
+{
+int8_t cReturn;
+
+	if( uxCount >= ( UBaseType_t ) ( queueINT8_MAX - cLock ) )
+	{
+		cReturn = queueINT8_MAX;
+	}
+	else
+	{
+		cReturn = ( int8_t ) ( cLock + ( int8_t ) uxCount );
+	}
+
+	return cReturn;
+}
+/*-----------------------------------------------------------*/
+
 static void prvUnlockQueue( Queue_t * const pxQueue )
 {
 	/* THIS FUNCTION MUST BE CALLED WITH THE SCHEDULER SUSPENDED. */
@@ -2925,6 +3707,58 @@ Queue_t * const pxQueue = xQueue;
 
 		return xReturn;
 	}
+	/*-----------------------------------------------------------*/
+
+	static BaseType_t prvNotifyQueueSetContainerItems( const Queue_t * const pxQueue, UBaseType_t uxCount )
+	{
+	Queue_t *pxQueueSetContainer = pxQueue->pxQueueSetContainer;
+	BaseType_t xReturn = pdFALSE;
+	UBaseType_t uxItem;
+
+		/* This function must be called from a critical section. */
+
+		configASSERT( pxQueueSetContainer );
+		configASSERT( uxCount <= ( pxQueueSetContainer->uxLength - pxQueueSetContainer->uxMessagesWaiting ) );
+
+		if( uxCount > ( pxQueueSetContainer->uxLength - pxQueueSetContainer->uxMessagesWaiting ) )
+		{
+			uxCount = pxQueueSetContainer->uxLength - pxQueueSetContainer->uxMessagesWaiting;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		if( uxCount > ( UBaseType_t ) 0 )
+		{
+			const int8_t cTxLock = pxQueueSetContainer->cTxLock;
+
+			traceQUEUE_SEND( pxQueueSetContainer );
+
+			/* The set holds the handle of the queue once for each item in the
+			queue, but the tasks waiting on the set are unblocked once for the
+			batch. */
+			for( uxItem = ( UBaseType_t ) 0; uxItem < uxCount; uxItem++ )
+			{
+				( void ) prvCopyDataToQueue( pxQueueSetContainer, &pxQueue, queueSEND_TO_BACK );
+			}
+
+			if( cTxLock == queueUNLOCKED )
+			{
+				xReturn = prvUnblockTasks( &( pxQueueSetContainer->xTasksWaitingToReceive ), uxCount );
+			}
+			else
+			{
+				pxQueueSetContainer->cTxLock = prvAddToLockCount( cTxLock, uxCount );
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return xReturn;
+	}
 
 #endif /* configUSE_QUEUE_SETS */
 
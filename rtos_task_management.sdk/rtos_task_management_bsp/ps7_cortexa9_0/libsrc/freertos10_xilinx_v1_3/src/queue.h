@@ -73,6 +73,7 @@ typedef struct QueueDefinition * QueueSetMemberHandle_t;
 #define queueQUEUE_TYPE_COUNTING_SEMAPHORE	( ( uint8_t ) 2U )
 #define queueQUEUE_TYPE_BINARY_SEMAPHORE	( ( uint8_t ) 3U )
 #define queueQUEUE_TYPE_RECURSIVE_MUTEX		( ( uint8_t ) 4U )
+#define queueQUEUE_TYPE_MEM_POOL			( ( uint8_t ) 5U )
 
 /**
  * queue. h
@@ -1406,6 +1407,69 @@ BaseType_t xQueueCRReceiveFromISR( QueueHandle_t xQueue, void *pvBuffer, BaseTyp
 BaseType_t xQueueCRSend( QueueHandle_t xQueue, const void *pvItemToQueue, TickType_t xTicksToWait );
 BaseType_t xQueueCRReceive( QueueHandle_t xQueue, void *pvBuffer, TickType_t xTicksToWait );
 
+/*
+ * Queues by reference, with configUSE_MEM_POOLS.  A queue created by
+ * xQueueCreateByReference() carries the buffers of a memory pool of
+ * mem_pool.h instead of copies of the items.  Each item is a
+ * QueueReference_t, the address and length of a buffer, so only it is copied
+ * into and out of the queue, whatever the size of the buffer.
+ *
+ * The sender takes a buffer from the pool of the queue with
+ * pvQueueAcquireBuffer(), fills it, and hands it over with
+ * xQueueSendReference().  xQueueReceiveReference() returns the same buffer,
+ * which the receiver reads where it is, and hands back to the pool with
+ * vQueueReleaseBuffer().  A buffer belongs to the sender until its send
+ * succeeds, and then to the receiver.  Sends and receives block, time out and
+ * wake the waiting tasks in priority order as on any other queue.  The buffers
+ * still queued are not released by xQueueReset() or vQueueDelete().
+ */
+struct MemPoolDef_t;
+
+typedef struct xQUEUE_REFERENCE
+{
+	void *pvBuffer;		/*< The buffer, a block of the pool of the queue. */
+	size_t xLength;		/*< The bytes of the buffer that were filled. */
+} QueueReference_t;
+
+#if( configUSE_MEM_POOLS == 1 )
+	#if( configSUPPORT_DYNAMIC_ALLOCATION == 1 )
+		QueueHandle_t xQueueCreateByReference( const UBaseType_t uxQueueLength, struct MemPoolDef_t *pxPool ) PRIVILEGED_FUNCTION;
+	#endif
+	/* pucQueueStorage holds uxQueueLength * sizeof( QueueReference_t ) bytes. */
+	QueueHandle_t xQueueCreateByReferenceStatic( const UBaseType_t uxQueueLength, struct MemPoolDef_t *pxPool, uint8_t *pucQueueStorage, StaticQueue_t *pxStaticQueue ) PRIVILEGED_FUNCTION;
+	void *pvQueueAcquireBuffer( QueueHandle_t xQueue, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+	void *pvQueueAcquireBufferFromISR( QueueHandle_t xQueue ) PRIVILEGED_FUNCTION;
+	BaseType_t xQueueSendReference( QueueHandle_t xQueue, void *pvBuffer, size_t xLength, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+	BaseType_t xQueueSendReferenceFromISR( QueueHandle_t xQueue, void *pvBuffer, size_t xLength, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+	BaseType_t xQueueReceiveReference( QueueHandle_t xQueue, void **ppvBuffer, size_t *pxLength, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+	void vQueueReleaseBuffer( QueueHandle_t xQueue, void *pvBuffer ) PRIVILEGED_FUNCTION;
+#endif
+
+/*
+ * Batches of items.  xQueueSendMultiple() copies up to uxItemCount items,
+ * which follow each other in pvItems, to the back of a queue, and
+ * xQueueReceiveMultiple() copies up to uxMaxItems from the front of it into
+ * pvBuffer.  Each returns the number of items it moved.
+ *
+ * All the items that fit are moved in one critical section, in at most two
+ * copies, rather than one call to xQueueGenericSend() or xQueueReceive() for
+ * each.  A task waiting on the other side is unblocked for each item, up to
+ * the number of items moved, but the caller yields at most once for the
+ * batch.
+ *
+ * xQueueSendMultiple() blocks for up to xTicksToWait while the queue is full,
+ * until it has sent all the items, and returns fewer on a timeout.
+ * xQueueReceiveMultiple() blocks for up to xTicksToWait only while the queue
+ * is empty, and returns the items there are once there is one, or 0 on a
+ * timeout.  The FromISR versions never block, and set
+ * *pxHigherPriorityTaskWoken as xQueueSendFromISR() and
+ * xQueueReceiveFromISR() do.  None may be used with a semaphore or a mutex.
+ */
+BaseType_t xQueueSendMultiple( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueSendMultipleFromISR( QueueHandle_t xQueue, const void * const pvItems, const UBaseType_t uxItemCount, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueReceiveMultiple( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+BaseType_t xQueueReceiveMultipleFromISR( QueueHandle_t xQueue, void * const pvBuffer, const UBaseType_t uxMaxItems, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
 /*
  * For internal use only.  Use xSemaphoreCreateMutex(),
  * xSemaphoreCreateCounting() or xSemaphoreGetMutexHolder() instead of calling
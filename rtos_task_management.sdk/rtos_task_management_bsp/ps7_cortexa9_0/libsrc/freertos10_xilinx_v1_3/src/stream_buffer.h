@@ -829,6 +829,48 @@ BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuf
  */
 BaseType_t xStreamBufferReceiveCompletedFromISR( StreamBufferHandle_t xStreamBuffer, BaseType_t *pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
 
+#if( configUSE_STREAM_BUFFER_REGIONS == 1 )
+
+/*
+ * The bytes of a stream buffer where they are, for a writer or a reader that
+ * moves them itself, as a DMA engine or the FIFO of a UART does, rather than
+ * have xStreamBufferSend() or xStreamBufferReceive() copy them.  Only for
+ * stream buffers, not message buffers.
+ *
+ * xStreamBufferGetWriteRegion() points *ppvRegion at the free bytes that
+ * follow each other from where the next byte is written, and returns how many
+ * there are, waiting up to xTicksToWait for at least one if the buffer is
+ * full.  Once up to that many bytes are written there, vStreamBufferCommitWrite()
+ * adds them to the buffer, and wakes a task waiting to receive as
+ * xStreamBufferSend() does, once the bytes in the buffer reach the trigger
+ * level.  xStreamBufferGetReadRegion() points *ppvRegion at the bytes that
+ * follow each other from where the next byte is read, and returns how many
+ * there are, waiting up to xTicksToWait for the trigger level if the buffer is
+ * empty.  Once up to that many bytes are used, vStreamBufferCommitRead()
+ * removes them from the buffer, and wakes a task waiting to send.
+ *
+ * A region ends at the end of the buffer, so the bytes that wrap around to its
+ * start are in the next region.  Nothing is added to or removed from the
+ * buffer until it is committed, so a region may be handed to a DMA transfer
+ * and committed from its completion interrupt, with the FromISR versions.  The
+ * region is in cached memory, so the caller flushes it before a transfer out
+ * of it, as by Xil_DCacheFlushRange(), and invalidates it after a transfer
+ * into it, as by Xil_DCacheInvalidateRange().
+ *
+ * Only one writer and one reader may use a buffer, as for the other
+ * functions.
+ */
+size_t xStreamBufferGetWriteRegion( StreamBufferHandle_t xStreamBuffer, void **ppvRegion, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferGetWriteRegionFromISR( StreamBufferHandle_t xStreamBuffer, void **ppvRegion ) PRIVILEGED_FUNCTION;
+void vStreamBufferCommitWrite( StreamBufferHandle_t xStreamBuffer, size_t xBytes ) PRIVILEGED_FUNCTION;
+void vStreamBufferCommitWriteFromISR( StreamBufferHandle_t xStreamBuffer, size_t xBytes, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferGetReadRegion( StreamBufferHandle_t xStreamBuffer, void **ppvRegion, TickType_t xTicksToWait ) PRIVILEGED_FUNCTION;
+size_t xStreamBufferGetReadRegionFromISR( StreamBufferHandle_t xStreamBuffer, void **ppvRegion ) PRIVILEGED_FUNCTION;
+void vStreamBufferCommitRead( StreamBufferHandle_t xStreamBuffer, size_t xBytes ) PRIVILEGED_FUNCTION;
+void vStreamBufferCommitReadFromISR( StreamBufferHandle_t xStreamBuffer, size_t xBytes, BaseType_t * const pxHigherPriorityTaskWoken ) PRIVILEGED_FUNCTION;
+
+#endif /* configUSE_STREAM_BUFFER_REGIONS */
+
 /* Functions below here are not part of the public API. */
 StreamBufferHandle_t xStreamBufferGenericCreate( size_t xBufferSizeBytes,
 												 size_t xTriggerLevelBytes,
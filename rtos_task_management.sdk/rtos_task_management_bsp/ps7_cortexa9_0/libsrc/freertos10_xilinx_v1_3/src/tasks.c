@@ -64,6 +64,33 @@ functions but without including stdio.h here. */
 	#define taskYIELD_IF_USING_PREEMPTION() portYIELD_WITHIN_API()
 #endif
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+	/* Values that can be assigned to the xTaskRunState member of the TCB, other
+	than the ID of the core the task runs on. */
+	#define taskTASK_NOT_RUNNING			( ( BaseType_t ) -1 )
+	#define taskTASK_SCHEDULED_TO_YIELD		( ( BaseType_t ) -2 )
+
+	#define taskTASK_IS_RUNNING( pxTCB )	( ( ( pxTCB )->xTaskRunState >= ( BaseType_t ) 0 ) ? pdTRUE : pdFALSE )
+	#define taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB )	( ( ( pxTCB )->xTaskRunState != taskTASK_NOT_RUNNING ) ? pdTRUE : pdFALSE )
+
+	/* Bits of the uxTaskAttributes member of the TCB. */
+	#define taskATTRIBUTE_IS_IDLE			( ( UBaseType_t ) 1U )
+
+	/* The affinity of a task that may run on any core. */
+	#define taskALL_CORES_AFFINITY			( ( UBaseType_t ) ( ( 1U << configNUMBER_OF_CORES ) - 1U ) )
+
+	/* Yield on the core that runs pxTCB, if any. */
+	#define taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB )											\
+	{																									\
+		if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )													\
+		{																								\
+			prvYieldCore( ( pxTCB )->xTaskRunState );													\
+		}																								\
+	}
+
+#endif /* configNUMBER_OF_CORES */
+
 /* Values that can be assigned to the ucNotifyState member of the TCB. */
 #define taskNOT_WAITING_NOTIFICATION	( ( uint8_t ) 0 )
 #define taskWAITING_NOTIFICATION		( ( uint8_t ) 1 )
@@ -210,21 +237,35 @@ configIDLE_TASK_NAME in FreeRTOSConfig.h. */
 
 /*-----------------------------------------------------------*/
 
-/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
-count overflows. */
-#define taskSWITCH_DELAYED_LISTS()																	\
-{																									\
-	List_t *pxTemp;																					\
-																									\
-	/* The delayed tasks list should be empty when the lists are switched. */						\
-	configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );										\
-																									\
-	pxTemp = pxDelayedTaskList;																		\
-	pxDelayedTaskList = pxOverflowDelayedTaskList;													\
-	pxOverflowDelayedTaskList = pxTemp;																\
-	xNumOfOverflows++;																				\
-	prvResetNextTaskUnblockTime();																	\
-}
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+	/* The slot of the timing wheel that holds the tasks that wake at xTime. */
+	#define taskDELAY_WHEEL_SLOT( xTime ) ( &( xDelayWheel[ ( xTime ) & ( TickType_t ) ( configDELAY_WHEEL_SIZE - 1 ) ] ) )
+
+	/* Any slot of the wheel is a delayed list. */
+	#define taskIS_DELAYED_LIST( pxList ) ( ( ( pxList ) >= &( xDelayWheel[ 0 ] ) ) && ( ( pxList ) < &( xDelayWheel[ configDELAY_WHEEL_SIZE ] ) ) )
+
+#else
+
+	/* pxDelayedTaskList and pxOverflowDelayedTaskList are switched when the tick
+	count overflows. */
+	#define taskSWITCH_DELAYED_LISTS()																	\
+	{																									\
+		List_t *pxTemp;																					\
+																										\
+		/* The delayed tasks list should be empty when the lists are switched. */						\
+		configASSERT( ( listLIST_IS_EMPTY( pxDelayedTaskList ) ) );										\
+																										\
+		pxTemp = pxDelayedTaskList;																		\
+		pxDelayedTaskList = pxOverflowDelayedTaskList;													\
+		pxOverflowDelayedTaskList = pxTemp;																\
+		xNumOfOverflows++;																				\
+		prvResetNextTaskUnblockTime();																	\
+	}
+
+	#define taskIS_DELAYED_LIST( pxList ) ( ( ( pxList ) == pxDelayedTaskList ) || ( ( pxList ) == pxOverflowDelayedTaskList ) )
+
+#endif /* configUSE_DELAY_WHEEL */
 
 /*-----------------------------------------------------------*/
 
@@ -307,7 +348,7 @@ typedef struct tskTaskControlBlock /* The old naming convention is used to preve
 	#endif
 
 	#if( configGENERATE_RUN_TIME_STATS == 1 )
-		uint32_t		ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
+		configRUN_TIME_COUNTER_TYPE	ulRunTimeCounter;	/*< Stores the amount of time the task has spent in the Running state. */
 	#endif
 
 	#if ( configUSE_NEWLIB_REENTRANT == 1 )
@@ -340,6 +381,12 @@ typedef struct tskTaskControlBlock /* The old naming convention is used to preve
 		int iTaskErrno;
 	#endif
 
+	#if( configNUMBER_OF_CORES > 1 )
+		volatile BaseType_t xTaskRunState;	/*< The ID of the core the task runs on, or taskTASK_NOT_RUNNING, or taskTASK_SCHEDULED_TO_YIELD. */
+		UBaseType_t		uxTaskAttributes;	/*< taskATTRIBUTE_IS_IDLE if the task is the idle task of a core. */
+		UBaseType_t		uxCoreAffinityMask;	/*< Bit n is set if the task may run on core n. */
+	#endif
+
 } tskTCB;
 
 /* The old tskTCB name is maintained above then typedefed to the new TCB_t name
@@ -348,17 +395,45 @@ typedef tskTCB TCB_t;
 
 /*lint -save -e956 A manual analysis and inspection has been used to determine
 which static variables must be declared volatile. */
-PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+#if ( configNUMBER_OF_CORES == 1 )
+
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCB = NULL;
+
+#else
+
+	/* The task that runs on each core.  The TCB of a task is found by its
+	xTaskRunState, and the task of the calling core by its ID, so pxCurrentTCB
+	names the task of the calling core, which only stays valid while the caller
+	can not be moved to another core. */
+	PRIVILEGED_DATA TCB_t * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ];
+	#define pxCurrentTCB ( ( TCB_t * ) xTaskGetCurrentTaskHandle() )
+
+#endif /* configNUMBER_OF_CORES */
 
 /* Lists for ready and blocked tasks. --------------------
 xDelayedTaskList1 and xDelayedTaskList2 could be move to function scople but
 doing so breaks some kernel aware debuggers and debuggers that rely on removing
 the static qualifier. */
 PRIVILEGED_DATA static List_t pxReadyTasksLists[ configMAX_PRIORITIES ];/*< Prioritised ready tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
-PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
-PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
-PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+	/* The delayed tasks are hashed by their wake time into the slots of a
+	timing wheel, in no order within a slot.  So a task is delayed in constant
+	time, and the tick only visits the slot of the new tick count, instead of
+	the sorted delayed list being walked on every insertion. */
+	PRIVILEGED_DATA static List_t xDelayWheel[ configDELAY_WHEEL_SIZE ];	/*< Delayed tasks, in the slot of their wake time. */
+	PRIVILEGED_DATA static TickType_t xDelayWheelTick = ( TickType_t ) configINITIAL_TICK_COUNT;	/*< The tick count when the tick last visited the wheel. */
+
+#else
+
+	PRIVILEGED_DATA static List_t xDelayedTaskList1;						/*< Delayed tasks. */
+	PRIVILEGED_DATA static List_t xDelayedTaskList2;						/*< Delayed tasks (two lists are used - one for delays that have overflowed the current tick count. */
+	PRIVILEGED_DATA static List_t * volatile pxDelayedTaskList;				/*< Points to the delayed task list currently being used. */
+	PRIVILEGED_DATA static List_t * volatile pxOverflowDelayedTaskList;		/*< Points to the delayed task list currently being used to hold tasks that have overflowed the current tick count. */
+
+#endif /* configUSE_DELAY_WHEEL */
+
 PRIVILEGED_DATA static List_t xPendingReadyList;						/*< Tasks that have been readied while the scheduler was suspended.  They will be moved to the ready list when the scheduler is resumed. */
 
 #if( INCLUDE_vTaskDelete == 1 )
@@ -386,11 +461,23 @@ PRIVILEGED_DATA static volatile TickType_t xTickCount 				= ( TickType_t ) confi
 PRIVILEGED_DATA static volatile UBaseType_t uxTopReadyPriority 		= tskIDLE_PRIORITY;
 PRIVILEGED_DATA static volatile BaseType_t xSchedulerRunning 		= pdFALSE;
 PRIVILEGED_DATA static volatile UBaseType_t uxPendedTicks 			= ( UBaseType_t ) 0U;
-PRIVILEGED_DATA static volatile BaseType_t xYieldPending 			= pdFALSE;
+#if ( configNUMBER_OF_CORES == 1 )
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPending 		= pdFALSE;
+#else
+	PRIVILEGED_DATA static volatile BaseType_t xYieldPendings[ configNUMBER_OF_CORES ];	/*< A context switch held pending on each core. */
+
+	/* The switch held pending on the calling core, which, as pxCurrentTCB,
+	only stays valid while the caller can not be moved to another core. */
+	#define xYieldPending xYieldPendings[ portGET_CORE_ID() ]
+#endif
 PRIVILEGED_DATA static volatile BaseType_t xNumOfOverflows 			= ( BaseType_t ) 0;
 PRIVILEGED_DATA static UBaseType_t uxTaskNumber 					= ( UBaseType_t ) 0U;
 PRIVILEGED_DATA static volatile TickType_t xNextTaskUnblockTime		= ( TickType_t ) 0U; /* Initialised to portMAX_DELAY before the scheduler starts. */
-PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle					= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#if ( configNUMBER_OF_CORES == 1 )
+	PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandle				= NULL;			/*< Holds the handle of the idle task.  The idle task is created automatically when the scheduler is started. */
+#else
+	PRIVILEGED_DATA static TaskHandle_t xIdleTaskHandles[ configNUMBER_OF_CORES ];	/*< Holds the handle of the idle task of each core, created when the scheduler is started. */
+#endif
 
 /* Context switches are held pending while the scheduler is suspended.  Also,
 interrupts must not manipulate the xStateListItem of a TCB, or any of the
@@ -406,8 +493,12 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 	/* Do not move these variables to function scope as doing so prevents the
 	code working with debuggers that need to remove the static qualifier. */
-	PRIVILEGED_DATA static uint32_t ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
-	PRIVILEGED_DATA static uint32_t ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
+	#if ( configNUMBER_OF_CORES == 1 )
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime = 0UL;	/*< Holds the value of a timer/counter the last time a task was switched in. */
+	#else
+		PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTaskSwitchedInTime[ configNUMBER_OF_CORES ];	/*< The same, for each core. */
+	#endif
+	PRIVILEGED_DATA static configRUN_TIME_COUNTER_TYPE ulTotalRunTime = 0UL;		/*< Holds the total amount of execution time as defined by the run time counter clock. */
 
 #endif
 
@@ -432,6 +523,11 @@ PRIVILEGED_DATA static volatile UBaseType_t uxSchedulerSuspended	= ( UBaseType_t
 
 	extern void vApplicationGetIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize ); /*lint !e526 Symbol not defined as it is an application callback. */
 
+	#if ( configNUMBER_OF_CORES > 1 )
+		/* Provides the memory of the idle tasks of the cores other than core 0. */
+		extern void vApplicationGetCoreIdleTaskMemory( StaticTask_t **ppxIdleTaskTCBBuffer, StackType_t **ppxIdleTaskStackBuffer, uint32_t *pulIdleTaskStackSize, BaseType_t xCoreID ); /*lint !e526 Symbol not defined as it is an application callback. */
+	#endif
+
 #endif
 
 /* File private functions. --------------------------------*/
@@ -548,6 +644,15 @@ static void prvAddCurrentTaskToDelayedList( TickType_t xTicksToWait, const BaseT
  */
 static void prvResetNextTaskUnblockTime( void );
 
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+	/*
+	 * Add the current task to the slot of the timing wheel for xTimeToWake.
+	 */
+	static void prvAddCurrentTaskToDelayWheel( TickType_t xTimeToWake, const TickType_t xConstTickCount ) PRIVILEGED_FUNCTION;
+
+#endif
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	/*
@@ -588,6 +693,38 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB ) PRIVILEGED_FUNCTION;
 
 #endif
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+	/*
+	 * Make the core xCoreID select its task again.  The calling core only marks
+	 * its own switch as pending, to be done when it leaves its critical section,
+	 * while another core is interrupted.  Called from a critical section.
+	 */
+	static void prvYieldCore( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called when pxTCB becomes ready, or its priority is raised.  If a core the
+	 * task may run on runs a task of a lower priority, yield on the core that
+	 * runs the lowest.  Called from a critical section.
+	 */
+	static void prvYieldForTask( const TCB_t *pxTCB ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Select the task of the core xCoreID: the first task of the highest
+	 * priority that no other core runs, and that may run on xCoreID.  Called
+	 * with both kernel locks held.
+	 */
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID ) PRIVILEGED_FUNCTION;
+
+	/*
+	 * Called when the calling task has just entered a critical section, or
+	 * suspended the scheduler, holding the kernel locks.  If another core has
+	 * asked the task to yield in the meantime, let the switch happen first.
+	 */
+	static void prvCheckForRunStateChange( void ) PRIVILEGED_FUNCTION;
+
+#endif /* configNUMBER_OF_CORES */
+
 /*-----------------------------------------------------------*/
 
 #if( configSUPPORT_STATIC_ALLOCATION == 1 )
@@ -1014,6 +1151,14 @@ UBaseType_t x;
 	}
 	#endif
 
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		pxNewTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+		pxNewTCB->uxTaskAttributes = ( pxTaskCode == prvIdleTask ) ? taskATTRIBUTE_IS_IDLE : ( UBaseType_t ) 0U;
+		pxNewTCB->uxCoreAffinityMask = tskNO_AFFINITY;
+	}
+	#endif
+
 	/* Initialize the TCB stack to look as if the task was already running,
 	but had been interrupted by the scheduler.  The return address is set
 	to the start of the task function. Once the stack has been initialised
@@ -1048,6 +1193,8 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	taskENTER_CRITICAL();
 	{
 		uxCurrentNumberOfTasks++;
+
+		#if ( configNUMBER_OF_CORES == 1 )
 		if( pxCurrentTCB == NULL )
 		{
 			/* There are no other tasks, or all the other tasks are in
@@ -1087,6 +1234,20 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#else
+		{
+			/* Each core starts with its idle task, given to it as the scheduler
+			starts, so the task of a core is never NULL once it runs. */
+			if( uxCurrentNumberOfTasks == ( UBaseType_t ) 1 )
+			{
+				prvInitialiseTaskLists();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configNUMBER_OF_CORES */
 
 		uxTaskNumber++;
 
@@ -1101,26 +1262,45 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		prvAddTaskToReadyList( pxNewTCB );
 
 		portSETUP_TCB( pxNewTCB );
+
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+			/* If the created task is of a higher priority than the task of a
+			core it may run on then it should run there now. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				prvYieldForTask( pxNewTCB );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configNUMBER_OF_CORES */
 	}
 	taskEXIT_CRITICAL();
 
-	if( xSchedulerRunning != pdFALSE )
+	#if ( configNUMBER_OF_CORES == 1 )
 	{
-		/* If the created task is of a higher priority than the current task
-		then it should run now. */
-		if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+		if( xSchedulerRunning != pdFALSE )
 		{
-			taskYIELD_IF_USING_PREEMPTION();
+			/* If the created task is of a higher priority than the current task
+			then it should run now. */
+			if( pxCurrentTCB->uxPriority < pxNewTCB->uxPriority )
+			{
+				taskYIELD_IF_USING_PREEMPTION();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
 		}
 		else
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
 	}
-	else
-	{
-		mtCOVERAGE_TEST_MARKER();
-	}
+	#endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -1129,6 +1309,9 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	void vTaskDelete( TaskHandle_t xTaskToDelete )
 	{
 	TCB_t *pxTCB;
+	#if ( configNUMBER_OF_CORES > 1 )
+		TCB_t *pxTCBToFree = NULL;
+	#endif
 
 		taskENTER_CRITICAL();
 		{
@@ -1162,6 +1345,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			not return. */
 			uxTaskNumber++;
 
+			#if ( configNUMBER_OF_CORES == 1 )
 			if( pxTCB == pxCurrentTCB )
 			{
 				/* A task is deleting itself.  This cannot complete within the
@@ -1194,23 +1378,76 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			}
 
 			traceTASK_DELETE( pxTCB );
+			#else
+			if( ( xSchedulerRunning != pdFALSE ) && ( taskTASK_IS_RUNNING_OR_SCHEDULED_TO_YIELD( pxTCB ) != pdFALSE ) )
+			{
+				/* The task runs on this core or another, so its memory is
+				freed by an idle task once it has been switched out.  The core
+				that runs it is made to switch before the critical section is
+				left, so the task can not put itself back on a list. */
+				vListInsertEnd( &xTasksWaitingTermination, &( pxTCB->xStateListItem ) );
+				++uxDeletedTasksWaitingCleanUp;
+
+				traceTASK_DELETE( pxTCB );
+
+				if( pxTCB->xTaskRunState == ( BaseType_t ) portGET_CORE_ID() )
+				{
+					configASSERT( uxSchedulerSuspended == 0 );
+					portPRE_TASK_DELETE_HOOK( pxTCB, &( xYieldPendings[ pxTCB->xTaskRunState ] ) );
+					vTaskYieldWithinAPI();
+				}
+				else
+				{
+					/* Running on another core, or already asked to yield. */
+					taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+				}
+			}
+			else
+			{
+				--uxCurrentNumberOfTasks;
+				pxTCBToFree = pxTCB;
+
+				traceTASK_DELETE( pxTCB );
+
+				/* Reset the next expected unblock time in case it referred to
+				the task that has just been deleted. */
+				prvResetNextTaskUnblockTime();
+			}
+			#endif /* configNUMBER_OF_CORES */
 		}
 		taskEXIT_CRITICAL();
 
-		/* Force a reschedule if it is the currently running task that has just
-		been deleted. */
-		if( xSchedulerRunning != pdFALSE )
+		#if ( configNUMBER_OF_CORES == 1 )
 		{
-			if( pxTCB == pxCurrentTCB )
+			/* Force a reschedule if it is the currently running task that has
+			just been deleted. */
+			if( xSchedulerRunning != pdFALSE )
 			{
-				configASSERT( uxSchedulerSuspended == 0 );
-				portYIELD_WITHIN_API();
+				if( pxTCB == pxCurrentTCB )
+				{
+					configASSERT( uxSchedulerSuspended == 0 );
+					portYIELD_WITHIN_API();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+		#else
+		{
+			/* Freeing the memory may suspend the scheduler, which is not done
+			from a critical section with more than one core. */
+			if( pxTCBToFree != NULL )
+			{
+				prvDeleteTCB( pxTCBToFree );
 			}
 			else
 			{
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#endif /* configNUMBER_OF_CORES */
 	}
 
 #endif /* INCLUDE_vTaskDelete */
@@ -1350,14 +1587,20 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 	eTaskState eTaskGetState( TaskHandle_t xTask )
 	{
 	eTaskState eReturn;
-	List_t const * pxStateList, *pxDelayedList, *pxOverflowedDelayedList;
+	List_t const * pxStateList;
+	BaseType_t xDelayed;
 	const TCB_t * const pxTCB = xTask;
 
 		configASSERT( pxTCB );
 
+		#if ( configNUMBER_OF_CORES == 1 )
 		if( pxTCB == pxCurrentTCB )
+		#else
+		if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+		#endif
 		{
-			/* The task calling this function is querying its own state. */
+			/* The task calling this function is querying its own state, or
+			the task runs on another core. */
 			eReturn = eRunning;
 		}
 		else
@@ -1365,12 +1608,11 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 			taskENTER_CRITICAL();
 			{
 				pxStateList = listLIST_ITEM_CONTAINER( &( pxTCB->xStateListItem ) );
-				pxDelayedList = pxDelayedTaskList;
-				pxOverflowedDelayedList = pxOverflowDelayedTaskList;
+				xDelayed = taskIS_DELAYED_LIST( pxStateList );
 			}
 			taskEXIT_CRITICAL();
 
-			if( ( pxStateList == pxDelayedList ) || ( pxStateList == pxOverflowedDelayedList ) )
+			if( xDelayed != pdFALSE )
 			{
 				/* The task being queried is referenced from one of the Blocked
 				lists. */
@@ -1484,14 +1726,14 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		https://www.freertos.org/RTOS-Cortex-M3-M4.html */
 		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		uxSavedInterruptState = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptState = taskENTER_CRITICAL_FROM_ISR();
 		{
 			/* If null is passed in here then it is the priority of the calling
 			task that is being queried. */
 			pxTCB = prvGetTCBFromHandle( xTask );
 			uxReturn = pxTCB->uxPriority;
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptState );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptState );
 
 		return uxReturn;
 	}
@@ -1643,14 +1885,45 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					mtCOVERAGE_TEST_MARKER();
 				}
 
-				if( xYieldRequired != pdFALSE )
+				#if ( configNUMBER_OF_CORES == 1 )
 				{
-					taskYIELD_IF_USING_PREEMPTION();
+					if( xYieldRequired != pdFALSE )
+					{
+						taskYIELD_IF_USING_PREEMPTION();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
-				else
+				#else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* Against the tasks of every core, not only the calling
+					one.  A task set down gives up the core it runs on, and a
+					ready task raised may preempt the lowest core. */
+					if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+					{
+						if( uxNewPriority < uxCurrentBasePriority )
+						{
+							prvYieldCore( pxTCB->xTaskRunState );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+					}
+					else if( uxNewPriority > uxCurrentBasePriority )
+					{
+						prvYieldForTask( pxTCB );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+
+					( void ) xYieldRequired;
 				}
+				#endif /* configNUMBER_OF_CORES */
 
 				/* Remove compiler warning about unused variables when the port
 				optimised task selection is not being used. */
@@ -1710,9 +1983,38 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				}
 			}
 			#endif
+
+			#if ( configNUMBER_OF_CORES > 1 )
+			{
+				if( xSchedulerRunning != pdFALSE )
+				{
+					/* Reset the next expected unblock time in case it referred
+					to the task that is now in the Suspended state. */
+					prvResetNextTaskUnblockTime();
+
+					/* The task may run on another core, so it is switched out
+					before the critical section is left, or it could put itself
+					back on a list and undo the suspension. */
+					if( pxTCB->xTaskRunState == ( BaseType_t ) portGET_CORE_ID() )
+					{
+						configASSERT( uxSchedulerSuspended == 0 );
+						vTaskYieldWithinAPI();
+					}
+					else
+					{
+						taskYIELD_TASK_CORE_IF_USING_PREEMPTION( pxTCB );
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			#endif /* configNUMBER_OF_CORES */
 		}
 		taskEXIT_CRITICAL();
 
+		#if ( configNUMBER_OF_CORES == 1 )
 		if( xSchedulerRunning != pdFALSE )
 		{
 			/* Reset the next expected unblock time in case it referred to the
@@ -1759,6 +2061,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		{
 			mtCOVERAGE_TEST_MARKER();
 		}
+		#endif /* configNUMBER_OF_CORES */
 	}
 
 #endif /* INCLUDE_vTaskSuspend */
@@ -1835,6 +2138,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					prvAddTaskToReadyList( pxTCB );
 
 					/* A higher priority task may have just been resumed. */
+					#if ( configNUMBER_OF_CORES == 1 )
 					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
 					{
 						/* This yield may not cause the task just resumed to run,
@@ -1846,6 +2150,9 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
+					#else
+					prvYieldForTask( pxTCB );
+					#endif
 				}
 				else
 				{
@@ -1892,7 +2199,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 		https://www.freertos.org/RTOS-Cortex-M3-M4.html */
 		portASSERT_IF_INTERRUPT_PRIORITY_INVALID();
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			if( prvTaskIsTaskSuspended( pxTCB ) != pdFALSE )
 			{
@@ -1903,6 +2210,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				{
 					/* Ready lists can be accessed so move the task from the
 					suspended list to the ready list directly. */
+					#if ( configNUMBER_OF_CORES == 1 )
 					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
 					{
 						xYieldRequired = pdTRUE;
@@ -1911,9 +2219,19 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
+					#endif
 
 					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
 					prvAddTaskToReadyList( pxTCB );
+
+					#if ( configNUMBER_OF_CORES > 1 )
+					{
+						/* Another core is interrupted here, only this one is
+						left to the caller. */
+						prvYieldForTask( pxTCB );
+						xYieldRequired = xYieldPendings[ portGET_CORE_ID() ];
+					}
+					#endif
 				}
 				else
 				{
@@ -1928,7 +2246,7 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xYieldRequired;
 	}
@@ -1936,12 +2254,90 @@ static void prvAddNewTaskToReadyList( TCB_t *pxNewTCB )
 #endif /* ( ( INCLUDE_xTaskResumeFromISR == 1 ) && ( INCLUDE_vTaskSuspend == 1 ) ) */
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+	static BaseType_t prvCreateIdleTasks( void )
+	{
+	BaseType_t xCoreID, xReturn = pdPASS;
+	char cIdleName[ configMAX_TASK_NAME_LEN ];
+
+		for( xCoreID = 0; ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) && ( xReturn == pdPASS ); xCoreID++ )
+		{
+			/* The idle task of core 0 keeps the name of the one idle task,
+			the others have the number of their core appended. */
+			strncpy( cIdleName, configIDLE_TASK_NAME, configMAX_TASK_NAME_LEN - 2 );
+			cIdleName[ configMAX_TASK_NAME_LEN - 2 ] = '\0';
+			if( xCoreID > 0 )
+			{
+				cIdleName[ strlen( cIdleName ) + 1 ] = '\0';
+				cIdleName[ strlen( cIdleName ) ] = ( char ) ( '0' + xCoreID );
+			}
+
+			#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+			{
+				StaticTask_t *pxIdleTaskTCBBuffer = NULL;
+				StackType_t *pxIdleTaskStackBuffer = NULL;
+				uint32_t ulIdleTaskStackSize;
+
+				if( xCoreID == 0 )
+				{
+					vApplicationGetIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize );
+				}
+				else
+				{
+					vApplicationGetCoreIdleTaskMemory( &pxIdleTaskTCBBuffer, &pxIdleTaskStackBuffer, &ulIdleTaskStackSize, xCoreID );
+				}
+
+				xIdleTaskHandles[ xCoreID ] = xTaskCreateStatic(	prvIdleTask,
+																	cIdleName,
+																	ulIdleTaskStackSize,
+																	( void * ) NULL,
+																	portPRIVILEGE_BIT,
+																	pxIdleTaskStackBuffer,
+																	pxIdleTaskTCBBuffer );
+			}
+			#else
+			{
+				( void ) xTaskCreate(	prvIdleTask,
+										cIdleName,
+										configMINIMAL_STACK_SIZE,
+										( void * ) NULL,
+										portPRIVILEGE_BIT,
+										&( xIdleTaskHandles[ xCoreID ] ) );
+			}
+			#endif /* configSUPPORT_STATIC_ALLOCATION */
+
+			if( xIdleTaskHandles[ xCoreID ] != NULL )
+			{
+				/* The idle task of a core only runs on that core, and is its
+				task until the scheduler starts. */
+				xIdleTaskHandles[ xCoreID ]->uxCoreAffinityMask = ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID;
+				xIdleTaskHandles[ xCoreID ]->xTaskRunState = xCoreID;
+				pxCurrentTCBs[ xCoreID ] = xIdleTaskHandles[ xCoreID ];
+			}
+			else
+			{
+				xReturn = pdFAIL;
+			}
+		}
+
+		return xReturn;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 void vTaskStartScheduler( void )
 {
 BaseType_t xReturn;
 
 	/* Add the idle task at the lowest priority. */
-	#if( configSUPPORT_STATIC_ALLOCATION == 1 )
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		/* One for each core. */
+		xReturn = prvCreateIdleTasks();
+	}
+	#elif( configSUPPORT_STATIC_ALLOCATION == 1 )
 	{
 		StaticTask_t *pxIdleTaskTCBBuffer = NULL;
 		StackType_t *pxIdleTaskStackBuffer = NULL;
@@ -2010,6 +2406,19 @@ BaseType_t xReturn;
 		starts to run. */
 		portDISABLE_INTERRUPTS();
 
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+		BaseType_t xCoreID;
+
+			/* Each core starts with the highest priority task it may run,
+			selected in the order of the cores. */
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				prvSelectHighestPriorityTask( xCoreID );
+			}
+		}
+		#endif /* configNUMBER_OF_CORES */
+
 		#if ( configUSE_NEWLIB_REENTRANT == 1 )
 		{
 			/* Switch Newlib's _impure_ptr variable to point to the _reent
@@ -2021,6 +2430,11 @@ BaseType_t xReturn;
 		xNextTaskUnblockTime = portMAX_DELAY;
 		xSchedulerRunning = pdTRUE;
 		xTickCount = ( TickType_t ) configINITIAL_TICK_COUNT;
+		#if ( configUSE_DELAY_WHEEL == 1 )
+		{
+			xDelayWheelTick = ( TickType_t ) configINITIAL_TICK_COUNT;
+		}
+		#endif
 
 		/* If configGENERATE_RUN_TIME_STATS is defined then the following
 		macro must be defined to configure the timer/counter used to generate
@@ -2054,7 +2468,11 @@ BaseType_t xReturn;
 
 	/* Prevent compiler warnings if INCLUDE_xTaskGetIdleTaskHandle is set to 0,
 	meaning xIdleTaskHandle is not used anywhere else. */
-	( void ) xIdleTaskHandle;
+	#if ( configNUMBER_OF_CORES == 1 )
+		( void ) xIdleTaskHandle;
+	#else
+		( void ) xIdleTaskHandles;
+	#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -2071,24 +2489,62 @@ void vTaskEndScheduler( void )
 
 void vTaskSuspendAll( void )
 {
-	/* A critical section is not required as the variable is of type
-	BaseType_t.  Please read Richard Barry's reply in the following link to a
-	post in the FreeRTOS support forum before reporting this as a bug! -
-	http://goo.gl/wu4acr */
-	++uxSchedulerSuspended;
-}
-/*----------------------------------------------------------*/
-
-#if ( configUSE_TICKLESS_IDLE != 0 )
-
-	static TickType_t prvGetExpectedIdleTime( void )
+	#if ( configNUMBER_OF_CORES == 1 )
 	{
-	TickType_t xReturn;
-	UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+		/* A critical section is not required as the variable is of type
+		BaseType_t.  Please read Richard Barry's reply in the following link to a
+		post in the FreeRTOS support forum before reporting this as a bug! -
+		http://goo.gl/wu4acr */
+		++uxSchedulerSuspended;
+	}
+	#else
+	{
+	UBaseType_t uxSavedInterruptStatus;
 
-		/* uxHigherPriorityReadyTasks takes care of the case where
-		configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
-		task that are in the Ready state, even though the idle task is
+		if( xSchedulerRunning != pdFALSE )
+		{
+			/* The task lock keeps the tasks of the other cores out of the
+			kernel until the scheduler is resumed, and the ISR lock guards the
+			count, which their interrupts read.  Interrupts are masked so the
+			task is not switched out between taking the lock and suspending the
+			scheduler. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			portGET_TASK_LOCK();
+
+			if( ( uxSchedulerSuspended == ( UBaseType_t ) 0U ) && ( portGET_CRITICAL_NESTING_COUNT() == 0U ) )
+			{
+				prvCheckForRunStateChange();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			portGET_ISR_LOCK();
+			++uxSchedulerSuspended;
+			portRELEASE_ISR_LOCK();
+
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			++uxSchedulerSuspended;
+		}
+	}
+	#endif /* configNUMBER_OF_CORES */
+}
+/*----------------------------------------------------------*/
+
+#if ( configUSE_TICKLESS_IDLE != 0 )
+
+	static TickType_t prvGetExpectedIdleTime( void )
+	{
+	TickType_t xReturn;
+	UBaseType_t uxHigherPriorityReadyTasks = pdFALSE;
+
+		/* uxHigherPriorityReadyTasks takes care of the case where
+		configUSE_PREEMPTION is 0, so there may be tasks above the idle priority
+		task that are in the Ready state, even though the idle task is
 		running. */
 		#if( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
 		{
@@ -2160,6 +2616,21 @@ BaseType_t xAlreadyYielded = pdFALSE;
 	{
 		--uxSchedulerSuspended;
 
+		#if ( configNUMBER_OF_CORES > 1 )
+		{
+			/* Let go of the task lock of vTaskSuspendAll(), which the critical
+			section holds until it is left. */
+			if( xSchedulerRunning != pdFALSE )
+			{
+				portRELEASE_TASK_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#endif /* configNUMBER_OF_CORES */
+
 		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
 		{
 			if( uxCurrentNumberOfTasks > ( UBaseType_t ) 0U )
@@ -2175,6 +2646,7 @@ BaseType_t xAlreadyYielded = pdFALSE;
 
 					/* If the moved task has a priority higher than the current
 					task then a yield must be performed. */
+					#if ( configNUMBER_OF_CORES == 1 )
 					if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
 					{
 						xYieldPending = pdTRUE;
@@ -2183,6 +2655,9 @@ BaseType_t xAlreadyYielded = pdFALSE;
 					{
 						mtCOVERAGE_TEST_MARKER();
 					}
+					#else
+					prvYieldForTask( pxTCB );
+					#endif
 				}
 
 				if( pxTCB != NULL )
@@ -2413,15 +2888,26 @@ TCB_t *pxTCB;
 			} while( uxQueue > ( UBaseType_t ) tskIDLE_PRIORITY ); /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
 
 			/* Search the delayed lists. */
-			if( pxTCB == NULL )
+			#if ( configUSE_DELAY_WHEEL == 1 )
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				for( uxQueue = 0; ( pxTCB == NULL ) && ( uxQueue < ( UBaseType_t ) configDELAY_WHEEL_SIZE ); uxQueue++ )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( &( xDelayWheel[ uxQueue ] ), pcNameToQuery );
+				}
 			}
-
-			if( pxTCB == NULL )
+			#else
 			{
-				pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxDelayedTaskList, pcNameToQuery );
+				}
+
+				if( pxTCB == NULL )
+				{
+					pxTCB = prvSearchForNameWithinSingleList( ( List_t * ) pxOverflowDelayedTaskList, pcNameToQuery );
+				}
 			}
+			#endif /* configUSE_DELAY_WHEEL */
 
 			#if ( INCLUDE_vTaskSuspend == 1 )
 			{
@@ -2453,7 +2939,7 @@ TCB_t *pxTCB;
 
 #if ( configUSE_TRACE_FACILITY == 1 )
 
-	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, uint32_t * const pulTotalRunTime )
+	UBaseType_t uxTaskGetSystemState( TaskStatus_t * const pxTaskStatusArray, const UBaseType_t uxArraySize, configRUN_TIME_COUNTER_TYPE * const pulTotalRunTime )
 	{
 	UBaseType_t uxTask = 0, uxQueue = configMAX_PRIORITIES;
 
@@ -2473,8 +2959,19 @@ TCB_t *pxTCB;
 
 				/* Fill in an TaskStatus_t structure with information on each
 				task in the Blocked state. */
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
-				uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				#if ( configUSE_DELAY_WHEEL == 1 )
+				{
+					for( uxQueue = 0; uxQueue < ( UBaseType_t ) configDELAY_WHEEL_SIZE; uxQueue++ )
+					{
+						uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), &( xDelayWheel[ uxQueue ] ), eBlocked );
+					}
+				}
+				#else
+				{
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxDelayedTaskList, eBlocked );
+					uxTask += prvListTasksWithinSingleList( &( pxTaskStatusArray[ uxTask ] ), ( List_t * ) pxOverflowDelayedTaskList, eBlocked );
+				}
+				#endif /* configUSE_DELAY_WHEEL */
 
 				#if( INCLUDE_vTaskDelete == 1 )
 				{
@@ -2529,12 +3026,34 @@ TCB_t *pxTCB;
 
 	TaskHandle_t xTaskGetIdleTaskHandle( void )
 	{
-		/* If xTaskGetIdleTaskHandle() is called before the scheduler has been
-		started, then xIdleTaskHandle will be NULL. */
-		configASSERT( ( xIdleTaskHandle != NULL ) );
-		return xIdleTaskHandle;
+		#if ( configNUMBER_OF_CORES == 1 )
+		{
+			/* If xTaskGetIdleTaskHandle() is called before the scheduler has been
+			started, then xIdleTaskHandle will be NULL. */
+			configASSERT( ( xIdleTaskHandle != NULL ) );
+			return xIdleTaskHandle;
+		}
+		#else
+		{
+			return xTaskGetIdleTaskHandleForCore( 0 );
+		}
+		#endif
 	}
 
+	#if ( configNUMBER_OF_CORES > 1 )
+
+		TaskHandle_t xTaskGetIdleTaskHandleForCore( BaseType_t xCoreID )
+		{
+			configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+
+			/* If called before the scheduler has been started, then the
+			handle will be NULL. */
+			configASSERT( ( xIdleTaskHandles[ xCoreID ] != NULL ) );
+			return xIdleTaskHandles[ xCoreID ];
+		}
+
+	#endif /* configNUMBER_OF_CORES */
+
 #endif /* INCLUDE_xTaskGetIdleTaskHandle */
 /*----------------------------------------------------------*/
 
@@ -2548,7 +3067,9 @@ implementations require configUSE_TICKLESS_IDLE to be set to a value other than
 	{
 		/* Correct the tick count value after a period during which the tick
 		was suppressed.  Note this does *not* call the tick hook function for
-		each stepped tick. */
+		each stepped tick.  With the timing wheel, the slots of the stepped
+		ticks are visited by the next tick, so a step onto the wake time of a
+		task wakes it on that tick, as the delayed lists would. */
 		configASSERT( ( xTickCount + xTicksToJump ) <= xNextTaskUnblockTime );
 		xTickCount += xTicksToJump;
 		traceINCREASE_TICK_COUNT( xTicksToJump );
@@ -2638,6 +3159,13 @@ BaseType_t xTaskIncrementTick( void )
 TCB_t * pxTCB;
 TickType_t xItemValue;
 BaseType_t xSwitchRequired = pdFALSE;
+#if ( configNUMBER_OF_CORES > 1 )
+	UBaseType_t uxSavedInterruptStatus;
+
+	/* The tick of one core unblocks the tasks of all of them, so the lists are
+	guarded against the other cores. */
+	uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
+#endif
 
 	/* Called by the portable layer each time a tick interrupt occurs.
 	Increments the tick then checks to see if the new tick value will cause any
@@ -2653,62 +3181,65 @@ BaseType_t xSwitchRequired = pdFALSE;
 		delayed lists if it wraps to 0. */
 		xTickCount = xConstTickCount;
 
-		if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
-		{
-			taskSWITCH_DELAYED_LISTS();
-		}
-		else
+		#if ( configUSE_DELAY_WHEEL == 1 )
 		{
-			mtCOVERAGE_TEST_MARKER();
-		}
+		const TickType_t xElapsed = xConstTickCount - xDelayWheelTick;
+		TickType_t xSlots = xElapsed;
+		List_t *pxSlot;
+		ListItem_t *pxIterator;
 
-		/* See if this tick has made a timeout expire.  Tasks are stored in
-		the	queue in the order of their wake time - meaning once one task
-		has been found whose block time has not expired there is no need to
-		look any further down the list. */
-		if( xConstTickCount >= xNextTaskUnblockTime )
-		{
-			for( ;; )
+			/* vTaskStepTick() moves the tick count on without visiting the
+			wheel, so the ticks since the last visit are visited now, one slot
+			each, or every slot once if there are more ticks than slots.  The
+			tick count overflowed if 0 is one of them. */
+			if( xConstTickCount < xElapsed ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
 			{
-				if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
-				{
-					/* The delayed list is empty.  Set xNextTaskUnblockTime
-					to the maximum possible value so it is extremely
-					unlikely that the
-					if( xTickCount >= xNextTaskUnblockTime ) test will pass
-					next time through. */
-					xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
-					break;
-				}
-				else
+				xNumOfOverflows++;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			if( xSlots > ( TickType_t ) configDELAY_WHEEL_SIZE )
+			{
+				xSlots = ( TickType_t ) configDELAY_WHEEL_SIZE;
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			xDelayWheelTick = xConstTickCount;
+
+			/* Only the slots of those ticks can hold tasks whose block time
+			has expired.  A task in them wakes if its wake time is one of those
+			ticks, which the unsigned difference finds across the overflow too.
+			The tasks that wake on a later turn of the wheel are left where
+			they are. */
+			while( xSlots > ( TickType_t ) 0U )
+			{
+				xSlots--;
+				pxSlot = taskDELAY_WHEEL_SLOT( xConstTickCount - xSlots );
+				pxIterator = listGET_HEAD_ENTRY( pxSlot );
+				while( pxIterator != listGET_END_MARKER( pxSlot ) )
 				{
-					/* The delayed list is not empty, get the value of the
-					item at the head of the delayed list.  This is the time
-					at which the task at the head of the delayed list must
-					be removed from the Blocked state. */
-					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-					xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
-
-					if( xConstTickCount < xItemValue )
-					{
-						/* It is not time to unblock this item yet, but the
-						item value is the time at which the task at the head
-						of the blocked list must be removed from the Blocked
-						state -	so record the item value in
-						xNextTaskUnblockTime. */
-						xNextTaskUnblockTime = xItemValue;
-						break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
-					}
-					else
+					pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+					xItemValue = listGET_LIST_ITEM_VALUE( pxIterator );
+
+					/* Move on before the item is removed from the slot. */
+					pxIterator = listGET_NEXT( pxIterator );
+
+					if( ( TickType_t ) ( xConstTickCount - xItemValue ) >= xElapsed )
 					{
-						mtCOVERAGE_TEST_MARKER();
+						continue;
 					}
 
 					/* It is time to remove the item from the Blocked state. */
 					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
 
-					/* Is the task waiting on an event also?  If so remove
-					it from the event list. */
+					/* Is the task waiting on an event also?  If so remove it from
+					the event list. */
 					if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
 					{
 						( void ) uxListRemove( &( pxTCB->xEventListItem ) );
@@ -2718,18 +3249,11 @@ BaseType_t xSwitchRequired = pdFALSE;
 						mtCOVERAGE_TEST_MARKER();
 					}
 
-					/* Place the unblocked task into the appropriate ready
-					list. */
 					prvAddTaskToReadyList( pxTCB );
 
-					/* A task being unblocked cannot cause an immediate
-					context switch if preemption is turned off. */
 					#if (  configUSE_PREEMPTION == 1 )
 					{
-						/* Preemption is on, but a context switch should
-						only be performed if the unblocked task has a
-						priority that is equal to or higher than the
-						currently executing task. */
+						#if ( configNUMBER_OF_CORES == 1 )
 						if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
 						{
 							xSwitchRequired = pdTRUE;
@@ -2738,16 +3262,129 @@ BaseType_t xSwitchRequired = pdFALSE;
 						{
 							mtCOVERAGE_TEST_MARKER();
 						}
+						#else
+						prvYieldForTask( pxTCB );
+						#endif
 					}
 					#endif /* configUSE_PREEMPTION */
 				}
 			}
+
+			/* Find the next wake time once this one has passed, and when the
+			tasks that overflowed the tick count come into range. */
+			if( ( xConstTickCount >= xNextTaskUnblockTime ) || ( xConstTickCount < xElapsed ) )
+			{
+				prvResetNextTaskUnblockTime();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		#else
+		{
+			if( xConstTickCount == ( TickType_t ) 0U ) /*lint !e774 'if' does not always evaluate to false as it is looking for an overflow. */
+			{
+				taskSWITCH_DELAYED_LISTS();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			/* See if this tick has made a timeout expire.  Tasks are stored in
+			the	queue in the order of their wake time - meaning once one task
+			has been found whose block time has not expired there is no need to
+			look any further down the list. */
+			if( xConstTickCount >= xNextTaskUnblockTime )
+			{
+				for( ;; )
+				{
+					if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+					{
+						/* The delayed list is empty.  Set xNextTaskUnblockTime
+						to the maximum possible value so it is extremely
+						unlikely that the
+						if( xTickCount >= xNextTaskUnblockTime ) test will pass
+						next time through. */
+						xNextTaskUnblockTime = portMAX_DELAY; /*lint !e961 MISRA exception as the casts are only redundant for some ports. */
+						break;
+					}
+					else
+					{
+						/* The delayed list is not empty, get the value of the
+						item at the head of the delayed list.  This is the time
+						at which the task at the head of the delayed list must
+						be removed from the Blocked state. */
+						pxTCB = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+						xItemValue = listGET_LIST_ITEM_VALUE( &( pxTCB->xStateListItem ) );
+
+						if( xConstTickCount < xItemValue )
+						{
+							/* It is not time to unblock this item yet, but the
+							item value is the time at which the task at the head
+							of the blocked list must be removed from the Blocked
+							state -	so record the item value in
+							xNextTaskUnblockTime. */
+							xNextTaskUnblockTime = xItemValue;
+							break; /*lint !e9011 Code structure here is deedmed easier to understand with multiple breaks. */
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						/* It is time to remove the item from the Blocked state. */
+						( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+
+						/* Is the task waiting on an event also?  If so remove
+						it from the event list. */
+						if( listLIST_ITEM_CONTAINER( &( pxTCB->xEventListItem ) ) != NULL )
+						{
+							( void ) uxListRemove( &( pxTCB->xEventListItem ) );
+						}
+						else
+						{
+							mtCOVERAGE_TEST_MARKER();
+						}
+
+						/* Place the unblocked task into the appropriate ready
+						list. */
+						prvAddTaskToReadyList( pxTCB );
+
+						/* A task being unblocked cannot cause an immediate
+						context switch if preemption is turned off. */
+						#if (  configUSE_PREEMPTION == 1 )
+						{
+							/* Preemption is on, but a context switch should
+							only be performed if the unblocked task has a
+							priority that is equal to or higher than the
+							currently executing task. */
+							#if ( configNUMBER_OF_CORES == 1 )
+							if( pxTCB->uxPriority >= pxCurrentTCB->uxPriority )
+							{
+								xSwitchRequired = pdTRUE;
+							}
+							else
+							{
+								mtCOVERAGE_TEST_MARKER();
+							}
+							#else
+							/* Against the task of every core. */
+							prvYieldForTask( pxTCB );
+							#endif
+						}
+						#endif /* configUSE_PREEMPTION */
+					}
+				}
+			}
 		}
+		#endif /* configUSE_DELAY_WHEEL */
 
 		/* Tasks of equal priority to the currently running task will share
 		processing time (time slice) if preemption is on, and the application
 		writer has not explicitly turned time slicing off. */
-		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		#if ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) && ( configNUMBER_OF_CORES == 1 ) )
 		{
 			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ pxCurrentTCB->uxPriority ] ) ) > ( UBaseType_t ) 1 )
 			{
@@ -2758,6 +3395,32 @@ BaseType_t xSwitchRequired = pdFALSE;
 				mtCOVERAGE_TEST_MARKER();
 			}
 		}
+		#elif ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) )
+		{
+		BaseType_t xCoreID;
+		const List_t *pxReadyList;
+		const ListItem_t *pxIterator;
+		const TCB_t *pxTCB;
+
+			/* A core shares its time only with a ready task of its priority
+			that no core runs and that may run on it. */
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				pxReadyList = &( pxReadyTasksLists[ pxCurrentTCBs[ xCoreID ]->uxPriority ] );
+
+				for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != listGET_END_MARKER( pxReadyList ); pxIterator = listGET_NEXT( pxIterator ) )
+				{
+					pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+					if( ( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING ) &&
+						( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U ) )
+					{
+						prvYieldCore( xCoreID );
+						break;
+					}
+				}
+			}
+		}
 		#endif /* ( ( configUSE_PREEMPTION == 1 ) && ( configUSE_TIME_SLICING == 1 ) ) */
 
 		#if ( configUSE_TICK_HOOK == 1 )
@@ -2801,6 +3464,12 @@ BaseType_t xSwitchRequired = pdFALSE;
 	}
 	#endif /* configUSE_PREEMPTION */
 
+	#if ( configNUMBER_OF_CORES > 1 )
+	{
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
+	}
+	#endif
+
 	return xSwitchRequired;
 }
 /*-----------------------------------------------------------*/
@@ -2899,6 +3568,20 @@ BaseType_t xSwitchRequired = pdFALSE;
 
 void vTaskSwitchContext( void )
 {
+#if ( configNUMBER_OF_CORES > 1 )
+	const BaseType_t xCoreID = ( BaseType_t ) portGET_CORE_ID();
+
+	/* The task lock is taken first, so the core waits here while another core
+	has the scheduler suspended, instead of holding its switch pending until a
+	resume it does not make.  The ISR lock guards the ready lists. */
+	portGET_TASK_LOCK();
+	portGET_ISR_LOCK();
+
+	/* With more than one core, a switch is never made from a critical
+	section, as the locks of the section would change hands. */
+	configASSERT( portGET_CRITICAL_NESTING_COUNT() == 0U );
+#endif
+
 	if( uxSchedulerSuspended != ( UBaseType_t ) pdFALSE )
 	{
 		/* The scheduler is currently suspended - do not allow a context
@@ -2925,6 +3608,7 @@ void vTaskSwitchContext( void )
 				overflows.  The guard against negative values is to protect
 				against suspect run time stat counter implementations - which
 				are provided by the application, not the kernel. */
+				#if ( configNUMBER_OF_CORES == 1 )
 				if( ulTotalRunTime > ulTaskSwitchedInTime )
 				{
 					pxCurrentTCB->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime );
@@ -2934,6 +3618,17 @@ void vTaskSwitchContext( void )
 					mtCOVERAGE_TEST_MARKER();
 				}
 				ulTaskSwitchedInTime = ulTotalRunTime;
+				#else
+				if( ulTotalRunTime > ulTaskSwitchedInTime[ xCoreID ] )
+				{
+					pxCurrentTCBs[ xCoreID ]->ulRunTimeCounter += ( ulTotalRunTime - ulTaskSwitchedInTime[ xCoreID ] );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+				ulTaskSwitchedInTime[ xCoreID ] = ulTotalRunTime;
+				#endif /* configNUMBER_OF_CORES */
 		}
 		#endif /* configGENERATE_RUN_TIME_STATS */
 
@@ -2949,7 +3644,11 @@ void vTaskSwitchContext( void )
 
 		/* Select a new task to run using either the generic C or port
 		optimised asm code. */
-		taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		#if ( configNUMBER_OF_CORES == 1 )
+			taskSELECT_HIGHEST_PRIORITY_TASK(); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+		#else
+			prvSelectHighestPriorityTask( xCoreID );
+		#endif
 		traceTASK_SWITCHED_IN();
 
 		/* After the new task is switched in, update the global errno. */
@@ -2967,6 +3666,11 @@ void vTaskSwitchContext( void )
 		}
 		#endif /* configUSE_NEWLIB_REENTRANT */
 	}
+
+#if ( configNUMBER_OF_CORES > 1 )
+	portRELEASE_ISR_LOCK();
+	portRELEASE_TASK_LOCK();
+#endif
 }
 /*-----------------------------------------------------------*/
 
@@ -3078,6 +3782,7 @@ BaseType_t xReturn;
 		vListInsertEnd( &( xPendingReadyList ), &( pxUnblockedTCB->xEventListItem ) );
 	}
 
+	#if ( configNUMBER_OF_CORES == 1 )
 	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
 	{
 		/* Return true if the task removed from the event list has a higher
@@ -3093,6 +3798,23 @@ BaseType_t xReturn;
 	{
 		xReturn = pdFALSE;
 	}
+	#else
+	{
+		/* The task is compared against the task of every core, and another
+		core is interrupted here, so only a switch of the calling core is
+		returned.  A task held pending is compared once xTaskResumeAll() has
+		readied it. */
+		if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+		{
+			prvYieldForTask( pxUnblockedTCB );
+			xReturn = xYieldPending;
+		}
+		else
+		{
+			xReturn = pdFALSE;
+		}
+	}
+	#endif /* configNUMBER_OF_CORES */
 
 	#if( configUSE_TICKLESS_IDLE != 0 )
 	{
@@ -3135,6 +3857,7 @@ TCB_t *pxUnblockedTCB;
 	( void ) uxListRemove( &( pxUnblockedTCB->xStateListItem ) );
 	prvAddTaskToReadyList( pxUnblockedTCB );
 
+	#if ( configNUMBER_OF_CORES == 1 )
 	if( pxUnblockedTCB->uxPriority > pxCurrentTCB->uxPriority )
 	{
 		/* The unblocked task has a priority above that of the calling task, so
@@ -3143,6 +3866,18 @@ TCB_t *pxUnblockedTCB;
 		occurs immediately that the scheduler is resumed (unsuspended). */
 		xYieldPending = pdTRUE;
 	}
+	#else
+	{
+		/* The other cores run on while this one has the scheduler suspended,
+		so their tasks are only compared inside a critical section.  A switch
+		of this core is still held until the scheduler is resumed. */
+		taskENTER_CRITICAL();
+		{
+			prvYieldForTask( pxUnblockedTCB );
+		}
+		taskEXIT_CRITICAL();
+	}
+	#endif /* configNUMBER_OF_CORES */
 }
 /*-----------------------------------------------------------*/
 
@@ -3323,8 +4058,9 @@ static portTASK_FUNCTION( prvIdleTask, pvParameters )
 			A critical region is not required here as we are just reading from
 			the list, and an occasional incorrect value will not matter.  If
 			the ready list at the idle priority contains more than one task
-			then a task other than the idle task is ready to execute. */
-			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) 1 )
+			then a task other than the idle task is ready to execute.  With
+			more than one core, the list holds the idle task of each. */
+			if( listCURRENT_LIST_LENGTH( &( pxReadyTasksLists[ tskIDLE_PRIORITY ] ) ) > ( UBaseType_t ) configNUMBER_OF_CORES )
 			{
 				taskYIELD();
 			}
@@ -3505,8 +4241,19 @@ UBaseType_t uxPriority;
 		vListInitialise( &( pxReadyTasksLists[ uxPriority ] ) );
 	}
 
-	vListInitialise( &xDelayedTaskList1 );
-	vListInitialise( &xDelayedTaskList2 );
+	#if ( configUSE_DELAY_WHEEL == 1 )
+	{
+		for( uxPriority = ( UBaseType_t ) 0U; uxPriority < ( UBaseType_t ) configDELAY_WHEEL_SIZE; uxPriority++ )
+		{
+			vListInitialise( &( xDelayWheel[ uxPriority ] ) );
+		}
+	}
+	#else
+	{
+		vListInitialise( &xDelayedTaskList1 );
+		vListInitialise( &xDelayedTaskList2 );
+	}
+	#endif /* configUSE_DELAY_WHEEL */
 	vListInitialise( &xPendingReadyList );
 
 	#if ( INCLUDE_vTaskDelete == 1 )
@@ -3521,10 +4268,14 @@ UBaseType_t uxPriority;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 
-	/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
-	using list2. */
-	pxDelayedTaskList = &xDelayedTaskList1;
-	pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	#if ( configUSE_DELAY_WHEEL == 0 )
+	{
+		/* Start with pxDelayedTaskList using list1 and the pxOverflowDelayedTaskList
+		using list2. */
+		pxDelayedTaskList = &xDelayedTaskList1;
+		pxOverflowDelayedTaskList = &xDelayedTaskList2;
+	}
+	#endif /* configUSE_DELAY_WHEEL */
 }
 /*-----------------------------------------------------------*/
 
@@ -3541,14 +4292,51 @@ static void prvCheckTasksWaitingTermination( void )
 		being called too often in the idle task. */
 		while( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
 		{
-			taskENTER_CRITICAL();
+			#if ( configNUMBER_OF_CORES == 1 )
 			{
-				pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-				( void ) uxListRemove( &( pxTCB->xStateListItem ) );
-				--uxCurrentNumberOfTasks;
-				--uxDeletedTasksWaitingCleanUp;
+				taskENTER_CRITICAL();
+				{
+					pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+					( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+					--uxCurrentNumberOfTasks;
+					--uxDeletedTasksWaitingCleanUp;
+				}
+				taskEXIT_CRITICAL();
 			}
-			taskEXIT_CRITICAL();
+			#else
+			{
+				pxTCB = NULL;
+
+				/* The idle task of another core may have freed the task in
+				the meantime, and a task deleted while it ran on another core
+				is only freed once that core has switched it out. */
+				taskENTER_CRITICAL();
+				{
+					if( uxDeletedTasksWaitingCleanUp > ( UBaseType_t ) 0U )
+					{
+						pxTCB = listGET_OWNER_OF_HEAD_ENTRY( ( &xTasksWaitingTermination ) ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+						if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+						{
+							( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+							--uxCurrentNumberOfTasks;
+							--uxDeletedTasksWaitingCleanUp;
+						}
+						else
+						{
+							pxTCB = NULL;
+						}
+					}
+				}
+				taskEXIT_CRITICAL();
+
+				if( pxTCB == NULL )
+				{
+					/* Try again on the next pass of the idle task. */
+					break;
+				}
+			}
+			#endif /* configNUMBER_OF_CORES */
 
 			prvDeleteTCB( pxTCB );
 		}
@@ -3597,7 +4385,11 @@ static void prvCheckTasksWaitingTermination( void )
 		state is just set to whatever is passed in. */
 		if( eState != eInvalid )
 		{
+			#if ( configNUMBER_OF_CORES == 1 )
 			if( pxTCB == pxCurrentTCB )
+			#else
+			if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+			#endif
 			{
 				pxTaskStatus->eCurrentState = eRunning;
 			}
@@ -3790,45 +4582,127 @@ static void prvCheckTasksWaitingTermination( void )
 #endif /* INCLUDE_vTaskDelete */
 /*-----------------------------------------------------------*/
 
-static void prvResetNextTaskUnblockTime( void )
-{
-TCB_t *pxTCB;
+#if ( configUSE_DELAY_WHEEL == 1 )
 
-	if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+	static void prvResetNextTaskUnblockTime( void )
 	{
-		/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
-		the maximum possible value so it is	extremely unlikely that the
-		if( xTickCount >= xNextTaskUnblockTime ) test will pass until
-		there is an item in the delayed list. */
+	const TickType_t xConstTickCount = xTickCount;
+	const List_t *pxSlot;
+	const ListItem_t *pxIterator;
+	TickType_t xTime, xItemValue;
+	UBaseType_t uxTurn;
+
+		/* Visit the slots in the order of the ticks they come round on.  A task
+		that wakes on the tick its slot comes round on wakes before any task
+		left to visit, so the search stops there.  Otherwise the earliest of
+		the wake times on later turns of the wheel is kept.  As with the
+		delayed lists, the tasks that wake after the tick count overflows are
+		not counted until it does. */
 		xNextTaskUnblockTime = portMAX_DELAY;
-	}
-	else
-	{
-		/* The new current delayed list is not empty, get the value of
-		the item at the head of the delayed list.  This is the time at
-		which the task at the head of the delayed list should be removed
-		from the Blocked state. */
-		( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
-		xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
-	}
-}
-/*-----------------------------------------------------------*/
 
-#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) )
+		for( uxTurn = ( UBaseType_t ) 1U; uxTurn <= ( UBaseType_t ) configDELAY_WHEEL_SIZE; uxTurn++ )
+		{
+			xTime = xConstTickCount + ( TickType_t ) uxTurn;
+
+			if( xTime < xConstTickCount )
+			{
+				/* Every wake time before the overflow is in a slot already
+				visited. */
+				break;
+			}
+
+			pxSlot = taskDELAY_WHEEL_SLOT( xTime );
+
+			for( pxIterator = listGET_HEAD_ENTRY( pxSlot ); pxIterator != listGET_END_MARKER( pxSlot ); pxIterator = listGET_NEXT( pxIterator ) )
+			{
+				xItemValue = listGET_LIST_ITEM_VALUE( pxIterator );
+
+				if( xItemValue == xTime )
+				{
+					xNextTaskUnblockTime = xTime;
+					return;
+				}
+				else if( ( xItemValue > xConstTickCount ) && ( xItemValue < xNextTaskUnblockTime ) )
+				{
+					xNextTaskUnblockTime = xItemValue;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+		}
+	}
+
+#else
+
+	static void prvResetNextTaskUnblockTime( void )
+	{
+	TCB_t *pxTCB;
+
+		if( listLIST_IS_EMPTY( pxDelayedTaskList ) != pdFALSE )
+		{
+			/* The new current delayed list is empty.  Set xNextTaskUnblockTime to
+			the maximum possible value so it is	extremely unlikely that the
+			if( xTickCount >= xNextTaskUnblockTime ) test will pass until
+			there is an item in the delayed list. */
+			xNextTaskUnblockTime = portMAX_DELAY;
+		}
+		else
+		{
+			/* The new current delayed list is not empty, get the value of
+			the item at the head of the delayed list.  This is the time at
+			which the task at the head of the delayed list should be removed
+			from the Blocked state. */
+			( pxTCB ) = listGET_OWNER_OF_HEAD_ENTRY( pxDelayedTaskList ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+			xNextTaskUnblockTime = listGET_LIST_ITEM_VALUE( &( ( pxTCB )->xStateListItem ) );
+		}
+	}
+
+#endif /* configUSE_DELAY_WHEEL */
+/*-----------------------------------------------------------*/
+
+#if ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) )
 
 	TaskHandle_t xTaskGetCurrentTaskHandle( void )
 	{
 	TaskHandle_t xReturn;
 
-		/* A critical section is not required as this is not called from
-		an interrupt and the current TCB will always be the same for any
-		individual execution thread. */
-		xReturn = pxCurrentTCB;
+		#if ( configNUMBER_OF_CORES == 1 )
+		{
+			/* A critical section is not required as this is not called from
+			an interrupt and the current TCB will always be the same for any
+			individual execution thread. */
+			xReturn = pxCurrentTCB;
+		}
+		#else
+		{
+		UBaseType_t uxSavedInterruptStatus;
+
+			/* The calling task must not be switched out and in again on
+			another core between reading the ID of the core and its task. */
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+			{
+				xReturn = pxCurrentTCBs[ portGET_CORE_ID() ];
+			}
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		#endif /* configNUMBER_OF_CORES */
 
 		return xReturn;
 	}
 
-#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) ) */
+	#if ( configNUMBER_OF_CORES > 1 )
+
+		TaskHandle_t xTaskGetCurrentTaskHandleForCore( BaseType_t xCoreID )
+		{
+			configASSERT( ( xCoreID >= 0 ) && ( xCoreID < ( BaseType_t ) configNUMBER_OF_CORES ) );
+			return pxCurrentTCBs[ xCoreID ];
+		}
+
+	#endif /* configNUMBER_OF_CORES */
+
+#endif /* ( ( INCLUDE_xTaskGetCurrentTaskHandle == 1 ) || ( configUSE_MUTEXES == 1 ) || ( configNUMBER_OF_CORES > 1 ) ) */
 /*-----------------------------------------------------------*/
 
 #if ( ( INCLUDE_xTaskGetSchedulerState == 1 ) || ( configUSE_TIMERS == 1 ) )
@@ -3843,14 +4717,25 @@ TCB_t *pxTCB;
 		}
 		else
 		{
-			if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
-			{
-				xReturn = taskSCHEDULER_RUNNING;
-			}
-			else
+			/* With more than one core, the critical section waits for another
+			core that has the scheduler suspended to resume it, so the state is
+			that seen by the calling core. */
+			#if ( configNUMBER_OF_CORES > 1 )
+				taskENTER_CRITICAL();
+			#endif
 			{
-				xReturn = taskSCHEDULER_SUSPENDED;
+				if( uxSchedulerSuspended == ( UBaseType_t ) pdFALSE )
+				{
+					xReturn = taskSCHEDULER_RUNNING;
+				}
+				else
+				{
+					xReturn = taskSCHEDULER_SUSPENDED;
+				}
 			}
+			#if ( configNUMBER_OF_CORES > 1 )
+				taskEXIT_CRITICAL();
+			#endif
 		}
 
 		return xReturn;
@@ -4191,6 +5076,500 @@ TCB_t *pxTCB;
 #endif /* portCRITICAL_NESTING_IN_TCB */
 /*-----------------------------------------------------------*/
 
+#if ( configNUMBER_OF_CORES > 1 )
+
+	void vTaskEnterCritical( void )
+	{
+		portDISABLE_INTERRUPTS();
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			/* The locks are taken once, by the outermost critical section of
+			the core.  The task lock always comes first. */
+			if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+			{
+				portGET_TASK_LOCK();
+				portGET_ISR_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			portSET_CRITICAL_NESTING_COUNT( portGET_CRITICAL_NESTING_COUNT() + 1U );
+
+			/* This is not the interrupt safe version of the enter critical
+			function so	assert() if it is being called from an interrupt
+			context.  Only API functions that end in "FromISR" can be used in an
+			interrupt.  Only assert if the critical nesting count is 1 to
+			protect against recursive calls if the assert function also uses a
+			critical section. */
+			if( portGET_CRITICAL_NESTING_COUNT() == 1U )
+			{
+				portASSERT_IF_IN_ISR();
+
+				/* Another core may have asked this task to yield while it
+				waited for the locks.  With the scheduler suspended, the task
+				holds the task lock, so can not have been asked. */
+				if( uxSchedulerSuspended == ( UBaseType_t ) 0U )
+				{
+					prvCheckForRunStateChange();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskExitCritical( void )
+	{
+	BaseType_t xYieldCurrentTask;
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+			if( portGET_CRITICAL_NESTING_COUNT() > 0U )
+			{
+				portSET_CRITICAL_NESTING_COUNT( portGET_CRITICAL_NESTING_COUNT() - 1U );
+
+				if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+				{
+					/* A switch asked for inside the critical section is made
+					now, unless this core has the scheduler suspended, which is
+					only known for sure while the locks are held. */
+					xYieldCurrentTask = ( ( xYieldPending != pdFALSE ) && ( uxSchedulerSuspended == ( UBaseType_t ) 0U ) ) ? pdTRUE : pdFALSE;
+
+					portRELEASE_ISR_LOCK();
+					portRELEASE_TASK_LOCK();
+					portENABLE_INTERRUPTS();
+
+					if( xYieldCurrentTask != pdFALSE )
+					{
+						portYIELD();
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskEnterCriticalFromISR( void )
+	{
+	UBaseType_t uxSavedInterruptStatus = 0U;
+
+		if( xSchedulerRunning != pdFALSE )
+		{
+			uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+
+			/* An interrupt takes only the ISR lock, as the task lock may be
+			held by the task it interrupted. */
+			if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+			{
+				portGET_ISR_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			portSET_CRITICAL_NESTING_COUNT( portGET_CRITICAL_NESTING_COUNT() + 1U );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		return uxSavedInterruptStatus;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskExitCriticalFromISR( UBaseType_t uxSavedInterruptStatus )
+	{
+		if( xSchedulerRunning != pdFALSE )
+		{
+			configASSERT( portGET_CRITICAL_NESTING_COUNT() > 0U );
+
+			if( portGET_CRITICAL_NESTING_COUNT() > 0U )
+			{
+				portSET_CRITICAL_NESTING_COUNT( portGET_CRITICAL_NESTING_COUNT() - 1U );
+
+				if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+				{
+					portRELEASE_ISR_LOCK();
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskYieldWithinAPI( void )
+	{
+		/* Inside a critical section the task can not be moved to another
+		core, so the core of the pending switch is known. */
+		if( portGET_CRITICAL_NESTING_COUNT() == 0U )
+		{
+			portYIELD();
+		}
+		else
+		{
+			xYieldPending = pdTRUE;
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvYieldCore( BaseType_t xCoreID )
+	{
+		if( xCoreID == ( BaseType_t ) portGET_CORE_ID() )
+		{
+			xYieldPendings[ xCoreID ] = pdTRUE;
+		}
+		else if( pxCurrentTCBs[ xCoreID ]->xTaskRunState != taskTASK_SCHEDULED_TO_YIELD )
+		{
+			/* The core can only switch once the locks held by the caller are
+			let go, by which time its task is marked. */
+			portYIELD_CORE( xCoreID );
+			pxCurrentTCBs[ xCoreID ]->xTaskRunState = taskTASK_SCHEDULED_TO_YIELD;
+		}
+		else
+		{
+			/* The core has already been asked. */
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvYieldForTask( const TCB_t *pxTCB )
+	{
+	BaseType_t xCoreID, xCorePriority, xLowestPriority, xLowestPriorityCore = -1;
+	const TCB_t *pxCoreTCB;
+
+		/* Called holding the locks.  Only a ready task that no core runs can
+		take a core, and only once the cores run their tasks. */
+		if( ( xSchedulerRunning != pdFALSE ) &&
+			( taskTASK_IS_RUNNING( pxTCB ) == pdFALSE ) &&
+			( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE ) )
+		{
+			/* The core to preempt runs a task of a lower priority than pxTCB,
+			the lowest of such cores.  An idle task counts one below the idle
+			priority, so a task of the idle priority still takes an idle core.
+			A core already switching will select its task anyway. */
+			xLowestPriority = ( BaseType_t ) pxTCB->uxPriority - ( BaseType_t ) 1;
+
+			for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+			{
+				pxCoreTCB = pxCurrentTCBs[ xCoreID ];
+
+				if( ( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) != 0U ) &&
+					( taskTASK_IS_RUNNING( pxCoreTCB ) != pdFALSE ) &&
+					( xYieldPendings[ xCoreID ] == pdFALSE ) )
+				{
+					xCorePriority = ( BaseType_t ) pxCoreTCB->uxPriority;
+
+					if( ( pxCoreTCB->uxTaskAttributes & taskATTRIBUTE_IS_IDLE ) != 0U )
+					{
+						xCorePriority--;
+					}
+
+					if( xCorePriority <= xLowestPriority )
+					{
+						xLowestPriority = xCorePriority;
+						xLowestPriorityCore = xCoreID;
+					}
+				}
+			}
+
+			if( xLowestPriorityCore >= 0 )
+			{
+				prvYieldCore( xLowestPriorityCore );
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvSelectHighestPriorityTask( BaseType_t xCoreID )
+	{
+	UBaseType_t uxPriority;
+	BaseType_t xTaskScheduled = pdFALSE, xDecrementTopPriority = pdTRUE;
+	List_t *pxReadyList;
+	ListItem_t *pxIterator;
+	TCB_t *pxTCB, *pxPreviousTCB = NULL;
+
+		/* The task of the core goes to the end of its ready list first, so it
+		is only selected again if no other task of its priority can be.
+		Selecting a task no longer moves the index of the list, as the tasks
+		the other cores run are stepped over. */
+		pxTCB = pxCurrentTCBs[ xCoreID ];
+		if( listIS_CONTAINED_WITHIN( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) ) != pdFALSE )
+		{
+			( void ) uxListRemove( &( pxTCB->xStateListItem ) );
+			vListInsertEnd( &( pxReadyTasksLists[ pxTCB->uxPriority ] ), &( pxTCB->xStateListItem ) );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+		{
+			uxPriority = uxTopReadyPriority;
+		}
+		#else
+		{
+			portGET_HIGHEST_PRIORITY( uxPriority, uxTopReadyPriority );
+		}
+		#endif
+
+		for( ;; )
+		{
+			pxReadyList = &( pxReadyTasksLists[ uxPriority ] );
+
+			if( listLIST_IS_EMPTY( pxReadyList ) == pdFALSE )
+			{
+				xDecrementTopPriority = pdFALSE;
+
+				for( pxIterator = listGET_HEAD_ENTRY( pxReadyList ); pxIterator != listGET_END_MARKER( pxReadyList ); pxIterator = listGET_NEXT( pxIterator ) )
+				{
+					pxTCB = listGET_LIST_ITEM_OWNER( pxIterator ); /*lint !e9079 void * is used as this macro is used with timers and co-routines too.  Alignment is known to be fine as the type of the pointer stored and retrieved is the same. */
+
+					if( ( pxTCB->uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) xCoreID ) ) == 0U )
+					{
+						continue;
+					}
+
+					if( pxTCB->xTaskRunState == taskTASK_NOT_RUNNING )
+					{
+						/* Swap it in. */
+						pxPreviousTCB = pxCurrentTCBs[ xCoreID ];
+						pxPreviousTCB->xTaskRunState = taskTASK_NOT_RUNNING;
+						pxTCB->xTaskRunState = xCoreID;
+						pxCurrentTCBs[ xCoreID ] = pxTCB;
+						xTaskScheduled = pdTRUE;
+						break;
+					}
+					else if( pxTCB == pxCurrentTCBs[ xCoreID ] )
+					{
+						/* It keeps the core. */
+						pxTCB->xTaskRunState = xCoreID;
+						xTaskScheduled = pdTRUE;
+						break;
+					}
+					else
+					{
+						/* Another core runs it. */
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+			}
+			else
+			{
+				/* Only generic selection keeps the top priority as a number,
+				lowered while the lists above are empty. */
+				#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 0 )
+				{
+					if( xDecrementTopPriority != pdFALSE )
+					{
+						uxTopReadyPriority--;
+					}
+				}
+				#endif
+			}
+
+			/* The idle task of the core is always ready at the idle
+			priority. */
+			if( ( xTaskScheduled != pdFALSE ) || ( uxPriority == tskIDLE_PRIORITY ) )
+			{
+				break;
+			}
+
+			uxPriority--;
+		}
+
+		configASSERT( xTaskScheduled != pdFALSE );
+		#if ( configUSE_PORT_OPTIMISED_TASK_SELECTION == 1 )
+			( void ) xDecrementTopPriority;
+		#endif
+
+		/* The task this core gave up may still be of a higher priority than
+		the task of another core, such as when its affinity keeps it off the
+		task of this core, so is placed again. */
+		if( pxPreviousTCB != NULL )
+		{
+			prvYieldForTask( pxPreviousTCB );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvCheckForRunStateChange( void )
+	{
+	UBaseType_t uxPrevCriticalNesting;
+	const TCB_t *pxThisTCB;
+
+		/* Called with interrupts masked, so the task stays on this core. */
+		pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+
+		while( pxThisTCB->xTaskRunState == taskTASK_SCHEDULED_TO_YIELD )
+		{
+			/* Let go of the locks, and unmask interrupts so the core takes
+			the yield it was sent, then take the locks back once the task runs
+			again, on this core or another.  The critical nesting count of
+			the task goes with it. */
+			uxPrevCriticalNesting = portGET_CRITICAL_NESTING_COUNT();
+
+			if( uxPrevCriticalNesting > 0U )
+			{
+				portSET_CRITICAL_NESTING_COUNT( 0U );
+				portRELEASE_ISR_LOCK();
+			}
+			else
+			{
+				/* Called from vTaskSuspendAll(), holding only the task lock. */
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			portRELEASE_TASK_LOCK();
+			portENABLE_INTERRUPTS();
+
+			/* The yield may not have arrived yet, in which case the state is
+			checked again once the locks are back. */
+
+			portDISABLE_INTERRUPTS();
+			portGET_TASK_LOCK();
+			portGET_ISR_LOCK();
+
+			portSET_CRITICAL_NESTING_COUNT( uxPrevCriticalNesting );
+
+			if( uxPrevCriticalNesting == 0U )
+			{
+				portRELEASE_ISR_LOCK();
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+
+			pxThisTCB = pxCurrentTCBs[ portGET_CORE_ID() ];
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	void vTaskCoreAffinitySet( const TaskHandle_t xTask, UBaseType_t uxCoreAffinityMask )
+	{
+	TCB_t *pxTCB;
+	UBaseType_t uxPreviousCoreAffinityMask;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+
+			uxPreviousCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+			pxTCB->uxCoreAffinityMask = uxCoreAffinityMask;
+
+			if( xSchedulerRunning != pdFALSE )
+			{
+				if( taskTASK_IS_RUNNING( pxTCB ) != pdFALSE )
+				{
+					/* The task leaves a core the mask no longer allows. */
+					if( ( uxCoreAffinityMask & ( ( UBaseType_t ) 1U << ( UBaseType_t ) pxTCB->xTaskRunState ) ) == 0U )
+					{
+						prvYieldCore( pxTCB->xTaskRunState );
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
+				}
+				else if( uxCoreAffinityMask != uxPreviousCoreAffinityMask )
+				{
+					/* The task may preempt a core it was not allowed on, or
+					have been meant for a core it is no longer allowed on. */
+					prvYieldForTask( pxTCB );
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
+			}
+			else
+			{
+				mtCOVERAGE_TEST_MARKER();
+			}
+		}
+		taskEXIT_CRITICAL();
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxTaskCoreAffinityGet( const TaskHandle_t xTask )
+	{
+	const TCB_t *pxTCB;
+	UBaseType_t uxCoreAffinityMask;
+
+		taskENTER_CRITICAL();
+		{
+			pxTCB = prvGetTCBFromHandle( xTask );
+			uxCoreAffinityMask = pxTCB->uxCoreAffinityMask;
+		}
+		taskEXIT_CRITICAL();
+
+		return uxCoreAffinityMask;
+	}
+
+#endif /* configNUMBER_OF_CORES */
+/*-----------------------------------------------------------*/
+
 #if ( ( configUSE_TRACE_FACILITY == 1 ) && ( configUSE_STATS_FORMATTING_FUNCTIONS > 0 ) )
 
 	static char *prvWriteNameToBuffer( char *pcBuffer, const char *pcTaskName )
@@ -4322,7 +5701,7 @@ TCB_t *pxTCB;
 	{
 	TaskStatus_t *pxTaskStatusArray;
 	UBaseType_t uxArraySize, x;
-	uint32_t ulTotalTime, ulStatsAsPercentage;
+	configRUN_TIME_COUNTER_TYPE ulTotalTime, ulStatsAsPercentage;
 
 		#if( configUSE_TRACE_FACILITY != 1 )
 		{
@@ -4395,7 +5774,7 @@ TCB_t *pxTCB;
 					{
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter, ulStatsAsPercentage );
+							sprintf( pcWriteBuffer, "\t%lu\t\t%lu%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter, ( unsigned long ) ulStatsAsPercentage );
 						}
 						#else
 						{
@@ -4411,7 +5790,7 @@ TCB_t *pxTCB;
 						consumed less than 1% of the total run time. */
 						#ifdef portLU_PRINTF_SPECIFIER_REQUIRED
 						{
-							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", pxTaskStatusArray[ x ].ulRunTimeCounter );
+							sprintf( pcWriteBuffer, "\t%lu\t\t<1%%\r\n", ( unsigned long ) pxTaskStatusArray[ x ].ulRunTimeCounter );
 						}
 						#else
 						{
@@ -4767,7 +6146,7 @@ TickType_t uxReturn;
 
 		pxTCB = xTaskToNotify;
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			if( pulPreviousNotificationValue != NULL )
 			{
@@ -4857,7 +6236,7 @@ TickType_t uxReturn;
 				}
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 
 		return xReturn;
 	}
@@ -4895,7 +6274,7 @@ TickType_t uxReturn;
 
 		pxTCB = xTaskToNotify;
 
-		uxSavedInterruptStatus = portSET_INTERRUPT_MASK_FROM_ISR();
+		uxSavedInterruptStatus = taskENTER_CRITICAL_FROM_ISR();
 		{
 			ucOriginalNotifyState = pxTCB->ucNotifyState;
 			pxTCB->ucNotifyState = taskNOTIFICATION_RECEIVED;
@@ -4945,7 +6324,7 @@ TickType_t uxReturn;
 				}
 			}
 		}
-		portCLEAR_INTERRUPT_MASK_FROM_ISR( uxSavedInterruptStatus );
+		taskEXIT_CRITICAL_FROM_ISR( uxSavedInterruptStatus );
 	}
 
 #endif /* configUSE_TASK_NOTIFICATIONS */
@@ -5030,30 +6409,38 @@ const TickType_t xConstTickCount = xTickCount;
 			/* The list item will be inserted in wake time order. */
 			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-			if( xTimeToWake < xConstTickCount )
+			#if ( configUSE_DELAY_WHEEL == 1 )
 			{
-				/* Wake time has overflowed.  Place this item in the overflow
-				list. */
-				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+				prvAddCurrentTaskToDelayWheel( xTimeToWake, xConstTickCount );
 			}
-			else
+			#else
 			{
-				/* The wake time has not overflowed, so the current block list
-				is used. */
-				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-				/* If the task entering the blocked state was placed at the
-				head of the list of blocked tasks then xNextTaskUnblockTime
-				needs to be updated too. */
-				if( xTimeToWake < xNextTaskUnblockTime )
+				if( xTimeToWake < xConstTickCount )
 				{
-					xNextTaskUnblockTime = xTimeToWake;
+					/* Wake time has overflowed.  Place this item in the overflow
+					list. */
+					vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 				}
 				else
 				{
-					mtCOVERAGE_TEST_MARKER();
+					/* The wake time has not overflowed, so the current block list
+					is used. */
+					vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+					/* If the task entering the blocked state was placed at the
+					head of the list of blocked tasks then xNextTaskUnblockTime
+					needs to be updated too. */
+					if( xTimeToWake < xNextTaskUnblockTime )
+					{
+						xNextTaskUnblockTime = xTimeToWake;
+					}
+					else
+					{
+						mtCOVERAGE_TEST_MARKER();
+					}
 				}
 			}
+			#endif /* configUSE_DELAY_WHEEL */
 		}
 	}
 	#else /* INCLUDE_vTaskSuspend */
@@ -5066,34 +6453,77 @@ const TickType_t xConstTickCount = xTickCount;
 		/* The list item will be inserted in wake time order. */
 		listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
 
-		if( xTimeToWake < xConstTickCount )
+		#if ( configUSE_DELAY_WHEEL == 1 )
 		{
-			/* Wake time has overflowed.  Place this item in the overflow list. */
-			vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+			prvAddCurrentTaskToDelayWheel( xTimeToWake, xConstTickCount );
 		}
-		else
+		#else
 		{
-			/* The wake time has not overflowed, so the current block list is used. */
-			vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
-
-			/* If the task entering the blocked state was placed at the head of the
-			list of blocked tasks then xNextTaskUnblockTime needs to be updated
-			too. */
-			if( xTimeToWake < xNextTaskUnblockTime )
+			if( xTimeToWake < xConstTickCount )
 			{
-				xNextTaskUnblockTime = xTimeToWake;
+				/* Wake time has overflowed.  Place this item in the overflow list. */
+				vListInsert( pxOverflowDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
 			}
 			else
 			{
-				mtCOVERAGE_TEST_MARKER();
+				/* The wake time has not overflowed, so the current block list is used. */
+				vListInsert( pxDelayedTaskList, &( pxCurrentTCB->xStateListItem ) );
+
+				/* If the task entering the blocked state was placed at the head of the
+				list of blocked tasks then xNextTaskUnblockTime needs to be updated
+				too. */
+				if( xTimeToWake < xNextTaskUnblockTime )
+				{
+					xNextTaskUnblockTime = xTimeToWake;
+				}
+				else
+				{
+					mtCOVERAGE_TEST_MARKER();
+				}
 			}
 		}
+		#endif /* configUSE_DELAY_WHEEL */
 
 		/* Avoid compiler warning when INCLUDE_vTaskSuspend is not 1. */
 		( void ) xCanBlockIndefinitely;
 	}
 	#endif /* INCLUDE_vTaskSuspend */
 }
+/*-----------------------------------------------------------*/
+
+#if ( configUSE_DELAY_WHEEL == 1 )
+
+	static void prvAddCurrentTaskToDelayWheel( TickType_t xTimeToWake, const TickType_t xConstTickCount )
+	{
+		/* A task that does not wait is woken on the next tick, as it would be
+		from the delayed list.  The tick has already visited this tick's slot. */
+		if( xTimeToWake == xConstTickCount )
+		{
+			xTimeToWake++;
+			listSET_LIST_ITEM_VALUE( &( pxCurrentTCB->xStateListItem ), xTimeToWake );
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+
+		/* The slot is not kept in wake time order, so the task is added in
+		constant time. */
+		vListInsertEnd( taskDELAY_WHEEL_SLOT( xTimeToWake ), &( pxCurrentTCB->xStateListItem ) );
+
+		/* A wake time that has overflowed the tick count is not counted until
+		the tick count overflows too. */
+		if( ( xTimeToWake > xConstTickCount ) && ( xTimeToWake < xNextTaskUnblockTime ) )
+		{
+			xNextTaskUnblockTime = xTimeToWake;
+		}
+		else
+		{
+			mtCOVERAGE_TEST_MARKER();
+		}
+	}
+
+#endif /* configUSE_DELAY_WHEEL */
 
 /* Code below here allows additional code to be inserted into this source file,
 especially where access to file scope functions and data is needed (for example
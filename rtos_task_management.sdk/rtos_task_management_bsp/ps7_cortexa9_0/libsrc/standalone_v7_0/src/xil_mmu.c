@@ -53,6 +53,8 @@
 *			 redundant TLB invalidation in the same API at the beginning.
 * 6.8   aru  09/06/18 Removed compilation warnings for ARMCC toolchain.
 *                     It fixes CR#1008309.
+* 7.0   ld   10/17/26 Added Xil_SetTlbPageAttributes, which splits a section
+*		      into 4KB pages through a second level table.
 * </pre>
 *
 * @note
@@ -68,6 +70,7 @@
 #include "xil_types.h"
 #include "xil_mmu.h"
 #include "xil_errata.h"
+#include "xstatus.h"
 
 /***************** Macros (Inline Functions) Definitions *********************/
 
@@ -76,9 +79,29 @@
 /************************** Constant Definitions *****************************/
 #define     ARM_AR_MEM_TTB_SECT_SIZE               1024*1024
 #define     ARM_AR_MEM_TTB_SECT_SIZE_MASK          (~(ARM_AR_MEM_TTB_SECT_SIZE-1UL))
+#define     ARM_AR_MEM_TTB_PAGE_SIZE               4096
+#define     ARM_AR_MEM_TTB_PAGE_SIZE_MASK          (~(ARM_AR_MEM_TTB_PAGE_SIZE-1UL))
+#define     ARM_AR_MEM_TTB_PAGES_PER_SECT          256U
+#define     ARM_AR_MEM_TTB_TYPE_MASK               0x3U
+#define     ARM_AR_MEM_TTB_SUPERSECTION            (0x1U << 18)
+#define     ARM_AR_MEM_TTB_TYPE_PAGE_TABLE         0x1U
+#define     ARM_AR_MEM_TTB_TYPE_SECTION            0x2U
+#define     ARM_AR_MEM_TTB_PAGE_TABLE_MASK         0xFFFFFC00U
+#define     ARM_AR_MEM_TTB_DOMAIN_MASK             0x1E0U
+#define     ARM_AR_MEM_TTB_SECT_NS                 (0x1U << 19)
+#define     ARM_AR_MEM_TTB_PAGE_TABLE_NS           (0x1U << 3)
+
+/* Invalidate the TLBs of all the cores in the inner shareable domain, as the
+ * cores of an SMP system share the translation table. */
+#define     XREG_CP15_INVAL_UTLB_IS                "p15, 0, %0,  c8,  c3, 0"
 /************************** Variable Definitions *****************************/
 
 extern u32 MMUTable;
+extern u32 MMUPageTables;
+extern u32 MMUPageTablesEnd;
+
+/* The second level tables taken so far */
+static u32 PageTablesUsed;
 
 /************************** Function Prototypes ******************************/
 
@@ -121,6 +144,95 @@ void Xil_SetTlbAttributes(INTPTR Addr, u32 attrib)
     isb(); /* synchronize context on this processor */
 }
 
+/*****************************************************************************/
+/**
+* @brief	This function converts the attributes of a section to those of the
+*			4KB small pages that cover the same memory.
+*
+* @param	Section: the first level translation table entry of the section.
+*
+* @return	The attributes of a small page entry.
+*
+******************************************************************************/
+static u32 Xil_SectionToPageAttributes(u32 Section)
+{
+	u32 Page = 0x2U;
+
+	Page |= (Section >> 4) & 0x1U;			/* XN */
+	Page |= Section & 0xCU;					/* C, B */
+	Page |= ((Section >> 10) & 0x3U) << 4;	/* AP[1:0] */
+	Page |= ((Section >> 12) & 0x7U) << 6;	/* TEX */
+	Page |= ((Section >> 15) & 0x1U) << 9;	/* AP[2] */
+	Page |= ((Section >> 16) & 0x3U) << 10;	/* S, nG */
+	return Page;
+}
+
+/*****************************************************************************/
+/**
+* @brief	This function sets the memory attributes for a 4KB page in the
+*			translation table.  The first time a page of a 1MB section is
+*			set, the section is split into pages with the attributes it had,
+*			through one of the second level tables of translation_table.S.
+*
+* @param	Addr: 32-bit address for which memory attributes need to be set.
+* @param	attrib: Attribute for the given page.  xil_mmu.h contains
+*			definitions of the page attributes, PAGE_NO_ACCESS among them,
+*			which makes any access to the page abort.
+*
+* @return	XST_SUCCESS, or XST_FAILURE if the section is not mapped as a
+*			section or a page table, or all the second level tables are
+*			used.
+*
+* @note		The MMU or D-cache does not need to be disabled before changing a
+*			translation table entry.  The calls must not be made concurrently.
+*
+******************************************************************************/
+s32 Xil_SetTlbPageAttributes(INTPTR Addr, u32 attrib)
+{
+	u32 *Section;
+	u32 *Table;
+	u32 Page;
+	u32 Index;
+
+	Section = &MMUTable + (Addr / ARM_AR_MEM_TTB_SECT_SIZE);
+	if ((*Section & ARM_AR_MEM_TTB_TYPE_MASK) == ARM_AR_MEM_TTB_TYPE_PAGE_TABLE) {
+		Table = (u32 *)(UINTPTR)(*Section & ARM_AR_MEM_TTB_PAGE_TABLE_MASK);
+	} else if (((*Section & ARM_AR_MEM_TTB_TYPE_MASK) == ARM_AR_MEM_TTB_TYPE_SECTION) &&
+		((*Section & ARM_AR_MEM_TTB_SUPERSECTION) == 0U)) {
+		Table = &MMUPageTables + (PageTablesUsed * ARM_AR_MEM_TTB_PAGES_PER_SECT);
+		if ((Table + ARM_AR_MEM_TTB_PAGES_PER_SECT) > &MMUPageTablesEnd) {
+			return XST_FAILURE;
+		}
+		PageTablesUsed++;
+
+		/* The table is complete before the section entry points to it. */
+		Page = Xil_SectionToPageAttributes(*Section);
+		for (Index = 0U; Index < ARM_AR_MEM_TTB_PAGES_PER_SECT; Index++) {
+			Table[Index] = ((*Section & ARM_AR_MEM_TTB_SECT_SIZE_MASK) +
+				(Index * ARM_AR_MEM_TTB_PAGE_SIZE)) | Page;
+		}
+		Xil_DCacheFlushRange((INTPTR)Table, ARM_AR_MEM_TTB_PAGES_PER_SECT * sizeof(u32));
+		*Section = (u32)(UINTPTR)Table | (*Section & ARM_AR_MEM_TTB_DOMAIN_MASK) |
+			(((*Section & ARM_AR_MEM_TTB_SECT_NS) != 0U) ? ARM_AR_MEM_TTB_PAGE_TABLE_NS : 0U) |
+			ARM_AR_MEM_TTB_TYPE_PAGE_TABLE;
+		Xil_DCacheFlushRange((INTPTR)Section, sizeof(u32));
+	} else {
+		return XST_FAILURE;
+	}
+
+	Index = (Addr / ARM_AR_MEM_TTB_PAGE_SIZE) % ARM_AR_MEM_TTB_PAGES_PER_SECT;
+	Table[Index] = (Addr & ARM_AR_MEM_TTB_PAGE_SIZE_MASK) | attrib;
+	Xil_DCacheFlushRange((INTPTR)&Table[Index], sizeof(u32));
+
+	mtcp(XREG_CP15_INVAL_UTLB_IS, 0U);
+	/* Invalidate all branch predictors */
+	mtcp(XREG_CP15_INVAL_BRANCH_ARRAY, 0U);
+
+	dsb(); /* ensure completion of the BP and TLB invalidation */
+	isb(); /* synchronize context on this processor */
+	return XST_SUCCESS;
+}
+
 /*****************************************************************************/
 /**
 * @brief	Enable MMU for cortex A9 processor. This function invalidates the
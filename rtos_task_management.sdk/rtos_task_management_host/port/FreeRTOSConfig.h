@@ -0,0 +1,57 @@
+/*
+ * FreeRTOSConfig.h
+ *
+ * The host simulation uses the configuration of the board support package, so
+ * the kernel is built with the same options as on the target.  Only the
+ * settings that depend on the width of a pointer are overridden, and the
+ * delayed task structure, tickless idle, the heap, the trace recorder and the
+ * number of cores under "make DELAY_WHEEL=1", "make TICKLESS=1",
+ * "make HEAP_TLSF=1", "make HEAP_REGIONS=1", "make trace" and "make SMP=1".
+ */
+
+#ifndef HOST_FREERTOSCONFIG_H
+#define HOST_FREERTOSCONFIG_H
+
+#include "../../rtos_task_management_bsp/ps7_cortexa9_0/libsrc/freertos10_xilinx_v1_3/src/FreeRTOSConfig.h"
+
+/* Pointers are 64 bits wide on the host. */
+#undef portPOINTER_SIZE_TYPE
+#define portPOINTER_SIZE_TYPE	uintptr_t
+
+/* Delay tasks on the timing wheel instead of the delayed lists. */
+#ifdef SIM_DELAY_WHEEL
+#undef configUSE_DELAY_WHEEL
+#define configUSE_DELAY_WHEEL	1
+#endif
+
+/* Stop the tick while idle. */
+#ifdef SIM_TICKLESS_IDLE
+#undef configUSE_TICKLESS_IDLE
+#define configUSE_TICKLESS_IDLE	1
+#endif
+
+/* Allocate from the two level segregated fit heap instead of heap_4.c. */
+#ifdef SIM_HEAP_TLSF
+#undef configUSE_HEAP_TLSF
+#define configUSE_HEAP_TLSF	1
+#endif
+
+/* Split the heap into the regions of heap_regions.h. */
+#ifdef SIM_HEAP_REGIONS
+#undef configUSE_HEAP_REGIONS
+#define configUSE_HEAP_REGIONS	1
+#endif
+
+/* Record the kernel events for make trace. */
+#ifdef SIM_TRACE_RECORDER
+#undef configUSE_TRACE_RECORDER
+#define configUSE_TRACE_RECORDER	1
+#endif
+
+/* Run the kernel on two cores, as the two Cortex-A9 of the Zynq-7000. */
+#ifdef SIM_SMP
+#undef configNUMBER_OF_CORES
+#define configNUMBER_OF_CORES	2
+#endif
+
+#endif /* HOST_FREERTOSCONFIG_H */
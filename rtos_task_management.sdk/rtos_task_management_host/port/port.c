@@ -0,0 +1,1125 @@
+/*
+ * FreeRTOS Kernel V10.0.0
+ * Host (Linux/POSIX) simulation port.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+/* Standard includes. */
+#include <pthread.h>
+#include <sched.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <sys/time.h>
+#include <time.h>
+#include <ucontext.h>
+#include <unistd.h>
+
+/* Scheduler includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+
+/* Xilinx includes. */
+#include "xtime_l.h"
+
+/* A critical section is exited when the critical section nesting count reaches
+this value. */
+#define portNO_CRITICAL_NESTING			( ( uint32_t ) 0 )
+
+/* The signal used as the tick interrupt. */
+#define portTICK_SIGNAL					SIGALRM
+
+/* The signal used for the interrupts raised by vPortRaiseInterrupt(). */
+#define portINTERRUPT_SIGNAL			SIGUSR1
+
+/* The signal one core sends another to make it switch tasks, standing for the
+software generated interrupt of the Zynq port.  The interrupts of the
+peripherals and the tick are only taken on core 0, so the yield is the one
+interrupt every core takes, and tells whether a thread has them masked. */
+#if( configNUMBER_OF_CORES > 1 )
+	#define portYIELD_CORE_SIGNAL		SIGUSR2
+	#define portCORE_SIGNAL				portYIELD_CORE_SIGNAL
+#else
+	#define portCORE_SIGNAL				portTICK_SIGNAL
+#endif
+
+/* The number of kernel locks, with more than one core. */
+#define portLOCKS						2
+
+/* The number of interrupt IDs, as on the GIC. */
+#define portMAX_INTERRUPTS				96
+#define portINTERRUPT_WORDS				( portMAX_INTERRUPTS / 32 )
+
+/* The interrupt ID the tick is accounted to, that of the SCU private timer. */
+#define portTICK_INTERRUPT_ID			29
+
+/* The number of tasks the port keeps CPU statistics for. */
+#define portMAX_TASK_CPU				32
+
+/* The length of a tick, and the most ticks suppressed in one sleep, so the
+simulation still sees a tick now and then to end the run. */
+#define portUS_PER_TICK					( 1000000UL / configTICK_RATE_HZ )
+#define portMAX_SUPPRESSED_TICKS		( ( TickType_t ) configTICK_RATE_HZ )
+
+/* The host thread that runs one task. */
+typedef struct xTHREAD
+{
+	pthread_t xPthread;					/* The thread itself. */
+	TaskFunction_t pxCode;				/* The function implementing the task. */
+	void *pvParameters;					/* The parameter passed to pxCode. */
+	pthread_mutex_t xMutex;				/* Protects xRunnable and xDying. */
+	pthread_cond_t xCond;				/* Signalled when xRunnable is set. */
+	BaseType_t xRunnable;				/* Set when the thread may run. */
+	BaseType_t xDying;					/* Set when the task has been deleted. */
+	BaseType_t xCore;					/* The core it runs on, set with xRunnable. */
+	uint32_t ulCriticalNesting;			/* Saved while the thread is switched out. */
+} Thread_t;
+
+/* CPU statistics of one task. */
+typedef struct xTASK_CPU_SLOT
+{
+	void *pvTCB;						/* The task, or NULL for a free slot. */
+	char cName[ configMAX_TASK_NAME_LEN ];	/* A copy of the task name. */
+	uint64_t ullRunTimeNs;				/* Time spent running. */
+	uint32_t ulSwitchedIn;				/* Times switched in. */
+} TaskCpuSlot_t;
+
+/*-----------------------------------------------------------*/
+
+/*
+ * The start routine of every task thread.
+ */
+static void *prvThreadStart( void *pvParameters );
+
+/*
+ * Block the calling thread until it is selected to run.  A thread whose task
+ * has been deleted exits here instead.
+ */
+static void prvWaitToRun( Thread_t *pxThread );
+
+/*
+ * Allow a waiting thread to run on core xCoreID.
+ */
+static void prvSignalToRun( Thread_t *pxThread, BaseType_t xCoreID );
+
+/*
+ * Select the next task of the calling core and, if it changed, hand the core
+ * over to its thread.  Must be called with interrupts masked.
+ */
+static void prvSwitchContext( void );
+
+/*
+ * Leave the interrupts of the core the thread now runs on unmasked as a signal
+ * handler returns, as the thread may have been switched out in the handler and
+ * back in on another core.  pvContext is the context passed to the handler.
+ */
+static void prvRestoreInterruptMask( void *pvContext );
+
+/*
+ * The tick interrupt.
+ */
+static void prvTickSignalHandler( int iSignal, siginfo_t *pxInfo, void *pvContext );
+
+/*
+ * The handler of the tick interrupt, run by prvTickSignalHandler().
+ */
+static void prvTickHandler( void *pvCallBackRef );
+
+/*
+ * The other interrupts, raised by vPortRaiseInterrupt().
+ */
+static void prvInterruptSignalHandler( int iSignal, siginfo_t *pxInfo, void *pvContext );
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	/*
+	 * The yield sent by vPortYieldCore().
+	 */
+	static void prvYieldCoreSignalHandler( int iSignal, siginfo_t *pxInfo, void *pvContext );
+
+#endif /* configNUMBER_OF_CORES */
+
+/*
+ * Run the handler of an interrupt, timing it for the run time stats.
+ */
+static void prvRunInterruptHandler( uint32_t ulInterruptID, void ( *pxHandler )( void * ), void *pvCallBackRef );
+
+/*
+ * Charge the time since the last switch of core xCoreID to pvOldTCB.
+ */
+static void prvAccountSwitch( BaseType_t xCoreID, void *pvOldTCB, void *pvNewTCB );
+
+/*
+ * The thread that runs the task.  pxTopOfStack, the first member of the TCB,
+ * points at the stack word that holds it.
+ */
+static Thread_t *prvGetThread( void *pvTCB );
+
+/*-----------------------------------------------------------*/
+
+/* The TCB of the task running on a core, maintained by tasks.c. */
+#if( configNUMBER_OF_CORES == 1 )
+	extern void * volatile pxCurrentTCB;
+	#define portCURRENT_TCB( xCoreID )	( ( void ) ( xCoreID ), pxCurrentTCB )
+#else
+	extern void * volatile pxCurrentTCBs[ configNUMBER_OF_CORES ];
+	#define portCURRENT_TCB( xCoreID )	pxCurrentTCBs[ xCoreID ]
+#endif
+
+/* The core the calling thread runs on.  A thread only changes core while it is
+switched out, so it sets this itself as it is switched back in. */
+static __thread BaseType_t xPortCoreID = 0;
+
+/* The interrupt nesting count of the thread, non zero while it runs the
+handler of an interrupt.  The handlers never nest, so it is 0 or 1. */
+static __thread uint32_t ulInterruptNesting = 0;
+
+/* The critical nesting count of the task running on each core.  Non zero until
+the first task starts, so critical sections used before the scheduler starts do
+not unmask the tick. */
+static volatile uint32_t ulCriticalNesting[ configNUMBER_OF_CORES ] = { [ 0 ... ( configNUMBER_OF_CORES - 1 ) ] = 9999UL };
+
+/* Set to pdTRUE by an ISR that requires a context switch of its core on exit. */
+static volatile BaseType_t xYieldRequired[ configNUMBER_OF_CORES ];
+
+/* Contains all the interrupt signals, and those taken by each core. */
+static sigset_t xInterruptSignals;
+static sigset_t xCoreInterruptSignals[ configNUMBER_OF_CORES ];
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	/* The core that holds each kernel lock, or -1, and how many times it has
+	taken the lock. */
+	static volatile BaseType_t xLockOwner[ portLOCKS ] = { -1, -1 };
+	static volatile uint32_t ulLockCount[ portLOCKS ];
+
+#endif /* configNUMBER_OF_CORES */
+
+/* The installed interrupt handlers, and the interrupts enabled and pending. */
+static void ( *pxInterruptHandlers[ portMAX_INTERRUPTS ] )( void * );
+static void *pvInterruptCallBackRefs[ portMAX_INTERRUPTS ];
+static volatile uint32_t ulInterruptsEnabled[ portINTERRUPT_WORDS ];
+static volatile uint32_t ulInterruptsPending[ portINTERRUPT_WORDS ];
+static volatile BaseType_t xSchedulerStarted = pdFALSE;
+
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+
+	/* The time spent in the handler of each interrupt, and the number of times
+	it ran, in global timer counts. */
+	static volatile uint64_t ullInterruptRunTime[ portMAX_INTERRUPTS ];
+	static volatile uint32_t ulInterruptCount[ portMAX_INTERRUPTS ];
+
+	/* The time spent in all the handlers, and the number of handlers run. */
+	static volatile uint64_t ullTotalInterruptRunTime = 0;
+	static volatile uint32_t ulTotalInterruptCount = 0;
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+/* Signalled when the scheduler is ended. */
+static pthread_mutex_t xEndMutex = PTHREAD_MUTEX_INITIALIZER;
+static pthread_cond_t xEndCond = PTHREAD_COND_INITIALIZER;
+static volatile BaseType_t xSchedulerEnded = pdFALSE;
+
+/* Simulation statistics, shared by the cores. */
+static pthread_mutex_t xStatsMutex = PTHREAD_MUTEX_INITIALIZER;
+static TaskCpuSlot_t xTaskCpu[ portMAX_TASK_CPU ];
+static uint64_t ullSchedulerStartNs;
+static uint64_t ullLastSwitchNs[ configNUMBER_OF_CORES ];
+static volatile uint32_t ulContextSwitches;
+
+/*-----------------------------------------------------------*/
+
+/* The default hooks are weak so the application can provide its own, as in
+portZynq7000.c. */
+void vApplicationAssert( const char *pcFileName, uint32_t ulLine ) __attribute__((weak));
+void vApplicationTickHook( void ) __attribute__((weak));
+void vApplicationIdleHook( void ) __attribute__((weak));
+void vApplicationMallocFailedHook( void ) __attribute__((weak));
+void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName ) __attribute__((weak));
+void vPortSimulationTickHook( void ) __attribute__((weak));
+
+/*-----------------------------------------------------------*/
+
+static void __attribute__((constructor)) prvInitialiseInterruptSignals( void )
+{
+struct sigaction xAction;
+BaseType_t xCoreID;
+
+	/* Core 0 takes every interrupt, the other cores only the yield. */
+	for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+	{
+		sigemptyset( &xCoreInterruptSignals[ xCoreID ] );
+		sigaddset( &xCoreInterruptSignals[ xCoreID ], portCORE_SIGNAL );
+	}
+	sigaddset( &xCoreInterruptSignals[ 0 ], portTICK_SIGNAL );
+	sigaddset( &xCoreInterruptSignals[ 0 ], portINTERRUPT_SIGNAL );
+	xInterruptSignals = xCoreInterruptSignals[ 0 ];
+
+	/* An interrupt may be raised before the scheduler starts, so its handler
+	is installed from the start. */
+	memset( &xAction, 0x00, sizeof( xAction ) );
+	xAction.sa_sigaction = prvInterruptSignalHandler;
+	xAction.sa_flags = SA_RESTART | SA_SIGINFO;
+	sigfillset( &xAction.sa_mask );
+	sigaction( portINTERRUPT_SIGNAL, &xAction, NULL );
+}
+/*-----------------------------------------------------------*/
+
+StackType_t *pxPortInitialiseStack( StackType_t *pxTopOfStack, TaskFunction_t pxCode, void *pvParameters )
+{
+Thread_t *pxThread;
+pthread_attr_t xAttr;
+sigset_t xOldMask;
+int iStatus;
+
+	/* The task's stack is not used by the thread, which has a host stack of
+	its own.  Only the pointer to the thread is stored in it. */
+	pxThread = ( Thread_t * ) malloc( sizeof( Thread_t ) );
+	configASSERT( pxThread != NULL );
+	memset( pxThread, 0x00, sizeof( Thread_t ) );
+	pxThread->pxCode = pxCode;
+	pxThread->pvParameters = pvParameters;
+	pxThread->ulCriticalNesting = portNO_CRITICAL_NESTING;
+	pthread_mutex_init( &pxThread->xMutex, NULL );
+	pthread_cond_init( &pxThread->xCond, NULL );
+
+	/* The new thread inherits the blocked interrupt signals, and keeps them
+	blocked until it is first selected to run.  An interrupt must not
+	interrupt the C library while it creates the thread. */
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, &xOldMask );
+	pthread_attr_init( &xAttr );
+	pthread_attr_setdetachstate( &xAttr, PTHREAD_CREATE_DETACHED );
+	iStatus = pthread_create( &pxThread->xPthread, &xAttr, prvThreadStart, pxThread );
+	pthread_attr_destroy( &xAttr );
+	pthread_sigmask( SIG_SETMASK, &xOldMask, NULL );
+	configASSERT( iStatus == 0 );
+	( void ) iStatus;
+
+	*pxTopOfStack = ( StackType_t ) pxThread;
+	return pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+static Thread_t *prvGetThread( void *pvTCB )
+{
+StackType_t *pxTopOfStack = *( StackType_t ** ) pvTCB;
+
+	return ( Thread_t * ) *pxTopOfStack;
+}
+/*-----------------------------------------------------------*/
+
+static void *prvThreadStart( void *pvParameters )
+{
+Thread_t *pxThread = ( Thread_t * ) pvParameters;
+
+	prvWaitToRun( pxThread );
+
+	/* The task starts with interrupts enabled. */
+	ulCriticalNesting[ xPortCoreID ] = pxThread->ulCriticalNesting;
+	vPortClearInterruptMask( pdFALSE );
+
+	pxThread->pxCode( pxThread->pvParameters );
+
+	/* A function that implements a task must not exit or attempt to return to
+	its caller as there is nothing to return to.  If a task wants to exit it
+	should instead call vTaskDelete( NULL ). */
+	configASSERT( pxThread == NULL );
+	vTaskDelete( NULL );
+
+	return NULL;
+}
+/*-----------------------------------------------------------*/
+
+static void prvWaitToRun( Thread_t *pxThread )
+{
+BaseType_t xDying;
+
+	pthread_mutex_lock( &pxThread->xMutex );
+	while( pxThread->xRunnable == pdFALSE )
+	{
+		pthread_cond_wait( &pxThread->xCond, &pxThread->xMutex );
+	}
+	pxThread->xRunnable = pdFALSE;
+	xDying = pxThread->xDying;
+	xPortCoreID = pxThread->xCore;
+	pthread_mutex_unlock( &pxThread->xMutex );
+
+	if( xDying != pdFALSE )
+	{
+		/* The TCB has been freed, so nothing refers to the thread anymore. */
+		pthread_mutex_destroy( &pxThread->xMutex );
+		pthread_cond_destroy( &pxThread->xCond );
+		free( pxThread );
+		pthread_exit( NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvSignalToRun( Thread_t *pxThread, BaseType_t xCoreID )
+{
+	pthread_mutex_lock( &pxThread->xMutex );
+	pxThread->xRunnable = pdTRUE;
+	pxThread->xCore = xCoreID;
+	pthread_cond_signal( &pxThread->xCond );
+	pthread_mutex_unlock( &pxThread->xMutex );
+}
+/*-----------------------------------------------------------*/
+
+static void prvSwitchContext( void )
+{
+const BaseType_t xCoreID = xPortCoreID;
+void *pvOldTCB = portCURRENT_TCB( xCoreID );
+void *pvNewTCB;
+Thread_t *pxOldThread;
+
+	/* Once switched out, the old task may be deleted by another core, so its
+	thread is found first. */
+	pxOldThread = prvGetThread( pvOldTCB );
+	vTaskSwitchContext();
+	pvNewTCB = portCURRENT_TCB( xCoreID );
+
+	if( pvNewTCB != pvOldTCB )
+	{
+		prvAccountSwitch( xCoreID, pvOldTCB, pvNewTCB );
+
+		/* Hand the core to the new task and wait until this one is selected
+		again, on any core.  The critical nesting count is part of the task
+		context. */
+		pxOldThread->ulCriticalNesting = ulCriticalNesting[ xCoreID ];
+		prvSignalToRun( prvGetThread( pvNewTCB ), xCoreID );
+		prvWaitToRun( pxOldThread );
+		ulCriticalNesting[ xPortCoreID ] = pxOldThread->ulCriticalNesting;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRestoreInterruptMask( void *pvContext )
+{
+ucontext_t *pxContext = ( ucontext_t * ) pvContext;
+int iSignal;
+
+	for( iSignal = 1; iSignal < NSIG; iSignal++ )
+	{
+		if( sigismember( &xInterruptSignals, iSignal ) == 1 )
+		{
+			if( sigismember( &xCoreInterruptSignals[ xPortCoreID ], iSignal ) == 1 )
+			{
+				sigdelset( &pxContext->uc_sigmask, iSignal );
+			}
+			else
+			{
+				sigaddset( &pxContext->uc_sigmask, iSignal );
+			}
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortStartScheduler( void )
+{
+struct sigaction xAction;
+struct itimerval xTimer;
+BaseType_t xCoreID;
+
+	/* The thread that starts the scheduler never runs a task, so it never
+	takes an interrupt. */
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, NULL );
+
+	memset( &xAction, 0x00, sizeof( xAction ) );
+	xAction.sa_sigaction = prvTickSignalHandler;
+	xAction.sa_flags = SA_RESTART | SA_SIGINFO;
+	sigfillset( &xAction.sa_mask );
+	sigaction( portTICK_SIGNAL, &xAction, NULL );
+
+	#if( configNUMBER_OF_CORES > 1 )
+	{
+		xAction.sa_sigaction = prvYieldCoreSignalHandler;
+		sigaction( portYIELD_CORE_SIGNAL, &xAction, NULL );
+	}
+	#endif
+
+	/* Start the timer that generates the tick interrupt. */
+	memset( &xTimer, 0x00, sizeof( xTimer ) );
+	xTimer.it_interval.tv_usec = ( suseconds_t ) ( 1000000UL / configTICK_RATE_HZ );
+	xTimer.it_value = xTimer.it_interval;
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+
+	/* Start the first task executing on each core. */
+	xSchedulerStarted = pdTRUE;
+	ullSchedulerStartNs = ullPortGetTimeNs();
+	for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+	{
+		ullLastSwitchNs[ xCoreID ] = ullSchedulerStartNs;
+		prvAccountSwitch( xCoreID, NULL, portCURRENT_TCB( xCoreID ) );
+		prvSignalToRun( prvGetThread( portCURRENT_TCB( xCoreID ) ), xCoreID );
+	}
+
+	/* Wait here until the scheduler is ended. */
+	pthread_mutex_lock( &xEndMutex );
+	while( xSchedulerEnded == pdFALSE )
+	{
+		pthread_cond_wait( &xEndCond, &xEndMutex );
+	}
+	pthread_mutex_unlock( &xEndMutex );
+
+	return 0;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEndScheduler( void )
+{
+struct itimerval xTimer;
+
+	/* Stop the tick, then release the thread that started the scheduler. */
+	memset( &xTimer, 0x00, sizeof( xTimer ) );
+	setitimer( ITIMER_REAL, &xTimer, NULL );
+
+	pthread_mutex_lock( &xEndMutex );
+	xSchedulerEnded = pdTRUE;
+	pthread_cond_signal( &xEndCond );
+	pthread_mutex_unlock( &xEndMutex );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYield( void )
+{
+uint32_t ulMask;
+
+	/* The task may come back on another core, so the mask is restored for the
+	core it is on then. */
+	ulMask = ulPortSetInterruptMask();
+	prvSwitchContext();
+	vPortClearInterruptMask( ulMask );
+}
+/*-----------------------------------------------------------*/
+
+void vPortYieldFromISR( void )
+{
+	/* The switch is performed as the tick handler exits. */
+	xYieldRequired[ xPortCoreID ] = pdTRUE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnterCritical( void )
+{
+	ulPortSetInterruptMask();
+	ulCriticalNesting[ xPortCoreID ]++;
+}
+/*-----------------------------------------------------------*/
+
+void vPortExitCritical( void )
+{
+	if( ulCriticalNesting[ xPortCoreID ] > portNO_CRITICAL_NESTING )
+	{
+		ulCriticalNesting[ xPortCoreID ]--;
+
+		if( ulCriticalNesting[ xPortCoreID ] == portNO_CRITICAL_NESTING )
+		{
+			vPortClearInterruptMask( pdFALSE );
+		}
+	}
+}
+/*-----------------------------------------------------------*/
+
+BaseType_t xPortIsInsideInterrupt( void )
+{
+	/* The count is of the thread, which a handler runs on, so it does not
+	change core while it is read. */
+	return ( ulInterruptNesting != 0UL ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortSetInterruptMask( void )
+{
+sigset_t xOldMask;
+
+	pthread_sigmask( SIG_BLOCK, &xInterruptSignals, &xOldMask );
+
+	/* Return pdTRUE if interrupts were already masked. */
+	return ( sigismember( &xOldMask, portCORE_SIGNAL ) != 0 ) ? pdTRUE : pdFALSE;
+}
+/*-----------------------------------------------------------*/
+
+void vPortClearInterruptMask( uint32_t ulNewMaskValue )
+{
+	if( ulNewMaskValue == pdFALSE )
+	{
+		pthread_sigmask( SIG_UNBLOCK, &xCoreInterruptSignals[ xPortCoreID ], NULL );
+	}
+}
+/*-----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+
+	BaseType_t xPortGetCoreID( void )
+	{
+		return xPortCoreID;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortYieldCore( BaseType_t xCoreID )
+	{
+		/* Called holding the kernel locks, so the task of the core can not
+		change before the signal is sent.  A task selected but not yet running
+		takes the signal as it starts. */
+		pthread_kill( prvGetThread( portCURRENT_TCB( xCoreID ) )->xPthread, portYIELD_CORE_SIGNAL );
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortGetLock( BaseType_t xLock )
+	{
+	BaseType_t xFree;
+
+		/* A core only switches tasks holding the locks in vTaskSwitchContext(),
+		which lets go of them first, so the lock is held by a core rather than
+		a thread, and can be taken again by the core that holds it. */
+		if( xLockOwner[ xLock ] != xPortCoreID )
+		{
+			for( ;; )
+			{
+				xFree = -1;
+				if( __atomic_compare_exchange_n( &xLockOwner[ xLock ], &xFree, xPortCoreID, pdFALSE, __ATOMIC_ACQUIRE, __ATOMIC_RELAXED ) != 0 )
+				{
+					break;
+				}
+
+				/* The holder may be waiting for the host CPU. */
+				sched_yield();
+			}
+		}
+
+		ulLockCount[ xLock ]++;
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortReleaseLock( BaseType_t xLock )
+	{
+		configASSERT( xLockOwner[ xLock ] == xPortCoreID );
+		configASSERT( ulLockCount[ xLock ] > 0UL );
+
+		ulLockCount[ xLock ]--;
+		if( ulLockCount[ xLock ] == 0UL )
+		{
+			__atomic_store_n( &xLockOwner[ xLock ], -1, __ATOMIC_RELEASE );
+		}
+	}
+	/*-----------------------------------------------------------*/
+
+	uint32_t ulPortGetCriticalNesting( void )
+	{
+		return ulCriticalNesting[ xPortCoreID ];
+	}
+	/*-----------------------------------------------------------*/
+
+	void vPortSetCriticalNesting( uint32_t ulNesting )
+	{
+		ulCriticalNesting[ xPortCoreID ] = ulNesting;
+	}
+	/*-----------------------------------------------------------*/
+
+	static void prvYieldCoreSignalHandler( int iSignal, siginfo_t *pxInfo, void *pvContext )
+	{
+		( void ) iSignal;
+		( void ) pxInfo;
+
+		if( ( xSchedulerStarted != pdFALSE ) && ( xSchedulerEnded == pdFALSE ) )
+		{
+			prvSwitchContext();
+		}
+
+		prvRestoreInterruptMask( pvContext );
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configNUMBER_OF_CORES */
+
+static void prvTickSignalHandler( int iSignal, siginfo_t *pxInfo, void *pvContext )
+{
+	( void ) iSignal;
+	( void ) pxInfo;
+
+	/* The interrupt signals are blocked while the handler runs, which masks
+	interrupts for the FromISR API functions. */
+	if( xSchedulerEnded == pdFALSE )
+	{
+		vPortSimulationTickHook();
+		prvRunInterruptHandler( portTICK_INTERRUPT_ID, prvTickHandler, NULL );
+
+		if( xYieldRequired[ xPortCoreID ] != pdFALSE )
+		{
+			xYieldRequired[ xPortCoreID ] = pdFALSE;
+			prvSwitchContext();
+		}
+	}
+
+	prvRestoreInterruptMask( pvContext );
+}
+/*-----------------------------------------------------------*/
+
+static void prvInterruptSignalHandler( int iSignal, siginfo_t *pxInfo, void *pvContext )
+{
+UBaseType_t uxWord;
+uint32_t ulPending;
+uint32_t ulInterruptID;
+
+	( void ) iSignal;
+	( void ) pxInfo;
+
+	/* Interrupts raised before the scheduler starts stay pending until the
+	next is raised. */
+	if( ( xSchedulerStarted != pdFALSE ) && ( xSchedulerEnded == pdFALSE ) )
+	{
+		for( uxWord = 0; uxWord < portINTERRUPT_WORDS; uxWord++ )
+		{
+			/* Take the pending interrupts that are enabled, leaving the rest
+			pending. */
+			ulPending = __atomic_fetch_and( &ulInterruptsPending[ uxWord ], ~ulInterruptsEnabled[ uxWord ], __ATOMIC_SEQ_CST );
+			ulPending &= ulInterruptsEnabled[ uxWord ];
+
+			while( ulPending != 0 )
+			{
+				ulInterruptID = ( uxWord * 32UL ) + ( uint32_t ) __builtin_ctz( ulPending );
+				ulPending &= ulPending - 1UL;
+
+				if( pxInterruptHandlers[ ulInterruptID ] != NULL )
+				{
+					prvRunInterruptHandler( ulInterruptID, pxInterruptHandlers[ ulInterruptID ], pvInterruptCallBackRefs[ ulInterruptID ] );
+				}
+			}
+		}
+
+		if( xYieldRequired[ xPortCoreID ] != pdFALSE )
+		{
+			xYieldRequired[ xPortCoreID ] = pdFALSE;
+			prvSwitchContext();
+		}
+	}
+
+	prvRestoreInterruptMask( pvContext );
+}
+/*-----------------------------------------------------------*/
+
+static void prvTickHandler( void *pvCallBackRef )
+{
+	( void ) pvCallBackRef;
+
+	if( xTaskIncrementTick() != pdFALSE )
+	{
+		xYieldRequired[ xPortCoreID ] = pdTRUE;
+	}
+}
+/*-----------------------------------------------------------*/
+
+static void prvRunInterruptHandler( uint32_t ulInterruptID, void ( *pxHandler )( void * ), void *pvCallBackRef )
+{
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+	XTime xStart, xEnd;
+#endif
+
+	( void ) ulInterruptID;
+	traceISR_ENTER( ulInterruptID );
+	ulInterruptNesting++;
+
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+	/* The handlers run with both signals blocked, so they never nest. */
+	XTime_GetTime( &xStart );
+	pxHandler( pvCallBackRef );
+	XTime_GetTime( &xEnd );
+
+	ullInterruptRunTime[ ulInterruptID ] += ( uint64_t ) ( xEnd - xStart );
+	ulInterruptCount[ ulInterruptID ]++;
+	ullTotalInterruptRunTime += ( uint64_t ) ( xEnd - xStart );
+	ulTotalInterruptCount++;
+#else
+	pxHandler( pvCallBackRef );
+#endif
+
+	ulInterruptNesting--;
+	traceISR_EXIT( ulInterruptID );
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetTraceTimestamp( void )
+{
+XTime xNow;
+
+	XTime_GetTime( &xNow );
+	return ( uint32_t ) xNow;
+}
+/*-----------------------------------------------------------*/
+
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+
+	void xCONFIGURE_TIMER_FOR_RUN_TIME_STATS( void )
+	{
+		/* The global timer stand-in runs from the host clock. */
+	}
+	/*-----------------------------------------------------------*/
+
+	uint64_t xGET_RUN_TIME_COUNTER_VALUE( void )
+	{
+	XTime xNow;
+	uint64_t ullInterruptTime;
+	uint32_t ulCount;
+
+		/* The global timer less the time spent in interrupt handlers.  Read
+		again if a handler ran part way through. */
+		do
+		{
+			ulCount = ulTotalInterruptCount;
+			ullInterruptTime = ullTotalInterruptRunTime;
+			XTime_GetTime( &xNow );
+		} while( ulCount != ulTotalInterruptCount );
+
+		return ( uint64_t ) xNow - ullInterruptTime;
+	}
+	/*-----------------------------------------------------------*/
+
+	UBaseType_t uxPortGetInterruptRunTime( PortInterruptRunTime_t *pxInterruptRunTime, UBaseType_t uxArraySize )
+	{
+	UBaseType_t uxCount = 0;
+	uint32_t ulInterruptID;
+
+		for( ulInterruptID = 0; ( ulInterruptID < portMAX_INTERRUPTS ) && ( uxCount < uxArraySize ); ulInterruptID++ )
+		{
+			if( ulInterruptCount[ ulInterruptID ] != 0UL )
+			{
+				/* Read again if the handler ran part way through. */
+				do
+				{
+					pxInterruptRunTime[ uxCount ].ulCount = ulInterruptCount[ ulInterruptID ];
+					pxInterruptRunTime[ uxCount ].ullRunTime = ullInterruptRunTime[ ulInterruptID ];
+				} while( pxInterruptRunTime[ uxCount ].ulCount != ulInterruptCount[ ulInterruptID ] );
+
+				pxInterruptRunTime[ uxCount ].ulInterruptID = ulInterruptID;
+				uxCount++;
+			}
+		}
+
+		return uxCount;
+	}
+	/*-----------------------------------------------------------*/
+
+#endif /* configGENERATE_RUN_TIME_STATS */
+
+BaseType_t xPortInstallInterruptHandler( uint8_t ucInterruptID, void ( *pxHandler )( void * ), void *pvCallBackRef )
+{
+	configASSERT( ucInterruptID < portMAX_INTERRUPTS );
+
+	pvInterruptCallBackRefs[ ucInterruptID ] = pvCallBackRef;
+	pxInterruptHandlers[ ucInterruptID ] = pxHandler;
+
+	return pdPASS;
+}
+/*-----------------------------------------------------------*/
+
+void vPortEnableInterrupt( uint8_t ucInterruptID )
+{
+	configASSERT( ucInterruptID < portMAX_INTERRUPTS );
+	__atomic_fetch_or( &ulInterruptsEnabled[ ucInterruptID / 32 ], 1UL << ( ucInterruptID % 32 ), __ATOMIC_SEQ_CST );
+}
+/*-----------------------------------------------------------*/
+
+void vPortDisableInterrupt( uint8_t ucInterruptID )
+{
+	configASSERT( ucInterruptID < portMAX_INTERRUPTS );
+	__atomic_fetch_and( &ulInterruptsEnabled[ ucInterruptID / 32 ], ~( 1UL << ( ucInterruptID % 32 ) ), __ATOMIC_SEQ_CST );
+}
+/*-----------------------------------------------------------*/
+
+void vPortRaiseInterrupt( uint8_t ucInterruptID )
+{
+	configASSERT( ucInterruptID < portMAX_INTERRUPTS );
+	__atomic_fetch_or( &ulInterruptsPending[ ucInterruptID / 32 ], 1UL << ( ucInterruptID % 32 ), __ATOMIC_SEQ_CST );
+
+	#if( configNUMBER_OF_CORES == 1 )
+	{
+		/* The signal is taken before this returns, unless the calling thread
+		has interrupts masked, in which case it is taken as they are
+		unmasked. */
+		pthread_kill( pthread_self(), portINTERRUPT_SIGNAL );
+	}
+	#else
+	{
+		/* The signal is sent to the process, so it is taken by the thread
+		running on core 0 once that has interrupts unmasked, whichever core
+		raised it. */
+		kill( getpid(), portINTERRUPT_SIGNAL );
+	}
+	#endif
+
+}
+/*-----------------------------------------------------------*/
+
+void vPortRaiseExternalInterrupt( uint8_t ucInterruptID )
+{
+	configASSERT( ucInterruptID < portMAX_INTERRUPTS );
+	__atomic_fetch_or( &ulInterruptsPending[ ucInterruptID / 32 ], 1UL << ( ucInterruptID % 32 ), __ATOMIC_SEQ_CST );
+
+	/* The calling thread has the interrupt signals blocked, so the signal is
+	taken by the one thread that has them unblocked, that of the task running
+	on core 0. */
+	kill( getpid(), portINTERRUPT_SIGNAL );
+}
+/*-----------------------------------------------------------*/
+
+#if( configUSE_TICKLESS_IDLE == 1 )
+
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime )
+	{
+	struct itimerval xTimer;
+	sigset_t xOldMask, xPending;
+	uint64_t ullLeftUs, ullCompletedUs;
+	uint32_t ulCompleteTickPeriods;
+	int iSignal;
+
+		if( xExpectedIdleTime > portMAX_SUPPRESSED_TICKS )
+		{
+			xExpectedIdleTime = portMAX_SUPPRESSED_TICKS;
+		}
+
+		/* Mask interrupts.  One that becomes pending still ends the wait
+		below, as an interrupt masked in the CPU ends WFI on the target. */
+		pthread_sigmask( SIG_BLOCK, &xInterruptSignals, &xOldMask );
+
+		/* The timer holds what is left of the current tick period. */
+		getitimer( ITIMER_REAL, &xTimer );
+		ullLeftUs = ( ( uint64_t ) xTimer.it_value.tv_sec * 1000000ULL ) + ( uint64_t ) xTimer.it_value.tv_usec;
+
+		/* Do not sleep if the tick became pending after the kernel worked out
+		the idle time, or if a task was readied since. */
+		sigpending( &xPending );
+		if( ( ullLeftUs == 0 ) || ( sigismember( &xPending, portTICK_SIGNAL ) != 0 ) || ( eTaskConfirmSleepModeStatus() == eAbortSleep ) )
+		{
+			pthread_sigmask( SIG_SETMASK, &xOldMask, NULL );
+			return;
+		}
+
+		/* Run the timer to the end of the expected idle time.  The interval
+		keeps one tick period, so it carries on with ordinary ticks. */
+		ullLeftUs += ( uint64_t ) portUS_PER_TICK * ( xExpectedIdleTime - 1UL );
+		xTimer.it_value.tv_sec = ( time_t ) ( ullLeftUs / 1000000ULL );
+		xTimer.it_value.tv_usec = ( suseconds_t ) ( ullLeftUs % 1000000ULL );
+		setitimer( ITIMER_REAL, &xTimer, NULL );
+
+		/* Wait for an interrupt, and leave it pending to be taken once the
+		mask is restored. */
+		do
+		{
+			iSignal = sigwaitinfo( &xInterruptSignals, NULL );
+		} while( iSignal < 0 );
+		pthread_kill( pthread_self(), iSignal );
+
+		getitimer( ITIMER_REAL, &xTimer );
+		ullLeftUs = ( ( uint64_t ) xTimer.it_value.tv_sec * 1000000ULL ) + ( uint64_t ) xTimer.it_value.tv_usec;
+
+		if( iSignal == portTICK_SIGNAL )
+		{
+			/* The timer expired.  The pending tick counts the last tick of the
+			sleep. */
+			ulCompleteTickPeriods = xExpectedIdleTime - 1UL;
+		}
+		else
+		{
+			/* Another interrupt ended the sleep.  Count the tick periods that
+			completed, and leave the timer with what is left of the current
+			one. */
+			ullCompletedUs = ( ( uint64_t ) portUS_PER_TICK * xExpectedIdleTime ) - ullLeftUs;
+			ulCompleteTickPeriods = ( uint32_t ) ( ullCompletedUs / portUS_PER_TICK );
+			ullLeftUs = ( ( uint64_t ) portUS_PER_TICK * ( ulCompleteTickPeriods + 1UL ) ) - ullCompletedUs;
+			xTimer.it_value.tv_sec = ( time_t ) ( ullLeftUs / 1000000ULL );
+			xTimer.it_value.tv_usec = ( suseconds_t ) ( ullLeftUs % 1000000ULL );
+			setitimer( ITIMER_REAL, &xTimer, NULL );
+		}
+
+		vTaskStepTick( ulCompleteTickPeriods );
+		pthread_sigmask( SIG_SETMASK, &xOldMask, NULL );
+	}
+
+#endif /* configUSE_TICKLESS_IDLE */
+/*-----------------------------------------------------------*/
+
+void vPortCleanUpTCB( void *pxTCB )
+{
+Thread_t *pxThread = prvGetThread( pxTCB );
+
+	/* The thread of a deleted task is waiting to run.  Release it, and it
+	will exit instead. */
+	pthread_mutex_lock( &pxThread->xMutex );
+	pxThread->xDying = pdTRUE;
+	pxThread->xRunnable = pdTRUE;
+	pthread_cond_signal( &pxThread->xCond );
+	pthread_mutex_unlock( &pxThread->xMutex );
+}
+/*-----------------------------------------------------------*/
+
+uint64_t ullPortGetTimeNs( void )
+{
+struct timespec xNow;
+
+	clock_gettime( CLOCK_MONOTONIC, &xNow );
+	return ( ( uint64_t ) xNow.tv_sec * 1000000000ULL ) + ( uint64_t ) xNow.tv_nsec;
+}
+/*-----------------------------------------------------------*/
+
+static TaskCpuSlot_t *prvGetTaskCpuSlot( void *pvTCB )
+{
+TaskCpuSlot_t *pxFree = NULL;
+UBaseType_t uxIndex;
+
+	for( uxIndex = 0; uxIndex < portMAX_TASK_CPU; uxIndex++ )
+	{
+		if( xTaskCpu[ uxIndex ].pvTCB == pvTCB )
+		{
+			return &xTaskCpu[ uxIndex ];
+		}
+		else if( ( xTaskCpu[ uxIndex ].pvTCB == NULL ) && ( pxFree == NULL ) )
+		{
+			pxFree = &xTaskCpu[ uxIndex ];
+		}
+	}
+
+	if( pxFree != NULL )
+	{
+		pxFree->pvTCB = pvTCB;
+		strncpy( pxFree->cName, pcTaskGetName( ( TaskHandle_t ) pvTCB ), configMAX_TASK_NAME_LEN - 1 );
+	}
+
+	return pxFree;
+}
+/*-----------------------------------------------------------*/
+
+static void prvAccountSwitch( BaseType_t xCoreID, void *pvOldTCB, void *pvNewTCB )
+{
+TaskCpuSlot_t *pxSlot;
+uint64_t ullNow = ullPortGetTimeNs();
+
+	pthread_mutex_lock( &xStatsMutex );
+
+	if( pvOldTCB != NULL )
+	{
+		pxSlot = prvGetTaskCpuSlot( pvOldTCB );
+		if( pxSlot != NULL )
+		{
+			pxSlot->ullRunTimeNs += ullNow - ullLastSwitchNs[ xCoreID ];
+		}
+		ulContextSwitches++;
+	}
+
+	pxSlot = prvGetTaskCpuSlot( pvNewTCB );
+	if( pxSlot != NULL )
+	{
+		pxSlot->ulSwitchedIn++;
+	}
+
+	ullLastSwitchNs[ xCoreID ] = ullNow;
+
+	pthread_mutex_unlock( &xStatsMutex );
+}
+/*-----------------------------------------------------------*/
+
+uint32_t ulPortGetContextSwitches( void )
+{
+	return ulContextSwitches;
+}
+/*-----------------------------------------------------------*/
+
+UBaseType_t uxPortGetTaskCpu( PortTaskCpu_t *pxTaskCpu, UBaseType_t uxArraySize, uint64_t *pullTotalNs )
+{
+UBaseType_t uxIndex, uxCount = 0;
+BaseType_t xCoreID;
+uint64_t ullNow;
+uint32_t ulMask;
+
+	ulMask = ulPortSetInterruptMask();
+	pthread_mutex_lock( &xStatsMutex );
+	{
+		ullNow = ullPortGetTimeNs();
+
+		for( uxIndex = 0; ( uxIndex < portMAX_TASK_CPU ) && ( uxCount < uxArraySize ); uxIndex++ )
+		{
+			if( xTaskCpu[ uxIndex ].pvTCB != NULL )
+			{
+				pxTaskCpu[ uxCount ].pcTaskName = xTaskCpu[ uxIndex ].cName;
+				pxTaskCpu[ uxCount ].ullRunTimeNs = xTaskCpu[ uxIndex ].ullRunTimeNs;
+				pxTaskCpu[ uxCount ].ulSwitchedIn = xTaskCpu[ uxIndex ].ulSwitchedIn;
+
+				/* A running task has been running since the last switch of its
+				core. */
+				for( xCoreID = 0; xCoreID < ( BaseType_t ) configNUMBER_OF_CORES; xCoreID++ )
+				{
+					if( xTaskCpu[ uxIndex ].pvTCB == portCURRENT_TCB( xCoreID ) )
+					{
+						pxTaskCpu[ uxCount ].ullRunTimeNs += ullNow - ullLastSwitchNs[ xCoreID ];
+					}
+				}
+				uxCount++;
+			}
+		}
+
+		if( pullTotalNs != NULL )
+		{
+			*pullTotalNs = ullNow - ullSchedulerStartNs;
+		}
+	}
+	pthread_mutex_unlock( &xStatsMutex );
+	vPortClearInterruptMask( ulMask );
+
+	return uxCount;
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationAssert( const char *pcFileName, uint32_t ulLine )
+{
+	fprintf( stderr, "Assert failed in file %s, line %lu\n", pcFileName, ( unsigned long ) ulLine );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationTickHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationIdleHook( void )
+{
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationMallocFailedHook( void )
+{
+	fprintf( stderr, "vApplicationMallocFailedHook() called\n" );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+void vApplicationStackOverflowHook( TaskHandle_t xTask, char *pcTaskName )
+{
+	( void ) xTask;
+	fprintf( stderr, "HALT: Task %s overflowed its stack.\n", pcTaskName );
+	abort();
+}
+/*-----------------------------------------------------------*/
+
+void vPortSimulationTickHook( void )
+{
+}
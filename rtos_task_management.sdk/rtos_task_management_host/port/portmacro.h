@@ -0,0 +1,254 @@
+/*
+ * FreeRTOS Kernel V10.0.0
+ * Host (Linux/POSIX) simulation port.
+ *
+ * Permission is hereby granted, free of charge, to any person obtaining a copy of
+ * this software and associated documentation files (the "Software"), to deal in
+ * the Software without restriction, including without limitation the rights to
+ * use, copy, modify, merge, publish, distribute, sublicense, and/or sell copies of
+ * the Software, and to permit persons to whom the Software is furnished to do so,
+ * subject to the following conditions:
+ *
+ * The above copyright notice and this permission notice shall be included in all
+ * copies or substantial portions of the Software.
+ *
+ * THE SOFTWARE IS PROVIDED "AS IS", WITHOUT WARRANTY OF ANY KIND, EXPRESS OR
+ * IMPLIED, INCLUDING BUT NOT LIMITED TO THE WARRANTIES OF MERCHANTABILITY, FITNESS
+ * FOR A PARTICULAR PURPOSE AND NONINFRINGEMENT. IN NO EVENT SHALL THE AUTHORS OR
+ * COPYRIGHT HOLDERS BE LIABLE FOR ANY CLAIM, DAMAGES OR OTHER LIABILITY, WHETHER
+ * IN AN ACTION OF CONTRACT, TORT OR OTHERWISE, ARISING FROM, OUT OF OR IN
+ * CONNECTION WITH THE SOFTWARE OR THE USE OR OTHER DEALINGS IN THE SOFTWARE.
+ *
+ * 1 tab == 4 spaces!
+ */
+
+#ifndef PORTMACRO_H
+#define PORTMACRO_H
+
+#ifdef __cplusplus
+	extern "C" {
+#endif
+
+#include <stdint.h>
+
+/*-----------------------------------------------------------
+ * Port specific definitions.
+ *
+ * Each FreeRTOS task runs in its own pthread.  Only the thread of the task in
+ * pxCurrentTCB is ever allowed to run; every other task thread waits on its
+ * own event until the scheduler selects it.  The tick interrupt is SIGALRM
+ * from an interval timer, the other interrupts are SIGUSR1, and "interrupts
+ * are disabled" means both are blocked in the running thread.
+ *
+ * With more than one core, one thread runs for the task of each core in
+ * pxCurrentTCBs.  The tick and the other interrupts are taken on core 0 only,
+ * and a core is made to switch tasks with SIGUSR2, which every core takes.
+ *-----------------------------------------------------------
+ */
+
+/* Type definitions. */
+#define portCHAR		char
+#define portFLOAT		float
+#define portDOUBLE		double
+#define portLONG		long
+#define portSHORT		short
+#define portSTACK_TYPE	uintptr_t
+#define portBASE_TYPE	long
+
+typedef portSTACK_TYPE StackType_t;
+typedef long BaseType_t;
+typedef unsigned long UBaseType_t;
+
+typedef uint32_t TickType_t;
+#define portMAX_DELAY ( TickType_t ) 0xffffffffUL
+
+/*-----------------------------------------------------------*/
+
+/* Hardware specifics. */
+#define portSTACK_GROWTH			( -1 )
+#define portTICK_PERIOD_MS			( ( TickType_t ) 1000 / configTICK_RATE_HZ )
+#define portBYTE_ALIGNMENT			8
+
+/*-----------------------------------------------------------*/
+
+/* Task utilities. */
+extern void vPortYield( void );
+extern void vPortYieldFromISR( void );
+
+#define portEND_SWITCHING_ISR( xSwitchRequired )\
+{												\
+	if( xSwitchRequired != pdFALSE )			\
+	{											\
+		vPortYieldFromISR();					\
+	}											\
+}
+
+#define portYIELD_FROM_ISR( x ) portEND_SWITCHING_ISR( x )
+#define portYIELD() vPortYield()
+
+/*-----------------------------------------------------------
+ * Critical section control
+ *----------------------------------------------------------*/
+
+extern void vPortEnterCritical( void );
+extern void vPortExitCritical( void );
+extern uint32_t ulPortSetInterruptMask( void );
+extern void vPortClearInterruptMask( uint32_t ulNewMaskValue );
+/* pdTRUE if called from an interrupt handler, for code shared by tasks and
+ISRs that must choose between an API function and its FromISR form. */
+extern BaseType_t xPortIsInsideInterrupt( void );
+
+#define portENTER_CRITICAL()		vPortEnterCritical();
+#define portEXIT_CRITICAL()			vPortExitCritical();
+#define portDISABLE_INTERRUPTS()	ulPortSetInterruptMask()
+#define portENABLE_INTERRUPTS()		vPortClearInterruptMask( 0 )
+
+/*-----------------------------------------------------------*/
+
+/*-----------------------------------------------------------
+ * Multiple cores
+ *
+ * The kernel takes the task lock and then the ISR lock for a critical section,
+ * and an interrupt only the ISR lock.  Both can be taken again by the core that
+ * holds them.  The critical nesting count is kept for each core.
+ *----------------------------------------------------------*/
+
+#if( configNUMBER_OF_CORES > 1 )
+	BaseType_t xPortGetCoreID( void );
+	void vPortYieldCore( BaseType_t xCoreID );
+	void vPortGetLock( BaseType_t xLock );
+	void vPortReleaseLock( BaseType_t xLock );
+	uint32_t ulPortGetCriticalNesting( void );
+	void vPortSetCriticalNesting( uint32_t ulNesting );
+
+	#define portTASK_LOCK						0
+	#define portISR_LOCK						1
+
+	#define portGET_CORE_ID()					xPortGetCoreID()
+	#define portYIELD_CORE( xCoreID )			vPortYieldCore( xCoreID )
+	#define portGET_TASK_LOCK()					vPortGetLock( portTASK_LOCK )
+	#define portRELEASE_TASK_LOCK()				vPortReleaseLock( portTASK_LOCK )
+	#define portGET_ISR_LOCK()					vPortGetLock( portISR_LOCK )
+	#define portRELEASE_ISR_LOCK()				vPortReleaseLock( portISR_LOCK )
+	#define portGET_CRITICAL_NESTING_COUNT()	ulPortGetCriticalNesting()
+	#define portSET_CRITICAL_NESTING_COUNT( x )	vPortSetCriticalNesting( x )
+#else
+	#define portGET_CORE_ID()					( ( BaseType_t ) 0 )
+#endif /* configNUMBER_OF_CORES */
+
+/*-----------------------------------------------------------*/
+
+/*-----------------------------------------------------------
+ * Interrupts
+ *
+ * SIGUSR1 stands for the interrupt controller.  The interrupts raised with
+ * vPortRaiseInterrupt() run their handlers as it is taken, with the same
+ * masking and the same switch on exit as the tick.
+ *----------------------------------------------------------*/
+
+/* The GIC priorities of the Zynq port, for setting up interrupts. */
+#define portLOWEST_INTERRUPT_PRIORITY ( ( ( uint32_t ) configUNIQUE_INTERRUPT_PRIORITIES ) - 1UL )
+#define portLOWEST_USABLE_INTERRUPT_PRIORITY ( portLOWEST_INTERRUPT_PRIORITY - 1UL )
+#define portPRIORITY_SHIFT 3
+
+BaseType_t xPortInstallInterruptHandler( uint8_t ucInterruptID, void ( *pxHandler )( void * ), void *pvCallBackRef );
+void vPortEnableInterrupt( uint8_t ucInterruptID );
+void vPortDisableInterrupt( uint8_t ucInterruptID );
+void vPortRaiseInterrupt( uint8_t ucInterruptID );
+/* Raise an interrupt from a host thread that runs no task, as a peripheral
+does.  It is taken by the task running on core 0. */
+void vPortRaiseExternalInterrupt( uint8_t ucInterruptID );
+
+/* With tickless idle, the idle task stops the tick until the next task is due
+to unblock, as portZynq7000.c does with the SCU private timer. */
+#if( configUSE_TICKLESS_IDLE == 1 )
+	void vPortSuppressTicksAndSleep( TickType_t xExpectedIdleTime );
+	#define portSUPPRESS_TICKS_AND_SLEEP( xExpectedIdleTime ) vPortSuppressTicksAndSleep( xExpectedIdleTime )
+#endif
+
+/* With the run time stats, the port counts the global timer less the time
+spent in interrupt handlers, which it accounts for by interrupt ID, as
+portZynq7000.c does.  The tick is accounted to the ID of the SCU private timer. */
+#if( configGENERATE_RUN_TIME_STATS == 1 )
+	/* The handler time of one interrupt, in global timer counts. */
+	typedef struct xPORT_INTERRUPT_RUN_TIME
+	{
+		uint32_t ulInterruptID;		/* The ID of the interrupt. */
+		uint32_t ulCount;			/* The number of times its handler ran. */
+		uint64_t ullRunTime;		/* The time spent in its handler, less that of the handlers nested in it. */
+	} PortInterruptRunTime_t;
+
+	void xCONFIGURE_TIMER_FOR_RUN_TIME_STATS( void );
+	uint64_t xGET_RUN_TIME_COUNTER_VALUE( void );
+
+	/* Fill pxInterruptRunTime with up to uxArraySize of the interrupts that
+	have run, in order of ID, returning how many were filled in. */
+	UBaseType_t uxPortGetInterruptRunTime( PortInterruptRunTime_t *pxInterruptRunTime, UBaseType_t uxArraySize );
+#endif
+
+/* The trace recorder stamps its records with the low word of the global timer
+stand-in.  Its records keep the low word of each address as the object. */
+uint32_t ulPortGetTraceTimestamp( void );
+#define portGET_TRACE_TIMESTAMP() ulPortGetTraceTimestamp()
+
+/*-----------------------------------------------------------*/
+
+/* Task function macros as described on the FreeRTOS.org WEB site. */
+#define portTASK_FUNCTION_PROTO( vFunction, pvParameters )	void vFunction( void *pvParameters )
+#define portTASK_FUNCTION( vFunction, pvParameters )	void vFunction( void *pvParameters )
+
+/* The thread of a deleted task is only released once its TCB is freed. */
+extern void vPortCleanUpTCB( void *pxTCB );
+#define portCLEAN_UP_TCB( pxTCB )	vPortCleanUpTCB( pxTCB )
+
+/* Tasks always have a floating point context on the host. */
+#define vPortTaskUsesFPU()
+#define portTASK_USES_FLOATING_POINT() vPortTaskUsesFPU()
+
+/* Architecture specific optimisations. */
+#ifndef configUSE_PORT_OPTIMISED_TASK_SELECTION
+	#define configUSE_PORT_OPTIMISED_TASK_SELECTION 1
+#endif
+
+#if configUSE_PORT_OPTIMISED_TASK_SELECTION == 1
+
+	/* Store/clear the ready priorities in a bit map. */
+	#define portRECORD_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) |= ( 1UL << ( uxPriority ) )
+	#define portRESET_READY_PRIORITY( uxPriority, uxReadyPriorities ) ( uxReadyPriorities ) &= ~( 1UL << ( uxPriority ) )
+
+	/*-----------------------------------------------------------*/
+
+	#define portGET_HIGHEST_PRIORITY( uxTopPriority, uxReadyPriorities ) uxTopPriority = ( 31UL - ( uint32_t ) __builtin_clz( ( uint32_t ) ( uxReadyPriorities ) ) )
+
+#endif /* configUSE_PORT_OPTIMISED_TASK_SELECTION */
+
+#define portNOP()
+#define portINLINE __inline
+
+/*-----------------------------------------------------------
+ * Simulation statistics kept by the port.
+ *----------------------------------------------------------*/
+
+/* The time each task has held the simulated CPU. */
+typedef struct xPORT_TASK_CPU
+{
+	const char *pcTaskName;		/* The name of the task. */
+	uint64_t ullRunTimeNs;		/* Total time the task has been running. */
+	uint32_t ulSwitchedIn;		/* Number of times the task was switched in. */
+} PortTaskCpu_t;
+
+/* Monotonic host time in nanoseconds. */
+uint64_t ullPortGetTimeNs( void );
+
+/* The number of context switches since the scheduler started. */
+uint32_t ulPortGetContextSwitches( void );
+
+/* Fill pxTaskCpu with up to uxArraySize tasks, returning how many there are.
+The time since the scheduler started is returned in pullTotalNs. */
+UBaseType_t uxPortGetTaskCpu( PortTaskCpu_t *pxTaskCpu, UBaseType_t uxArraySize, uint64_t *pullTotalNs );
+
+#ifdef __cplusplus
+	} /* extern C */
+#endif
+
+#endif /* PORTMACRO_H */
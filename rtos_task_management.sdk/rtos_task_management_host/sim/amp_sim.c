@@ -0,0 +1,171 @@
+/*
+ * amp_sim.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+#define _GNU_SOURCE
+/* Standard includes. */
+#include <linux/futex.h>
+#include <pthread.h>
+#include <signal.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+#include <sys/prctl.h>
+#include <sys/syscall.h>
+#include <unistd.h>
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Application includes. */
+#include "amp_channel.h"
+/* Simulation includes. */
+#include "sim.h"
+
+#define SIM_AMP_OCM_SIZE	0x10000UL				/* the OCM mapped high, up to the top */
+#define SIM_AMP_GIC_OFFSET	SIM_AMP_OCM_SIZE		/* the shared interrupts, after the OCM */
+#define SIM_AMP_GIC_SIZE	0x1000UL				/* a page for the shared interrupts */
+#define SIM_AMP_START_ADDRESS	0xFFFFFFF0UL		/* where the boot ROM of core 1 reads its start */
+#define SIM_AMP_POLL_US	100							/* time between reads of the start address */
+#define SIM_AMP_CORE1_MS	"4000000000"			/* run time of core 1, which ends with core 0 */
+
+/* The software generated interrupts raised on each core, shared by the two
+ * processes.  Each word is a futex. */
+typedef struct {
+	volatile u32 pending[ 2 ];
+} SimAmpGic;
+
+/* Raise the interrupts of the other core on this one, as a thread. */
+static void *prvSimAmpListen( void *pvParameters );
+#if ( AMP_CORE == 0 )
+/* Start the process of core 1 from pcImage, with the shared memory in fd. */
+static void prvSimAmpStartCore1( const char *pcImage, int fd );
+#endif
+/*-----------------------------------------------------------*/
+
+/* The shared interrupts. */
+static SimAmpGic *pxGic;
+
+
+/*-----------------------------------------------------------*/
+/* Map the shared memory before main() starts. */
+static void __attribute__((constructor)) prvSimAmpInit( void )
+{
+	void *pvOcm;			/* Hold the OCM as mapped. */
+	pthread_t xListener;	/* Hold the thread that takes the interrupts of the other core. */
+	sigset_t xAll, xOld;	/* Hold the signals blocked in it, and in this thread. */
+	int fd;					/* Hold the shared memory. */
+
+#if ( AMP_CORE == 0 )
+	fd = memfd_create( "amp_ocm", 0 );
+	if ( ( fd < 0 ) || ( ftruncate( fd, SIM_AMP_GIC_OFFSET + SIM_AMP_GIC_SIZE ) != 0 ) ) {
+		perror( "amp: shared memory" );
+		exit( EXIT_FAILURE );
+	}
+#else
+	if ( getenv( "SIM_AMP_FD" ) == NULL ) {
+		fprintf( stderr, "amp: core 1 is started by core 0, with SIM_AMP_CORE1 set\n" );
+		exit( EXIT_FAILURE );
+	}
+	fd = atoi( getenv( "SIM_AMP_FD" ) );
+#endif
+
+	/* The OCM is at its address on the target, so the application uses it
+	 * unchanged. */
+	pvOcm = mmap( ( void * ) ( UINTPTR ) AMP_SHARED_BASE, SIM_AMP_OCM_SIZE, PROT_READ | PROT_WRITE,
+		MAP_SHARED | MAP_FIXED_NOREPLACE, fd, 0 );
+	pxGic = mmap( NULL, SIM_AMP_GIC_SIZE, PROT_READ | PROT_WRITE, MAP_SHARED, fd, SIM_AMP_GIC_OFFSET );
+	if ( ( pvOcm != ( void * ) ( UINTPTR ) AMP_SHARED_BASE ) || ( pxGic == MAP_FAILED ) ) {
+		perror( "amp: mapping the OCM" );
+		exit( EXIT_FAILURE );
+	}
+
+#if ( AMP_CORE == 0 )
+	if ( getenv( "SIM_AMP_CORE1" ) != NULL ) {
+		prvSimAmpStartCore1( getenv( "SIM_AMP_CORE1" ), fd );
+	}
+	else {
+		fprintf( stderr, "amp: SIM_AMP_CORE1 is not set, so core 1 does not run\n" );
+	}
+#else
+	while ( *( volatile u32 * ) SIM_AMP_START_ADDRESS == 0 ) {
+		usleep( SIM_AMP_POLL_US );
+	}
+#endif
+
+	/* The listener takes none of the interrupt signals of the port. */
+	sigfillset( &xAll );
+	pthread_sigmask( SIG_SETMASK, &xAll, &xOld );
+	if ( pthread_create( &xListener, NULL, prvSimAmpListen, NULL ) != 0 ) {
+		perror( "amp: listener" );
+		exit( EXIT_FAILURE );
+	}
+	pthread_detach( xListener );
+	pthread_sigmask( SIG_SETMASK, &xOld, NULL );
+}
+
+
+/*-----------------------------------------------------------*/
+void vSimAmpRaise( u32 interruptID )
+{
+	volatile u32 *pulPending = &pxGic->pending[ 1 - AMP_CORE ];	/* Hold the interrupts of the other core. */
+
+	__atomic_fetch_or( pulPending, 1U << interruptID, __ATOMIC_SEQ_CST );
+	syscall( SYS_futex, ( u32 * ) pulPending, FUTEX_WAKE, 1, NULL, NULL, 0 );
+}
+
+
+/*-----------------------------------------------------------*/
+static void *prvSimAmpListen( void *pvParameters )
+{
+	volatile u32 *pulPending = &pxGic->pending[ AMP_CORE ];	/* Hold the interrupts of this core. */
+	u32 pending;	/* Hold the interrupts taken. */
+
+	for( ;; )
+	{
+		pending = __atomic_exchange_n( pulPending, 0, __ATOMIC_SEQ_CST );
+		if ( pending == 0 ) {
+			syscall( SYS_futex, ( u32 * ) pulPending, FUTEX_WAIT, 0, NULL, NULL, 0 );
+			continue;
+		}
+
+		while ( pending != 0 ) {
+			vPortRaiseExternalInterrupt( ( uint8_t ) __builtin_ctz( pending ) );
+			pending &= pending - 1;
+		}
+	}
+	return NULL;
+}
+
+
+#if ( AMP_CORE == 0 )
+/*-----------------------------------------------------------*/
+static void prvSimAmpStartCore1( const char *pcImage, int fd )
+{
+	char fdText[ 16 ];	/* Hold the shared memory, for the environment. */
+	pid_t pid;			/* Hold the process of core 1. */
+
+	pid = fork();
+	if ( pid < 0 ) {
+		perror( "amp: starting core 1" );
+		exit( EXIT_FAILURE );
+	}
+	if ( pid > 0 ) {
+		return;
+	}
+
+	/* Core 1 inherits the shared memory, replays no input, and is killed as
+	 * core 0 ends. */
+	snprintf( fdText, sizeof( fdText ), "%d", fd );
+	setenv( "SIM_AMP_FD", fdText, 1 );
+	setenv( "SIM_DURATION_MS", SIM_AMP_CORE1_MS, 1 );
+	unsetenv( "SIM_TRACE" );
+	unsetenv( "SIM_LED_LOG" );
+	prctl( PR_SET_PDEATHSIG, SIGKILL );
+	execl( pcImage, pcImage, ( char * ) NULL );
+	perror( "amp: starting core 1" );
+	_exit( EXIT_FAILURE );
+}
+#endif
@@ -0,0 +1,19 @@
+/*
+ * heap_regions_sim.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* Xilinx includes. */
+#include "xil_types.h"
+
+#define SIM_HEAP_FAST_SIZE	0x2C000UL				/* the OCM at 0x0 left after the TCBs */
+#define SIM_HEAP_BULK_SIZE	0x100000UL				/* _HEAP_BULK_SIZE of lscript.ld */
+
+/* The regions of the kernel heap, in the sections that lscript.ld lays out on
+ * the target.  The linker defines the __start_ and __stop_ symbols of each, as
+ * their names are C identifiers.  Nothing else uses the arrays. */
+static u8 simHeapFast[ SIM_HEAP_FAST_SIZE ] __attribute__(( section( "heap_fast" ), aligned( 32 ), used ));
+static u8 simHeapBulk[ SIM_HEAP_BULK_SIZE ] __attribute__(( section( "heap_bulk" ), aligned( 32 ), used ));
@@ -0,0 +1,169 @@
+/*
+ * sim.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+#include "task.h"
+/* Simulation includes. */
+#include "sim.h"
+
+#define SIM_MAX_TASKS	16							/* tasks in the CPU report */
+#define SIM_NO_TRACE_MS	5000ULL						/* run time without a trace */
+#define NS_PER_MS	1000000ULL
+
+/* Print the report of the run. */
+static void prvSimReport( void );
+/*-----------------------------------------------------------*/
+
+/* The host time at which the run started, and its length. */
+static u64 startNs;
+static u64 durationNs;
+
+
+/*-----------------------------------------------------------*/
+/* Configure the run from the environment before main() starts. */
+static void __attribute__((constructor)) prvSimInit( void )
+{
+	const char *pcTrace = getenv( "SIM_TRACE" );
+	const char *pcDuration = getenv( "SIM_DURATION_MS" );
+	const char *pcLedLog = getenv( "SIM_LED_LOG" );
+	const SimEvent *pxEvents;	/* Hold the trace. */
+	u32 count;					/* Hold the number of events in the trace. */
+
+	startNs = ullPortGetTimeNs();
+
+	if ( ( pcTrace != NULL ) && ( xSimLoadTrace( pcTrace ) != pdPASS ) ) {
+		exit( EXIT_FAILURE );
+	}
+	if ( ( pcLedLog != NULL ) && ( xSimOpenLedLog( pcLedLog ) != pdPASS ) ) {
+		exit( EXIT_FAILURE );
+	}
+
+	if ( pcDuration != NULL ) {
+		durationNs = strtoull( pcDuration, NULL, 10 ) * NS_PER_MS;
+	}
+	else {
+		count = ulSimGetInputEvents( &pxEvents );
+		durationNs = ( count > 0 )
+			? ( pxEvents[ count - 1 ].time + ( SIM_DEFAULT_TAIL_MS * NS_PER_MS ) )
+			: ( SIM_NO_TRACE_MS * NS_PER_MS );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+u64 ullSimGetTime( void )
+{
+	return ullPortGetTimeNs() - startNs;
+}
+
+
+/*-----------------------------------------------------------*/
+/* End the run from the tick once it has lasted long enough. */
+void vPortSimulationTickHook( void )
+{
+	if ( ullSimGetTime() >= durationNs ) {
+		prvSimReport();
+		exit( EXIT_SUCCESS );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+/* End the run as soon as the benchmark suite is complete. */
+void vBenchmarkCompleteHook( void )
+{
+	prvSimReport();
+	exit( EXIT_SUCCESS );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvSimReport( void )
+{
+	PortTaskCpu_t tasks[ SIM_MAX_TASKS ];	/* Hold the CPU use of each task. */
+	UBaseType_t uxTasks, uxIndex;			/* Hold the number of tasks, and the index. */
+	u64 totalNs;							/* Hold the time the scheduler has run. */
+	const SimEvent *pxInputs, *pxWrites;	/* Hold the trace and the writes. */
+	u32 inputCount, writeCount;				/* Hold their lengths. */
+	u32 input, write = 0;					/* Hold the index of each. */
+	u64 latency, minLatency = 0, maxLatency = 0, sumLatency = 0;
+	u32 latencyCount = 0;					/* Hold the inputs followed by a write. */
+	u64 interval, minInterval = 0, maxInterval = 0;
+
+	uxTasks = uxPortGetTaskCpu( tasks, SIM_MAX_TASKS, &totalNs );
+	inputCount = ulSimGetInputEvents( &pxInputs );
+	writeCount = ulSimGetOutputWrites( &pxWrites );
+
+	printf( "\n==== simulation report ====\n" );
+	printf( "run time:          %llu ms\n", ( unsigned long long ) ( ullSimGetTime() / NS_PER_MS ) );
+	printf( "ticks:             %lu\n", ( unsigned long ) xTaskGetTickCountFromISR() );
+	printf( "context switches:  %lu\n", ( unsigned long ) ulPortGetContextSwitches() );
+
+	printf( "\n%-*s %8s %12s\n", configMAX_TASK_NAME_LEN, "task", "CPU %", "switched in" );
+	for ( uxIndex = 0; uxIndex < uxTasks; ++uxIndex ) {
+		printf( "%-*s %8.2f %12lu\n", configMAX_TASK_NAME_LEN, tasks[ uxIndex ].pcTaskName,
+			( totalNs > 0 ) ? ( 100.0 * ( double ) tasks[ uxIndex ].ullRunTimeNs / ( double ) totalNs ) : 0.0,
+			( unsigned long ) tasks[ uxIndex ].ulSwitchedIn );
+	}
+
+	/* The interval between output writes shows the LED period. */
+	for ( write = 1; write < writeCount; ++write ) {
+		interval = pxWrites[ write ].time - pxWrites[ write - 1 ].time;
+		if ( ( write == 1 ) || ( interval < minInterval ) ) {
+			minInterval = interval;
+		}
+		if ( interval > maxInterval ) {
+			maxInterval = interval;
+		}
+	}
+	printf( "\nLED writes:        %lu\n", ( unsigned long ) writeCount );
+	if ( writeCount > 1 ) {
+		printf( "LED interval:      min %.3f ms, mean %.3f ms, max %.3f ms\n",
+			( double ) minInterval / NS_PER_MS,
+			( double ) ( pxWrites[ writeCount - 1 ].time - pxWrites[0].time ) / ( writeCount - 1 ) / NS_PER_MS,
+			( double ) maxInterval / NS_PER_MS );
+	}
+
+	/* The latency from each input event to the next LED write. */
+	printf( "\n%10s %4s %6s %14s\n", "input ms", "port", "value", "to LED ms" );
+	write = 0;
+	for ( input = 0; input < inputCount; ++input ) {
+		while ( ( write < writeCount ) && ( pxWrites[ write ].time < pxInputs[ input ].time ) ) {
+			++write;
+		}
+		printf( "%10llu %4s %#6x ", ( unsigned long long ) ( pxInputs[ input ].time / NS_PER_MS ),
+			( pxInputs[ input ].channel == SIM_BTN_CHANNEL ) ? "btn" : "sw", pxInputs[ input ].value );
+		if ( write < writeCount ) {
+			latency = pxWrites[ write ].time - pxInputs[ input ].time;
+			printf( "%14.3f\n", ( double ) latency / NS_PER_MS );
+			if ( ( latencyCount == 0 ) || ( latency < minLatency ) ) {
+				minLatency = latency;
+			}
+			if ( latency > maxLatency ) {
+				maxLatency = latency;
+			}
+			sumLatency += latency;
+			++latencyCount;
+		}
+		else {
+			printf( "%14s\n", "none" );
+		}
+	}
+	if ( latencyCount > 0 ) {
+		printf( "input to LED:      min %.3f ms, mean %.3f ms, max %.3f ms\n",
+			( double ) minLatency / NS_PER_MS,
+			( double ) sumLatency / latencyCount / NS_PER_MS,
+			( double ) maxLatency / NS_PER_MS );
+	}
+
+	fflush( stdout );
+}
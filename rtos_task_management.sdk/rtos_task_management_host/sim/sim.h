@@ -0,0 +1,80 @@
+/*
+ * sim.h
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* The harness that runs the lab application on the host.
+*
+* The inputs of the AXI GPIO are replayed from a trace file, one event per line:
+*
+* 	<time in ms> btn <hex value>
+* 	<time in ms> sw  <hex value>
+*
+* Blank lines and lines starting with # are ignored.  Every write to an output
+* is recorded with its time, and may be logged as CSV.  The run ends after a
+* fixed duration with a report of the context switches, the CPU use of each
+* task, and the latency from each input event to the next LED write.
+*
+* The run is configured from the environment:
+*
+* 	SIM_TRACE		the trace to replay (no input changes if unset)
+* 	SIM_DURATION_MS	the length of the run (2 s after the last event if unset)
+* 	SIM_LED_LOG		a CSV file to log the LED writes to
+*
+* A benchmark build (make bench) ends as soon as the suite is complete.
+*
+* The AMP build (make AMP=1) runs the image of each core in a process of its
+* own.  The two share the OCM mapped high, at its address on the target, and
+* raise the software generated interrupts of each other.  Core 0 starts the
+* process of core 1 from the image named by SIM_AMP_CORE1, which then waits,
+* as in the boot ROM, for core 0 to write its start address.  It ends with
+* core 0.
+*
+*******************************************************************************************/
+
+#ifndef SIM_H
+#define SIM_H
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Xilinx includes. */
+#include "xil_types.h"
+
+/* sim definitions */
+#define SIM_BTN_DEVICE	0					/* GPIO device with the buttons */
+#define SIM_BTN_CHANNEL	1					/* GPIO port of the buttons */
+#define  SIM_SW_DEVICE	0					/* GPIO device with the switches */
+#define  SIM_SW_CHANNEL	2					/* GPIO port of the switches */
+#define SIM_DEFAULT_TAIL_MS	2000ULL			/* run time after the last event */
+
+/* A change of an input or a write to an output. */
+typedef struct {
+	u64 time;		/* the time of the event, in ns since the run started */
+	u16 device;		/* the GPIO device */
+	u16 channel;	/* the GPIO port */
+	u32 value;		/* the value of the port */
+} SimEvent;
+
+/* The time since the run started, in ns. */
+u64 ullSimGetTime( void );
+
+/* Load the input trace from pcPath, returning pdPASS or pdFAIL. */
+BaseType_t xSimLoadTrace( const char *pcPath );
+/* Log every output write to pcPath as CSV, returning pdPASS or pdFAIL. */
+BaseType_t xSimOpenLedLog( const char *pcPath );
+/* The events of the input trace. */
+u32 ulSimGetInputEvents( const SimEvent **ppxEvents );
+/* The output writes so far. */
+u32 ulSimGetOutputWrites( const SimEvent **ppxWrites );
+#ifdef SIM_AMP
+/* Raise a software generated interrupt on the core of the other image. */
+void vSimAmpRaise( u32 interruptID );
+#endif
+
+#endif /* SIM_H */
@@ -0,0 +1,225 @@
+/*
+ * xgpio_sim.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Xilinx includes. */
+#include "xgpio.h"
+/* Simulation includes. */
+#include "sim.h"
+
+#define SIM_MAX_DEVICES	2							/* number of GPIO devices */
+#define SIM_MAX_CHANNELS	2						/* ports of each GPIO device */
+#define SIM_LINE_LENGTH	128							/* longest line in a trace */
+
+/* A growing array of events. */
+typedef struct {
+	SimEvent *pxEvents;	/* the events, in time order */
+	u32 count;			/* number of events */
+	u32 size;			/* number of events allocated */
+} SimEventList;
+
+/* Add an event to the end of a list. */
+static BaseType_t prvAppendEvent( SimEventList *pxList, const SimEvent *pxEvent );
+/*-----------------------------------------------------------*/
+
+/* The input trace, and the next event of it. */
+static SimEventList inputs;
+static u32 nextInput;
+/* The current value of each port. */
+static u32 portValue[ SIM_MAX_DEVICES ][ SIM_MAX_CHANNELS ];
+/* The output writes, and the file they are logged to. */
+static SimEventList outputs;
+static FILE *ledLog;
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xSimLoadTrace( const char *pcPath )
+{
+	FILE *trace;					/* Hold the trace file. */
+	char line[ SIM_LINE_LENGTH ];	/* Hold one line of the trace. */
+	char port[ 8 ];					/* Hold the name of the port. */
+	unsigned long long ms;			/* Hold the time of the event. */
+	unsigned long value;			/* Hold the value of the port. */
+	SimEvent event;					/* Hold the parsed event. */
+	u32 lineNumber = 0;				/* Hold the line number, for errors. */
+	u64 last = 0;					/* Hold the time of the previous event. */
+
+	trace = fopen( pcPath, "r" );
+	if ( trace == NULL ) {
+		fprintf( stderr, "sim: cannot open trace %s\n", pcPath );
+		return pdFAIL;
+	}
+
+	while ( fgets( line, sizeof( line ), trace ) != NULL ) {
+		++lineNumber;
+		if ( ( line[ strspn( line, " \t\r\n" ) ] == '\0' ) || ( line[0] == '#' ) ) {
+			continue;
+		}
+
+		if ( sscanf( line, "%llu %7s %lx", &ms, port, &value ) != 3 ) {
+			fprintf( stderr, "sim: %s:%u: expected <ms> btn|sw <hex>\n", pcPath, lineNumber );
+			fclose( trace );
+			return pdFAIL;
+		}
+
+		event.time = ms * 1000000ULL;
+		event.value = ( u32 ) value;
+		if ( strcmp( port, "btn" ) == 0 ) {
+			event.device = SIM_BTN_DEVICE;
+			event.channel = SIM_BTN_CHANNEL;
+		}
+		else if ( strcmp( port, "sw" ) == 0 ) {
+			event.device = SIM_SW_DEVICE;
+			event.channel = SIM_SW_CHANNEL;
+		}
+		else {
+			fprintf( stderr, "sim: %s:%u: unknown port %s\n", pcPath, lineNumber, port );
+			fclose( trace );
+			return pdFAIL;
+		}
+
+		/* The trace is replayed in order. */
+		if ( event.time < last ) {
+			fprintf( stderr, "sim: %s:%u: events are out of order\n", pcPath, lineNumber );
+			fclose( trace );
+			return pdFAIL;
+		}
+		last = event.time;
+
+		if ( prvAppendEvent( &inputs, &event ) != pdPASS ) {
+			fclose( trace );
+			return pdFAIL;
+		}
+	}
+
+	fclose( trace );
+	return pdPASS;
+}
+
+
+/*-----------------------------------------------------------*/
+BaseType_t xSimOpenLedLog( const char *pcPath )
+{
+	ledLog = fopen( pcPath, "w" );
+	if ( ledLog == NULL ) {
+		fprintf( stderr, "sim: cannot open LED log %s\n", pcPath );
+		return pdFAIL;
+	}
+	fprintf( ledLog, "time_us,device,channel,value\n" );
+	return pdPASS;
+}
+
+
+/*-----------------------------------------------------------*/
+u32 ulSimGetInputEvents( const SimEvent **ppxEvents )
+{
+	*ppxEvents = inputs.pxEvents;
+	return inputs.count;
+}
+
+
+/*-----------------------------------------------------------*/
+u32 ulSimGetOutputWrites( const SimEvent **ppxWrites )
+{
+	*ppxWrites = outputs.pxEvents;
+	return outputs.count;
+}
+
+
+/*-----------------------------------------------------------*/
+int XGpio_Initialize( XGpio *InstancePtr, u16 DeviceId )
+{
+	if ( DeviceId >= SIM_MAX_DEVICES ) {
+		return XST_DEVICE_NOT_FOUND;
+	}
+
+	InstancePtr->DeviceId = DeviceId;
+	InstancePtr->IsDual = TRUE;
+	InstancePtr->IsReady = TRUE;
+	return XST_SUCCESS;
+}
+
+
+/*-----------------------------------------------------------*/
+void XGpio_SetDataDirection( XGpio *InstancePtr, unsigned Channel, u32 DirectionMask )
+{
+	/* Every port is both replayed and recorded. */
+	( void ) InstancePtr;
+	( void ) Channel;
+	( void ) DirectionMask;
+}
+
+
+/*-----------------------------------------------------------*/
+u32 XGpio_DiscreteRead( XGpio *InstancePtr, unsigned Channel )
+{
+	u32 value;		/* Hold the value of the port. */
+	u32 mask;		/* Hold the interrupt mask. */
+	u64 now;		/* Hold the time of the read. */
+
+	/* The tick hook also reads the inputs, so the trace cursor is only
+	 * moved with interrupts masked, as a register read is atomic. */
+	mask = ulPortSetInterruptMask();
+	now = ullSimGetTime();
+	while ( ( nextInput < inputs.count ) && ( inputs.pxEvents[ nextInput ].time <= now ) ) {
+		portValue[ inputs.pxEvents[ nextInput ].device ][ inputs.pxEvents[ nextInput ].channel - 1 ]
+			= inputs.pxEvents[ nextInput ].value;
+		++nextInput;
+	}
+	value = portValue[ InstancePtr->DeviceId ][ Channel - 1 ];
+	vPortClearInterruptMask( mask );
+
+	return value;
+}
+
+
+/*-----------------------------------------------------------*/
+void XGpio_DiscreteWrite( XGpio *InstancePtr, unsigned Channel, u32 Data )
+{
+	SimEvent event;	/* Hold the write. */
+	u32 mask;		/* Hold the interrupt mask. */
+
+	mask = ulPortSetInterruptMask();
+	event.time = ullSimGetTime();
+	event.device = InstancePtr->DeviceId;
+	event.channel = ( u16 ) Channel;
+	event.value = Data;
+	portValue[ event.device ][ Channel - 1 ] = Data;
+	prvAppendEvent( &outputs, &event );
+
+	if ( ledLog != NULL ) {
+		fprintf( ledLog, "%llu,%u,%u,0x%x\n", ( unsigned long long ) ( event.time / 1000ULL ),
+			event.device, event.channel, event.value );
+	}
+	vPortClearInterruptMask( mask );
+}
+
+
+/*-----------------------------------------------------------*/
+static BaseType_t prvAppendEvent( SimEventList *pxList, const SimEvent *pxEvent )
+{
+	SimEvent *pxEvents;	/* Hold the grown array. */
+
+	if ( pxList->count == pxList->size ) {
+		pxList->size = ( pxList->size == 0 ) ? 64 : ( pxList->size * 2 );
+		pxEvents = realloc( pxList->pxEvents, pxList->size * sizeof( SimEvent ) );
+		if ( pxEvents == NULL ) {
+			fprintf( stderr, "sim: out of memory for events\n" );
+			return pdFAIL;
+		}
+		pxList->pxEvents = pxEvents;
+	}
+
+	pxList->pxEvents[ pxList->count++ ] = *pxEvent;
+	return pdPASS;
+}
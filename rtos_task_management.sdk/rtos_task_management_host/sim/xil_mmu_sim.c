@@ -0,0 +1,53 @@
+/*
+ * xil_mmu_sim.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* Standard includes. */
+#include <stdio.h>
+#include <stdlib.h>
+#include <sys/mman.h>
+/* Xilinx includes. */
+#include "xil_exception.h"
+#include "xil_mmu.h"
+#include "xstatus.h"
+
+#define SIM_PAGE_SIZE	4096UL						/* the page of the MMU, and of the host */
+
+/* The data abort handler, which the host never calls. */
+static Xil_ExceptionHandler xDataAbortHandler;
+
+
+/*-----------------------------------------------------------*/
+/* The task stacks are never run on by the host, so a guard page only catches
+ * the kernel and the application writing past the bottom of a stack. */
+s32 Xil_SetTlbPageAttributes( INTPTR Addr, u32 attrib )
+{
+	void *pvPage = ( void * ) ( Addr & ~( INTPTR ) ( SIM_PAGE_SIZE - 1 ) );	/* Hold the page. */
+
+	if ( mprotect( pvPage, SIM_PAGE_SIZE, ( attrib == PAGE_NO_ACCESS ) ? PROT_NONE : ( PROT_READ | PROT_WRITE ) ) != 0 ) {
+		perror( "mmu: page attributes" );
+		return XST_FAILURE;
+	}
+	return XST_SUCCESS;
+}
+
+
+/*-----------------------------------------------------------*/
+void Xil_ExceptionRegisterHandler( u32 Exception_id, Xil_ExceptionHandler Handler, void *Data )
+{
+	if ( Exception_id == XIL_EXCEPTION_ID_DATA_ABORT_INT ) {
+		xDataAbortHandler = Handler;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+void Xil_DataAbortHandler( void *CallBackRef )
+{
+	fprintf( stderr, "HALT: data abort.\n" );
+	abort();
+}
@@ -0,0 +1,41 @@
+/*
+ * xil_printf_sim.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* Standard includes. */
+#include <stdarg.h>
+#include <stdio.h>
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Xilinx includes. */
+#include "xil_printf.h"
+
+
+/*-----------------------------------------------------------*/
+void xil_printf( const char8 *ctrl1, ... )
+{
+	va_list args;	/* Hold the arguments. */
+	u32 mask;		/* Hold the interrupt mask. */
+
+	/* The C library must not be entered again from the tick. */
+	mask = ulPortSetInterruptMask();
+	va_start( args, ctrl1 );
+	vprintf( ctrl1, args );
+	va_end( args );
+	vPortClearInterruptMask( mask );
+}
+
+
+/*-----------------------------------------------------------*/
+void outbyte( char8 c )
+{
+	u32 mask;		/* Hold the interrupt mask. */
+
+	mask = ulPortSetInterruptMask();
+	putchar( c );
+	vPortClearInterruptMask( mask );
+}
@@ -0,0 +1,99 @@
+/*
+ * xpm_counter_sim.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* Standard includes. */
+#include <string.h>
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Xilinx includes. */
+#include "xparameters.h"
+#include "xpm_counter.h"
+
+#define SIM_NO_EVENT	0xFFU						/* an event the host never counts */
+#define CYCLES_PER_USECOND	( XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ / 1000000UL )	/* CPU clock cycles per us */
+
+/* The event of each counter in XPM_CNTRCFG3, the only configuration with the clock cycles. */
+static const u32 cfg3Events[ XPM_CTRCOUNT ] = {
+	XPM_EVENT_IMMEDBRANCH, XPM_EVENT_UNALIGNEDACCESS, XPM_EVENT_BRANCHMISS,
+	XPM_EVENT_CLOCKCYCLES, XPM_EVENT_BRANCHPREDICT, XPM_EVENT_JAVABYTECODE
+};
+
+/* The event counted by each counter. */
+static u32 events[ XPM_CTRCOUNT ];
+/* The selected counter. */
+static u32 selected;
+/* The host time the counters were reset, and the cycles counted while they were stopped. */
+static u64 resetNs;
+static u32 stoppedCycles;
+static BaseType_t xCounting;
+
+
+/*-----------------------------------------------------------*/
+/* The clock cycles since the counters were reset. */
+static u32 prvCycles( void )
+{
+	if ( !xCounting ) {
+		return stoppedCycles;
+	}
+	return ( u32 ) ( ( ( ullPortGetTimeNs() - resetNs ) * CYCLES_PER_USECOND ) / 1000ULL );
+}
+
+
+/*-----------------------------------------------------------*/
+void Xpm_SetEvents( s32 PmcrCfg )
+{
+	u32 counter;	/* Hold the index of the counter. */
+
+	for ( counter = 0; counter < XPM_CTRCOUNT; ++counter ) {
+		events[counter] = ( PmcrCfg == XPM_CNTRCFG3 ) ? cfg3Events[counter] : SIM_NO_EVENT;
+	}
+
+	/* Reset and enable the counters. */
+	resetNs = ullPortGetTimeNs();
+	xCounting = pdTRUE;
+}
+
+
+/*-----------------------------------------------------------*/
+void Xpm_GetEventCounters( u32 *PmCtrValue )
+{
+	u32 counter;	/* Hold the index of the counter. */
+
+	/* As on the target, reading the counters stops them. */
+	stoppedCycles = prvCycles();
+	xCounting = pdFALSE;
+
+	for ( counter = 0; counter < XPM_CTRCOUNT; ++counter ) {
+		PmCtrValue[counter] = ( events[counter] == XPM_EVENT_CLOCKCYCLES ) ? stoppedCycles : 0;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+void vSimWriteCp15( const char *pcRegister, u32 ulValue )
+{
+	if ( strcmp( pcRegister, XREG_CP15_EVENT_CNTR_SEL ) == 0 ) {
+		selected = ulValue % XPM_CTRCOUNT;
+	}
+	else if ( strcmp( pcRegister, XREG_CP15_EVENT_TYPE_SEL ) == 0 ) {
+		events[selected] = ulValue;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+u32 ulSimReadCp15( const char *pcRegister )
+{
+	if ( strcmp( pcRegister, XREG_CP15_PERF_MONITOR_COUNT ) == 0 ) {
+		return ( events[selected] == XPM_EVENT_CLOCKCYCLES ) ? prvCycles() : 0;
+	}
+	if ( strcmp( pcRegister, XREG_CP15_PERF_CYCLE_COUNTER ) == 0 ) {
+		return prvCycles();
+	}
+	return 0;
+}
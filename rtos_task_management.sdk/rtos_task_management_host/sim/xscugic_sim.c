@@ -0,0 +1,52 @@
+/*
+ * xscugic_sim.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Xilinx includes. */
+#include "xscugic.h"
+/* Simulation includes. */
+#include "sim.h"
+
+#define SIM_MAX_SGI	16								/* software generated interrupts 0 to 15 */
+#ifdef SIM_AMP
+#define SIM_CPU_MASK	( 1U << AMP_CORE )			/* the core of this image */
+#define SIM_PEER_MASK	( 1U << ( 1 - AMP_CORE ) )	/* the core of the other image */
+#else
+#define SIM_CPU_MASK	XSCUGIC_SPI_CPU0_MASK		/* only CPU 0 is simulated */
+#define SIM_PEER_MASK	0U
+#endif
+
+/* The interrupt controller instance, as defined by portZynq7000.c. */
+XScuGic xInterruptController;
+
+
+/*-----------------------------------------------------------*/
+void XScuGic_SetPriorityTriggerType( XScuGic *InstancePtr, u32 Int_Id, u8 Priority, u8 Trigger )
+{
+	/* Every simulated interrupt has the same priority. */
+}
+
+
+/*-----------------------------------------------------------*/
+s32 XScuGic_SoftwareIntr( XScuGic *InstancePtr, u32 Int_Id, u32 Cpu_Id )
+{
+	if ( ( Int_Id >= SIM_MAX_SGI ) || ( ( Cpu_Id & ( SIM_CPU_MASK | SIM_PEER_MASK ) ) == 0 ) ) {
+		return XST_FAILURE;
+	}
+
+#ifdef SIM_AMP
+	if ( ( Cpu_Id & SIM_PEER_MASK ) != 0 ) {
+		vSimAmpRaise( Int_Id );
+	}
+#endif
+	if ( ( Cpu_Id & SIM_CPU_MASK ) != 0 ) {
+		vPortRaiseInterrupt( ( uint8_t ) Int_Id );
+	}
+	return XST_SUCCESS;
+}
@@ -0,0 +1,43 @@
+/*
+ * xtime_sim.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/* FreeRTOS includes. */
+#include "FreeRTOS.h"
+/* Xilinx includes. */
+#include "xtime_l.h"
+
+#define NS_PER_SECOND	1000000000ULL				/* host clock resolution */
+
+/* Added to the host clock to give the global timer. */
+static XTime offset;
+
+
+/*-----------------------------------------------------------*/
+/* The global timer counts at COUNTS_PER_SECOND from the host clock. */
+static XTime prvHostCounts( void )
+{
+	u64 ns = ullPortGetTimeNs();	/* Hold the host time. */
+
+	/* Split the seconds off so the product cannot overflow. */
+	return ( ( ns / NS_PER_SECOND ) * COUNTS_PER_SECOND )
+		+ ( ( ( ns % NS_PER_SECOND ) * COUNTS_PER_SECOND ) / NS_PER_SECOND );
+}
+
+
+/*-----------------------------------------------------------*/
+void XTime_SetTime( XTime Xtime_Global )
+{
+	offset = Xtime_Global - prvHostCounts();
+}
+
+
+/*-----------------------------------------------------------*/
+void XTime_GetTime( XTime *Xtime_Global )
+{
+	*Xtime_Global = prvHostCounts() + offset;
+}
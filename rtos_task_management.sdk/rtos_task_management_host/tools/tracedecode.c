@@ -0,0 +1,639 @@
+/*
+ * tracedecode.c
+ *
+ * Created on: 	17 October 2026
+ *     Author: 	Leomar Duran
+ *    Version: 	1.0
+ */
+
+/********************************************************************************************
+* DESCRIPTION
+********************************************************************************************
+* Decodes a dump of the kernel trace recorder, see FreeRTOSRingTrace.h, from a
+* capture of the console, such as the output of make trace or a log of the UART
+* or JTAG DCC of the board.  Everything outside the begin and end lines of the
+* dump is ignored.
+*
+*	tracedecode [-w columns] [-s start_ms] [-e end_ms] [-c intervals.csv] [capture]
+*
+* The report has a Gantt chart of the tasks and the interrupts, one column per
+* equal slice of the trace, or of start_ms to end_ms of it, with
+*	'#'	running for at least half of the slice,
+*	'+'	running for less than half,
+*	'.'	ready to run for some of the slice, but not running.
+* Then for each task, the number of times it was switched in and its CPU time,
+* less the interrupts that it was interrupted by, and the latency from being
+* made ready to being switched in.  Then for each interrupt, the number of
+* times it ran and the time its handler took.
+*
+* With -c, the intervals each task ran are also written as CSV, in
+* microseconds from the start of the trace.
+*
+* The dump is little-endian, as are the Cortex-A9 and the host.  The 32-bit
+* timestamps are unwrapped by taking the difference between records as signed,
+* so no gap between records may be longer than half of the wrap, 6.6 s at the
+* 325 MHz of the global timer.
+*
+*******************************************************************************************/
+
+/* Standard includes. */
+#include <ctype.h>
+#include <stdint.h>
+#include <stdio.h>
+#include <stdlib.h>
+#include <string.h>
+#include <unistd.h>
+/* Kernel includes. */
+#include "FreeRTOSRingTrace.h"
+
+/* decoder definitions */
+#define DECODE_LINE_MAX	256					/* longest line of the capture read */
+#define DECODE_LINE_BYTES	16				/* bytes of a line of the dump */
+#define DECODE_MAX_TASKS	256				/* most tasks told apart */
+#define DECODE_MAX_INTERRUPTS	1024		/* interrupt IDs of the GIC */
+#define DECODE_MAX_NESTING	16				/* deepest nesting of interrupts followed */
+#define DECODE_COLUMNS	100					/* default columns of the Gantt chart */
+
+/* A record, with its timestamp unwrapped. */
+typedef struct {
+	uint64_t time;			/* timestamp, in counts from the first record */
+	uint32_t order;			/* the position in the dump */
+	TraceRecord_t record;	/* the record */
+} Event;
+
+/* An interval a task ran for. */
+typedef struct {
+	int task;				/* the index of the task */
+	uint64_t start;			/* the time it was switched in */
+	uint64_t end;			/* the time it was switched out */
+} Interval;
+
+/* A growing array. */
+typedef struct {
+	void *items;			/* the items */
+	size_t count;			/* the number of items */
+	size_t capacity;		/* the items that fit */
+} Array;
+
+/* A task, and its statistics. */
+typedef struct {
+	uint32_t object;		/* the address of its TCB */
+	char name[ traceRECORDER_NAME_LEN ];	/* its name */
+	uint32_t runs;			/* times switched in from another task */
+	uint64_t cpu;			/* time running, less interrupts */
+	int ready;				/* whether it is ready, and not running */
+	uint64_t readyTime;		/* the time it was made ready */
+	Array latencies;		/* uint64_t, ready to switched in */
+	Array readyIntervals;	/* Interval, ready but not running */
+} Task;
+
+/* An interrupt, and its statistics. */
+typedef struct {
+	uint32_t count;			/* times its handler ran */
+	uint64_t total;			/* time in its handler, less those nested */
+	uint64_t min;			/* shortest time in its handler */
+	uint64_t max;			/* longest time in its handler */
+} Interrupt;
+
+/* Read the dump from the capture into the header, the names and the records. */
+static int prvReadDump( FILE *capture, TraceDumpHeader_t *header, Array *names, Array *records );
+/* Decode a line of hex into DECODE_LINE_BYTES bytes, returning 0 if it is not one. */
+static int prvDecodeLine( const char *line, uint8_t *bytes );
+/* Add an item to an array. */
+static void *prvAppend( Array *array, size_t size );
+/* Find or add the task with the address. */
+static int prvTask( uint32_t object );
+/* Order events by time, then by their position in the dump. */
+static int prvCompareEvents( const void *a, const void *b );
+/* Order latencies. */
+static int prvCompareTimes( const void *a, const void *b );
+/* Follow the events, working out the intervals and the statistics. */
+static void prvReplay( const Event *events, size_t count, Array *intervals, Array *isrIntervals );
+/* Print the Gantt chart of start to end. */
+static void prvPrintGantt( const Array *intervals, const Array *isrIntervals, uint64_t start, uint64_t end, int columns );
+/* Print one row of the Gantt chart. */
+static void prvPrintRow( const char *name, const Array *running, int task, const Array *ready,
+	uint64_t start, uint64_t end, int columns );
+/* Print the report of the tasks and the interrupts. */
+static void prvPrintReport( uint64_t span );
+/* Convert counts to microseconds. */
+static double prvMicros( uint64_t counts );
+/*-----------------------------------------------------------*/
+
+/* The rate of the timestamps. */
+static double countsPerMicro;
+/* The tasks. */
+static Task tasks[ DECODE_MAX_TASKS ];
+static int taskCount;
+/* The interrupts. */
+static Interrupt interrupts[ DECODE_MAX_INTERRUPTS ];
+
+
+/*-----------------------------------------------------------*/
+int main( int argc, char *argv[] )
+{
+	TraceDumpHeader_t header = { 0 };	/* Hold the header of the dump. */
+	Array names = { 0 };		/* Hold the task names. */
+	Array records = { 0 };		/* Hold the records. */
+	Array intervals = { 0 };	/* Hold the intervals the tasks ran. */
+	Array isrIntervals = { 0 };	/* Hold the intervals in interrupts. */
+	Event *events;				/* Hold the records, unwrapped and in order. */
+	FILE *capture = stdin;		/* Hold the capture. */
+	FILE *csv;					/* Hold the CSV of the intervals. */
+	const char *csvPath = NULL;	/* Hold the path of the CSV. */
+	double startMs = 0, endMs = -1;	/* Hold the part of the trace charted. */
+	int columns = DECODE_COLUMNS;	/* Hold the columns of the chart. */
+	uint64_t span, start, end;	/* Hold the length and the part charted. */
+	uint32_t last = 0;			/* Hold the last timestamp. */
+	size_t index;				/* Hold the index of the record or interval. */
+	int option;					/* Hold the option. */
+
+	while ( ( option = getopt( argc, argv, "w:s:e:c:" ) ) != -1 ) {
+		switch ( option ) {
+		case 'w': columns = atoi( optarg ); break;
+		case 's': startMs = atof( optarg ); break;
+		case 'e': endMs = atof( optarg ); break;
+		case 'c': csvPath = optarg; break;
+		default:
+			fprintf( stderr, "usage: %s [-w columns] [-s start_ms] [-e end_ms] [-c intervals.csv] [capture]\n", argv[0] );
+			return 2;
+		}
+	}
+	if ( columns < 1 ) {
+		columns = DECODE_COLUMNS;
+	}
+	if ( optind < argc ) {
+		capture = fopen( argv[optind], "r" );
+		if ( capture == NULL ) {
+			perror( argv[optind] );
+			return 1;
+		}
+	}
+
+	if ( !prvReadDump( capture, &header, &names, &records ) ) {
+		return 1;
+	}
+	countsPerMicro = header.ulTimestampHz / 1e6;
+
+	for ( index = 0; index < names.count; ++index ) {
+		const TraceTaskName_t *name = &( ( TraceTaskName_t * ) names.items )[ index ];	/* Hold the name. */
+		int task = prvTask( name->ulTask );	/* Hold the task named. */
+
+		if ( task >= 0 ) {
+			memcpy( tasks[task].name, name->cName, traceRECORDER_NAME_LEN );
+			tasks[task].name[ traceRECORDER_NAME_LEN - 1 ] = '\0';
+		}
+	}
+
+	/* Unwrap the timestamps in the order of the dump, which is the order they
+	 * were claimed in, then sort the few taken out of order by nesting. */
+	events = calloc( records.count + 1, sizeof( Event ) );
+	if ( events == NULL ) {
+		perror( "tracedecode" );
+		return 1;
+	}
+	for ( index = 0; index < records.count; ++index ) {
+		events[index].record = ( ( TraceRecord_t * ) records.items )[ index ];
+		events[index].order = ( uint32_t ) index;
+		if ( index == 0 ) {
+			events[index].time = 0;
+		} else {
+			events[index].time = events[index - 1].time
+				+ ( int64_t ) ( int32_t ) ( events[index].record.ulTimestamp - last );
+		}
+		last = events[index].record.ulTimestamp;
+	}
+	if ( records.count > 0 ) {
+		uint64_t lowest = events[0].time;	/* Hold the earliest time. */
+
+		for ( index = 1; index < records.count; ++index ) {
+			if ( ( int64_t ) ( events[index].time - lowest ) < 0 ) {
+				lowest = events[index].time;
+			}
+		}
+		for ( index = 0; index < records.count; ++index ) {
+			events[index].time -= lowest;
+		}
+	}
+	qsort( events, records.count, sizeof( Event ), prvCompareEvents );
+	span = ( records.count > 0 ) ? events[records.count - 1].time : 0;
+
+	prvReplay( events, records.count, &intervals, &isrIntervals );
+
+	printf( "trace: %u records over %.3f ms, %u lost before the dump, timestamps at %u Hz\n",
+		( unsigned ) records.count, prvMicros( span ) / 1000.0, ( unsigned ) header.ulLost,
+		( unsigned ) header.ulTimestampHz );
+
+	start = ( uint64_t ) ( startMs * 1000.0 * countsPerMicro );
+	end = ( endMs < 0 ) ? span : ( uint64_t ) ( endMs * 1000.0 * countsPerMicro );
+	if ( end > span ) {
+		end = span;
+	}
+	if ( end > start ) {
+		prvPrintGantt( &intervals, &isrIntervals, start, end, columns );
+	}
+	prvPrintReport( span );
+
+	if ( csvPath != NULL ) {
+		csv = fopen( csvPath, "w" );
+		if ( csv == NULL ) {
+			perror( csvPath );
+			return 1;
+		}
+		fprintf( csv, "task,start_us,end_us\n" );
+		for ( index = 0; index < intervals.count; ++index ) {
+			const Interval *interval = &( ( Interval * ) intervals.items )[ index ];	/* Hold the interval. */
+
+			fprintf( csv, "%s,%.3f,%.3f\n", tasks[interval->task].name,
+				prvMicros( interval->start ), prvMicros( interval->end ) );
+		}
+		fclose( csv );
+	}
+
+	return 0;
+}
+
+
+/*-----------------------------------------------------------*/
+static int prvReadDump( FILE *capture, TraceDumpHeader_t *header, Array *names, Array *records )
+{
+	char line[ DECODE_LINE_MAX ];	/* Hold the line read. */
+	uint8_t bytes[ 2 * DECODE_LINE_BYTES ];	/* Hold the bytes of the line. */
+	int inDump = 0;					/* Hold whether the line is in the dump. */
+	uint32_t lines = 0;				/* Hold the lines of the dump decoded. */
+	uint32_t skipped = 0;			/* Hold the lines of the dump that were not hex. */
+
+	while ( fgets( line, sizeof( line ), capture ) != NULL ) {
+		if ( strstr( line, traceRECORDER_BEGIN ) != NULL ) {
+			/* The last dump of the capture is decoded. */
+			inDump = 1;
+			lines = 0;
+			skipped = 0;
+			names->count = 0;
+			records->count = 0;
+			continue;
+		}
+		if ( !inDump ) {
+			continue;
+		}
+		if ( strstr( line, traceRECORDER_END ) != NULL ) {
+			inDump = 0;
+			continue;
+		}
+		if ( !prvDecodeLine( line, &bytes[ ( lines < 2 ) ? ( lines * DECODE_LINE_BYTES ) : 0 ] ) ) {
+			++skipped;
+			continue;
+		}
+
+		/* The header takes two lines, then come the names and the records. */
+		if ( lines == 1 ) {
+			memcpy( header, bytes, sizeof( *header ) );
+			if ( ( header->ulMagic != traceRECORDER_MAGIC ) || ( header->usVersion != traceRECORDER_VERSION )
+				|| ( header->usRecordSize != sizeof( TraceRecord_t ) ) ) {
+				fprintf( stderr, "tracedecode: the dump is not of version %d.\n", traceRECORDER_VERSION );
+				return 0;
+			}
+		} else if ( lines >= 2 ) {
+			if ( lines < ( 2 + header->ulTasks ) ) {
+				memcpy( prvAppend( names, sizeof( TraceTaskName_t ) ), bytes, sizeof( TraceTaskName_t ) );
+			} else {
+				memcpy( prvAppend( records, sizeof( TraceRecord_t ) ), bytes, sizeof( TraceRecord_t ) );
+			}
+		}
+		++lines;
+	}
+
+	if ( lines < 2 ) {
+		fprintf( stderr, "tracedecode: no dump between %s and %s.\n", traceRECORDER_BEGIN, traceRECORDER_END );
+		return 0;
+	}
+	if ( ( skipped > 0 ) || ( records->count != header->ulRecords ) ) {
+		fprintf( stderr, "tracedecode: %u lines of the dump were not hex, %u of %u records read.\n",
+			( unsigned ) skipped, ( unsigned ) records->count, ( unsigned ) header->ulRecords );
+	}
+	return 1;
+}
+
+
+/*-----------------------------------------------------------*/
+static int prvDecodeLine( const char *line, uint8_t *bytes )
+{
+	int index;	/* Hold the index of the digit. */
+	int digit;	/* Hold the value of the digit. */
+
+	for ( index = 0; index < ( 2 * DECODE_LINE_BYTES ); ++index ) {
+		if ( !isxdigit( ( unsigned char ) line[index] ) ) {
+			return 0;
+		}
+		digit = isdigit( ( unsigned char ) line[index] ) ? ( line[index] - '0' )
+			: ( tolower( ( unsigned char ) line[index] ) - 'a' + 10 );
+		if ( ( index % 2 ) == 0 ) {
+			bytes[index / 2] = ( uint8_t ) ( digit << 4 );
+		} else {
+			bytes[index / 2] |= ( uint8_t ) digit;
+		}
+	}
+
+	/* Nothing but the end of the line may follow. */
+	return ( line[index] == '\0' ) || ( line[index] == '\r' ) || ( line[index] == '\n' );
+}
+
+
+/*-----------------------------------------------------------*/
+static void *prvAppend( Array *array, size_t size )
+{
+	if ( array->count == array->capacity ) {
+		array->capacity = ( array->capacity == 0 ) ? 64 : ( array->capacity * 2 );
+		array->items = realloc( array->items, array->capacity * size );
+		if ( array->items == NULL ) {
+			perror( "tracedecode" );
+			exit( 1 );
+		}
+	}
+	return ( char * ) array->items + ( array->count++ * size );
+}
+
+
+/*-----------------------------------------------------------*/
+static int prvTask( uint32_t object )
+{
+	int task;	/* Hold the index of the task. */
+
+	for ( task = 0; task < taskCount; ++task ) {
+		if ( tasks[task].object == object ) {
+			return task;
+		}
+	}
+	if ( taskCount == DECODE_MAX_TASKS ) {
+		return -1;
+	}
+	tasks[taskCount].object = object;
+	snprintf( tasks[taskCount].name, sizeof( tasks[taskCount].name ), "%08x", ( unsigned ) object );
+	return taskCount++;
+}
+
+
+/*-----------------------------------------------------------*/
+static int prvCompareEvents( const void *a, const void *b )
+{
+	const Event *ea = a, *eb = b;	/* Hold the events. */
+
+	if ( ea->time != eb->time ) {
+		return ( ea->time < eb->time ) ? -1 : 1;
+	}
+	return ( ea->order < eb->order ) ? -1 : ( ea->order > eb->order );
+}
+
+
+/*-----------------------------------------------------------*/
+static int prvCompareTimes( const void *a, const void *b )
+{
+	const uint64_t *ta = a, *tb = b;	/* Hold the times. */
+
+	return ( *ta < *tb ) ? -1 : ( *ta > *tb );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvReplay( const Event *events, size_t count, Array *intervals, Array *isrIntervals )
+{
+	int current = -1;			/* Hold the running task, once known. */
+	uint64_t sliceStart = 0;	/* Hold when the running task was switched in. */
+	uint64_t sliceIsr = 0;		/* Hold the interrupt time since then. */
+	uint64_t isrStart[ DECODE_MAX_NESTING ];	/* Hold when each nested handler started. */
+	uint64_t isrNested[ DECODE_MAX_NESTING ];	/* Hold the time of the handlers nested in each. */
+	int depth = 0;				/* Hold the nesting of the handlers. */
+	uint64_t elapsed;			/* Hold the time of a handler. */
+	Interval *interval;			/* Hold the interval added. */
+	size_t index;				/* Hold the index of the event. */
+	int task;					/* Hold the task of the event. */
+
+	for ( index = 0; index < count; ++index ) {
+		const TraceRecord_t *record = &events[index].record;	/* Hold the record. */
+		uint64_t now = events[index].time;	/* Hold its time. */
+
+		switch ( record->ulEvent ) {
+		case eTraceTaskSwitchedIn:
+			task = prvTask( record->ulObject );
+			if ( task < 0 ) {
+				break;
+			}
+			/* The kernel traces a switch in on every tick and yield, even
+			 * when it switches back to the same task. */
+			if ( task != current ) {
+				if ( current >= 0 ) {
+					tasks[current].cpu += ( now - sliceStart ) - sliceIsr;
+					interval = prvAppend( intervals, sizeof( Interval ) );
+					interval->task = current;
+					interval->start = sliceStart;
+					interval->end = now;
+				}
+				tasks[task].runs++;
+				current = task;
+				sliceStart = now;
+				sliceIsr = 0;
+			}
+			if ( tasks[task].ready ) {
+				*( uint64_t * ) prvAppend( &tasks[task].latencies, sizeof( uint64_t ) ) = now - tasks[task].readyTime;
+				interval = prvAppend( &tasks[task].readyIntervals, sizeof( Interval ) );
+				interval->task = task;
+				interval->start = tasks[task].readyTime;
+				interval->end = now;
+				tasks[task].ready = 0;
+			}
+			break;
+
+		case eTraceTaskReady:
+			task = prvTask( record->ulObject );
+			if ( ( task >= 0 ) && ( task != current ) && !tasks[task].ready ) {
+				tasks[task].ready = 1;
+				tasks[task].readyTime = now;
+			}
+			break;
+
+		case eTraceTaskDelete:
+		case eTraceTaskSuspend:
+			task = prvTask( record->ulObject );
+			if ( task >= 0 ) {
+				tasks[task].ready = 0;
+			}
+			break;
+
+		case eTraceISREnter:
+			if ( depth < DECODE_MAX_NESTING ) {
+				isrStart[depth] = now;
+				isrNested[depth] = 0;
+			}
+			++depth;
+			break;
+
+		case eTraceISRExit:
+			/* An exit without its entry came before the dump started. */
+			if ( depth == 0 ) {
+				break;
+			}
+			--depth;
+			if ( ( depth >= DECODE_MAX_NESTING ) || ( record->ulObject >= DECODE_MAX_INTERRUPTS ) ) {
+				break;
+			}
+			elapsed = now - isrStart[depth];
+			if ( depth > 0 ) {
+				isrNested[depth - 1] += elapsed;
+			} else {
+				sliceIsr += elapsed;
+				interval = prvAppend( isrIntervals, sizeof( Interval ) );
+				interval->task = ( int ) record->ulObject;
+				interval->start = isrStart[depth];
+				interval->end = now;
+			}
+			elapsed -= isrNested[depth];
+			{
+				Interrupt *irq = &interrupts[ record->ulObject ];	/* Hold the interrupt. */
+
+				if ( ( irq->count == 0 ) || ( elapsed < irq->min ) ) {
+					irq->min = elapsed;
+				}
+				if ( elapsed > irq->max ) {
+					irq->max = elapsed;
+				}
+				irq->total += elapsed;
+				irq->count++;
+			}
+			break;
+
+		default:
+			break;
+		}
+	}
+
+	/* Close the slice of the task running at the end. */
+	if ( ( current >= 0 ) && ( count > 0 ) ) {
+		tasks[current].cpu += ( events[count - 1].time - sliceStart ) - sliceIsr;
+		interval = prvAppend( intervals, sizeof( Interval ) );
+		interval->task = current;
+		interval->start = sliceStart;
+		interval->end = events[count - 1].time;
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPrintGantt( const Array *intervals, const Array *isrIntervals, uint64_t start, uint64_t end, int columns )
+{
+	int task;	/* Hold the index of the task. */
+
+	printf( "\n%.3f to %.3f ms, %.3f ms per column; '#' running at least half, '+' running, '.' ready\n",
+		prvMicros( start ) / 1000.0, prvMicros( end ) / 1000.0,
+		prvMicros( end - start ) / 1000.0 / columns );
+	for ( task = 0; task < taskCount; ++task ) {
+		prvPrintRow( tasks[task].name, intervals, task, &tasks[task].readyIntervals, start, end, columns );
+	}
+	prvPrintRow( "(ISR)", isrIntervals, -1, NULL, start, end, columns );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPrintRow( const char *name, const Array *running, int task, const Array *ready,
+	uint64_t start, uint64_t end, int columns )
+{
+	double *run = calloc( columns, sizeof( double ) );	/* Hold the time running in each column. */
+	char *waiting = calloc( columns, 1 );	/* Hold whether ready in each column. */
+	double width = ( double ) ( end - start ) / columns;	/* Hold the counts of a column. */
+	size_t index;		/* Hold the index of the interval. */
+	int column;			/* Hold the index of the column. */
+
+	if ( ( run == NULL ) || ( waiting == NULL ) ) {
+		perror( "tracedecode" );
+		exit( 1 );
+	}
+
+	for ( index = 0; index < running->count; ++index ) {
+		const Interval *interval = &( ( Interval * ) running->items )[ index ];	/* Hold the interval. */
+		uint64_t from, to;	/* Hold the interval, clipped to the chart. */
+
+		if ( ( ( task >= 0 ) && ( interval->task != task ) ) || ( interval->end <= start ) || ( interval->start >= end ) ) {
+			continue;
+		}
+		from = ( interval->start < start ) ? start : interval->start;
+		to = ( interval->end > end ) ? end : interval->end;
+		for ( column = ( int ) ( ( from - start ) / width ); ( column < columns ) && ( start + column * width < to ); ++column ) {
+			double left = start + column * width;	/* Hold the start of the column. */
+			double right = left + width;			/* Hold the end of the column. */
+
+			run[column] += ( ( to < right ) ? to : right ) - ( ( from > left ) ? from : left );
+		}
+	}
+	for ( index = 0; ( ready != NULL ) && ( index < ready->count ); ++index ) {
+		const Interval *interval = &( ( Interval * ) ready->items )[ index ];	/* Hold the interval. */
+
+		if ( ( interval->end <= start ) || ( interval->start >= end ) ) {
+			continue;
+		}
+		for ( column = ( interval->start < start ) ? 0 : ( int ) ( ( interval->start - start ) / width );
+			( column < columns ) && ( start + column * width < interval->end ); ++column ) {
+			waiting[column] = 1;
+		}
+	}
+
+	printf( "%-10s |", name );
+	for ( column = 0; column < columns; ++column ) {
+		putchar( ( run[column] * 2 >= width ) ? '#' : ( run[column] > 0 ) ? '+' : waiting[column] ? '.' : ' ' );
+	}
+	printf( "|\n" );
+
+	free( run );
+	free( waiting );
+}
+
+
+/*-----------------------------------------------------------*/
+static void prvPrintReport( uint64_t span )
+{
+	int task;			/* Hold the index of the task. */
+	int id;				/* Hold the ID of the interrupt. */
+	size_t index;		/* Hold the index of the latency. */
+	uint64_t sum;		/* Hold the sum of the latencies. */
+	uint64_t *sorted;	/* Hold the latencies of the task, in order. */
+	size_t count;		/* Hold the number of latencies. */
+
+	printf( "\n%-10s %8s %10s %7s %8s %9s %9s %9s %9s\n",
+		"task", "runs", "CPU ms", "CPU %", "wakes", "min us", "mean us", "p99 us", "max us" );
+	for ( task = 0; task < taskCount; ++task ) {
+		printf( "%-10s %8u %10.3f %6.2f%% ", tasks[task].name, ( unsigned ) tasks[task].runs,
+			prvMicros( tasks[task].cpu ) / 1000.0, ( span > 0 ) ? ( 100.0 * tasks[task].cpu / span ) : 0.0 );
+
+		count = tasks[task].latencies.count;
+		if ( count == 0 ) {
+			printf( "%8u %9s %9s %9s %9s\n", 0U, "-", "-", "-", "-" );
+			continue;
+		}
+		sorted = tasks[task].latencies.items;
+		qsort( sorted, count, sizeof( uint64_t ), prvCompareTimes );
+		sum = 0;
+		for ( index = 0; index < count; ++index ) {
+			sum += sorted[index];
+		}
+		printf( "%8u %9.2f %9.2f %9.2f %9.2f\n", ( unsigned ) count, prvMicros( sorted[0] ),
+			prvMicros( sum ) / count, prvMicros( sorted[ ( count * 99 ) / 100 ] ), prvMicros( sorted[count - 1] ) );
+	}
+
+	printf( "\n%-10s %8s %10s %7s %8s %9s %9s %9s %9s\n",
+		"interrupt", "count", "total ms", "CPU %", "", "min us", "mean us", "", "max us" );
+	for ( id = 0; id < DECODE_MAX_INTERRUPTS; ++id ) {
+		const Interrupt *irq = &interrupts[id];	/* Hold the interrupt. */
+
+		if ( irq->count == 0 ) {
+			continue;
+		}
+		printf( "IRQ %-6d %8u %10.3f %6.2f%% %8s %9.2f %9.2f %9s %9.2f\n", id, ( unsigned ) irq->count,
+			prvMicros( irq->total ) / 1000.0, ( span > 0 ) ? ( 100.0 * irq->total / span ) : 0.0, "",
+			prvMicros( irq->min ), prvMicros( irq->total ) / irq->count, "", prvMicros( irq->max ) );
+	}
+}
+
+
+/*-----------------------------------------------------------*/
+static double prvMicros( uint64_t counts )
+{
+	return counts / countsPerMicro;
+}
@@ -0,0 +1,34 @@
+/*
+ * xgpio.h
+ *
+ * Host stand-in for the AXI GPIO driver.  The inputs are replayed from a
+ * trace, and the outputs are recorded with the time of each write.  See
+ * sim/xgpio_sim.c.
+ */
+
+#ifndef XGPIO_H			/* prevent circular inclusions */
+#define XGPIO_H			/* by using protection macros */
+
+#include "xil_types.h"
+#include "xstatus.h"
+
+#define XGPIO_IR_MASK		0x3 /**< Mask of all bits */
+#define XGPIO_IR_CH1_MASK	0x1 /**< Mask for the 1st channel */
+#define XGPIO_IR_CH2_MASK	0x2 /**< Mask for the 2nd channel */
+
+/**
+ * The XGpio driver instance data.
+ */
+typedef struct {
+	u16 DeviceId;		/* Device ID of the GPIO */
+	u32 IsReady;		/* Device is initialized and ready */
+	int IsDual;		/* Are 2 Channels supported in h/w */
+} XGpio;
+
+int XGpio_Initialize(XGpio *InstancePtr, u16 DeviceId);
+void XGpio_SetDataDirection(XGpio *InstancePtr, unsigned Channel,
+			    u32 DirectionMask);
+u32 XGpio_DiscreteRead(XGpio *InstancePtr, unsigned Channel);
+void XGpio_DiscreteWrite(XGpio *InstancePtr, unsigned Channel, u32 Mask);
+
+#endif /* end of protection macro */
@@ -0,0 +1,28 @@
+/*
+ * xil_cache.h
+ *
+ * Host stand-in for the cache maintenance of the Cortex-A9.  The host keeps
+ * its caches coherent, so cleaning and invalidating a range are only the
+ * barriers that end them on the target.
+ */
+
+#ifndef XIL_CACHE_H
+#define XIL_CACHE_H
+
+#include "xil_types.h"
+
+static inline void Xil_DCacheFlushRange(INTPTR adr, u32 len)
+{
+	(void) adr;
+	(void) len;
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+static inline void Xil_DCacheInvalidateRange(INTPTR adr, u32 len)
+{
+	(void) adr;
+	(void) len;
+	__atomic_thread_fence(__ATOMIC_SEQ_CST);
+}
+
+#endif /* XIL_CACHE_H */
@@ -0,0 +1,21 @@
+/*
+ * xil_exception.h
+ *
+ * Host stand-in for the exception handlers of the Cortex-A9.  The host takes
+ * no data aborts, so the handlers are kept by sim/xil_mmu_sim.c and never
+ * called.
+ */
+
+#ifndef XIL_EXCEPTION_H
+#define XIL_EXCEPTION_H
+
+#include "xil_types.h"
+
+#define XIL_EXCEPTION_ID_DATA_ABORT_INT		4U
+
+typedef void (*Xil_ExceptionHandler)(void *data);
+
+void Xil_ExceptionRegisterHandler(u32 Exception_id, Xil_ExceptionHandler Handler, void *Data);
+void Xil_DataAbortHandler(void *CallBackRef);
+
+#endif /* XIL_EXCEPTION_H */
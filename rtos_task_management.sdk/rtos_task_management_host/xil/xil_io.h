@@ -0,0 +1,24 @@
+/*
+ * xil_io.h
+ *
+ * Host stand-in for the register access of the Xilinx drivers.  Only the
+ * 32-bit accesses are given, to memory the simulation has mapped at the
+ * address, as sim/amp_sim.c does with the OCM.
+ */
+
+#ifndef XIL_IO_H           /* prevent circular inclusions */
+#define XIL_IO_H           /* by using protection macros */
+
+#include "xil_types.h"
+
+static inline u32 Xil_In32(UINTPTR Addr)
+{
+	return *(volatile u32 *) Addr;
+}
+
+static inline void Xil_Out32(UINTPTR Addr, u32 Value)
+{
+	*(volatile u32 *) Addr = Value;
+}
+
+#endif /* end of protection macro */
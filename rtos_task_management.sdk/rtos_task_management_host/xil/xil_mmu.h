@@ -0,0 +1,19 @@
+/*
+ * xil_mmu.h
+ *
+ * Host stand-in for the MMU functions of the Cortex-A9.  Only the 4KB pages
+ * are modelled, by sim/xil_mmu_sim.c, with the protection of the host pages,
+ * so a write to a guard page kills the process with SIGSEGV.
+ */
+
+#ifndef XIL_MMU_H
+#define XIL_MMU_H
+
+#include "xil_types.h"
+
+#define PAGE_NORM_WB_CACHE 0x576	/* Normal write back cacheable shareable */
+#define PAGE_NO_ACCESS 0x0		/* Generates a translation fault if accessed */
+
+s32 Xil_SetTlbPageAttributes(INTPTR Addr, u32 attrib);
+
+#endif /* XIL_MMU_H */
@@ -0,0 +1,15 @@
+/*
+ * xil_printf.h
+ *
+ * Host stand-in for the Xilinx console output.
+ */
+
+#ifndef XIL_PRINTF_H
+#define XIL_PRINTF_H
+
+#include "xil_types.h"
+
+void xil_printf( const char8 *ctrl1, ...);
+void outbyte( char8 c );
+
+#endif /* XIL_PRINTF_H */
@@ -0,0 +1,42 @@
+/*
+ * xpm_counter.h
+ *
+ * Host stand-in for the Cortex-A9 event counter functions.  The clock cycles
+ * are counted from the host clock at the CPU clock frequency, and every other
+ * event reads as 0.  See sim/xpm_counter_sim.c.
+ */
+
+#ifndef XPMCOUNTER_H /* prevent circular inclusions */
+#define XPMCOUNTER_H /* by using protection macros */
+
+#include "xpseudo_asm.h"
+#include "xil_types.h"
+
+/* Number of performance counters */
+#define XPM_CTRCOUNT 6U
+
+/* The Cortex-A9 Performance Monitor Events used on the host */
+#define XPM_EVENT_IMMEDBRANCH 0x0DU
+#define XPM_EVENT_UNALIGNEDACCESS 0x0FU
+#define XPM_EVENT_BRANCHMISS 0x10U
+#define XPM_EVENT_CLOCKCYCLES 0x11U
+#define XPM_EVENT_BRANCHPREDICT 0x12U
+#define XPM_EVENT_JAVABYTECODE 0x40U
+
+/* The configurations of the event counters */
+#define XPM_CNTRCFG1	0
+#define XPM_CNTRCFG2	1
+#define XPM_CNTRCFG3	2
+#define XPM_CNTRCFG4	3
+#define XPM_CNTRCFG5	4
+#define XPM_CNTRCFG6	5
+#define XPM_CNTRCFG7	6
+#define XPM_CNTRCFG8	7
+#define XPM_CNTRCFG9	8
+#define XPM_CNTRCFG10	9
+#define XPM_CNTRCFG11	10
+
+void Xpm_SetEvents(s32 PmcrCfg);
+void Xpm_GetEventCounters(u32 *PmCtrValue);
+
+#endif /* end of protection macro */
@@ -0,0 +1,25 @@
+/*
+ * xpseudo_asm.h
+ *
+ * Host stand-in for the coprocessor access macros.  Only the performance
+ * monitor registers of xreg_cortexa9.h are modelled, by sim/xpm_counter_sim.c,
+ * and the event that wakes another core.
+ */
+
+#ifndef XPSEUDO_ASM_H /* prevent circular inclusions */
+#define XPSEUDO_ASM_H /* by using protection macros */
+
+#include "xil_types.h"
+#include "xreg_cortexa9.h"
+
+#define mtcp(rn, v)	vSimWriteCp15((rn), (v))
+#define mfcp(rn)	ulSimReadCp15((rn))
+
+/* Core 1 of the AMP simulation polls for its start address instead of
+ * waiting for an event, see sim/amp_sim.c. */
+#define sev()	((void) 0)
+
+void vSimWriteCp15(const char *pcRegister, u32 ulValue);
+u32 ulSimReadCp15(const char *pcRegister);
+
+#endif /* XPSEUDO_ASM_H */
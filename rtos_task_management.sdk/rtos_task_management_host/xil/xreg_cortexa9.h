@@ -0,0 +1,22 @@
+/*
+ * xreg_cortexa9.h
+ *
+ * Host stand-in for the Cortex-A9 register names.  Only the performance
+ * monitor and the data fault registers are given, with the same names as the
+ * GCC definitions of the board support package.
+ */
+
+#ifndef XREG_CORTEXA9_H
+#define XREG_CORTEXA9_H
+
+#define XREG_CP15_PERF_MONITOR_CTRL		"p15, 0, %0,  c9, c12, 0"
+#define XREG_CP15_COUNT_ENABLE_SET		"p15, 0, %0,  c9, c12, 1"
+#define XREG_CP15_EVENT_CNTR_SEL		"p15, 0, %0,  c9, c12, 5"
+#define XREG_CP15_PERF_CYCLE_COUNTER		"p15, 0, %0,  c9, c13, 0"
+#define XREG_CP15_EVENT_TYPE_SEL		"p15, 0, %0,  c9, c13, 1"
+#define XREG_CP15_PERF_MONITOR_COUNT		"p15, 0, %0,  c9, c13, 2"
+
+#define XREG_CP15_DATA_FAULT_STATUS		"p15, 0, %0,  c5,  c0, 0"
+#define XREG_CP15_DATA_FAULT_ADDRESS		"p15, 0, %0,  c6,  c0, 0"
+
+#endif /* XREG_CORTEXA9_H */
@@ -0,0 +1,30 @@
+/*
+ * xscugic.h
+ *
+ * Host stand-in for the interrupt controller driver.  Only the software
+ * generated interrupts are modelled, and are raised as interrupts of the host
+ * port, or on the other core of the AMP simulation.  See sim/xscugic_sim.c.
+ */
+
+#ifndef XSCUGIC_H			/* prevent circular inclusions */
+#define XSCUGIC_H			/* by using protection macros */
+
+#include "xil_types.h"
+#include "xstatus.h"
+
+#define XSCUGIC_MAX_NUM_INTR_INPUTS	95U
+#define XSCUGIC_SPI_CPU0_MASK	0x00000001U /**< CPU 0 Mask*/
+#define XSCUGIC_SPI_CPU1_MASK	0x00000002U /**< CPU 1 Mask*/
+
+/**
+ * The XScuGic driver instance data.
+ */
+typedef struct {
+	u32 IsReady;		/**< Device is initialized and ready */
+} XScuGic;
+
+void XScuGic_SetPriorityTriggerType(XScuGic *InstancePtr, u32 Int_Id,
+					u8 Priority, u8 Trigger);
+s32 XScuGic_SoftwareIntr(XScuGic *InstancePtr, u32 Int_Id, u32 Cpu_Id);
+
+#endif /* end of protection macro */
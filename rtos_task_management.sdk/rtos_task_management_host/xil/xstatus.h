@@ -0,0 +1,14 @@
+/*
+ * xstatus.h
+ *
+ * Host stand-in for the Xilinx status codes.
+ */
+
+#ifndef XSTATUS_H
+#define XSTATUS_H
+
+#define XST_SUCCESS                     0L
+#define XST_FAILURE                     1L
+#define XST_DEVICE_NOT_FOUND            2L
+
+#endif /* XSTATUS_H */
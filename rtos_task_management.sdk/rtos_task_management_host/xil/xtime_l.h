@@ -0,0 +1,21 @@
+/*
+ * xtime_l.h
+ *
+ * Host stand-in for the global timer.  The host clock is scaled to the rate of
+ * the Zynq global timer, so times keep their units on the host.
+ */
+
+#ifndef XTIME_H /* prevent circular inclusions */
+#define XTIME_H /* by using protection macros */
+
+#include "xil_types.h"
+#include "xparameters.h"
+
+typedef u64 XTime;
+
+#define COUNTS_PER_SECOND          (XPAR_CPU_CORTEXA9_CORE_CLOCK_FREQ_HZ /2)
+
+void XTime_SetTime(XTime Xtime_Global);
+void XTime_GetTime(XTime *Xtime_Global);
+
+#endif /* XTIME_H */